@@ -93,6 +93,7 @@ public:
         std::cout << "[OUTTYPE] typeName=" << getOutputTypeName() << std::endl;
         std::cout << "[NUMPARTITIONS] numPartitions=" << numNodePartitions << std::endl;
         std::cout << "[MEM] total memory=" << totalMemoryOnThisNode << std::endl;
+        std::cout << "[PRODUCERS] numProducers=" << numProducers << std::endl;
     }
 
     std::string getOutputTypeName() {
@@ -135,6 +136,17 @@ public:
         return this->totalMemoryOnThisNode;
     }
 
+    // to set the number of nodes that shuffle into the input set while this stage runs
+    void setNumProducers(int numProducers) {
+        this->numProducers = numProducers;
+    }
+
+    // returns 0 if the input set is complete before this stage starts, otherwise the number of
+    // producers whose end of stream this stage waits for
+    int getNumProducers() {
+        return this->numProducers;
+    }
+
 
     ENABLE_DEEP_COPY
 
@@ -158,6 +170,8 @@ private:
     int numNodePartitions;
 
     size_t totalMemoryOnThisNode;
+
+    int numProducers = 0;
 };
 }
 
@@ -0,0 +1,20 @@
+
+#ifndef BACKEND_PING_H
+#define BACKEND_PING_H
+
+#include "Object.h"
+
+//  PRELOAD %BackendPing%
+
+namespace pdb {
+
+// this is sent by the frontend to check that the backend still takes requests; the server answers
+// with a SimpleRequestResult
+class BackendPing : public Object {
+
+public:
+    ENABLE_DEEP_COPY
+};
+}
+
+#endif
@@ -54,6 +54,11 @@ class CatGetDatabaseResult : public Object {
    * The timestamp this database is created on
    */
   long createdOn;
+
+  /**
+   * The version of the catalog when it answered, -1 if unknown
+   */
+  long catalogVersion = -1;
 };
 }
 
@@ -71,6 +71,19 @@ class CatGetSetResult : public Object {
    * The real name of the type see above
    */
   String type;
+
+  /**
+   * How the set is partitioned, see PDBCatalogSet
+   */
+  String partitionLambda;
+  String partitionLambdaInputClass;
+  int32_t numPartitions = 0;
+  String partitionNodes;
+
+  /**
+   * The version of the catalog that answered, so that clients know when their cached metadata is stale
+   */
+  long catalogVersion = -1;
 };
 }
 
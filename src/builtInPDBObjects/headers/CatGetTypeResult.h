@@ -56,6 +56,11 @@ class CatGetTypeResult : public Object {
    */
   pdb::String typeCategory;
 
+  /**
+   * The version of the catalog when it answered, -1 if unknown
+   */
+  long catalogVersion = -1;
+
 };
 }
 
@@ -0,0 +1,89 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2018 Rice University                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+
+#ifndef CAT_SET_PARTITIONING_H
+#define CAT_SET_PARTITIONING_H
+
+#include "Object.h"
+#include "PDBString.h"
+#include "Handle.h"
+
+// PRELOAD %CatSetPartitioningRequest%
+
+namespace pdb {
+
+// encapsulates a request to record how a registered set is partitioned, see PDBCatalogSet; a
+// request with numPartitions 0 clears the partitioning
+class CatSetPartitioningRequest : public Object {
+
+ public:
+  ~CatSetPartitioningRequest() = default;
+  CatSetPartitioningRequest() = default;
+
+  CatSetPartitioningRequest(const std::string &dbName,
+                            const std::string &setName,
+                            const std::string &partitionLambda,
+                            const std::string &partitionLambdaInputClass,
+                            int32_t numPartitions,
+                            const std::string &partitionNodes) : dbName(dbName), setName(setName),
+                                                                 partitionLambda(partitionLambda),
+                                                                 partitionLambdaInputClass(partitionLambdaInputClass),
+                                                                 numPartitions(numPartitions),
+                                                                 partitionNodes(partitionNodes) {}
+
+  CatSetPartitioningRequest(const Handle<CatSetPartitioningRequest> &requestToCopy) {
+    dbName = requestToCopy->dbName;
+    setName = requestToCopy->setName;
+    partitionLambda = requestToCopy->partitionLambda;
+    partitionLambdaInputClass = requestToCopy->partitionLambdaInputClass;
+    numPartitions = requestToCopy->numPartitions;
+    partitionNodes = requestToCopy->partitionNodes;
+  }
+
+  ENABLE_DEEP_COPY
+
+  /**
+   * The name of the database
+   */
+  String dbName;
+
+  /**
+   * The name of the set
+   */
+  String setName;
+
+  /**
+   * The lambda the set is partitioned with and the class it applies to
+   */
+  String partitionLambda;
+  String partitionLambdaInputClass;
+
+  /**
+   * The number of hash partitions, 0 if the set is not partitioned by a lambda
+   */
+  int32_t numPartitions = 0;
+
+  /**
+   * The nodes the partitions are placed on
+   */
+  String partitionNodes;
+};
+
+}
+
+#endif
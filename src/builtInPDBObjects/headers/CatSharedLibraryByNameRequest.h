@@ -36,9 +36,13 @@ public:
     CatSharedLibraryByNameRequest(int16_t identifierIn, String NameIn)
         : identifier(identifierIn), objectTypeName(NameIn) {}
 
+    CatSharedLibraryByNameRequest(int16_t identifierIn, String NameIn, bool hashOnlyIn)
+        : identifier(identifierIn), objectTypeName(NameIn), hashOnly(hashOnlyIn) {}
+
     CatSharedLibraryByNameRequest(const CatSharedLibraryByNameRequest& objectToCopy) {
         objectTypeName = objectToCopy.objectTypeName;
         identifier = objectToCopy.identifier;
+        hashOnly = objectToCopy.hashOnly;
     }
 
     ~CatSharedLibraryByNameRequest(){};
@@ -51,11 +55,17 @@ public:
         return identifier;
     }
 
+    // whether only the content hash of the library is requested, and not its bytes
+    bool isHashOnly() {
+        return hashOnly;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
     int16_t identifier=0;
     String objectTypeName="";
+    bool hashOnly = false;
 };
 }
 
@@ -42,18 +42,20 @@ class CatSyncRequest : public Object {
 
   CatSyncRequest() = default;
 
-  CatSyncRequest(const std::string &nodeIP, int port, const std::string &nodeType) {
+  CatSyncRequest(const std::string &nodeIP, int port, const std::string &nodeType, long sinceVersion = 0) {
 
     // init the fields
     this->nodeIP = nodeIP;
     this->nodePort = port;
     this->nodeType = nodeType;
+    this->sinceVersion = sinceVersion;
   }
 
   explicit CatSyncRequest(const Handle<CatSyncRequest> &requestToCopy) {
     nodeIP = requestToCopy->nodeIP;
     nodePort = requestToCopy->nodePort;
     nodeType = requestToCopy->nodeType;
+    sinceVersion = requestToCopy->sinceVersion;
   }
 
   ~CatSyncRequest() = default;
@@ -74,6 +76,11 @@ class CatSyncRequest : public Object {
    * The type of the node "worker" or "manager"
    */
   pdb::String nodeType;
+
+  /**
+   * The version of the last catalog change the node has applied, the manager sends the changes after it
+   */
+  long sinceVersion = 0;
 };
 
 } /* namespace pdb */
@@ -74,7 +74,7 @@ public:
   ENABLE_DEEP_COPY
 
   /**
-   * The bytes we want to send
+   * The catalog changes the node is missing, as written by PDBCatalogChange::serialize
    */
   pdb::Handle<Vector<unsigned char>> bytes;
   bool restart = false;
@@ -27,6 +27,8 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <cstdio>
+#include <cstdint>
 #include "PDBString.h"
 #include "PDBVector.h"
 
@@ -44,6 +46,7 @@ namespace pdb {
  *   2) name: the name of the type
  *   2) typeCategory either {built-in, user-defined}
  *   3) soBytes: are the bytes of the .so library
+ *   4) soHash: the content hash of the .so library
  */
 
 class CatalogUserTypeMetadata : public pdb::Object {
@@ -72,6 +75,7 @@ public:
 
     // copy the bytes
     memcpy(this->soBytes->c_ptr(), libraryBytes, librarySize);
+    this->soHash = getLibraryHash(libraryBytes, librarySize);
   }
 
   CatalogUserTypeMetadata(const CatalogUserTypeMetadata &pdbCatalogEntryToCopy) {
@@ -80,6 +84,7 @@ public:
     this->typeID = pdbCatalogEntryToCopy.typeID;
     this->typeCategory = pdbCatalogEntryToCopy.typeCategory;
     this->typeName = pdbCatalogEntryToCopy.typeName;
+    this->soHash = pdbCatalogEntryToCopy.soHash;
     this->soBytes = pdb::makeObject<pdb::Vector<char>>(soBytes->size(), soBytes->size());
 
     // copy the bytes
@@ -94,6 +99,21 @@ public:
   pdb::String typeCategory;
   // the bytes containing the .so library file
   pdb::Handle<pdb::Vector<char>> soBytes;
+  // the content hash of the .so library file, set even if the bytes are not sent
+  pdb::String soHash;
+
+  // returns the content hash of a .so library: a 64-bit FNV-1a hash of the bytes and the size,
+  // which is the same on every node, so that nodes can key the libraries they cache by it
+  static std::string getLibraryHash(const char *libraryBytes, size_t librarySize) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < librarySize; i++) {
+      hash ^= (unsigned char) libraryBytes[i];
+      hash *= 1099511628211ULL;
+    }
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long) hash);
+    return std::string(hex) + "." + std::to_string(librarySize);
+  }
 };
 
 } /* namespace pdb */
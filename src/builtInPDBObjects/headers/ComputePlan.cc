@@ -11,6 +11,8 @@
 #include "JoinCompBase.h"
 #include "Lexer.h"
 #include "Parser.h"
+#include <deque>
+#include <pthread.h>
 
 extern int yydebug;
 
@@ -18,14 +20,29 @@ namespace pdb {
 
 inline ComputePlan::ComputePlan() {}
 
-inline LogicalPlanPtr ComputePlan::getPlan() {
-
-    // if we already have the plan, then just return it
-    if (myPlan != nullptr)
-        return myPlan;
+// parses a TCAP program, or returns the result of parsing it before; the parsed programs are
+// shared by all threads, so they must not be changed
+inline std::shared_ptr<AtomicComputationList> parseTCAP(const std::string& tcap) {
+
+    // the programs parsed so far, the oldest first; never destroyed, since pipeline threads may
+    // still run while static objects are destroyed
+    static pthread_mutex_t cacheMutex = PTHREAD_MUTEX_INITIALIZER;
+    static auto* parsed =
+        new std::deque<std::pair<std::string, std::shared_ptr<AtomicComputationList>>>();
+
+    // the lock is held while parsing, so that the threads of a stage, which all start at
+    // once, wait for the first one to parse instead of parsing it themselves
+    pthread_mutex_lock(&cacheMutex);
+    for (auto& entry : *parsed) {
+        if (entry.first == tcap) {
+            std::shared_ptr<AtomicComputationList> result = entry.second;
+            pthread_mutex_unlock(&cacheMutex);
+            return result;
+        }
+    }
 
     // get the string to compile
-    std::string myLogicalPlan = TCAPComputation;
+    std::string myLogicalPlan = tcap;
     myLogicalPlan.push_back('\0');
 
     // where the result of the parse goes
@@ -47,9 +64,30 @@ inline LogicalPlanPtr ComputePlan::getPlan() {
         exit(1);
     }
 
+    // remember the result, forgetting the oldest program if we have too many
+    std::shared_ptr<AtomicComputationList> result(myResult);
+    if (result != nullptr) {
+        if (parsed->size() >= PDB_PARSED_TCAP_CACHE_SIZE) {
+            parsed->pop_front();
+        }
+        parsed->push_back(std::make_pair(tcap, result));
+    }
+    pthread_mutex_unlock(&cacheMutex);
+    return result;
+}
+
+inline LogicalPlanPtr ComputePlan::getPlan() {
+
+    // if we already have the plan, then just return it
+    if (myPlan != nullptr)
+        return myPlan;
+
+    // parse the string, unless some other copy of this plan already did
+    std::shared_ptr<AtomicComputationList> myResult = parseTCAP(TCAPComputation);
+
     if (myResult != nullptr) {
-        // this is the logical plan to return
-        // JiaNote: there is a memory leak regarding myResult, we need to fix it in the future
+        // this is the logical plan to return; it copies the parsed graph, and extracts the
+        // lambdas of our own computations
         myPlan = std::make_shared<LogicalPlan>(*myResult, allComputations);
     }
     // and now we are outta here
@@ -108,6 +146,21 @@ inline std::string ComputePlan::getProducingComputationName(std::string sourceTu
 }
 
 
+inline void ComputePlan::preloadTypes(std::vector<std::string> moreTypeNames) {
+
+    std::vector<std::string> typeNames = moreTypeNames;
+    for (int i = 0; i < allComputations.size(); i++) {
+        // calling a method on the computation fixes the vTablePtr of the computation itself
+        Handle<Computation> curComp = allComputations[i];
+        typeNames.push_back(curComp->getOutputType());
+        for (int j = 0; j < curComp->getNumInputs(); j++) {
+            typeNames.push_back(curComp->getIthInputType(j));
+        }
+    }
+    VTableMap::preloadTypes(typeNames);
+}
+
+
 // JiaNote: ToDo: reuse code to obtain consumer, attsToOperateOn and projection, encapsuelate that
 // into a separate function.
 
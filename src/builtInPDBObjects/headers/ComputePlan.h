@@ -12,6 +12,12 @@
 #include "SinkMerger.h"
 #include "SinkShuffler.h"
 
+// how many parsed TCAP programs a process keeps, so that the threads and stages that run the same
+// program parse it only once
+#ifndef PDB_PARSED_TCAP_CACHE_SIZE
+#define PDB_PARSED_TCAP_CACHE_SIZE 16
+#endif
+
 // PRELOAD %ComputePlan%
 
 namespace pdb {
@@ -60,11 +66,19 @@ public:
     //     on the
     //     AtomicComputation objects stored in the graph of SIMD-style operations.
     //
+    // The TCAP string is parsed only once per process: the parsed graph is never changed once
+    // built, so all the copies of a plan (one per pipeline thread) share it, and each copy only
+    // extracts the lambdas of its own Computation objects.
+    //
     LogicalPlanPtr getPlan();
 
     // JiaNote: get producing computation name
     std::string getProducingComputationName(std::string sourceTupleSetName);
 
+    // loads the shared libraries of all user types that the computations consume and produce,
+    // together with the given type names, before any pipeline starts to run
+    void preloadTypes(std::vector<std::string> moreTypeNames = std::vector<std::string>());
+
     // Note that once getPlan () has been called, ComputePlan object contains a C++ smart pointer
     // inside of it.
     // IT IS VERY DANGEROUS TO SEND SUCH A POINTER ACCROSS THE NETWORK.  Hence, after calling
@@ -126,6 +126,38 @@ public:
         return this->desiredSize;
     }
 
+    // the version of the set on the node that reports it, which is bumped on any change
+    void setVersion (long version) {
+        this->version = version;
+    }
+
+    long getVersion () {
+        return this->version;
+    }
+
+    // the execution profile of the stage that wrote the set on the node that reports it
+    void setProfile (std::string profile) {
+        this->profile = profile;
+    }
+
+    std::string getProfile () {
+        return this->profile;
+    }
+
+    // set by the node that reports the set if the stage that wrote it failed there
+    void setFailure (std::string errMsg) {
+        this->failed = true;
+        this->errMsg = errMsg;
+    }
+
+    bool isFailed () {
+        return this->failed;
+    }
+
+    std::string getErrMsg () {
+        return this->errMsg;
+    }
+
 private:
     String dataBase;
     String setName;
@@ -140,6 +172,10 @@ private:
     int numHashKeys = 0;
     String dataType;
     size_t desiredSize;
+    long version = 0;
+    String profile;
+    bool failed = false;
+    String errMsg;
 };
 }
 
@@ -31,6 +31,15 @@ public:
         return numHashKeys;
     }
 
+    // the execution profile of the job stage that this is the result of
+    void setProfile (std::string profile) {
+        this->profile = profile;
+    }
+
+    std::string getProfile() {
+        return profile;
+    }
+
     std::pair<bool, std::string> getRes() {
         return std::make_pair(res, errMsg);
     }
@@ -39,6 +48,7 @@ private:
     bool res;
     String errMsg;
     int numHashKeys = 0;
+    String profile;
 };
 }
 
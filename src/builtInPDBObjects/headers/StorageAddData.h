@@ -23,13 +23,15 @@ public:
                    bool typeCheck = true,
                    bool flushOrNot = true,
                    bool compressedOrNot = false,
-                   bool directPutOrNot = false)
+                   bool directPutOrNot = false,
+                   bool lastOfStreamOrNot = false)
         : dataBase(dataBase), setName(setName), typeName(typeName) {
         this->typeCheck = typeCheck;
         this->typeID = -1;
         this->flushOrNot = flushOrNot;
         this->compressedOrNot = compressedOrNot;
         this->directPutOrNot = directPutOrNot;
+        this->lastOfStreamOrNot = lastOfStreamOrNot;
     }
 
 
@@ -40,13 +42,15 @@ public:
                    bool typeCheck = true,
                    bool flushOrNot = true,
                    bool compressedOrNot = false,
-                   bool directPutOrNot = false)
+                   bool directPutOrNot = false,
+                   bool lastOfStreamOrNot = false)
         : dataBase(dataBase), setName(setName), typeName(typeName) {
         this->typeCheck = typeCheck;
         this->typeID = typeID;
         this->flushOrNot = flushOrNot;
         this->compressedOrNot = compressedOrNot;
         this->directPutOrNot = directPutOrNot;
+        this->lastOfStreamOrNot = lastOfStreamOrNot;
     }
 
     std::string getDatabase() {
@@ -81,6 +85,11 @@ public:
         return directPutOrNot;
     }
 
+    // true if this is the last data the sender adds to the set while a consumer scans it
+    bool isLastOfStream() {
+        return lastOfStreamOrNot;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
@@ -92,6 +101,7 @@ private:
     bool flushOrNot;
     bool compressedOrNot;
     bool directPutOrNot;
+    bool lastOfStreamOrNot = false;
 };
 }
 
@@ -17,8 +17,18 @@ public:
     StorageCollectStats() {}
     ~StorageCollectStats() {}
 
+    StorageCollectStats(long sinceVersion) : sinceVersion(sinceVersion) {}
+
+    // only sets changed after this statistics version are returned
+    long getSinceVersion() {
+        return sinceVersion;
+    }
+
 
     ENABLE_DEEP_COPY
+
+private:
+    long sinceVersion = 0;
 };
 }
 
@@ -7,18 +7,27 @@
 #include "PDBString.h"
 #include "PDBVector.h"
 #include "SetIdentifier.h"
+#include "DataTypes.h"
 
 // PRELOAD %StorageCollectStatsResponse%
 
 namespace pdb {
 
-// encapsulates a request to return all user set information
+// encapsulates the statistics of user sets on one node, either as a response to
+// StorageCollectStats, or pushed by the node to the manager when its sets change
 class StorageCollectStatsResponse : public Object {
 
 public:
     StorageCollectStatsResponse() {}
     ~StorageCollectStatsResponse() {}
 
+    StorageCollectStatsResponse(NodeID nodeId,
+                                long version,
+                                Handle<Vector<Handle<SetIdentifier>>> stats)
+        : nodeId(nodeId), version(version) {
+        this->stats = stats;
+    }
+
     Handle<Vector<Handle<SetIdentifier>>>& getStats() {
         return stats;
     }
@@ -28,10 +37,29 @@ public:
         this->stats = stats;
     }
 
+    NodeID getNodeId() {
+        return nodeId;
+    }
+
+    void setNodeId(NodeID nodeId) {
+        this->nodeId = nodeId;
+    }
+
+    // the statistics version of the node when the stats were taken
+    long getVersion() {
+        return version;
+    }
+
+    void setVersion(long version) {
+        this->version = version;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
     Handle<Vector<Handle<SetIdentifier>>> stats;
+    NodeID nodeId = -1;
+    long version = 0;
 };
 }
 
@@ -4,6 +4,7 @@
 
 
 #include "Object.h"
+#include "DataTypes.h"
 
 //  PRELOAD %StorageNoMorePage%
 
@@ -16,7 +17,49 @@ public:
     StorageNoMorePage() {}
     ~StorageNoMorePage() {}
 
+    // the scan of the given set finished, so that a backend that scans several sets at once
+    // closes the right scanner
+    StorageNoMorePage(DatabaseID dbId, UserTypeID typeId, SetID setId) {
+        this->forSet = true;
+        this->dbId = dbId;
+        this->typeId = typeId;
+        this->setId = setId;
+    }
+
+    bool isForSet() {
+        return this->forSet;
+    }
+
+    DatabaseID getDatabaseID() {
+        return this->dbId;
+    }
+
+    UserTypeID getUserTypeID() {
+        return this->typeId;
+    }
+
+    SetID getSetID() {
+        return this->setId;
+    }
+
+    // a scan is incomplete if it gave up waiting for the producers of a shuffle stream, so
+    // the pages the backend got are not all the data of the set
+    void setComplete(bool complete) {
+        this->complete = complete;
+    }
+
+    bool isComplete() {
+        return this->complete;
+    }
+
     ENABLE_DEEP_COPY
+
+private:
+    bool forSet = false;
+    DatabaseID dbId = 0;
+    UserTypeID typeId = 0;
+    SetID setId = 0;
+    bool complete = true;
 };
 }
 
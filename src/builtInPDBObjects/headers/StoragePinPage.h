@@ -85,6 +85,15 @@ public:
         this->pageId = pageId;
     }
 
+    // the NUMA node of the thread that will use the page, -1 if unknown
+    int getNumaNode() {
+        return this->numaNode;
+    }
+
+    void setNumaNode(int numaNode) {
+        this->numaNode = numaNode;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
@@ -94,6 +103,7 @@ private:
     UserTypeID userTypeId;
     SetID setId;
     PageID pageId;
+    int numaNode = -1;
 };
 }
 
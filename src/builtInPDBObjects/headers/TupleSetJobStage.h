@@ -312,6 +312,8 @@ public:
             }
         }
         std::cout << "[Probing] isProbing=" << this->probeOrNot << std::endl;
+        std::cout << "[Pipelined] isPipelinedWithConsumer=" << this->pipelinedWithConsumerOrNot
+                  << std::endl;
         std::cout << "Number of cluster nodes=" << getNumNodes() << std::endl;
         std::cout << "Total memory on this node is " << totalMemoryOnThisNode << std::endl;
         std::cout << "Number of total partitions=" << getNumTotalPartitions() << std::endl;
@@ -464,6 +466,28 @@ public:
         return this->allocatorPolicy;
     }
 
+    // to set whether the stage that consumes the shuffled output runs at the same time as this
+    // stage, so that each node marks the end of what it sends
+    void setPipelinedWithConsumer(bool pipelinedWithConsumerOrNot) {
+        this->pipelinedWithConsumerOrNot = pipelinedWithConsumerOrNot;
+    }
+
+    // to return whether the consumer of the shuffled output runs at the same time as this stage
+    bool isPipelinedWithConsumer() {
+        return this->pipelinedWithConsumerOrNot;
+    }
+
+    // to set how the pages that this stage shuffles or broadcasts are compressed, e.g. "none",
+    // "snappy", "lz4", "zstd:3" or "adaptive"
+    void setShuffleCodec(std::string shuffleCodec) {
+        this->shuffleCodec = shuffleCodec;
+    }
+
+    // to return how the pages that this stage shuffles or broadcasts are compressed
+    std::string getShuffleCodec() {
+        return this->shuffleCodec;
+    }
+
     ENABLE_DEEP_COPY
 
 
@@ -571,6 +595,11 @@ private:
     //Does this stage has local join probe
     bool localJoinProbeOrNot = false;
 
+    // Does the consumer of the shuffled output run at the same time as this stage?
+    bool pipelinedWithConsumerOrNot = false;
+
+    // how the shuffled or broadcasted pages are compressed
+    String shuffleCodec;
 
 };
 }
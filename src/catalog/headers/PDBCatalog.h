@@ -261,7 +261,56 @@ class PDBCatalog {
    */
   bool updateNode(const PDBCatalogNodePtr& node, std::string &error);
 
+  /**
+   * Stores the library of a type that was registered without one
+   * @param typeName - the name of the type
+   * @param soBytes - the bytes of the library
+   * @param error - the error if any
+   * @return true if we stored it, false otherwise
+   */
+  bool updateTypeLibrary(const std::string &typeName, const std::vector<char> &soBytes, std::string &error);
+
+  /**
+   * Records how a set is partitioned, the partition lambda, the number of partitions and the nodes they are placed on
+   * @param set - the set with the partitioning, the set is looked up by its database and name
+   * @param error - the error if any
+   * @return true if we recorded it, false otherwise
+   */
+  bool updateSetPartitioning(const PDBCatalogSet &set, std::string &error);
+
+  /**
+   * Appends a change to the change log, with the version after the latest one
+   * @param change - the change
+   * @return the version of the change
+   */
+  long logChange(PDBCatalogChange change);
+
+  /**
+   * If the change log is empty but the catalog is not (it was created before the catalog kept a log), records
+   * every database, set, user type and node as a change, so that replaying the log rebuilds the catalog
+   */
+  void initChangeLog();
+
+  /**
+   * Applies a change of another catalog, and records it in the change log with its version. A change that is
+   * already in effect is skipped, so that replaying changes some of which were already applied is safe.
+   * @param change - the change
+   * @param error - the error if any
+   * @return true if the catalog reflects the change, false otherwise
+   */
+  bool applyChange(const PDBCatalogChange &change, std::string &error);
 
+  /**
+   * Returns the version of the latest change in the change log, 0 if it is empty
+   */
+  long getLatestChange();
+
+  /**
+   * Returns the changes with a version larger than the given one, in order
+   * @param version - the version
+   * @return the changes
+   */
+  std::vector<PDBCatalogChange> getChangesSince(long version);
 
  private:
 
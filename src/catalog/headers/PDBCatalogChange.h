@@ -0,0 +1,273 @@
+//
+// A change of the catalog, as recorded in the change log of the manager catalog
+//
+
+#ifndef PDB_PDBCATALOGCHANGE_H
+#define PDB_PDBCATALOGCHANGE_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sqlite_orm.h>
+
+#include "PDBCatalogSet.h"
+#include "PDBCatalogType.h"
+#include "PDBCatalogNode.h"
+
+namespace pdb {
+
+/**
+ * This class maps the change log of the catalog. The manager catalog appends a change with the next version every
+ * time it registers or removes something, and a worker catalog asks for the changes since the last version it has
+ * applied, instead of copying the whole catalog. The changes of types do not carry the libraries, a worker fetches
+ * the library of a type the first time it is asked for it.
+ */
+class PDBCatalogChange {
+ public:
+
+  /**
+   * The kinds of changes
+   */
+  static constexpr const char *ADD_DATABASE = "addDatabase";
+  static constexpr const char *ADD_SET = "addSet";
+  static constexpr const char *ADD_TYPE = "addType";
+  static constexpr const char *ADD_NODE = "addNode";
+  static constexpr const char *REMOVE_DATABASE = "removeDatabase";
+  static constexpr const char *REMOVE_SET = "removeSet";
+  static constexpr const char *SET_PARTITIONING = "setPartitioning";
+
+  /**
+   * The default constructor needed by the orm
+   */
+  PDBCatalogChange() = default;
+
+  static PDBCatalogChange addDatabase(const std::string &database) {
+    PDBCatalogChange change;
+    change.operation = ADD_DATABASE;
+    change.database = database;
+    return change;
+  }
+
+  static PDBCatalogChange addSet(const PDBCatalogSet &set) {
+    PDBCatalogChange change;
+    change.operation = ADD_SET;
+    change.database = set.database;
+    change.setName = set.name;
+    change.typeName = set.type == nullptr ? "" : *set.type;
+    return change;
+  }
+
+  static PDBCatalogChange addType(const PDBCatalogType &type) {
+    PDBCatalogChange change;
+    change.operation = ADD_TYPE;
+    change.typeName = type.name;
+    change.typeID = type.id;
+    change.typeCategory = type.typeCategory;
+    return change;
+  }
+
+  static PDBCatalogChange addNode(const PDBCatalogNode &node) {
+    PDBCatalogChange change;
+    change.operation = ADD_NODE;
+    change.nodeID = node.nodeID;
+    change.nodeAddress = node.address;
+    change.nodePort = node.port;
+    change.nodeType = node.nodeType;
+    return change;
+  }
+
+  static PDBCatalogChange removeDatabase(const std::string &database) {
+    PDBCatalogChange change;
+    change.operation = REMOVE_DATABASE;
+    change.database = database;
+    return change;
+  }
+
+  static PDBCatalogChange removeSet(const std::string &database, const std::string &setName) {
+    PDBCatalogChange change;
+    change.operation = REMOVE_SET;
+    change.database = database;
+    change.setName = setName;
+    return change;
+  }
+
+  static PDBCatalogChange setPartitioning(const PDBCatalogSet &set) {
+    PDBCatalogChange change;
+    change.operation = SET_PARTITIONING;
+    change.database = set.database;
+    change.setName = set.name;
+    change.typeName = set.type == nullptr ? "" : *set.type;
+    change.partitionLambda = set.partitionLambda;
+    change.partitionLambdaInputClass = set.partitionLambdaInputClass;
+    change.numPartitions = set.numPartitions;
+    change.partitionNodes = set.partitionNodes;
+    return change;
+  }
+
+  /**
+   * The version of the change, versions start at 1 and grow by one with every change
+   */
+  long version = 0;
+
+  /**
+   * What the change does, one of the kinds above
+   */
+  std::string operation;
+
+  /**
+   * The database that is added or removed, or the database of the set
+   */
+  std::string database;
+
+  /**
+   * The name of the set that is added or removed
+   */
+  std::string setName;
+
+  /**
+   * The name of the type that is added, or the type of the set
+   */
+  std::string typeName;
+
+  /**
+   * The id and the category of the type that is added
+   */
+  int typeID = -1;
+  std::string typeCategory;
+
+  /**
+   * The node that is added
+   */
+  std::string nodeID;
+  std::string nodeAddress;
+  int nodePort = -1;
+  std::string nodeType;
+
+  /**
+   * The partitioning of the set, see PDBCatalogSet
+   */
+  std::string partitionLambda;
+  std::string partitionLambdaInputClass;
+  int numPartitions = 0;
+  std::string partitionNodes;
+
+  /**
+   * Writes changes into bytes to send them to another node
+   * @param changes - the changes
+   * @param bytes - where we append the bytes
+   */
+  static void serialize(const std::vector<PDBCatalogChange> &changes, std::vector<unsigned char> &bytes) {
+    for (const auto &change : changes) {
+      writeValue(bytes, change.version);
+      writeString(bytes, change.operation);
+      writeString(bytes, change.database);
+      writeString(bytes, change.setName);
+      writeString(bytes, change.typeName);
+      writeValue(bytes, change.typeID);
+      writeString(bytes, change.typeCategory);
+      writeString(bytes, change.nodeID);
+      writeString(bytes, change.nodeAddress);
+      writeValue(bytes, change.nodePort);
+      writeString(bytes, change.nodeType);
+      writeString(bytes, change.partitionLambda);
+      writeString(bytes, change.partitionLambdaInputClass);
+      writeValue(bytes, change.numPartitions);
+      writeString(bytes, change.partitionNodes);
+    }
+  }
+
+  /**
+   * Reads changes written by serialize
+   * @param bytes - the bytes
+   * @param numBytes - how many bytes there are
+   * @param changes - where we put the changes
+   * @return false if the bytes are malformed
+   */
+  static bool deserialize(const unsigned char *bytes, size_t numBytes, std::vector<PDBCatalogChange> &changes) {
+    size_t pos = 0;
+    while (pos < numBytes) {
+      PDBCatalogChange change;
+      if (!readValue(bytes, numBytes, pos, change.version) ||
+          !readString(bytes, numBytes, pos, change.operation) ||
+          !readString(bytes, numBytes, pos, change.database) ||
+          !readString(bytes, numBytes, pos, change.setName) ||
+          !readString(bytes, numBytes, pos, change.typeName) ||
+          !readValue(bytes, numBytes, pos, change.typeID) ||
+          !readString(bytes, numBytes, pos, change.typeCategory) ||
+          !readString(bytes, numBytes, pos, change.nodeID) ||
+          !readString(bytes, numBytes, pos, change.nodeAddress) ||
+          !readValue(bytes, numBytes, pos, change.nodePort) ||
+          !readString(bytes, numBytes, pos, change.nodeType) ||
+          !readString(bytes, numBytes, pos, change.partitionLambda) ||
+          !readString(bytes, numBytes, pos, change.partitionLambdaInputClass) ||
+          !readValue(bytes, numBytes, pos, change.numPartitions) ||
+          !readString(bytes, numBytes, pos, change.partitionNodes)) {
+        return false;
+      }
+      changes.push_back(std::move(change));
+    }
+    return true;
+  }
+
+  /**
+   * Return the schema of the database object
+   * @return the schema
+   */
+  static auto getSchema() {
+
+    // return the schema
+    return sqlite_orm::make_table("changes", sqlite_orm::make_column("version", &PDBCatalogChange::version),
+                                             sqlite_orm::make_column("operation", &PDBCatalogChange::operation),
+                                             sqlite_orm::make_column("changeDatabase", &PDBCatalogChange::database),
+                                             sqlite_orm::make_column("changeSetName", &PDBCatalogChange::setName),
+                                             sqlite_orm::make_column("changeTypeName", &PDBCatalogChange::typeName),
+                                             sqlite_orm::make_column("changeTypeID", &PDBCatalogChange::typeID),
+                                             sqlite_orm::make_column("changeTypeCategory", &PDBCatalogChange::typeCategory),
+                                             sqlite_orm::make_column("changeNodeID", &PDBCatalogChange::nodeID),
+                                             sqlite_orm::make_column("changeNodeAddress", &PDBCatalogChange::nodeAddress),
+                                             sqlite_orm::make_column("changeNodePort", &PDBCatalogChange::nodePort),
+                                             sqlite_orm::make_column("changeNodeType", &PDBCatalogChange::nodeType),
+                                             sqlite_orm::make_column("changePartitionLambda", &PDBCatalogChange::partitionLambda, sqlite_orm::default_value(std::string())),
+                                             sqlite_orm::make_column("changePartitionLambdaInputClass", &PDBCatalogChange::partitionLambdaInputClass, sqlite_orm::default_value(std::string())),
+                                             sqlite_orm::make_column("changeNumPartitions", &PDBCatalogChange::numPartitions, sqlite_orm::default_value(0)),
+                                             sqlite_orm::make_column("changePartitionNodes", &PDBCatalogChange::partitionNodes, sqlite_orm::default_value(std::string())),
+                                             sqlite_orm::primary_key(&PDBCatalogChange::version));
+  }
+
+ private:
+
+  template <class Value>
+  static void writeValue(std::vector<unsigned char> &bytes, Value value) {
+    auto *begin = (unsigned char *) &value;
+    bytes.insert(bytes.end(), begin, begin + sizeof(Value));
+  }
+
+  static void writeString(std::vector<unsigned char> &bytes, const std::string &value) {
+    writeValue(bytes, (size_t) value.size());
+    bytes.insert(bytes.end(), value.begin(), value.end());
+  }
+
+  template <class Value>
+  static bool readValue(const unsigned char *bytes, size_t numBytes, size_t &pos, Value &value) {
+    if (numBytes - pos < sizeof(Value)) {
+      return false;
+    }
+    memcpy(&value, bytes + pos, sizeof(Value));
+    pos += sizeof(Value);
+    return true;
+  }
+
+  static bool readString(const unsigned char *bytes, size_t numBytes, size_t &pos, std::string &value) {
+    size_t size;
+    if (!readValue(bytes, numBytes, pos, size) || numBytes - pos < size) {
+      return false;
+    }
+    value.assign((const char *) bytes + pos, size);
+    pos += size;
+    return true;
+  }
+};
+
+}
+
+#endif //PDB_PDBCATALOGCHANGE_H
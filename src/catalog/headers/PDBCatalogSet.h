@@ -66,6 +66,45 @@ class PDBCatalogSet {
    */
   std::shared_ptr<std::string> type;
 
+  /**
+   * The lambda the set was partitioned with when it was loaded, the name of the attribute or the method it applies,
+   * empty if the set is not partitioned by a lambda
+   */
+  std::string partitionLambda;
+
+  /**
+   * The class the partition lambda is applied to
+   */
+  std::string partitionLambdaInputClass;
+
+  /**
+   * The number of hash partitions the set is split into, 0 if the set is not partitioned by a lambda
+   */
+  int numPartitions = 0;
+
+  /**
+   * The nodes the partitions are placed on, "ip:port" of each node in the order of the node ids, separated by commas.
+   * Partition i lives on node i / (numPartitions / number of nodes)
+   */
+  std::string partitionNodes;
+
+  /**
+   * Returns true if the set is partitioned by a lambda
+   */
+  bool isPartitioned() const {
+    return numPartitions > 0 && !partitionLambda.empty();
+  }
+
+  /**
+   * Returns true if this set and the other set have their partitions placed the same way, so that partition i of
+   * both sets lives on the same node
+   * @param other - the other set
+   */
+  bool isPlacedLike(const PDBCatalogSet &other) const {
+    return isPartitioned() && other.isPartitioned() && numPartitions == other.numPartitions &&
+           partitionNodes == other.partitionNodes;
+  }
+
   /**
    * Return the schema of the database object
    * @return the schema
@@ -77,6 +116,10 @@ class PDBCatalogSet {
                                            sqlite_orm::make_column("setName", &PDBCatalogSet::name),
                                            sqlite_orm::make_column("setDatabase", &PDBCatalogSet::database),
                                            sqlite_orm::make_column("setType", &PDBCatalogSet::type),
+                                           sqlite_orm::make_column("setPartitionLambda", &PDBCatalogSet::partitionLambda, sqlite_orm::default_value(std::string())),
+                                           sqlite_orm::make_column("setPartitionLambdaInputClass", &PDBCatalogSet::partitionLambdaInputClass, sqlite_orm::default_value(std::string())),
+                                           sqlite_orm::make_column("setNumPartitions", &PDBCatalogSet::numPartitions, sqlite_orm::default_value(0)),
+                                           sqlite_orm::make_column("setPartitionNodes", &PDBCatalogSet::partitionNodes, sqlite_orm::default_value(std::string())),
                                            sqlite_orm::foreign_key(&PDBCatalogSet::database).references(&PDBCatalogDatabase::name),
                                            sqlite_orm::foreign_key(&PDBCatalogSet::type).references(&PDBCatalogType::name),
                                            sqlite_orm::primary_key(&PDBCatalogSet::setIdentifier));
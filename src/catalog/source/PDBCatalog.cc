@@ -316,22 +316,8 @@ int32_t pdb::PDBCatalog::numRegisteredTypes() {
 
 std::vector<pdb::PDBCatalogSet> pdb::PDBCatalog::getSetsInDatabase(const std::string &dbName) {
 
-  // select all the sets
-  auto rows = storage.select(columns(&PDBCatalogSet::name, &PDBCatalogSet::database, &PDBCatalogSet::type),
-                             where(c(&PDBCatalogSet::database) == dbName));
-
-  // create a return value
-  std::vector<pdb::PDBCatalogSet> ret;
-
-  // preallocate
-  ret.reserve(rows.size());
-
-  // create the objects
-  for(auto &r : rows) {
-    ret.emplace_back(pdb::PDBCatalogSet(std::get<0>(r), std::get<1>(r), *std::get<2>(r)));
-  }
-
-  return std::move(ret);
+  // select all the sets, with their partitioning
+  return std::move(storage.get_all<PDBCatalogSet>(where(c(&PDBCatalogSet::database) == dbName)));
 }
 
 std::vector<pdb::PDBCatalogNode> pdb::PDBCatalog::getNodes() {
@@ -464,3 +450,175 @@ bool pdb::PDBCatalog::removeSet(const std::string &dbName, const std::string &se
 
   return true;
 }
+
+bool pdb::PDBCatalog::updateTypeLibrary(const std::string &typeName, const std::vector<char> &soBytes, std::string &error) {
+
+  try {
+
+    // grab the type
+    auto type = getType(typeName);
+
+    // if the type does not exist indicate an error
+    if(type == nullptr) {
+      error = "The type " + typeName + " does not exist\n";
+      return false;
+    }
+
+    // store the library
+    type->soBytes = soBytes;
+    storage.replace(*type);
+
+    return true;
+
+  } catch(std::system_error &e){
+
+    // set the error we failed
+    error = "Could not update the library of the type : " + typeName +  "! The SQL error is : "  + std::string(e.what());
+
+    // we failed
+    return false;
+  }
+}
+
+bool pdb::PDBCatalog::updateSetPartitioning(const pdb::PDBCatalogSet &set, std::string &error) {
+
+  try {
+
+    // grab the set
+    auto stored = getSet(set.database, set.name);
+
+    // if the set does not exist indicate an error
+    if(stored == nullptr) {
+      error = "Set with the identifier " + set.database + ":" + set.name + " does not exist\n";
+      return false;
+    }
+
+    // store the partitioning
+    stored->partitionLambda = set.partitionLambda;
+    stored->partitionLambdaInputClass = set.partitionLambdaInputClass;
+    stored->numPartitions = set.numPartitions;
+    stored->partitionNodes = set.partitionNodes;
+    storage.replace(*stored);
+
+    return true;
+
+  } catch(std::system_error &e){
+
+    // set the error we failed
+    error = "Could not update the partitioning of the set : " + set.database + ":" + set.name +  "! The SQL error is : "  + std::string(e.what());
+
+    // we failed
+    return false;
+  }
+}
+
+long pdb::PDBCatalog::logChange(pdb::PDBCatalogChange change) {
+
+  // the next version
+  change.version = getLatestChange() + 1;
+
+  // store the change
+  storage.replace(change);
+
+  return change.version;
+}
+
+void pdb::PDBCatalog::initChangeLog() {
+
+  // if there is a log we are done
+  if(getLatestChange() != 0) {
+    return;
+  }
+
+  // the types first, since a set refers to its type, the ones every catalog registers by itself are skipped when the
+  // log is applied
+  for(const auto &type : getTypesWithoutLibrary()) {
+    logChange(PDBCatalogChange::addType(type));
+  }
+
+  // then the databases, then their sets
+  for(const auto &db : getDatabases()) {
+    logChange(PDBCatalogChange::addDatabase(db.name));
+  }
+  for(const auto &db : getDatabases()) {
+    for(const auto &set : getSetsInDatabase(db.name)) {
+      logChange(PDBCatalogChange::addSet(set));
+      if(set.isPartitioned()) {
+        logChange(PDBCatalogChange::setPartitioning(set));
+      }
+    }
+  }
+
+  // and the nodes
+  for(const auto &node : getNodes()) {
+    logChange(PDBCatalogChange::addNode(node));
+  }
+}
+
+bool pdb::PDBCatalog::applyChange(const pdb::PDBCatalogChange &change, std::string &error) {
+
+  bool res = true;
+
+  if(change.operation == PDBCatalogChange::ADD_DATABASE) {
+    res = databaseExists(change.database) || registerDatabase(std::make_shared<PDBCatalogDatabase>(change.database), error);
+  }
+  else if(change.operation == PDBCatalogChange::ADD_SET) {
+
+    // the set may have been removed and added again with a different type
+    auto set = getSet(change.database, change.setName);
+    if(set != nullptr && (set->type == nullptr || *set->type != change.typeName)) {
+      res = removeSet(change.database, change.setName, error);
+      set = nullptr;
+    }
+    res = res && (set != nullptr || registerSet(std::make_shared<PDBCatalogSet>(change.setName, change.database, change.typeName), error));
+  }
+  else if(change.operation == PDBCatalogChange::ADD_TYPE) {
+
+    // the library is fetched from the manager the first time it is needed
+    res = typeExists(change.typeName) ||
+          registerType(std::make_shared<PDBCatalogType>(change.typeID, change.typeCategory, change.typeName, std::vector<char>()), error);
+  }
+  else if(change.operation == PDBCatalogChange::ADD_NODE) {
+    res = nodeExists(change.nodeID) ||
+          registerNode(std::make_shared<PDBCatalogNode>(change.nodeID, change.nodeAddress, change.nodePort, change.nodeType), error);
+  }
+  else if(change.operation == PDBCatalogChange::REMOVE_DATABASE) {
+    res = !databaseExists(change.database) || removeDatabase(change.database, error);
+  }
+  else if(change.operation == PDBCatalogChange::REMOVE_SET) {
+    res = !setExists(change.database, change.setName) || removeSet(change.database, change.setName, error);
+  }
+  else if(change.operation == PDBCatalogChange::SET_PARTITIONING) {
+    PDBCatalogSet set(change.setName, change.database, change.typeName);
+    set.partitionLambda = change.partitionLambda;
+    set.partitionLambdaInputClass = change.partitionLambdaInputClass;
+    set.numPartitions = change.numPartitions;
+    set.partitionNodes = change.partitionNodes;
+    res = updateSetPartitioning(set, error);
+  }
+  else {
+    error = "Unknown catalog change " + change.operation + "\n";
+    return false;
+  }
+
+  // remember that we have applied it
+  if(res) {
+    storage.replace(change);
+  }
+
+  return res;
+}
+
+long pdb::PDBCatalog::getLatestChange() {
+
+  // grab the largest version
+  auto latest = storage.max(&PDBCatalogChange::version);
+
+  // if there is none the log is empty
+  return latest == nullptr ? 0 : *latest;
+}
+
+std::vector<pdb::PDBCatalogChange> pdb::PDBCatalog::getChangesSince(long version) {
+  return std::move(storage.get_all<PDBCatalogChange>(where(c(&PDBCatalogChange::version) > version),
+                                                     order_by(&PDBCatalogChange::version)));
+}
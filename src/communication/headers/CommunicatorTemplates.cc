@@ -87,9 +87,9 @@ bool PDBCommunicator::sendObject(Handle<ObjType>& sendMe, std::string& errMsg) {
 
     PDB_COUT << "Sent object with typeName=" << getTypeName<ObjType>() << ", recType=" << recType
              << " and socketFD=" << socketFD << std::endl;
-    logToMe->info(std::string("Sent object with typeName=") + getTypeName<ObjType>() +
-                  std::string(", recType=") + std::to_string(recType) +
-                  std::string(" and socketFD=") + std::to_string(socketFD));
+    PDB_LOG_INFO(logToMe, std::string("Sent object with typeName=") + getTypeName<ObjType>() +
+                          std::string(", recType=") + std::to_string(recType) +
+                          std::string(" and socketFD=") + std::to_string(socketFD));
     return true;
 }
 
@@ -150,13 +150,13 @@ Handle<ObjType> PDBCommunicator::getNextObject(void* readToHere,
     // if we have previously gotten the size, just return it
     if (!readCurMsgSize) {
         getSizeOfNextObject();
-        logToMe->debug(std::string("run getSizeOfNextObject() and get type=") +
-                       std::to_string(nextTypeID) + std::string(" and size=") +
-                       std::to_string(msgSize));
+        PDB_LOG_DEBUG(logToMe, std::string("run getSizeOfNextObject() and get type=") +
+                               std::to_string(nextTypeID) + std::string(" and size=") +
+                               std::to_string(msgSize));
     } else {
-        logToMe->debug(std::string("get size info directly with type=") +
-                       std::to_string(nextTypeID) + std::string(" and size=") +
-                       std::to_string(msgSize));
+        PDB_LOG_DEBUG(logToMe, std::string("get size info directly with type=") +
+                               std::to_string(nextTypeID) + std::string(" and size=") +
+                               std::to_string(msgSize));
     }
 
     if (msgSize == 0) {
@@ -189,9 +189,9 @@ Handle<ObjType> PDBCommunicator::getNextObject(void* readToHere,
 
     // create an object and get outta here
     success = true;
-    logToMe->trace("PDBCommunicator: read the object with no problem.");
-    logToMe->trace("PDBCommunicator: root offset is " +
-                   std::to_string(((Record<ObjType>*)readToHere)->rootObjectOffset()));
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: read the object with no problem.");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: root offset is " +
+                           std::to_string(((Record<ObjType>*)readToHere)->rootObjectOffset()));
     readCurMsgSize = false;
     return ((Record<ObjType>*)readToHere)->getRootObject();
 }
@@ -202,13 +202,13 @@ Handle<ObjType> PDBCommunicator::getNextObject(bool& success, std::string& errMs
     // if we have previously gotten the size, just return it
     if (!readCurMsgSize) {
         getSizeOfNextObject();
-        logToMe->debug(std::string("run getSizeOfNextObject() and get type=") +
-                       std::to_string(nextTypeID) + std::string(" and size=") +
-                       std::to_string(msgSize));
+        PDB_LOG_DEBUG(logToMe, std::string("run getSizeOfNextObject() and get type=") +
+                               std::to_string(nextTypeID) + std::string(" and size=") +
+                               std::to_string(msgSize));
     } else {
-        logToMe->debug(std::string("get size info directly with type=") +
-                       std::to_string(nextTypeID) + std::string(" and size=") +
-                       std::to_string(msgSize));
+        PDB_LOG_DEBUG(logToMe, std::string("get size info directly with type=") +
+                               std::to_string(nextTypeID) + std::string(" and size=") +
+                               std::to_string(msgSize));
     }
     if (msgSize == 0) {
         success = false;
@@ -234,11 +234,11 @@ Handle<ObjType> PDBCommunicator::getNextObject(bool& success, std::string& errMs
     UseTemporaryAllocationBlock myBlock{(size_t)(msgSize) + (size_t)16 * (size_t)1024 * (size_t)1024};
     // if we were successful, then copy it to the current allocation block
     if (success) {
-        logToMe->trace("PDBCommunicator: about to do the deep copy.");
+        PDB_LOG_TRACE(logToMe, "PDBCommunicator: about to do the deep copy.");
         // std :: cout << "to get handle by deep copy to current block" << std :: endl;
         temp = deepCopyToCurrentAllocationBlock(temp);
         // std :: cout << "got handle" << std :: endl;
-        logToMe->trace("PDBCommunicator: completed the deep copy.");
+        PDB_LOG_TRACE(logToMe, "PDBCommunicator: completed the deep copy.");
         free(mem);
         return temp;
     } else {
@@ -0,0 +1,71 @@
+
+#ifndef PDB_PAGE_CODEC_H
+#define PDB_PAGE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// how many released compression buffers are kept for reuse
+#ifndef PDB_CODEC_POOL_SIZE
+#define PDB_CODEC_POOL_SIZE 16
+#endif
+
+// the zstd level used when "zstd" is given without a level
+#ifndef PDB_DEFAULT_ZSTD_LEVEL
+#define PDB_DEFAULT_ZSTD_LEVEL 1
+#endif
+
+// This class compresses the pages that are shuffled or broadcasted between nodes.  A compressed
+// page travels as a frame: a small header, which names the codec and the size of the page,
+// followed by the compressed bytes, so that the receiver can decompress it without knowing how
+// the sender was configured, and straight into the page where it ends up.  Bytes without the
+// header are taken as raw snappy, which is what the dispatcher still sends.
+//
+// LZ4 and zstd are used only if the build found them (PDB_HAVE_LZ4 and PDB_HAVE_ZSTD); otherwise
+// those codecs fall back to snappy, and the frame says so.
+
+namespace pdb {
+
+enum PageCodecType { NoCodec = 0, SnappyCodec = 1, LZ4Codec = 2, ZstdCodec = 3 };
+
+class PageCodec {
+
+public:
+    // parses "none", "snappy", "lz4", "zstd" or "zstd:<level>"; returns false if the name is
+    // not one of those
+    static bool parse(std::string name, PageCodecType& codec, int& level);
+
+    // returns the name of a codec, as parse accepts it
+    static std::string getName(PageCodecType codec, int level);
+
+    // returns true if this build can compress with the codec
+    static bool isAvailable(PageCodecType codec);
+
+    // returns the largest frame that compressing numBytes can produce
+    static size_t maxFrameSize(PageCodecType codec, size_t numBytes);
+
+    // compresses numBytes at bytes into frame, which must have room for maxFrameSize bytes;
+    // returns the size of the frame
+    static size_t compress(
+        PageCodecType codec, int level, const char* bytes, size_t numBytes, char* frame);
+
+    // returns the size of the page that a frame decompresses into, or 0 if the frame is malformed
+    static size_t getPageSize(const char* frame, size_t frameSize);
+
+    // returns the codec that compressed a frame
+    static PageCodecType getCodec(const char* frame, size_t frameSize);
+
+    // decompresses a frame into dest, which has room for destSize bytes; returns false if the
+    // frame is malformed or the page does not fit
+    static bool decompress(const char* frame, size_t frameSize, char* dest, size_t destSize);
+
+    // returns a buffer of at least size bytes, reusing a released one if there is one
+    static char* getBuffer(size_t size);
+
+    // gives a buffer from getBuffer back to the pool
+    static void releaseBuffer(char* buffer);
+};
+}
+
+#endif
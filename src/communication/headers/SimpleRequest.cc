@@ -42,7 +42,7 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
                       << " and address=" << address << std::endl;
             return onErr;
         }
-        myLogger->info(std::string("Successfully connected to remote server with port=") +
+        PDB_LOG_INFO(myLogger, std::string("Successfully connected to remote server with port=") +
                        std::to_string(port) + std::string(" and address=") + address);
         PDB_COUT << "Successfully connected to remote server with port=" << port
                  << " and address=" << address << std::endl;
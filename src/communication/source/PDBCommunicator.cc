@@ -49,7 +49,7 @@ bool PDBCommunicator::pointToInternet(PDBLoggerPtr logToMeIn, int socketFDIn, st
     struct sockaddr_in cli_addr;
     socklen_t clilen = sizeof(cli_addr);
     bzero((char*)&cli_addr, sizeof(cli_addr));
-    logToMe->info("PDBCommunicator: about to wait for request from Internet");
+    PDB_LOG_INFO(logToMe, "PDBCommunicator: about to wait for request from Internet");
     socketFD = accept(socketFDIn, (struct sockaddr*)&cli_addr, &clilen);
     if (socketFD < 0) {
         logToMe->error("PDBCommunicator: could not get FD to internet socket");
@@ -61,7 +61,7 @@ bool PDBCommunicator::pointToInternet(PDBLoggerPtr logToMeIn, int socketFDIn, st
         return true;
     }
     socketClosed = false;
-    logToMe->info("PDBCommunicator: got request from Internet");
+    PDB_LOG_INFO(logToMe, "PDBCommunicator: got request from Internet");
     return false;
 }
 
@@ -89,8 +89,8 @@ bool PDBCommunicator::connectToInternetServer(PDBLoggerPtr logToMeIn,
         return true;
     }
 
-    logToMe->trace("PDBCommunicator: Got internet socket");
-    logToMe->trace("PDBCommunicator: About to check the database for the host name");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: Got internet socket");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: About to check the database for the host name");
     */
     /* CHRIS NOTE: turns out that gethostbyname () is depricated, and should be replaced */
     // std :: cout << "Address cstring=" << serverAddress.c_str() << std :: endl;
@@ -106,7 +106,7 @@ bool PDBCommunicator::connectToInternetServer(PDBLoggerPtr logToMeIn,
         return true;
     }*/
 
-    logToMe->trace("PDBCommunicator: About to connect to the remote host");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: About to connect to the remote host");
 
     /*
     bzero((char *) &serv_addr, sizeof (serv_addr));
@@ -151,7 +151,7 @@ bool PDBCommunicator::connectToInternetServer(PDBLoggerPtr logToMeIn,
     for (rp = result; rp != NULL; rp = rp->ai_next) {
         int count = 0;
         while (count <= MAX_RETRIES) {
-            logToMe->trace("PDBCommunicator: creating socket....");
+            PDB_LOG_TRACE(logToMe, "PDBCommunicator: creating socket....");
             socketFD = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
             if (socketFD == -1) {
                 continue;
@@ -190,8 +190,8 @@ bool PDBCommunicator::connectToInternetServer(PDBLoggerPtr logToMeIn,
     this->portNumber = portNumber;
     this->serverAddress = serverAddress;
     socketClosed = false;
-    logToMe->trace("PDBCommunicator: Successfully connected to the remote host");
-    logToMe->trace("PDBCommunicator: Socket FD is " + std::to_string(socketFD));
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: Successfully connected to the remote host");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: Socket FD is " + std::to_string(socketFD));
     /*    std :: cout << "##########################" << std :: endl;
         std :: cout << "Connected to server with port =" << portNumber <<", address =" <<
        serverAddress << ", socket=" << socketFD << std :: endl;
@@ -254,7 +254,7 @@ bool PDBCommunicator::pointToFile(PDBLoggerPtr logToMeIn, int socketFDIn, std::s
     // connect to the backend
     logToMe = logToMeIn;
 
-    logToMe->trace("PDBCommunicator: about to wait for request from same machine");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: about to wait for request from same machine");
     socketFD = accept(socketFDIn, 0, 0);
     if (socketFD < 0) {
         logToMe->error("PDBCommunicator: could not get FD to local socket");
@@ -267,7 +267,7 @@ bool PDBCommunicator::pointToFile(PDBLoggerPtr logToMeIn, int socketFDIn, std::s
         return true;
     }
 
-    logToMe->trace("PDBCommunicator: got request from same machine");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: got request from same machine");
     socketClosed = false;
     return false;
 }
@@ -281,10 +281,10 @@ PDBCommunicator::~PDBCommunicator() {
     if (needToSendDisconnectMsg && socketFD > 0) {
         const UseTemporaryAllocationBlock tempBlock{1024};
         Handle<CloseConnection> temp = makeObject<CloseConnection>();
-        logToMe->trace("PDBCommunicator: closing connection to the server");
+        PDB_LOG_TRACE(logToMe, "PDBCommunicator: closing connection to the server");
         std::string errMsg;
         if (!sendObject(temp, errMsg)) {
-            logToMe->trace("PDBCommunicator: could not send close connection message");
+            PDB_LOG_TRACE(logToMe, "PDBCommunicator: could not send close connection message");
         }
     }
 
@@ -334,7 +334,7 @@ size_t PDBCommunicator::getSizeOfNextObject() {
 
     // if we have previously gotten the size, just return it
     if (readCurMsgSize) {
-        logToMe->debug("getSizeOfNextObject: we've done this before");
+        PDB_LOG_DEBUG(logToMe, "getSizeOfNextObject: we've done this before");
         return msgSize;
     }
 
@@ -359,8 +359,8 @@ size_t PDBCommunicator::getSizeOfNextObject() {
             socketClosed = true;
             return 0;
         } else if (receivedBytes == 0) {
-            logToMe->info(
-                "PDBCommunicator: the other side closed the socket when we try to read the type");
+            PDB_LOG_INFO(
+                logToMe, "PDBCommunicator: the other side closed the socket when we try to read the type");
             nextTypeID = NoMsg_TYPEID;
             PDB_COUT
                 << "PDBCommunicator: the other side closed the socket when we try to get next type"
@@ -368,7 +368,7 @@ size_t PDBCommunicator::getSizeOfNextObject() {
 
             if (retries < 0) {
                 retries++;
-                logToMe->info("PDBCommunicator: Retry to see whether network can recover");
+                PDB_LOG_INFO(logToMe, "PDBCommunicator: Retry to see whether network can recover");
                 PDB_COUT << "PDBCommunicator: Retry to see whether network can recover"
                          << std::endl;
                 continue;
@@ -381,15 +381,15 @@ size_t PDBCommunicator::getSizeOfNextObject() {
             }
 
         } else {
-            logToMe->info(std::string("PDBCommunicator: receivedBytes for reading type is ") +
-                          std::to_string(receivedBytes));
+            PDB_LOG_INFO(logToMe, std::string("PDBCommunicator: receivedBytes for reading type is ") +
+                                  std::to_string(receivedBytes));
             receivedTotal = receivedTotal + receivedBytes;
             bytesToReceive = sizeof(int16_t) - receivedTotal;
         }
     }
     // now we get enough bytes
-    logToMe->trace("PDBCommunicator: typeID of next object is " + std::to_string(nextTypeID));
-    logToMe->trace("PDBCommunicator: getting the size of the next object:");
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: typeID of next object is " + std::to_string(nextTypeID));
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: getting the size of the next object:");
 
     // make sure we got enough bytes... if we did not, then error out
     receivedBytes = 0;
@@ -410,8 +410,8 @@ size_t PDBCommunicator::getSizeOfNextObject() {
             msgSize = 0;
             return 0;
         } else if (receivedBytes == 0) {
-            logToMe->info(
-                "PDBCommunicator: the other side closed the socket when we try to get next size");
+            PDB_LOG_INFO(
+                logToMe, "PDBCommunicator: the other side closed the socket when we try to get next size");
             nextTypeID = NoMsg_TYPEID;
             PDB_COUT
                 << "PDBCommunicator: the other side closed the socket when we try to get next size"
@@ -421,7 +421,7 @@ size_t PDBCommunicator::getSizeOfNextObject() {
                 retries++;
                 PDB_COUT << "PDBCommunicator: Retry to see whether network can recover"
                          << std::endl;
-                logToMe->info("PDBCommunicator: Retry to see whether network can recover");
+                PDB_LOG_INFO(logToMe, "PDBCommunicator: Retry to see whether network can recover");
                 continue;
             } else {
                 close(socketFD);
@@ -432,14 +432,14 @@ size_t PDBCommunicator::getSizeOfNextObject() {
             }
 
         } else {
-            logToMe->info(std::string("PDBCommunicator: receivedBytes for reading size is ") +
-                          std::to_string(receivedBytes));
+            PDB_LOG_INFO(logToMe, std::string("PDBCommunicator: receivedBytes for reading size is ") +
+                                  std::to_string(receivedBytes));
             receivedTotal = receivedTotal + receivedBytes;
             bytesToReceive = sizeof(size_t) - receivedTotal;
         }
     }
     // OK, we did get enough bytes
-    logToMe->trace("PDBCommunicator: size of next object is " + std::to_string(msgSize));
+    PDB_LOG_TRACE(logToMe, "PDBCommunicator: size of next object is " + std::to_string(msgSize));
     readCurMsgSize = true;
     return msgSize;
 }
@@ -455,16 +455,16 @@ bool PDBCommunicator::doTheWrite(char* start, char* end) {
         // make sure they went through
         if (numBytes < 0) {
             logToMe->error("PDBCommunicator: error in socket write");
-            logToMe->trace("PDBCommunicator: tried to write " + std::to_string(end - start) +
-                           " bytes.\n");
-            logToMe->trace("PDBCommunicator: Socket FD is " + std::to_string(socketFD));
+            PDB_LOG_TRACE(logToMe, "PDBCommunicator: tried to write " + std::to_string(end - start) +
+                                   " bytes.\n");
+            PDB_LOG_TRACE(logToMe, "PDBCommunicator: Socket FD is " + std::to_string(socketFD));
             logToMe->error(strerror(errno));
             // if (retries < MAX_RETRIES) {
             if (retries < 0) {
                 retries++;
                 PDB_COUT << "PDBCommunicator: Retry to see whether network can recover"
                          << std::endl;
-                logToMe->info("PDBCommunicator: Retry to see whether network can recover");
+                PDB_LOG_INFO(logToMe, "PDBCommunicator: Retry to see whether network can recover");
                 continue;
                 continue;
             } else {
@@ -478,8 +478,8 @@ bool PDBCommunicator::doTheWrite(char* start, char* end) {
                 return true;
             }
         } else {
-            logToMe->trace("PDBCommunicator: wrote " + std::to_string(numBytes) + " and are " +
-                           std::to_string(end - start - numBytes) + " to go!");
+            PDB_LOG_TRACE(logToMe, "PDBCommunicator: wrote " + std::to_string(numBytes) + " and are " +
+                                   std::to_string(end - start - numBytes) + " to go!");
             start += numBytes;
         }
     }
@@ -501,7 +501,7 @@ bool PDBCommunicator::doTheRead(char* dataIn) {
     while (cur - start < (long)msgSize) {
 
         ssize_t numBytes = read(socketFD, cur, msgSize - (cur - start));
-        this->logToMe->trace("PDBCommunicator: received bytes: " + std::to_string(numBytes));
+        PDB_LOG_TRACE(logToMe, "PDBCommunicator: received bytes: " + std::to_string(numBytes));
 
         if (numBytes < 0) {
             logToMe->error(
@@ -512,12 +512,12 @@ bool PDBCommunicator::doTheRead(char* dataIn) {
             socketClosed = true;
             return true;
         } else if (numBytes == 0) {
-            logToMe->info("PDBCommunicator: the other side closed the socket when we do the read");
+            PDB_LOG_INFO(logToMe, "PDBCommunicator: the other side closed the socket when we do the read");
             PDB_COUT << "PDBCommunicator: the other side closed the socket when we doTheRead"
                      << std::endl;
             if (retries < 0) {
                 retries++;
-                logToMe->info("PDBCommunicator: Retry to see whether network can recover");
+                PDB_LOG_INFO(logToMe, "PDBCommunicator: Retry to see whether network can recover");
                 PDB_COUT << "PDBCommunicator: Retry to see whether network can recover"
                          << std::endl;
                 continue;
@@ -530,8 +530,8 @@ bool PDBCommunicator::doTheRead(char* dataIn) {
         } else {
             cur += numBytes;
         }
-        this->logToMe->trace("PDBCommunicator: " + std::to_string(msgSize - (cur - start)) +
-                             " bytes to go!");
+        PDB_LOG_TRACE(logToMe, "PDBCommunicator: " + std::to_string(msgSize - (cur - start)) +
+                               " bytes to go!");
     }
     return false;
 }
@@ -0,0 +1,290 @@
+
+#ifndef PDB_PAGE_CODEC_CC
+#define PDB_PAGE_CODEC_CC
+
+#include "PageCodec.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include <snappy.h>
+#ifdef PDB_HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef PDB_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace pdb {
+
+namespace {
+
+// the header of a frame; a snappy stream starts with its length as a varint of at most five
+// bytes, the last of which is below 0x10, so it never starts with the five 0xff of the magic
+struct PageFrameHeader {
+    unsigned char magic[8];
+    uint16_t codec;
+    uint16_t level;
+    uint32_t reserved;
+    uint64_t pageSize;
+};
+
+const unsigned char frameMagic[8] = {0xff, 0xff, 0xff, 0xff, 0xff, 'P', 'G', 'C'};
+
+// the released buffers, each of which starts with its capacity
+pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+std::vector<char*> pool;
+
+#ifdef PDB_HAVE_ZSTD
+// zstd contexts are expensive to set up, so each thread keeps its own
+thread_local ZSTD_CCtx* zstdCompressContext = nullptr;
+thread_local ZSTD_DCtx* zstdDecompressContext = nullptr;
+#endif
+
+bool isFrame(const char* frame, size_t frameSize) {
+    return frameSize >= sizeof(PageFrameHeader) && memcmp(frame, frameMagic, 8) == 0;
+}
+
+// the codec that compress really uses for the given one
+PageCodecType getUsableCodec(PageCodecType codec) {
+    return PageCodec::isAvailable(codec) ? codec : SnappyCodec;
+}
+}
+
+bool PageCodec::parse(std::string name, PageCodecType& codec, int& level) {
+    level = 0;
+    if (name == "none") {
+        codec = NoCodec;
+    } else if (name == "snappy") {
+        codec = SnappyCodec;
+    } else if (name == "lz4") {
+        codec = LZ4Codec;
+    } else if (name == "zstd") {
+        codec = ZstdCodec;
+        level = PDB_DEFAULT_ZSTD_LEVEL;
+    } else if (name.compare(0, 5, "zstd:") == 0) {
+        codec = ZstdCodec;
+        level = atoi(name.c_str() + 5);
+        if (level <= 0) {
+            level = PDB_DEFAULT_ZSTD_LEVEL;
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string PageCodec::getName(PageCodecType codec, int level) {
+    switch (codec) {
+        case NoCodec:
+            return "none";
+        case SnappyCodec:
+            return "snappy";
+        case LZ4Codec:
+            return "lz4";
+        case ZstdCodec:
+            return "zstd:" + std::to_string(level);
+    }
+    return "unknown";
+}
+
+bool PageCodec::isAvailable(PageCodecType codec) {
+    switch (codec) {
+        case NoCodec:
+        case SnappyCodec:
+            return true;
+        case LZ4Codec:
+#ifdef PDB_HAVE_LZ4
+            return true;
+#else
+            return false;
+#endif
+        case ZstdCodec:
+#ifdef PDB_HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+size_t PageCodec::maxFrameSize(PageCodecType codec, size_t numBytes) {
+    size_t maxSize = numBytes;
+    switch (getUsableCodec(codec)) {
+        case NoCodec:
+            break;
+        case SnappyCodec:
+            maxSize = snappy::MaxCompressedLength(numBytes);
+            break;
+        case LZ4Codec:
+#ifdef PDB_HAVE_LZ4
+            maxSize = LZ4_compressBound(numBytes);
+#endif
+            break;
+        case ZstdCodec:
+#ifdef PDB_HAVE_ZSTD
+            maxSize = ZSTD_compressBound(numBytes);
+#endif
+            break;
+    }
+    return sizeof(PageFrameHeader) + maxSize;
+}
+
+size_t PageCodec::compress(
+    PageCodecType codec, int level, const char* bytes, size_t numBytes, char* frame) {
+    codec = getUsableCodec(codec);
+    PageFrameHeader* header = (PageFrameHeader*)frame;
+    memcpy(header->magic, frameMagic, 8);
+    header->codec = codec;
+    header->level = level;
+    header->reserved = 0;
+    header->pageSize = numBytes;
+    char* dest = frame + sizeof(PageFrameHeader);
+    size_t compressedSize = numBytes;
+    switch (codec) {
+        case NoCodec:
+            memcpy(dest, bytes, numBytes);
+            break;
+        case SnappyCodec:
+            snappy::RawCompress(bytes, numBytes, dest, &compressedSize);
+            break;
+        case LZ4Codec:
+#ifdef PDB_HAVE_LZ4
+        {
+            size_t destSize = maxFrameSize(codec, numBytes) - sizeof(PageFrameHeader);
+            compressedSize = LZ4_compress_default(bytes, dest, (int)numBytes, (int)destSize);
+        }
+#endif
+            break;
+        case ZstdCodec:
+#ifdef PDB_HAVE_ZSTD
+            if (zstdCompressContext == nullptr) {
+                zstdCompressContext = ZSTD_createCCtx();
+            }
+            compressedSize = ZSTD_compressCCtx(zstdCompressContext,
+                                               dest,
+                                               maxFrameSize(codec, numBytes) - sizeof(PageFrameHeader),
+                                               bytes,
+                                               numBytes,
+                                               level);
+            if (ZSTD_isError(compressedSize)) {
+                std::cout << "PageCodec: zstd failed: " << ZSTD_getErrorName(compressedSize)
+                          << std::endl;
+                header->codec = NoCodec;
+                memcpy(dest, bytes, numBytes);
+                compressedSize = numBytes;
+            }
+#endif
+            break;
+    }
+    return sizeof(PageFrameHeader) + compressedSize;
+}
+
+size_t PageCodec::getPageSize(const char* frame, size_t frameSize) {
+    if (isFrame(frame, frameSize)) {
+        return ((PageFrameHeader*)frame)->pageSize;
+    }
+    size_t pageSize = 0;
+    if (!snappy::GetUncompressedLength(frame, frameSize, &pageSize)) {
+        return 0;
+    }
+    return pageSize;
+}
+
+PageCodecType PageCodec::getCodec(const char* frame, size_t frameSize) {
+    if (isFrame(frame, frameSize)) {
+        return (PageCodecType)((PageFrameHeader*)frame)->codec;
+    }
+    return SnappyCodec;
+}
+
+bool PageCodec::decompress(const char* frame, size_t frameSize, char* dest, size_t destSize) {
+    size_t pageSize = getPageSize(frame, frameSize);
+    if (pageSize == 0 || pageSize > destSize) {
+        return false;
+    }
+    if (!isFrame(frame, frameSize)) {
+        return snappy::RawUncompress(frame, frameSize, dest);
+    }
+    PageFrameHeader* header = (PageFrameHeader*)frame;
+    const char* bytes = frame + sizeof(PageFrameHeader);
+    size_t numBytes = frameSize - sizeof(PageFrameHeader);
+    switch (header->codec) {
+        case NoCodec:
+            if (numBytes != pageSize) {
+                return false;
+            }
+            memcpy(dest, bytes, numBytes);
+            return true;
+        case SnappyCodec: {
+            // snappy writes as many bytes as its stream says, which must be what the header says
+            size_t uncompressedSize = 0;
+            if (!snappy::GetUncompressedLength(bytes, numBytes, &uncompressedSize) ||
+                uncompressedSize != pageSize) {
+                return false;
+            }
+            return snappy::RawUncompress(bytes, numBytes, dest);
+        }
+#ifdef PDB_HAVE_LZ4
+        case LZ4Codec:
+            return LZ4_decompress_safe(bytes, dest, (int)numBytes, (int)pageSize) ==
+                (int)pageSize;
+#endif
+#ifdef PDB_HAVE_ZSTD
+        case ZstdCodec: {
+            if (zstdDecompressContext == nullptr) {
+                zstdDecompressContext = ZSTD_createDCtx();
+            }
+            size_t res =
+                ZSTD_decompressDCtx(zstdDecompressContext, dest, pageSize, bytes, numBytes);
+            return !ZSTD_isError(res) && res == pageSize;
+        }
+#endif
+        default:
+            std::cout << "PageCodec: this build can not decompress "
+                      << getName((PageCodecType)header->codec, header->level) << std::endl;
+            return false;
+    }
+}
+
+char* PageCodec::getBuffer(size_t size) {
+    char* buffer = nullptr;
+    pthread_mutex_lock(&poolMutex);
+    for (size_t i = 0; i < pool.size(); i++) {
+        if (*((size_t*)pool[i]) >= size) {
+            buffer = pool[i];
+            pool[i] = pool.back();
+            pool.pop_back();
+            break;
+        }
+    }
+    pthread_mutex_unlock(&poolMutex);
+    if (buffer == nullptr) {
+        buffer = (char*)malloc(size + sizeof(size_t));
+        if (buffer == nullptr) {
+            std::cout << "PageCodec: failed to allocate memory with size=" << size << std::endl;
+            exit(1);
+        }
+        *((size_t*)buffer) = size;
+    }
+    return buffer + sizeof(size_t);
+}
+
+void PageCodec::releaseBuffer(char* buffer) {
+    if (buffer == nullptr) {
+        return;
+    }
+    buffer -= sizeof(size_t);
+    pthread_mutex_lock(&poolMutex);
+    if (pool.size() < PDB_CODEC_POOL_SIZE) {
+        pool.push_back(buffer);
+        buffer = nullptr;
+    }
+    pthread_mutex_unlock(&poolMutex);
+    free(buffer);
+}
+}
+
+#endif
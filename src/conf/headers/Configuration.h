@@ -8,6 +8,10 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
 #include "DataTypes.h"
 
 #include "LogLevel.h"
@@ -15,6 +19,11 @@
 
 using namespace std;
 
+// the settings file read by servers that are started by MasterMain and WorkerMain
+#ifndef DEFAULT_SETTINGS_FILE
+#define DEFAULT_SETTINGS_FILE "conf/pdbSettings.conf"
+#endif
+
 #ifndef DEFAULT_PAGE_SIZE
 #define DEFAULT_PAGE_SIZE ((size_t)(256) * (size_t)(1024) * (size_t)(1024))
 #endif
@@ -37,6 +46,21 @@ using namespace std;
 #define DEFAULT_BROADCAST_PAGE_SIZE size_t(512) * size_t(1024) * size_t(1024)
 #endif
 
+// pages no larger than SMALL_PAGE_MAX_SIZE are carved out of slabs of SMALL_PAGE_SLAB_SIZE
+// bytes in shared memory, with one power-of-two size class (starting at SMALL_PAGE_MIN_SIZE)
+// per slab, so that small pages do not fragment the pool for large pages
+#ifndef SMALL_PAGE_MIN_SIZE
+#define SMALL_PAGE_MIN_SIZE ((size_t)(64) * (size_t)(1024))
+#endif
+
+#ifndef SMALL_PAGE_MAX_SIZE
+#define SMALL_PAGE_MAX_SIZE ((size_t)(16) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+#ifndef SMALL_PAGE_SLAB_SIZE
+#define SMALL_PAGE_SLAB_SIZE ((size_t)(64) * (size_t)(1024) * (size_t)(1024))
+#endif
+
 
 #ifndef DEFAULT_MAX_CONNECTIONS
 #define DEFAULT_MAX_CONNECTIONS 200
@@ -68,6 +92,12 @@ using namespace std;
 #define DEFAULT_NUM_CORES 8 
 #endif
 
+// how shuffled and broadcasted pages are compressed, unless a stage says otherwise:
+// "none", "snappy", "lz4", "zstd:<level>", or "adaptive" to compress only while it pays off
+#ifndef DEFAULT_SHUFFLE_CODEC
+#define DEFAULT_SHUFFLE_CODEC "adaptive"
+#endif
+
 // create a smart pointer for Configuration objects
 class Configuration;
 typedef shared_ptr<Configuration> ConfigurationPtr;
@@ -105,6 +135,11 @@ private:
     LogLevel logLevel;
     string rootDir;
     string selfLearningDB;
+    bool numaAware;
+    bool pinThreads;
+    bool useHugePages;
+    string shuffleCodec;
+    bool resultCaching;
 
 public:
     Configuration() {
@@ -136,6 +171,63 @@ public:
         hashPageSize = DEFAULT_HASH_PAGE_SIZE;
         initDirs();
         selfLearningDB = "selfLearningDB";
+        numaAware = false;
+        pinThreads = false;
+        useHugePages = false;
+        shuffleCodec = DEFAULT_SHUFFLE_CODEC;
+        resultCaching = false;
+    }
+
+    // to read the key=value lines of a settings file, skipping comments; spaces and commas
+    // are removed from values, and the first line of a key wins
+    static std::map<std::string, std::string> readSettings(std::string settingsFile) {
+        std::map<std::string, std::string> keyValues;
+        std::ifstream infile(settingsFile);
+        std::string line;
+        while (std::getline(infile, line)) {
+            size_t found = line.find_first_not_of(" \t");
+            if ((found == std::string::npos) || (line[found] == '#')) {
+                continue;
+            }
+            std::istringstream isLine(line);
+            std::string key;
+            std::string value;
+            if (std::getline(isLine, key, '=')) {
+                std::getline(isLine, value);
+                key.erase(std::remove_if(key.begin(), key.end(), ::isspace), key.end());
+                value.erase(std::remove_if(value.begin(), value.end(), ::isspace), value.end());
+                value.erase(std::remove(value.begin(), value.end(), ','), value.end());
+                keyValues.insert(std::make_pair(key, value));
+            }
+        }
+        return keyValues;
+    }
+
+    // to map a setting to a boolean
+    static bool toBool(std::string str) {
+        std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+        return (str == "true") || (str == "1") || (str == "y") || (str == "yes");
+    }
+
+    // to load the settings from a settings file, settings that are missing in the file
+    // keep their current values
+    void loadSettings(std::string settingsFile = DEFAULT_SETTINGS_FILE) {
+        std::map<std::string, std::string> keyValues = readSettings(settingsFile);
+        if (keyValues.count("numaAware") > 0) {
+            numaAware = toBool(keyValues["numaAware"]);
+        }
+        if (keyValues.count("pinThreads") > 0) {
+            pinThreads = toBool(keyValues["pinThreads"]);
+        }
+        if (keyValues.count("useHugePages") > 0) {
+            useHugePages = toBool(keyValues["useHugePages"]);
+        }
+        if (keyValues.count("resultCaching") > 0) {
+            resultCaching = toBool(keyValues["resultCaching"]);
+        }
+        if (keyValues.count("shuffleCodec") > 0) {
+            shuffleCodec = keyValues["shuffleCodec"];
+        }
     }
 
     void initDirs() {
@@ -424,6 +516,46 @@ public:
         this->selfLearningDB = selfLearningDB;
     }
 
+    bool getNumaAware() {
+        return this->numaAware;
+    }
+
+    void setNumaAware(bool numaAware) {
+        this->numaAware = numaAware;
+    }
+
+    bool getPinThreads() {
+        return this->pinThreads;
+    }
+
+    void setPinThreads(bool pinThreads) {
+        this->pinThreads = pinThreads;
+    }
+
+    bool getUseHugePages() {
+        return this->useHugePages;
+    }
+
+    void setUseHugePages(bool useHugePages) {
+        this->useHugePages = useHugePages;
+    }
+
+    string getShuffleCodec() {
+        return this->shuffleCodec;
+    }
+
+    void setShuffleCodec(string shuffleCodec) {
+        this->shuffleCodec = shuffleCodec;
+    }
+
+    bool getResultCaching() {
+        return this->resultCaching;
+    }
+
+    void setResultCaching(bool resultCaching) {
+        this->resultCaching = resultCaching;
+    }
+
 
     void printOut() {
         cout << "nodeID: " << nodeId << endl;
@@ -454,6 +586,11 @@ public:
         cout << "logEnabled: " << logEnabled << endl;
         cout << "batchSize: " << batchSize << endl;
         cout << "selfLearningDB: " << selfLearningDB << endl;
+        cout << "numaAware: " << numaAware << endl;
+        cout << "pinThreads: " << pinThreads << endl;
+        cout << "useHugePages: " << useHugePages << endl;
+        cout << "shuffleCodec: " << shuffleCodec << endl;
+        cout << "resultCaching: " << resultCaching << endl;
     }
 };
 
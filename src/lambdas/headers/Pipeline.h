@@ -6,6 +6,7 @@
 #include "ComputeSink.h"
 #include "UseTemporaryAllocationBlock.h"
 #include "Handle.h"
+#include "ExecutionProfiler.h"
 #include <queue>
 
 #ifndef MIN_BATCH_SIZE
@@ -85,6 +86,14 @@ private:
 
     int delay = DELAY_VALUE;
 
+    // gets a new output page, and records the time to pin it
+    MemoryHolderPtr getNewOutputPage() {
+        long begin = ExecutionProfiler::now();
+        std::pair<void*, size_t> page = getNewPage();
+        ExecutionProfiler::record("page pin", ExecutionProfiler::now() - begin, 0, 0, page.second);
+        return std::make_shared<MemoryHolder>(page);
+    }
+
 public:
 
     int id;
@@ -166,7 +175,10 @@ public:
                     std::cout << id << ": This is Strange... how did I find a page with objects??\n";
                 }
                 std::cout << id << ": to discard a page in iteration=" << iteration << " and page iteration =" << unwrittenPages.front()->iteration << std::endl;
+                long begin = ExecutionProfiler::now();
                 discardPage(unwrittenPages.front()->location);
+                ExecutionProfiler::record("page discard", ExecutionProfiler::now() - begin, 0, 0,
+                                          unwrittenPages.front()->getSize());
                 unwrittenPages.pop();
 
                 // in this case, the page DID have some data written to it
@@ -182,7 +194,10 @@ public:
                     makeObjectAllocatorBlock(1024, true);
                 // make sure he is written
                 std::cout << id << ": to write back a page in iteration=" << iteration << " and page iteration =" << unwrittenPages.front()->iteration << " and page location =" << unwrittenPages.front()->location << std::endl;
+                long begin = ExecutionProfiler::now();
                 writeBackPage(unwrittenPages.front()->location);
+                ExecutionProfiler::record("page unpin", ExecutionProfiler::now() - begin, 0, 0,
+                                          unwrittenPages.front()->getSize());
                 
                 // and get ridda him
                 unwrittenPages.pop();
@@ -195,7 +210,7 @@ public:
 
         // this is where we are outputting all of our results to
         std::cout << id << ": to get a new output page" << std::endl;
-        MemoryHolderPtr myRAM = std::make_shared<MemoryHolder>(getNewPage());
+        MemoryHolderPtr myRAM = getNewOutputPage();
         std::cout << id << ": got a new page" << std::endl;
 
         if (myRAM->location == nullptr) {
@@ -210,12 +225,22 @@ public:
         // the iteration counter
         int iteration = 0;
 
+        // the names of the executors in the profile
+        std::vector<const char*> executorNames;
+        for (int i = 0; i < pipeline.size(); i++) {
+            executorNames.push_back(ExecutionProfiler::intern(std::string("pipeline executor ") +
+                                                              std::to_string(i) + ": " +
+                                                              pipeline[i]->getType()));
+        }
+        long begin;
+
         // while there is still data
         // Jia Note: dataSource->getNextTupleSet() can throw exception for certain data sources like
         // MapTupleSetIterator
         while (true) {
 
            try {
+               begin = ExecutionProfiler::now();
                curChunk = dataSource->getNextTupleSet();
            } catch (NotEnoughSpace& n) {
                curChunk = nullptr;
@@ -225,13 +250,14 @@ public:
                iteration++;
                cleanPages(iteration);
                std::cout << id <<": to get a new output page" << std::endl;
-               myRAM = std::make_shared<MemoryHolder>(getNewPage());
+               myRAM = getNewOutputPage();
                std::cout << id <<": got a new output page" << std::endl;
                if (myRAM->location == nullptr) {
                    std::cout << id << ": ERROR: insufficient memory in heap" << std::endl;
                    return;
                }
                myRAM->outputSink = dataSink->createNewOutputContainer();
+               begin = ExecutionProfiler::now();
                curChunk = dataSource->getNextTupleSet();
            }
 
@@ -239,13 +265,18 @@ public:
                std::cout << id << ": WARNING: get an empty chunk in pipeline" << std::endl;
                break;
            }
+           ExecutionProfiler::record(
+               "pipeline source", ExecutionProfiler::now() - begin, 0, curChunk->getNumRows());
            
            //if (id==1)
                //std::cout << id << ": got a chunk to feed to pipeline" << std::endl;
             // go through all of the pipeline stages
+           int whichExecutor = 0;
            for (ComputeExecutorPtr& q : pipeline) {
 
+                int rowsIn = curChunk->getNumRows();
                 try {
+                    begin = ExecutionProfiler::now();
                     curChunk = q->process(curChunk);
                 //if (id==1)
                     //std::cout << id << ": processed a chunk" << std::endl;
@@ -258,7 +289,7 @@ public:
                     iteration++;
                     cleanPages(iteration);
                     std::cout << id <<": to get a new output page" << std::endl;
-                    myRAM = std::make_shared<MemoryHolder>(getNewPage());
+                    myRAM = getNewOutputPage();
                     if (myRAM->location == nullptr) {
                         std::cout << "ERROR: insufficient memory in heap or the corresponding partition sink is used up" << std::endl;
                         return;
@@ -268,6 +299,7 @@ public:
 
                     // then try again
                     try {
+                        begin = ExecutionProfiler::now();
                         curChunk = q->process(curChunk);
                     } catch (NotEnoughSpace& n) {
                         std::cout << id << ": curChunk contains " << curChunk->getNumRows(0) << " rows" 
@@ -278,6 +310,11 @@ public:
                         exit(1);
                     }
                 }
+                ExecutionProfiler::record(executorNames[whichExecutor],
+                                          ExecutionProfiler::now() - begin,
+                                          rowsIn,
+                                          curChunk->getNumRows());
+                whichExecutor++;
            }
 
            bool end = false;
@@ -287,7 +324,10 @@ public:
                    if (myRAM->outputSink == nullptr) {
                        myRAM->outputSink = dataSink->createNewOutputContainer();
                    }
+                   begin = ExecutionProfiler::now();
                    dataSink->writeOut(curChunk, myRAM->outputSink);
+                   ExecutionProfiler::record(
+                       "pipeline sink", ExecutionProfiler::now() - begin, curChunk->getNumRows());
                    //if (id==1)
                         //std::cout << id << ": write out a chunk" << std::endl;
                    end = true;                    
@@ -302,7 +342,7 @@ public:
                     iteration++;
                     cleanPages(iteration);
                     std::cout << id <<": to get a new output page" << std::endl;
-                    myRAM = std::make_shared<MemoryHolder>(getNewPage());
+                    myRAM = getNewOutputPage();
                     if (myRAM->location == nullptr) {
                         std::cout << "ERROR: insufficient memory in heap or the corresponding partition sink is used up" << std::endl;
                         return;
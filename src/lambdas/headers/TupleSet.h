@@ -286,6 +286,14 @@ public:
     }
 
 
+    // to get number of rows, which is the same for all columns; returns 0 if there is no column
+    int getNumRows() {
+        if (columns.size() == 0) {
+            return 0;
+        }
+        return columns.begin()->second.second.getCount(columns.begin()->second.first);
+    }
+
     // copies a column from another TupleSet, deleting the target, if necessary
     void copyColumn(TupleSetPtr fromMe, int whichColInFromMe, int whichColToCopyTo) {
 
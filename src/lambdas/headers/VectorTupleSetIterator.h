@@ -30,6 +30,17 @@ private:
     // and the tuple set we return
     TupleSetPtr output;
 
+    // the page holding the current vector is not in any allocation block and stays put until
+    // we call doneWithVector, so copying its handles into tuple sets (and destroying those
+    // copies) can skip reference counting altogether
+    void borrowCurrentRecord() {
+        if (myRec == nullptr) {
+            getAllocator().returnBorrowedRegion();
+        } else {
+            getAllocator().borrowRegion(myRec, myRec->numBytes());
+        }
+    }
+
 public:
     // the first param is a callback function that the iterator will call in order to obtain the
     // page holding the next vector to iterate
@@ -46,6 +57,7 @@ public:
 
         // extract the vector from the input page
         myRec = (Record<Vector<Handle<Object>>>*)getAnotherVector();
+        borrowCurrentRecord();
 
         if (myRec != nullptr) {
 
@@ -113,6 +125,7 @@ public:
             }
             lastRec = myRec;
             myRec = (Record<Vector<Handle<Object>>>*)getAnotherVector();
+            borrowCurrentRecord();
             //std::cout << "fetched another vector" << std::endl;
             if (myRec == nullptr){
                 return nullptr;
@@ -130,6 +143,7 @@ public:
 
             // try to get another vector
             myRec = (Record<Vector<Handle<Object>>>*)getAnotherVector();
+            borrowCurrentRecord();
             //std::cout << "fetched another vector" << std::endl;
 
             // if we could not, then we are outta here
@@ -149,6 +163,7 @@ public:
                 }
                 lastRec = myRec;
                 myRec = (Record<Vector<Handle<Object>>>*)getAnotherVector();
+                borrowCurrentRecord();
                 //std::cout << "fetched another vector" << std::endl;
                 if (myRec == nullptr){
                     return nullptr;
@@ -191,6 +206,7 @@ public:
         }
 
         lastRec = nullptr;
+        getAllocator().returnBorrowedRegion();
     }
 };
 }
@@ -6,6 +6,7 @@
 #include "LAASTNode.h"
 #include "LAExpressionNode.h"
 #include "LAPostfixExpressionNode.h"
+#include <vector>
 
 
 struct LAMultiplicativeExpressionNode;
@@ -23,6 +24,11 @@ private:
     pdb::Handle<pdb::Computation> query2;
     LADimension dim;
 
+    // flattens a chain of "multiply" nodes into its operands, left to right
+    void collectMultiplyChain(LAPDBInstance& instance,
+                              std::vector<pdb::Handle<pdb::Computation>>& operands,
+                              std::vector<LADimension>& dims);
+
 public:
     LAMultiplicativeExpressionNode(const char* op)
         : LAExpressionNode(LA_ASTNODE_TYPE_MULTIPLICATIVEEXPRESSION) {
@@ -9,6 +9,7 @@
 #include <fcntl.h>
 #include <set>
 #include <map>
+#include <vector>
 
 #include "PDBDebug.h"
 #include "PDBString.h"
@@ -19,10 +20,21 @@
 #include "DispatcherClient.h"
 #include "Set.h"
 #include "DataTypes.h"
+#include "Configuration.h"
 #include "LADimension.h"
 
 // by Binhang, June 2017
 
+// an identifier bound to a computation that is not materialized yet, used when a whole
+// program is compiled into one job
+struct LAPendingBinding {
+    std::string identifier;
+    pdb::Handle<pdb::Computation> query;
+    LADimension dim;
+    // whether a later statement reads this binding directly from the computation
+    bool consumed = false;
+};
+
 class LAPDBInstance {
 
 private:
@@ -46,6 +58,20 @@ private:
     std::map<std::string, std::string> identifierPDBSetNameMap;
     std::map<std::string, LADimension> identifierDimensionMap;
 
+    // whether statements are bound into one program-wide query graph instead of being executed
+    bool fusing = false;
+    std::vector<LAPendingBinding> pendingBindings;
+    std::map<std::string, int> pendingBindingIndex;
+
+    // bookkeeping for the algebraic rewrites: computations that are the transpose of,
+    // or the product of, other computations
+    std::map<pdb::Computation*, pdb::Handle<pdb::Computation>> transposeInputs;
+    std::map<pdb::Computation*, std::pair<pdb::Handle<pdb::Computation>, pdb::Handle<pdb::Computation>>>
+        multiplyInputs;
+
+    // computations that a rewrite replaced, and that no longer consume their inputs
+    std::set<pdb::Computation*> droppedComputations;
+
 public:
     LAPDBInstance(bool printResultIn,
                   bool clusterModeIn,
@@ -183,6 +209,118 @@ public:
         return identifierDimensionMap[identiferName];
     }
 
+    // the page size for a set holding blocks of the given dimension, so that a page holds a
+    // handful of blocks instead of always pinning 64MB for tiny results like row/col aggregates
+    size_t getPageSizeForDimension(LADimension dim) {
+        size_t blockBytes =
+            (size_t)dim.blockRowSize * (size_t)dim.blockColSize * sizeof(double) + 1024;
+        size_t pageSize = 1024 * 1024;
+        while (pageSize < 4 * blockBytes && pageSize < DEFAULT_PAGE_SIZE) {
+            pageSize *= 2;
+        }
+        return pageSize;
+    }
+
+    void setFusing(bool fusingIn) {
+        fusing = fusingIn;
+    }
+
+    bool isFusing() {
+        return fusing;
+    }
+
+    void addPendingBinding(std::string identiferName,
+                           pdb::Handle<pdb::Computation> query,
+                           LADimension dim) {
+        LAPendingBinding binding;
+        binding.identifier = identiferName;
+        binding.query = query;
+        binding.dim = dim;
+        pendingBindingIndex[identiferName] = pendingBindings.size();
+        pendingBindings.push_back(binding);
+    }
+
+    bool existsPendingBinding(std::string identiferName) {
+        return fusing && pendingBindingIndex.find(identiferName) != pendingBindingIndex.end();
+    }
+
+    // returns the computation currently bound to the identifier, and marks it as an
+    // intermediate that does not need to be written out
+    pdb::Handle<pdb::Computation> consumePendingBinding(std::string identiferName) {
+        LAPendingBinding& binding = pendingBindings[pendingBindingIndex[identiferName]];
+        binding.consumed = true;
+        return binding.query;
+    }
+
+    // whether this binding is the last assignment to its identifier
+    bool isLatestPendingBinding(int index) {
+        return pendingBindingIndex[pendingBindings[index].identifier] == index;
+    }
+
+    std::vector<LAPendingBinding>& getPendingBindings() {
+        return pendingBindings;
+    }
+
+    void clearPendingBindings() {
+        pendingBindings.clear();
+        pendingBindingIndex.clear();
+        transposeInputs.clear();
+        multiplyInputs.clear();
+        droppedComputations.clear();
+    }
+
+    void recordTranspose(pdb::Handle<pdb::Computation> result,
+                         pdb::Handle<pdb::Computation> input) {
+        transposeInputs[&(*result)] = input;
+    }
+
+    bool isTranspose(pdb::Handle<pdb::Computation> query) {
+        return transposeInputs.find(&(*query)) != transposeInputs.end();
+    }
+
+    pdb::Handle<pdb::Computation> getTransposeInput(pdb::Handle<pdb::Computation> query) {
+        return transposeInputs[&(*query)];
+    }
+
+    void recordMultiply(pdb::Handle<pdb::Computation> result,
+                        pdb::Handle<pdb::Computation> left,
+                        pdb::Handle<pdb::Computation> right) {
+        multiplyInputs[&(*result)] = std::make_pair(left, right);
+    }
+
+    bool isMultiply(pdb::Handle<pdb::Computation> query) {
+        return multiplyInputs.find(&(*query)) != multiplyInputs.end();
+    }
+
+    std::pair<pdb::Handle<pdb::Computation>, pdb::Handle<pdb::Computation>> getMultiplyInputs(
+        pdb::Handle<pdb::Computation> query) {
+        return multiplyInputs[&(*query)];
+    }
+
+    // drops a computation that a rewrite replaced from the query graph: setInput counted it as
+    // a consumer of each of its inputs, so it gives those counts back. A computation that is
+    // bound to an identifier, or that is consumed by another computation, is kept
+    void dropComputation(pdb::Handle<pdb::Computation> query) {
+        if (query->getNumConsumers() > 0 || droppedComputations.count(&(*query)) > 0) {
+            return;
+        }
+        for (auto& binding : pendingBindings) {
+            if (&(*binding.query) == &(*query)) {
+                return;
+            }
+        }
+        droppedComputations.insert(&(*query));
+        if (!query->hasInput()) {
+            return;
+        }
+        for (int i = 0; i < query->getNumInputs(); i++) {
+            pdb::Handle<pdb::Computation> input = query->getIthInput(i);
+            if (input != nullptr) {
+                input->setNumConsumers(input->getNumConsumers() - 1);
+            }
+        }
+    }
+
     void clearCachedSets() {
         std::cout << "Clear all the set in LA_db." << std::endl;
         for (auto const& setName : cachedSet) {
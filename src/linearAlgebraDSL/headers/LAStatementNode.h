@@ -48,7 +48,19 @@ public:
         expression = e;
     }
 
+    std::string getIdentifierName() {
+        return identifier->toString();
+    }
+
+    bool isPrintQueryResult() {
+        return printQueryResult;
+    }
+
     void evaluateQuery(LAPDBInstance& instance);
+
+    // binds the statement into the program-wide query graph held by the instance, without
+    // submitting a job; see LAStatementsList::evaluateProgram
+    void bindQuery(LAPDBInstance& instance);
 };
 
 #endif
\ No newline at end of file
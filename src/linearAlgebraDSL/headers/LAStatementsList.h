@@ -24,6 +24,10 @@ public:
     LAStatementNodePtr get(int i) {
         return statements[i];
     }
+
+    // compiles all the statements into one query graph and runs it as a single job,
+    // only writing out the identifiers that are not consumed by later statements
+    void evaluateProgram(LAPDBInstance& instance);
 };
 
 #endif
\ No newline at end of file
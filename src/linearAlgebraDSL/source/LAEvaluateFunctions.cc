@@ -8,6 +8,7 @@
 #include "LAMultiplicativeExpressionNode.h"
 #include "LAAdditiveExpressionNode.h"
 #include "LAStatementNode.h"
+#include "LAStatementsList.h"
 
 #include "LASillyDuplicateColMultiSelection.h"
 #include "LASillyDuplicateRowMultiSelection.h"
@@ -44,10 +45,191 @@
 #include "LambdaIdentifier.h"
 
 #include <fstream>
+#include <functional>
+#include <limits>
 
 // by Binhang, June 2017
 
 
+// builds the transpose of a computation, applying the rewrites:
+//   (A^T)^T     => A
+//   (A %*% B)^T => B^T %*% A^T, when either side is a transpose that then cancels out
+static pdb::Handle<pdb::Computation> makeLATranspose(LAPDBInstance& instance,
+                                                     pdb::Handle<pdb::Computation> input);
+
+// builds the product of two computations, fusing a transposed left operand into the join:
+//   A^T %*% B => A '* B
+static pdb::Handle<pdb::Computation> makeLAMultiply(LAPDBInstance& instance,
+                                                    pdb::Handle<pdb::Computation> left,
+                                                    pdb::Handle<pdb::Computation> right) {
+    pdb::Handle<pdb::Computation> join;
+    if (instance.isTranspose(left)) {
+        join = makeObject<LASillyTransposeMultiply1Join>();
+        join->setInput(0, instance.getTransposeInput(left));
+        instance.dropComputation(left);
+    } else {
+        join = makeObject<LASillyMultiply1Join>();
+        join->setInput(0, left);
+    }
+    join->setInput(1, right);
+    pdb::Handle<pdb::Computation> aggregate = makeObject<LASillyMultiply2Aggregate>();
+    aggregate->setInput(join);
+    instance.recordMultiply(aggregate, left, right);
+    return aggregate;
+}
+
+static pdb::Handle<pdb::Computation> makeLATranspose(LAPDBInstance& instance,
+                                                     pdb::Handle<pdb::Computation> input) {
+    if (instance.isTranspose(input)) {
+        std::cout << "LA rewrite: eliminated double transpose" << std::endl;
+        instance.dropComputation(input);
+        return instance.getTransposeInput(input);
+    }
+    if (instance.isMultiply(input)) {
+        auto operands = instance.getMultiplyInputs(input);
+        if (instance.isTranspose(operands.first) || instance.isTranspose(operands.second)) {
+            std::cout << "LA rewrite: pushed transpose below multiply" << std::endl;
+            // the aggregate and its join are replaced by the new product
+            pdb::Handle<pdb::Computation> join = input->getIthInput(0);
+            instance.dropComputation(input);
+            instance.dropComputation(join);
+            return makeLAMultiply(instance,
+                                  makeLATranspose(instance, operands.second),
+                                  makeLATranspose(instance, operands.first));
+        }
+    }
+    pdb::Handle<pdb::Computation> transpose = makeObject<LASillyTransposeSelection>();
+    transpose->setInput(input);
+    instance.recordTranspose(transpose, input);
+    return transpose;
+}
+
+
+// orders the multiplications of a chain of matrices with the classic dynamic program over
+// the number of scalar multiplications, and builds the corresponding computations
+static pdb::Handle<pdb::Computation> makeLAMultiplyChain(
+    LAPDBInstance& instance,
+    std::vector<pdb::Handle<pdb::Computation>>& operands,
+    std::vector<LADimension>& dims) {
+    int n = operands.size();
+    std::vector<std::vector<double>> cost(n, std::vector<double>(n, 0.0));
+    std::vector<std::vector<int>> split(n, std::vector<int>(n, 0));
+    for (int len = 2; len <= n; len++) {
+        for (int i = 0; i + len - 1 < n; i++) {
+            int j = i + len - 1;
+            cost[i][j] = std::numeric_limits<double>::max();
+            for (int k = i; k < j; k++) {
+                double rows = (double)dims[i].blockRowSize * dims[i].blockRowNum;
+                double inner = (double)dims[k].blockColSize * dims[k].blockColNum;
+                double cols = (double)dims[j].blockColSize * dims[j].blockColNum;
+                double curCost = cost[i][k] + cost[k + 1][j] + rows * inner * cols;
+                if (curCost < cost[i][j]) {
+                    cost[i][j] = curCost;
+                    split[i][j] = k;
+                }
+            }
+        }
+    }
+    std::function<pdb::Handle<pdb::Computation>(int, int)> build =
+        [&](int i, int j) -> pdb::Handle<pdb::Computation> {
+        if (i == j) {
+            return operands[i];
+        }
+        return makeLAMultiply(instance, build(i, split[i][j]), build(split[i][j] + 1, j));
+    };
+    std::cout << "LA rewrite: multiply chain of " << n << " matrices costs " << cost[0][n - 1]
+              << " scalar multiplications" << std::endl;
+    return build(0, n - 1);
+}
+
+
+// creates the output set for a statement result and the computation writing to it
+static pdb::Handle<pdb::Computation> makeLAWriteSet(LAPDBInstance& instance,
+                                                    pdb::Handle<pdb::Computation> statementQuery,
+                                                    std::string outputSetName,
+                                                    LADimension dim) {
+    Handle<Computation> writeSet;
+    size_t pageSize = instance.getPageSizeForDimension(dim);
+    if (statementQuery->getOutputType().compare("MatrixBlock") == 0) {
+        if (!instance.getStorageClient().createSet<MatrixBlock>(
+                "LA_db", outputSetName, instance.instanceErrMsg(), pageSize)) {
+            std::cout << "Not able to create set: " + instance.instanceErrMsg() << std::endl;
+            exit(-1);
+        }
+        writeSet = makeObject<LAWriteMatrixBlockSet>("LA_db", outputSetName);
+    } else if (statementQuery->getOutputType().compare("LAMaxElementOutputType") == 0) {
+        if (!instance.getStorageClient().createSet<LAMaxElementOutputType>(
+                "LA_db", outputSetName, instance.instanceErrMsg(), pageSize)) {
+            std::cout << "Not able to create set: " + instance.instanceErrMsg() << std::endl;
+            exit(-1);
+        }
+        writeSet = makeObject<LAWriteMaxElementSet>("LA_db", outputSetName);
+    } else if (statementQuery->getOutputType().compare("LAMinElementOutputType") == 0) {
+        if (!instance.getStorageClient().createSet<LAMinElementOutputType>(
+                "LA_db", outputSetName, instance.instanceErrMsg(), pageSize)) {
+            std::cout << "Not able to create set: " + instance.instanceErrMsg() << std::endl;
+            exit(-1);
+        }
+        writeSet = makeObject<LAWriteMinElementSet>("LA_db", outputSetName);
+    } else {
+        std::cerr << "Invalid query output type!" << std::endl;
+        exit(1);
+    }
+    writeSet->setInput(statementQuery);
+    return writeSet;
+}
+
+
+// prints the content of a statement's output set
+static void printLAResultSet(LAPDBInstance& instance,
+                             std::string outputType,
+                             std::string outputSetName) {
+    std::cout << "To print result..." << std::endl;
+    if (outputType.compare("MatrixBlock") == 0) {
+        SetIterator<MatrixBlock> output =
+            instance.getQueryClient().getSetIterator<MatrixBlock>("LA_db", outputSetName);
+        std::cout << "Output Matrix:" << std::endl;
+        int count = 0;
+        for (auto a : output) {
+            std::cout << count << ":";
+            a->printMeta();
+            std::cout << std::endl;
+            count++;
+        }
+        std::cout << "Matrix output block nums:" << count << "\n";
+    } else if (outputType.compare("LAMaxElementOutputType") == 0) {
+        SetIterator<LAMaxElementOutputType> result =
+            instance.getQueryClient().getSetIterator<LAMaxElementOutputType>("LA_db",
+                                                                             outputSetName);
+        std::cout << "Max Element query results: " << std::endl;
+        int countOut = 0;
+        for (auto a : result) {
+            std::cout << countOut << ":";
+            a->print();
+            std::cout << std::endl;
+            countOut++;
+        }
+        std::cout << "Max Element output count:" << countOut << "\n";
+    } else if (outputType.compare("LAMinElementOutputType") == 0) {
+        SetIterator<LAMinElementOutputType> result =
+            instance.getQueryClient().getSetIterator<LAMinElementOutputType>("LA_db",
+                                                                             outputSetName);
+        std::cout << "Min Element query results: " << std::endl;
+        int countOut = 0;
+        for (auto a : result) {
+            std::cout << countOut << ":";
+            a->print();
+            std::cout << std::endl;
+            countOut++;
+        }
+        std::cout << "Min Element output count:" << countOut << "\n";
+    } else {
+        std::cerr << "Invalid query output type!" << std::endl;
+        exit(1);
+    }
+}
+
+
 pdb::Handle<pdb::Computation>& LAInitializerNode::evaluate(LAPDBInstance& instance) {
     int totalBlocks = dim.blockRowNum * dim.blockColNum;
     int index = instance.getDispatchCount();
@@ -223,6 +405,15 @@ pdb::Handle<pdb::Computation>& LAInitializerNode::evaluate(LAPDBInstance& instan
 
 
 pdb::Handle<pdb::Computation>& LAIdentifierNode::evaluate(LAPDBInstance& instance) {
+    if (instance.existsPendingBinding(name)) {
+        // the identifier is computed earlier in the same program, so read it directly from
+        // that computation instead of scanning a materialized set
+        scanSet = instance.consumePendingBinding(name);
+        setDimension(instance.findDimension(name));
+        std::cout << "LAIdentifierNode:: " << name << " pipelined from an earlier statement"
+                  << std::endl;
+        return scanSet;
+    }
     scanSet =
         pdb::makeObject<LAScanMatrixBlockSet>("LA_db", instance.getPDBSetNameForIdentifier(name));
     if (scanSet.isNullPtr()) {
@@ -323,8 +514,7 @@ pdb::Handle<pdb::Computation>& LAPostfixExpressionNode::evaluate(LAPDBInstance&
         query = child->evaluate(instance);
         setDimension(child->getDimension());
     } else if (postOperator.compare("transpose") == 0) {
-        query = makeObject<LASillyTransposeSelection>();
-        query->setInput(child->evaluate(instance));
+        query = makeLATranspose(instance, child->evaluate(instance));
         setDimension(child->getDimension().transpose());
     } else if (postOperator.compare("inverse") == 0) {
         pdb::Handle<pdb::Computation> queryAgg1 = makeObject<LASillyInverse1Aggregate>();
@@ -369,21 +559,21 @@ pdb::Handle<pdb::Computation>& LAMultiplicativeExpressionNode::evaluate(LAPDBIns
         }
         setDimension(dimLeft);
     } else if (multiOperator.compare("multiply") == 0) {
-        query1 = makeObject<LASillyMultiply1Join>();
-        query1->setInput(0, leftChild->evaluate(instance));
-        query1->setInput(1, rightChild->evaluate(instance));
-        LADimension dimLeft = leftChild->getDimension();
-        LADimension dimRight = rightChild->getDimension();
-        if (dimLeft.blockColSize != dimRight.blockRowSize ||
-            dimLeft.blockColNum != dimRight.blockRowNum) {
-            std::cerr << "Multiply operator dimension not match: " << leftChild->toString() << ","
-                      << rightChild->toString() << std::endl;
-            exit(1);
+        std::vector<pdb::Handle<pdb::Computation>> operands;
+        std::vector<LADimension> dims;
+        collectMultiplyChain(instance, operands, dims);
+        for (int i = 0; i + 1 < dims.size(); i++) {
+            if (dims[i].blockColSize != dims[i + 1].blockRowSize ||
+                dims[i].blockColNum != dims[i + 1].blockRowNum) {
+                std::cerr << "Multiply operator dimension not match: " << toString() << std::endl;
+                exit(1);
+            }
         }
-        query2 = makeObject<LASillyMultiply2Aggregate>();
-        query2->setInput(query1);
-        LADimension dimNew(
-            dimLeft.blockRowSize, dimRight.blockColSize, dimLeft.blockRowNum, dimRight.blockColNum);
+        query2 = makeLAMultiplyChain(instance, operands, dims);
+        LADimension dimNew(dims.front().blockRowSize,
+                           dims.back().blockColSize,
+                           dims.front().blockRowNum,
+                           dims.back().blockColNum);
         setDimension(dimNew);
     } else if (multiOperator.compare("transpose_multiply") == 0) {
         query1 = makeObject<LASillyTransposeMultiply1Join>();
@@ -412,6 +602,21 @@ pdb::Handle<pdb::Computation>& LAMultiplicativeExpressionNode::evaluate(LAPDBIns
 }
 
 
+void LAMultiplicativeExpressionNode::collectMultiplyChain(
+    LAPDBInstance& instance,
+    std::vector<pdb::Handle<pdb::Computation>>& operands,
+    std::vector<LADimension>& dims) {
+    if (multiOperator.compare("multiply") == 0) {
+        leftChild->collectMultiplyChain(instance, operands, dims);
+        operands.push_back(rightChild->evaluate(instance));
+        dims.push_back(rightChild->getDimension());
+    } else {
+        operands.push_back(evaluate(instance));
+        dims.push_back(getDimension());
+    }
+}
+
+
 pdb::Handle<pdb::Computation>& LAAdditiveExpressionNode::evaluate(LAPDBInstance& instance) {
     if (addOperator.compare("none") == 0) {
         query = rightChild->evaluate(instance);
@@ -462,39 +667,14 @@ void LAStatementNode::evaluateQuery(LAPDBInstance& instance) {
     } else {
         pdb::Handle<pdb::Computation> statementQuery = expression->evaluate(instance);
         std::cout << "Query output type: " << statementQuery->getOutputType() << std::endl;
-        Handle<Computation> writeSet;
         std::string outputSetName = "LA_computation_result_" + identifier->toString();
         if (instance.existsPDBSet(outputSetName)) {  // Right now do not support rename a
                                                      // identifier!
             std::cerr << "This is bad, PDB Set name <" << outputSetName << "> exists!" << std::endl;
             exit(1);
         }
-        if (statementQuery->getOutputType().compare("MatrixBlock") == 0) {
-            if (!instance.getStorageClient().createSet<MatrixBlock>(
-                    "LA_db", outputSetName, instance.instanceErrMsg(), size_t(64)*size_t(1024)*size_t(1024))) {
-                std::cout << "Not able to create set: " + instance.instanceErrMsg() << std::endl;
-                exit(-1);
-            }
-            writeSet = makeObject<LAWriteMatrixBlockSet>("LA_db", outputSetName);
-        } else if (statementQuery->getOutputType().compare("LAMaxElementOutputType") == 0) {
-            if (!instance.getStorageClient().createSet<LAMaxElementOutputType>(
-                    "LA_db", outputSetName, instance.instanceErrMsg(), size_t(64)*size_t(1024)*size_t(1024))) {
-                std::cout << "Not able to create set: " + instance.instanceErrMsg() << std::endl;
-                exit(-1);
-            }
-            writeSet = makeObject<LAWriteMaxElementSet>("LA_db", outputSetName);
-        } else if (statementQuery->getOutputType().compare("LAMinElementOutputType") == 0) {
-            if (!instance.getStorageClient().createSet<LAMinElementOutputType>(
-                    "LA_db", outputSetName, instance.instanceErrMsg(), size_t(64)*size_t(1024)*size_t(1024))) {
-                std::cout << "Not able to create set: " + instance.instanceErrMsg() << std::endl;
-                exit(-1);
-            }
-            writeSet = makeObject<LAWriteMinElementSet>("LA_db", outputSetName);
-        } else {
-            std::cerr << "Invalid query output type!" << std::endl;
-            exit(1);
-        }
-        writeSet->setInput(statementQuery);
+        Handle<Computation> writeSet =
+            makeLAWriteSet(instance, statementQuery, outputSetName, expression->getDimension());
         auto begin = std::chrono::high_resolution_clock::now();
         std::cout << "job name is " << instance.getJobName() << std::endl;
         if (!instance.getQueryClient().executeComputations(instance.instanceErrMsg(), instance.getJobName()+std::to_string(instance.getDispatchCount()), writeSet)) {
@@ -503,6 +683,7 @@ void LAStatementNode::evaluateQuery(LAPDBInstance& instance) {
             ;
         }
         instance.increaseDispatchCount();
+        instance.clearPendingBindings();
         std::cout << std::endl;
         auto end = std::chrono::high_resolution_clock::now();
 
@@ -511,49 +692,7 @@ void LAStatementNode::evaluateQuery(LAPDBInstance& instance) {
         instance.addToIdentifierDimensionMap(identifier->toString(), expression->getDimension());
 
         if (printQueryResult) {
-            std::cout << "To print result..." << std::endl;
-            if (statementQuery->getOutputType().compare("MatrixBlock") == 0) {
-                SetIterator<MatrixBlock> output =
-                    instance.getQueryClient().getSetIterator<MatrixBlock>("LA_db", outputSetName);
-                std::cout << "Output Matrix:" << std::endl;
-                int count = 0;
-                for (auto a : output) {
-                    std::cout << count << ":";
-                    a->printMeta();
-                    std::cout << std::endl;
-                    count++;
-                }
-                std::cout << "Matrix output block nums:" << count << "\n";
-            } else if (statementQuery->getOutputType().compare("LAMaxElementOutputType") == 0) {
-                SetIterator<LAMaxElementOutputType> result =
-                    instance.getQueryClient().getSetIterator<LAMaxElementOutputType>("LA_db",
-                                                                                     outputSetName);
-                std::cout << "Max Element query results: " << std::endl;
-                int countOut = 0;
-                for (auto a : result) {
-                    std::cout << countOut << ":";
-                    a->print();
-                    std::cout << std::endl;
-                    countOut++;
-                }
-                std::cout << "Max Element output count:" << countOut << "\n";
-            } else if (statementQuery->getOutputType().compare("LAMinElementOutputType") == 0) {
-                SetIterator<LAMinElementOutputType> result =
-                    instance.getQueryClient().getSetIterator<LAMinElementOutputType>("LA_db",
-                                                                                     outputSetName);
-                std::cout << "Min Element query results: " << std::endl;
-                int countOut = 0;
-                for (auto a : result) {
-                    std::cout << countOut << ":";
-                    a->print();
-                    std::cout << std::endl;
-                    countOut++;
-                }
-                std::cout << "Min Element output count:" << countOut << "\n";
-            } else {
-                std::cerr << "Invalid query output type!" << std::endl;
-                exit(1);
-            }
+            printLAResultSet(instance, statementQuery->getOutputType(), outputSetName);
             std::cout
                 << "Time Duration: "
                 << std::chrono::duration_cast<std::chrono::duration<float>>(end - begin).count()
@@ -561,4 +700,78 @@ void LAStatementNode::evaluateQuery(LAPDBInstance& instance) {
         }
     }
 }
+
+
+void LAStatementNode::bindQuery(LAPDBInstance& instance) {
+    if (expression->isSyntaxSugarInitializer()) {
+        // initializers load their data right away, the same as in evaluateQuery
+        evaluateQuery(instance);
+    } else {
+        pdb::Handle<pdb::Computation> statementQuery = expression->evaluate(instance);
+        std::cout << "Bound " << identifier->toString()
+                  << " with output type: " << statementQuery->getOutputType() << std::endl;
+        instance.addPendingBinding(
+            identifier->toString(), statementQuery, expression->getDimension());
+        instance.addToIdentifierDimensionMap(identifier->toString(), expression->getDimension());
+    }
+}
+
+
+void LAStatementsList::evaluateProgram(LAPDBInstance& instance) {
+    // all the statements share one block for their query objects, as they go out in one job
+    const UseTemporaryAllocationBlock tempBlock{32 * 1024 * 1024};
+    instance.setFusing(true);
+    std::map<std::string, bool> printQueryResult;
+    for (int i = 0; i < statements.size(); i++) {
+        std::cout << "Current statement:" << statements[i]->toString() << std::endl;
+        statements[i]->bindQuery(instance);
+        printQueryResult[statements[i]->getIdentifierName()] = statements[i]->isPrintQueryResult();
+    }
+
+    // only the bindings no later statement reads are written out
+    std::vector<LAPendingBinding>& bindings = instance.getPendingBindings();
+    std::vector<Handle<Computation>> sinks;
+    std::vector<int> outputs;
+    for (int i = 0; i < bindings.size(); i++) {
+        if (bindings[i].consumed || !instance.isLatestPendingBinding(i)) {
+            continue;
+        }
+        std::string outputSetName = "LA_computation_result_" + bindings[i].identifier;
+        if (instance.existsPDBSet(outputSetName)) {
+            std::cerr << "This is bad, PDB Set name <" << outputSetName << "> exists!" << std::endl;
+            exit(1);
+        }
+        sinks.push_back(makeLAWriteSet(instance, bindings[i].query, outputSetName, bindings[i].dim));
+        outputs.push_back(i);
+    }
+
+    if (!sinks.empty()) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        std::cout << "job name is " << instance.getJobName() << std::endl;
+        if (!instance.getQueryClient().executeComputations(
+                instance.instanceErrMsg(),
+                instance.getJobName() + std::to_string(instance.getDispatchCount()),
+                sinks)) {
+            std::cout << "Query failed. Message was: " << instance.instanceErrMsg() << "\n";
+            exit(1);
+        }
+        instance.increaseDispatchCount();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "Executed " << statements.size() << " statements as one job with "
+                  << sinks.size() << " outputs in "
+                  << std::chrono::duration_cast<std::chrono::duration<float>>(end - begin).count()
+                  << " secs." << std::endl;
+    }
+
+    for (int i : outputs) {
+        std::string outputSetName = "LA_computation_result_" + bindings[i].identifier;
+        instance.addToCachedSet(outputSetName);
+        instance.addToIdentifierPDBSetNameMap(bindings[i].identifier, outputSetName);
+        if (printQueryResult[bindings[i].identifier]) {
+            printLAResultSet(instance, bindings[i].query->getOutputType(), outputSetName);
+        }
+    }
+    instance.clearPendingBindings();
+    instance.setFusing(false);
+}
 #endif
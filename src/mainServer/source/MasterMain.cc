@@ -65,6 +65,7 @@ int main(int argc, char* argv[]) {
     pdb::PDBServer frontEnd(port, 100, myLogger);
 
     ConfigurationPtr conf = make_shared<Configuration>();
+    conf->loadSettings();
 
     frontEnd.addFunctionality<pdb::CatalogServer>("CatalogDir", true, masterIp, port, masterIp, port);
     frontEnd.addFunctionality<pdb::CatalogClient>(port, "localhost", myLogger);
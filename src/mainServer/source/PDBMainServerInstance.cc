@@ -49,63 +49,6 @@
 
 using namespace std;
 
-map<string, string> readConfigFile(const char* m_configFile) {
-    map<string, string> keyValues;
-
-    std::ifstream infile(m_configFile);
-
-    std::string line;
-    while (std::getline(infile, line)) {
-        // check if the first charachter of the line is a comment starting with #
-        char found = line.find_first_not_of(" \t");
-        if (found != string::npos) {
-            if (line[found] == '#')
-                continue;
-            else {
-                std::istringstream is_line(line);
-                std::string key;
-                // looking for = in the line and getting the keys and values
-                if (std::getline(is_line, key, '=')) {
-                    std::string value;
-                    // this line removes the space at the end of the string if there are any sppaces
-                    key.erase(std::remove_if(key.begin(), key.end(), ::isspace), key.end());
-                    if (std::getline(is_line, value))
-                        // this line removes the space at the end of the string if there are any
-                        // sppaces
-                        value.erase(std::remove_if(value.begin(), value.end(), ::isspace),
-                                    value.end());
-
-                    // removes comma at the end of the line
-                    value.erase(std::remove(value.begin(), value.end(), ','), value.end());
-
-                    // Checks if the given character is a punctuation character as classified by the
-                    // current C locale. The default C locale classifies
-                    // the characters !"#$%&'()*+,-./:;<=>?@[\]^_`{|}~ as punctuation.
-                    // value.erase(std::remove_if(value.begin(), value.end(), ::ispunct),
-                    // value.end());
-
-                    // print out all of the key/values
-                    // std::cout << key << "," << value << std::endl;
-
-                    //  store_line(key, value);
-                    keyValues.insert(std::make_pair(key, value));
-                }
-            }
-        }
-    }
-
-    return keyValues;
-}
-
-// helper function to map string to boolean
-bool to_bool(std::string str) {
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
-    std::istringstream is(str);
-    bool b;
-    is >> std::boolalpha >> b;
-    return b;
-}
-
 int main(int argc, char** argv) {
 
     string serverName;
@@ -138,6 +81,10 @@ int main(int argc, char** argv) {
     bool enableCatalog = true;
     bool enableDM = true;
     bool useUnixDomainSock = false;
+    bool numaAware = false;
+    bool pinThreads = false;
+    bool useHugePages = false;
+    std::string shuffleCodec = DEFAULT_SHUFFLE_CODEC;
 
     const char* m_configFile = "./conf/pdbSettings.conf";
 
@@ -182,7 +129,7 @@ int main(int argc, char** argv) {
 
     // read the config file and create a map out of it.
     map<string, string> keyValues;
-    keyValues = readConfigFile(m_configFile);
+    keyValues = Configuration::readSettings(m_configFile);
 
     // We go through the map and find the configuration keys.
 
@@ -205,25 +152,25 @@ int main(int argc, char** argv) {
 
     // enableStorage
     if (keyValues.find("enableStorage") != keyValues.end()) {
-        enableStorage = to_bool(keyValues["enableStorage"]);
+        enableStorage = Configuration::toBool(keyValues["enableStorage"]);
         cout << "enableStorage: " << enableStorage << endl;
     }
 
     // enableCatalog
     if (keyValues.find("enableCatalog") != keyValues.end()) {
-        enableCatalog = to_bool(keyValues["enableCatalog"]);
+        enableCatalog = Configuration::toBool(keyValues["enableCatalog"]);
         cout << "enableCatalog: " << enableCatalog << endl;
     }
 
     // enableDM
     if (keyValues.find("enableDM") != keyValues.end()) {
-        enableDM = to_bool(keyValues["enableDM"]);
+        enableDM = Configuration::toBool(keyValues["enableDM"]);
         cout << "enableDM: " << enableDM << endl;
     }
 
     // useUnixDomainSock
     if (keyValues.find("useUnixDomainSock") != keyValues.end()) {
-        useUnixDomainSock = to_bool(keyValues["useUnixDomainSock"]);
+        useUnixDomainSock = Configuration::toBool(keyValues["useUnixDomainSock"]);
         cout << "useUnixDomainSock: " << useUnixDomainSock << endl;
     }
 
@@ -255,7 +202,7 @@ int main(int argc, char** argv) {
 
     // logEnabled
     if (keyValues.find("logEnabled") != keyValues.end()) {
-        logEnabled = to_bool(keyValues["logEnabled"]);
+        logEnabled = Configuration::toBool(keyValues["logEnabled"]);
         cout << "logEnabled: " << logEnabled << endl;
     }
 
@@ -298,7 +245,7 @@ int main(int argc, char** argv) {
     //	// isMaster
     //	if (keyValues.find("isMaster") != keyValues.end()) {
     //        // no need to do that - default is master
-    //		//		isMaster = to_bool(keyValues["isMaster"]);
+    //		//		isMaster = Configuration::toBool(keyValues["isMaster"]);
     //		cout << "isMaster: " << isMaster << endl;
     //	}
 
@@ -321,6 +268,26 @@ int main(int argc, char** argv) {
         cout << "queryPlannerPlace: " << queryPlannerPlace << endl;
     }
 
+    if (keyValues.find("numaAware") != keyValues.end()) {
+        numaAware = Configuration::toBool(keyValues["numaAware"]);
+        cout << "numaAware: " << numaAware << endl;
+    }
+
+    if (keyValues.find("pinThreads") != keyValues.end()) {
+        pinThreads = Configuration::toBool(keyValues["pinThreads"]);
+        cout << "pinThreads: " << pinThreads << endl;
+    }
+
+    if (keyValues.find("useHugePages") != keyValues.end()) {
+        useHugePages = Configuration::toBool(keyValues["useHugePages"]);
+        cout << "useHugePages: " << useHugePages << endl;
+    }
+
+    if (keyValues.find("shuffleCodec") != keyValues.end()) {
+        shuffleCodec = keyValues["shuffleCodec"];
+        cout << "shuffleCodec: " << shuffleCodec << endl;
+    }
+
 
     cout << "#################################################" << endl;
     cout << "######                                     ######" << endl;
@@ -339,6 +306,10 @@ int main(int argc, char** argv) {
     conf->setQueryPlannerPlace(queryPlannerPlace);
     conf->setUseUnixDomainSock(useUnixDomainSock);
     conf->setShmSize(sharedMemSize);
+    conf->setNumaAware(numaAware);
+    conf->setPinThreads(pinThreads);
+    conf->setUseHugePages(useHugePages);
+    conf->setShuffleCodec(shuffleCodec);
 
     // now print out the configurations
     conf->printOut();
@@ -375,7 +346,11 @@ int main(int argc, char** argv) {
 
     cout << "Log Level is set to " << logger->getLoglevel() << endl;
 
-    SharedMemPtr shm = make_shared<SharedMem>(conf->getShmSize(), logger);
+    SharedMemPtr shm = make_shared<SharedMem>(
+        conf->getShmSize(), logger, conf->getNumaAware(), conf->getUseHugePages());
+
+    // both the frontend and the forked backend create their worker queues after this
+    pdb::PDBWorkerQueue::setPinWorkers(conf->getPinThreads());
 
 
     // STORAGE
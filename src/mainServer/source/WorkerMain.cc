@@ -3,6 +3,7 @@
 #define WORKER_MAIN_CC
 
 #include "PDBServer.h"
+#include "BackendPool.h"
 #include "CatalogServer.h"
 #include "CatalogClient.h"
 #include "StorageClient.h"
@@ -74,6 +75,7 @@ int main(int argc, char* argv[]) {
         }
     }
     conf->initDirs();
+    conf->loadSettings();
     std::cout << "Node Id =" << nodeId << std::endl;
     std::cout << "Thread number =" << numThreads << std::endl;
     std::cout << "Shared memory size =" << sharedMemSize << std::endl;
@@ -95,7 +97,9 @@ int main(int argc, char* argv[]) {
     pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>(frontendLoggerFile);
     conf->setNumThreads(numThreads);
     conf->setShmSize(sharedMemSize);
-    SharedMemPtr shm = make_shared<SharedMem>(conf->getShmSize(), logger);
+    SharedMemPtr shm = make_shared<SharedMem>(
+        conf->getShmSize(), logger, conf->getNumaAware(), conf->getUseHugePages());
+    pdb::PDBWorkerQueue::setPinWorkers(conf->getPinThreads());
 
     std::string ipcFile =
         std::string("/tmp/") + localIp + std::string("_") + std::to_string(localPort);
@@ -104,56 +108,63 @@ int main(int argc, char* argv[]) {
 
     string errMsg;
     if (shm != nullptr) {
-        pid_t child_pid = fork();
-        if (child_pid == 0) {
-            // I'm the backend server
-            std::string backendLoggerFile = std::string("backend_") + localIp + std::string("_") +
-                std::to_string(localPort) + std::string(".log");
-            pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>(backendLoggerFile);
-            pdb::PDBServer backEnd(conf->getBackEndIpcFile(), 100, logger);
-            backEnd.addFunctionality<pdb::HermesExecutionServer>(nodeId, 
-                shm, backEnd.getWorkerQueue(), logger, conf);
-            bool usePangea = true;
-            std::string clientLoggerFile = std::string("client_") + localIp + std::string("_") +
-                std::to_string(localPort) + std::string(".log");
-            backEnd.addFunctionality<pdb::StorageClient>(
-                localPort, "localhost", make_shared<pdb::PDBLogger>(clientLoggerFile), usePangea);
-            backEnd.startServer(nullptr);
-
-        } else if (child_pid == -1) {
-            std::cout << "Fatal Error: fork failed." << std::endl;
+        // the backends are forked by the launcher of the pool, which has to be forked before the
+        // frontend starts any thread
+        pdb::BackendPool backEnds(
+            conf->getBackEndIpcFile(),
+            [=](std::string backEndIpcFile) {
+                // I'm a backend server
+                std::string backendLoggerFile = std::string("backend_") + localIp +
+                    std::string("_") + std::to_string(localPort) + std::string(".log");
+                pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>(backendLoggerFile);
+                pdb::PDBServer backEnd(backEndIpcFile, 100, logger);
+                backEnd.addFunctionality<pdb::HermesExecutionServer>(
+                    nodeId, shm, backEnd.getWorkerQueue(), logger, conf);
+                bool usePangea = true;
+                std::string clientLoggerFile = std::string("client_") + localIp +
+                    std::string("_") + std::to_string(localPort) + std::string(".log");
+                backEnd.addFunctionality<pdb::StorageClient>(
+                    localPort, "localhost", make_shared<pdb::PDBLogger>(clientLoggerFile), usePangea);
+                backEnd.startServer(nullptr);
+            },
+            logger);
+
+        // I'm the frontend server
+        pdb::PDBServer frontEnd(localPort, 100, logger);
+        // frontEnd.addFunctionality<pdb :: PipelineDummyTestServer>();
+        frontEnd.addFunctionality<pdb::PangeaStorageServer>(
+            shm, frontEnd.getWorkerQueue(), logger, conf, standalone);
+        frontEnd.getFunctionality<pdb::PangeaStorageServer>().startFlushConsumerThreads();
+        bool createSet = true;
+        if (standalone == false) {
+            createSet = false;
+        }
+        frontEnd.addFunctionality<pdb::FrontendQueryTestServer>(standalone, createSet);
+        if (standalone == true) {
+            string nodeName = "standalone";
+            string nodeType = "master";
+
+            pdb::UseTemporaryAllocationBlock tempBlock{1024 * 1024};
+            frontEnd.addFunctionality<pdb::CatalogServer>(
+                "CatalogDir", true, "localhost", localPort, "localhost", localPort);
+            frontEnd.addFunctionality<pdb::CatalogClient>(localPort, "localhost", logger);
+
         } else {
-            // I'm the frontend server
-            pdb::PDBServer frontEnd(localPort, 100, logger);
-            // frontEnd.addFunctionality<pdb :: PipelineDummyTestServer>();
-            frontEnd.addFunctionality<pdb::PangeaStorageServer>(
-                shm, frontEnd.getWorkerQueue(), logger, conf, standalone);
-            frontEnd.getFunctionality<pdb::PangeaStorageServer>().startFlushConsumerThreads();
-            bool createSet = true;
-            if (standalone == false) {
-                createSet = false;
-            }
-            frontEnd.addFunctionality<pdb::FrontendQueryTestServer>(standalone, createSet);
-            if (standalone == true) {
-                string nodeName = "standalone";
-                string nodeType = "master";
-
-                pdb::UseTemporaryAllocationBlock tempBlock{1024 * 1024};
-                frontEnd.addFunctionality<pdb::CatalogServer>(
-                    "CatalogDir", true, "localhost", localPort, "localhost", localPort);
-                frontEnd.addFunctionality<pdb::CatalogClient>(localPort, "localhost", logger);
-
-            } else {
-
-                std::string catalogFile = std::string("CatalogDir_") + localIp + std::string("_") +
-                    std::to_string(localPort);
-                frontEnd.addFunctionality<pdb::CatalogServer>(
-                    catalogFile, false, masterIp, masterPort, localIp, localPort);
-                frontEnd.addFunctionality<pdb::CatalogClient>(localPort, "localhost", logger);
-            }
-
-            frontEnd.startServer(nullptr);
+
+            std::string catalogFile = std::string("CatalogDir_") + localIp + std::string("_") +
+                std::to_string(localPort);
+            frontEnd.addFunctionality<pdb::CatalogServer>(
+                catalogFile, false, masterIp, masterPort, localIp, localPort);
+            frontEnd.addFunctionality<pdb::CatalogClient>(localPort, "localhost", logger);
         }
+
+        // start the backend, and switch the frontend to a spare whenever the backend dies
+        backEnds.start([&frontEnd](std::string backEndIpcFile) {
+            frontEnd.getFunctionality<pdb::PangeaStorageServer>().setPathToBackEndServer(
+                backEndIpcFile);
+        });
+
+        frontEnd.startServer(nullptr);
     }
 }
 
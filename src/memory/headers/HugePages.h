@@ -0,0 +1,34 @@
+
+#ifndef HUGE_PAGES_H
+#define HUGE_PAGES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+// the size of a huge page on x86-64
+#ifndef HUGE_PAGE_SIZE
+#define HUGE_PAGE_SIZE ((size_t)(2) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+// blocks at least this large are advised to be backed by transparent huge pages
+#ifndef HUGE_PAGE_ADVISE_THRESHOLD
+#define HUGE_PAGE_ADVISE_THRESHOLD ((size_t)(8) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+// asks the kernel to back the huge-page-aligned part of the given range with transparent
+// huge pages; this is only advice, so it returns false without harm if THP is unavailable
+inline bool adviseHugePages(void* start, size_t numBytes) {
+#ifdef MADV_HUGEPAGE
+    uintptr_t first = ((uintptr_t)start + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+    uintptr_t last = ((uintptr_t)start + numBytes) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+    if (last <= first) {
+        return false;
+    }
+    return madvise((void*)first, last - first, MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+#endif
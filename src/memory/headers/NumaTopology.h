@@ -0,0 +1,155 @@
+
+#ifndef NUMA_TOPOLOGY_H
+#define NUMA_TOPOLOGY_H
+
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <string>
+#include <vector>
+
+// the memory policy used to bind a range of memory to NUMA nodes, see mbind(2)
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+
+// this class reads the NUMA topology of this machine from sysfs, so that we do not
+// need to depend on libnuma; on a machine without NUMA support it reports a single
+// node holding all CPUs
+
+class NumaTopology {
+
+public:
+    // returns the topology of this machine, which is read once
+    static NumaTopology& getTopology() {
+        static NumaTopology topology;
+        return topology;
+    }
+
+    // returns the number of NUMA nodes
+    int getNumNodes() {
+        return cpusOfNode.size();
+    }
+
+    // returns the CPUs of the given node
+    std::vector<int>& getCpusOfNode(int node) {
+        return cpusOfNode[node];
+    }
+
+    // returns the node of the given CPU
+    int getNodeOfCpu(int cpu) {
+        if ((cpu < 0) || (cpu >= (int)nodeOfCpu.size())) {
+            return 0;
+        }
+        return nodeOfCpu[cpu];
+    }
+
+    // returns the node of the CPU that the calling thread is running on
+    int getCurrentNode() {
+        if (cpusOfNode.size() == 1) {
+            return 0;
+        }
+        return getNodeOfCpu(sched_getcpu());
+    }
+
+    // returns all CPUs ordered round-robin over the nodes (first CPU of node 0, first CPU
+    // of node 1, ..., second CPU of node 0, ...), so that pinning consecutive threads to
+    // consecutive entries spreads them evenly over the nodes
+    std::vector<int> getInterleavedCpus() {
+        std::vector<int> cpus;
+        for (size_t i = 0; cpus.size() < nodeOfCpu.size(); i++) {
+            bool found = false;
+            for (auto& nodeCpus : cpusOfNode) {
+                if (i < nodeCpus.size()) {
+                    cpus.push_back(nodeCpus[i]);
+                    found = true;
+                }
+            }
+            if (found == false) {
+                break;
+            }
+        }
+        return cpus;
+    }
+
+    // binds the pages of a memory range to the given node, so that they are allocated
+    // there on first touch; returns false if the binding fails
+    bool bindToNode(void* start, size_t numBytes, int node) {
+        if (cpusOfNode.size() == 1) {
+            return true;
+        }
+        unsigned long nodeMask[16];
+        memset(nodeMask, 0, sizeof(nodeMask));
+        nodeMask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+        return syscall(SYS_mbind,
+                       start,
+                       numBytes,
+                       MPOL_BIND,
+                       nodeMask,
+                       sizeof(nodeMask) * 8,
+                       0) == 0;
+    }
+
+private:
+    NumaTopology() {
+        int numCpus = sysconf(_SC_NPROCESSORS_CONF);
+        if (numCpus <= 0) {
+            numCpus = 1;
+        }
+        nodeOfCpu.resize(numCpus, 0);
+        for (int node = 0;; node++) {
+            std::string fileName = std::string("/sys/devices/system/node/node") +
+                std::to_string(node) + std::string("/cpulist");
+            FILE* file = fopen(fileName.c_str(), "r");
+            if (file == nullptr) {
+                break;
+            }
+            char buffer[4096];
+            std::vector<int> cpus;
+            if (fgets(buffer, sizeof(buffer), file) != nullptr) {
+                cpus = parseCpuList(buffer);
+            }
+            fclose(file);
+            for (int cpu : cpus) {
+                if (cpu < numCpus) {
+                    nodeOfCpu[cpu] = node;
+                }
+            }
+            cpusOfNode.push_back(cpus);
+        }
+        if (cpusOfNode.size() == 0) {
+            std::vector<int> cpus;
+            for (int cpu = 0; cpu < numCpus; cpu++) {
+                cpus.push_back(cpu);
+            }
+            cpusOfNode.push_back(cpus);
+        }
+    }
+
+    // parses a list like "0-7,16-23"
+    static std::vector<int> parseCpuList(char* list) {
+        std::vector<int> cpus;
+        char* saveptr = nullptr;
+        for (char* range = strtok_r(list, ",\n", &saveptr); range != nullptr;
+             range = strtok_r(nullptr, ",\n", &saveptr)) {
+            int first, last;
+            int numParsed = sscanf(range, "%d-%d", &first, &last);
+            if (numParsed == 1) {
+                last = first;
+            } else if (numParsed != 2) {
+                continue;
+            }
+            for (int cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    std::vector<std::vector<int>> cpusOfNode;
+    std::vector<int> nodeOfCpu;
+};
+
+#endif
@@ -10,7 +10,10 @@
 #include "tlsf.h"
 #endif
 
+#include <map>
 #include <memory>
+#include <set>
+#include <vector>
 using namespace std;
 class SharedMem;
 typedef shared_ptr<SharedMem> SharedMemPtr;
@@ -19,9 +22,47 @@ typedef shared_ptr<SharedMem> SharedMemPtr;
 //this class wraps a shared memory buffer pool for allocating pages
 //this class uses mmap system call
 
+//each NUMA sub-pool is a multiple of this size
+#ifndef SHARED_MEM_NODE_POOL_ALIGNMENT
+#define SHARED_MEM_NODE_POOL_ALIGNMENT ((size_t)(2) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+//at most this many threads are used to prefault the pool
+#ifndef SHARED_MEM_MAX_PREFAULT_THREADS
+#define SHARED_MEM_MAX_PREFAULT_THREADS 16
+#endif
+
+//each small page slab is carved with this much room in front of its chunks to align them;
+//chunk sizes are multiples of it, so every chunk is aligned without padding of its own
+#ifndef SMALL_PAGE_ALIGNMENT
+#define SMALL_PAGE_ALIGNMENT ((size_t)(4096))
+#endif
+
+//a slab of small pages of the same size class
+struct SmallPageSlab {
+    unsigned int classId;
+    unsigned int numChunks;
+    //the address returned by the pool, which is freed with the slab
+    char* rawStart;
+    vector<char*> freeChunks;
+};
+
+//makes the calling thread allocate from the given NUMA node while the guard is alive
+struct PreferredNodeGuard {
+    explicit PreferredNodeGuard(int node);
+    ~PreferredNodeGuard();
+};
+
 class SharedMem {
 public:
-    SharedMem(size_t shmMemSize, pdb::PDBLoggerPtr logger);
+    //if numaAware is true, the pool is split into one sub-pool per NUMA node, and memory is
+    //allocated from the sub-pool of the node that the calling thread runs on;
+    //if useHugePages is true, the pool is backed by hugetlbfs (or, failing that, transparent
+    //huge pages) and is prefaulted in parallel
+    SharedMem(size_t shmMemSize,
+              pdb::PDBLoggerPtr logger,
+              bool numaAware = false,
+              bool useHugePages = false);
     ~SharedMem();
     void lock();
     void unlock();
@@ -36,13 +77,29 @@ public:
     void* _malloc_unsafe(size_t size);
     void _free_unsafe(void* ptr, size_t size);
     size_t getShmSize();
+    size_t getNumSmallPageSlabs();
+    //sets the NUMA node that the calling thread allocates from, e.g. the node of the thread
+    //that requested a page; -1 means the node that the calling thread runs on
+    static void setPreferredNode(int node);
+    //returns the start of the small page slab that ptr belongs to, or nullptr if ptr
+    //was not allocated from a slab
+    void* getSmallPageSlab(void* ptr);
 
 protected:
     int initialize();
     void destroy();
-    int getMem();
+    int getMem(bool useHugePages = false);
+    void prefault();
     int initMallocs();
     int initMutex();
+    void* mallocSmallPage(size_t size);
+    bool freeSmallPage(void* ptr);
+    map<char*, SmallPageSlab>::iterator findSmallPageSlab(void* ptr);
+    static size_t getSmallPageChunkSize(unsigned int classId);
+#ifndef USE_MEMCACHED_SLAB_ALLOCATOR
+    void* mallocFromNodePools(size_t size);
+    void freeToNodePool(void* ptr);
+#endif
 
 private:
     pthread_mutex_t* memLock;
@@ -51,10 +108,17 @@ private:
     SlabAllocatorPtr allocator;
 #else
     tlsfAllocator allocator;
-    void* my_tlsf;
+    //one tlsf pool per NUMA node, each covering nodePoolSize bytes of memPool
+    vector<void*> nodeTlsfs;
+    size_t nodePoolSize;
 #endif
     void* memPool;
     size_t shmMemSize;
+    //small page slabs keyed by their first chunk; they are only touched by the frontend,
+    //which is the only process that allocates and frees pages
+    map<char*, SmallPageSlab> smallPageSlabs;
+    //for each size class, the slabs that still have free chunks
+    vector<set<char*>> partialSmallPageSlabs;
 };
 
 #endif /* SHAREDMEM_H */
@@ -1,5 +1,9 @@
 #include "SharedMem.h"
 #include "Configuration.h"
+#include "NumaTopology.h"
+#include "HugePages.h"
+#include <algorithm>
+#include <vector>
 #include <sys/mman.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -18,24 +22,75 @@
 #include "tlsf.h"
 #endif
 
-SharedMem::SharedMem(size_t memSize, pdb::PDBLoggerPtr logger) {
+// the NUMA node that the calling thread allocates from, -1 for the node it runs on
+static thread_local int preferredNode = -1;
+
+void SharedMem::setPreferredNode(int node) {
+    preferredNode = node;
+}
+
+PreferredNodeGuard::PreferredNodeGuard(int node) {
+    SharedMem::setPreferredNode(node);
+}
+
+PreferredNodeGuard::~PreferredNodeGuard() {
+    SharedMem::setPreferredNode(-1);
+}
+
+SharedMem::SharedMem(size_t memSize, pdb::PDBLoggerPtr logger, bool numaAware, bool useHugePages) {
     this->shmMemSize = memSize;
     this->memPool = nullptr;
-    if (this->getMem() < 0) {
+    if (this->getMem(useHugePages) < 0) {
         std::cout << "Fatal error: initialize shared memory failed with size=" << memSize
                   << std::endl;
         logger->error(std::string("Fatal error: initialize shared memory failed with size=") +
                       std::to_string(memSize));
         exit(-1);
     }
+#ifndef USE_MEMCACHED_SLAB_ALLOCATOR
+    // with NUMA awareness, split the pool into one sub-pool per node, each bound to its node
+    int numNodes = 1;
+    if (numaAware == true) {
+        numNodes = NumaTopology::getTopology().getNumNodes();
+    }
+    this->nodePoolSize = roundDown(this->shmMemSize / numNodes, SHARED_MEM_NODE_POOL_ALIGNMENT);
+    if (this->nodePoolSize < 2 * DEFAULT_PAGE_SIZE) {
+        numNodes = 1;
+        this->nodePoolSize = this->shmMemSize;
+    }
+    for (int i = 0; (numNodes > 1) && (i < numNodes); i++) {
+        char* start = (char*)this->memPool + i * this->nodePoolSize;
+        size_t numBytes = (i == numNodes - 1) ? (this->shmMemSize - i * this->nodePoolSize)
+                                              : this->nodePoolSize;
+        if (NumaTopology::getTopology().bindToNode(start, numBytes, i) == false) {
+            std::cout << "SharedMem: failed to bind sub-pool to NUMA node " << i << std::endl;
+        }
+    }
+#endif
+    // fault the whole pool in now (after it has been bound to nodes), so that the first
+    // scans after fork do not pay for it
+    if (useHugePages == true) {
+        this->prefault();
+    }
 #ifdef USE_MEMCACHED_SLAB_ALLOCATOR
     this->allocator =
         make_shared<SlabAllocator>(this->memPool, this->shmMemSize, DEFAULT_PAGE_SIZE, 512);
 #else
-    this->my_tlsf = this->allocator.tlsf_create_with_pool(this->memPool, this->shmMemSize);
+    for (int i = 0; i < numNodes; i++) {
+        char* start = (char*)this->memPool + i * this->nodePoolSize;
+        size_t numBytes = (i == numNodes - 1) ? (this->shmMemSize - i * this->nodePoolSize)
+                                              : this->nodePoolSize;
+        this->nodeTlsfs.push_back(this->allocator.tlsf_create_with_pool(start, numBytes));
+    }
+    std::cout << "SharedMem: created " << numNodes << " sub-pool(s)" << std::endl;
 #endif
     this->initMutex();
     this->logger = logger;
+    unsigned int numSmallPageClasses = 0;
+    while ((SMALL_PAGE_MIN_SIZE << numSmallPageClasses) <= SMALL_PAGE_MAX_SIZE) {
+        numSmallPageClasses++;
+    }
+    this->partialSmallPageSlabs.resize(numSmallPageClasses);
 }
 
 SharedMem::~SharedMem() {
@@ -55,13 +110,30 @@ size_t SharedMem::getShmSize() {
 }
 
 
+size_t SharedMem::getNumSmallPageSlabs() {
+    this->lock();
+    size_t numSlabs = this->smallPageSlabs.size();
+    this->unlock();
+    return numSlabs;
+}
+
+
+void* SharedMem::getSmallPageSlab(void* ptr) {
+    this->lock();
+    auto it = this->findSmallPageSlab(ptr);
+    void* start = (it == this->smallPageSlabs.end()) ? nullptr : it->first;
+    this->unlock();
+    return start;
+}
+
+
 void* SharedMem::malloc(size_t size) {
-    void* ptr;
+    void* ptr = nullptr;
     this->lock();
 #ifdef USE_MEMCACHED_SLAB_ALLOCATOR
     ptr = this->allocator->slabs_alloc_unsafe(size);
 #else
-    ptr = this->allocator.tlsf_malloc(this->my_tlsf, size);
+    ptr = this->mallocFromNodePools(size);
 #endif
     this->unlock();
     return ptr;
@@ -69,6 +141,16 @@ void* SharedMem::malloc(size_t size) {
 
 
 void* SharedMem::mallocAlign(size_t size, size_t alignment, int& offset) {
+    // small pages come from slabs, whose chunks are already aligned
+    if ((size <= SMALL_PAGE_MAX_SIZE) && (alignment <= SMALL_PAGE_ALIGNMENT)) {
+        this->lock();
+        void* chunk = this->mallocSmallPage(size);
+        this->unlock();
+        if (chunk != nullptr) {
+            offset = 0;
+            return chunk;
+        }
+    }
     void* ptr = this->malloc(size + alignment);
     void* retPtr = ptr;
     offset = 0;
@@ -82,15 +164,104 @@ void* SharedMem::mallocAlign(size_t size, size_t alignment, int& offset) {
 
 void SharedMem::free(void* ptr, size_t size) {
     this->lock();
+    if (this->freeSmallPage(ptr) == false) {
 #ifdef USE_MEMCACHED_SLAB_ALLOCATOR
-    this->allocator->slabs_free_unsafe(ptr, size);
+        this->allocator->slabs_free_unsafe(ptr, size);
 #else
-    this->allocator.tlsf_free(this->my_tlsf, ptr);
+        this->freeToNodePool(ptr);
 #endif
+    }
     this->unlock();
 }
 
 
+size_t SharedMem::getSmallPageChunkSize(unsigned int classId) {
+    return SMALL_PAGE_MIN_SIZE << classId;
+}
+
+// to allocate a small page from the slabs of its size class, carving a new slab out of the
+// pool if all slabs of that class are full; returns nullptr if there is no room for a new slab,
+// and the caller should then fall back to the pool itself.
+// a slab is sized as a whole number of chunks plus the room to align them, so no chunk is lost.
+// the caller must hold the lock
+void* SharedMem::mallocSmallPage(size_t size) {
+    unsigned int classId = 0;
+    while (getSmallPageChunkSize(classId) < size) {
+        classId++;
+    }
+    set<char*>& partialSlabs = this->partialSmallPageSlabs[classId];
+    if (partialSlabs.empty()) {
+        size_t chunkSize = getSmallPageChunkSize(classId);
+        unsigned int numChunks = SMALL_PAGE_SLAB_SIZE / chunkSize;
+        if (numChunks == 0) {
+            numChunks = 1;
+        }
+        char* rawStart = (char*)this->_malloc_unsafe(numChunks * chunkSize + SMALL_PAGE_ALIGNMENT);
+        if (rawStart == nullptr) {
+            return nullptr;
+        }
+        char* start = addressRoundUp(rawStart, SMALL_PAGE_ALIGNMENT);
+        SmallPageSlab& slab = this->smallPageSlabs[start];
+        slab.classId = classId;
+        slab.numChunks = numChunks;
+        slab.rawStart = rawStart;
+        slab.freeChunks.clear();
+        for (unsigned int i = slab.numChunks; i > 0; i--) {
+            slab.freeChunks.push_back(start + (i - 1) * chunkSize);
+        }
+        partialSlabs.insert(start);
+    }
+    // always allocate from the lowest slab, so that the higher ones can drain and be returned
+    SmallPageSlab& slab = this->smallPageSlabs[*partialSlabs.begin()];
+    char* chunk = slab.freeChunks.back();
+    slab.freeChunks.pop_back();
+    if (slab.freeChunks.empty()) {
+        partialSlabs.erase(partialSlabs.begin());
+    }
+    return chunk;
+}
+
+// to find the slab that a pointer belongs to, or the end of the slabs if there is none.
+// the caller must hold the lock
+map<char*, SmallPageSlab>::iterator SharedMem::findSmallPageSlab(void* ptr) {
+    auto it = this->smallPageSlabs.upper_bound((char*)ptr);
+    if (it == this->smallPageSlabs.begin()) {
+        return this->smallPageSlabs.end();
+    }
+    --it;
+    size_t slabSize = it->second.numChunks * getSmallPageChunkSize(it->second.classId);
+    if ((char*)ptr >= it->first + slabSize) {
+        return this->smallPageSlabs.end();
+    }
+    return it;
+}
+
+// to free a small page, returning its slab to the pool once the slab is empty;
+// returns false if the pointer does not belong to any slab.
+// the caller must hold the lock
+bool SharedMem::freeSmallPage(void* ptr) {
+    auto it = this->findSmallPageSlab(ptr);
+    if (it == this->smallPageSlabs.end()) {
+        return false;
+    }
+    char* start = it->first;
+    SmallPageSlab& slab = it->second;
+    set<char*>& partialSlabs = this->partialSmallPageSlabs[slab.classId];
+    slab.freeChunks.push_back((char*)ptr);
+    if (slab.freeChunks.size() == slab.numChunks) {
+        char* rawStart = slab.rawStart;
+        size_t slabSize =
+            slab.numChunks * getSmallPageChunkSize(slab.classId) + SMALL_PAGE_ALIGNMENT;
+        partialSlabs.erase(start);
+        this->smallPageSlabs.erase(it);
+        this->_free_unsafe(rawStart, slabSize);
+    } else {
+        partialSlabs.insert(start);
+    }
+    return true;
+}
+
+
 char* SharedMem::addressRoundUp(char* address, size_t roundTo) {
     size_t roundToMask = (~((size_t)roundTo - 1));
     return (char*)((size_t)((address) + (roundTo - 1)) & roundToMask);
@@ -121,17 +292,85 @@ void SharedMem::destroy() {
     }
 }
 
-int SharedMem::getMem() {
+int SharedMem::getMem(bool useHugePages) {
     if (this->memPool && (this->memPool != (void*)-1)) {
         return -1;
     }
+#ifdef MAP_HUGETLB
+    // try hugetlbfs first, which needs huge pages reserved via vm.nr_hugepages
+    if (useHugePages == true) {
+        size_t hugeSize = roundUp(this->shmMemSize, HUGE_PAGE_SIZE);
+        this->memPool = mmap(
+            0, hugeSize, PROT_READ | PROT_WRITE, MAP_ANON | MAP_SHARED | MAP_HUGETLB, -1, 0);
+        if (this->memPool != (void*)-1) {
+            this->shmMemSize = hugeSize;
+            std::cout << "SharedMem: pool is backed by hugetlbfs" << std::endl;
+            return 0;
+        }
+        std::cout << "SharedMem: can't get huge pages from hugetlbfs, falling back to THP"
+                  << std::endl;
+    }
+#endif
     this->memPool = mmap(0, this->shmMemSize, PROT_READ | PROT_WRITE, MAP_ANON | MAP_SHARED, -1, 0);
     if (this->memPool == (void*)-1) {
         return -1;
     }
+    if ((useHugePages == true) && (adviseHugePages(this->memPool, this->shmMemSize) == false)) {
+        std::cout << "SharedMem: transparent huge pages are not available" << std::endl;
+    }
     return 0;
 }
 
+struct PrefaultRange {
+    char* start;
+    size_t numBytes;
+};
+
+static void* prefaultRange(void* rangeIn) {
+    PrefaultRange* range = (PrefaultRange*)rangeIn;
+    volatile char* start = range->start;
+    for (size_t i = 0; i < range->numBytes; i += 4096) {
+        start[i] = 0;
+    }
+    return nullptr;
+}
+
+// to touch every page of the pool, using one thread per CPU (up to
+// SHARED_MEM_MAX_PREFAULT_THREADS); this must be done before the pool is handed to the
+// allocator, because it overwrites the pool with zeros
+void SharedMem::prefault() {
+    int numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (numThreads > SHARED_MEM_MAX_PREFAULT_THREADS) {
+        numThreads = SHARED_MEM_MAX_PREFAULT_THREADS;
+    }
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    size_t stripeSize = roundUp(this->shmMemSize / numThreads, HUGE_PAGE_SIZE);
+    std::vector<PrefaultRange> ranges;
+    for (size_t offset = 0; offset < this->shmMemSize; offset += stripeSize) {
+        PrefaultRange range;
+        range.start = (char*)this->memPool + offset;
+        range.numBytes = std::min(stripeSize, this->shmMemSize - offset);
+        ranges.push_back(range);
+    }
+    std::vector<pthread_t> threads(ranges.size());
+    std::vector<bool> started(ranges.size(), false);
+    for (size_t i = 0; i < ranges.size(); i++) {
+        started[i] = (pthread_create(&threads[i], nullptr, prefaultRange, &ranges[i]) == 0);
+        if (started[i] == false) {
+            prefaultRange(&ranges[i]);
+        }
+    }
+    for (size_t i = 0; i < ranges.size(); i++) {
+        if (started[i] == true) {
+            pthread_join(threads[i], nullptr);
+        }
+    }
+    std::cout << "SharedMem: prefaulted " << this->shmMemSize << " bytes with " << ranges.size()
+              << " threads" << std::endl;
+}
+
 long long SharedMem::computeOffset(void* shmAddress) {
     return (long long)((char*)shmAddress - (char*)this->memPool);
 }
@@ -156,7 +395,7 @@ void* SharedMem::_malloc_unsafe(size_t size) {
 #ifdef USE_MEMCACHED_SLAB_ALLOCATOR
     return this->allocator->slabs_alloc_unsafe(size);
 #else
-    return this->allocator.tlsf_malloc(this->my_tlsf, size);
+    return this->mallocFromNodePools(size);
 #endif
 }
 
@@ -164,6 +403,37 @@ void SharedMem::_free_unsafe(void* ptr, size_t size) {
 #ifdef USE_MEMCACHED_SLAB_ALLOCATOR
     return this->allocator->slabs_free_unsafe(ptr, size);
 #else
-    return this->allocator.tlsf_free(this->my_tlsf, ptr);
+    return this->freeToNodePool(ptr);
 #endif
 }
+
+#ifndef USE_MEMCACHED_SLAB_ALLOCATOR
+// to allocate from the sub-pool of the preferred NUMA node of the calling thread, or else of
+// the node it runs on, falling back to the sub-pools of the other nodes if it is full
+void* SharedMem::mallocFromNodePools(size_t size) {
+    int numNodes = this->nodeTlsfs.size();
+    int localNode = 0;
+    if (numNodes > 1) {
+        localNode = (preferredNode >= 0) ? preferredNode
+                                         : NumaTopology::getTopology().getCurrentNode();
+        localNode = localNode % numNodes;
+    }
+    for (int i = 0; i < numNodes; i++) {
+        void* ptr =
+            this->allocator.tlsf_malloc(this->nodeTlsfs[(localNode + i) % numNodes], size);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+    }
+    return nullptr;
+}
+
+// to return memory to the sub-pool that it was allocated from
+void SharedMem::freeToNodePool(void* ptr) {
+    size_t node = ((char*)ptr - (char*)this->memPool) / this->nodePoolSize;
+    if (node >= this->nodeTlsfs.size()) {
+        node = this->nodeTlsfs.size() - 1;
+    }
+    this->allocator.tlsf_free(this->nodeTlsfs[node], ptr);
+}
+#endif
@@ -564,6 +564,11 @@ inline bool MultiPolicyAllocator<FirstPolicy, OtherPolicies...>::isManaged(void*
         return true;
     }
 
+    // a borrowed region is never managed, so don't bother searching for him
+    if (isBorrowed(here)) {
+        return false;
+    }
+
     // otherwise, he is not in the active block, so look for him
     auto i = std::lower_bound(allInactives.begin(), allInactives.end(), here);
 
@@ -575,6 +580,31 @@ inline bool MultiPolicyAllocator<FirstPolicy, OtherPolicies...>::isManaged(void*
     return false;
 }
 
+template <typename FirstPolicy, typename... OtherPolicies>
+inline bool MultiPolicyAllocator<FirstPolicy, OtherPolicies...>::borrowRegion(void* start,
+                                                                              size_t numBytes) {
+
+    borrowedStart = nullptr;
+    borrowedEnd = nullptr;
+    if (start == nullptr || isManaged(start)) {
+        return false;
+    }
+    borrowedStart = CHAR_PTR(start);
+    borrowedEnd = CHAR_PTR(start) + numBytes;
+    return true;
+}
+
+template <typename FirstPolicy, typename... OtherPolicies>
+inline void MultiPolicyAllocator<FirstPolicy, OtherPolicies...>::returnBorrowedRegion() {
+    borrowedStart = nullptr;
+    borrowedEnd = nullptr;
+}
+
+template <typename FirstPolicy, typename... OtherPolicies>
+inline bool MultiPolicyAllocator<FirstPolicy, OtherPolicies...>::isBorrowed(void* here) {
+    return (CHAR_PTR(here) >= borrowedStart) && (CHAR_PTR(here) < borrowedEnd);
+}
+
 template <typename FirstPolicy, typename... OtherPolicies>
 inline void MultiPolicyAllocator<FirstPolicy, OtherPolicies...>::emptyOutBlock(void* here) {
 
@@ -398,6 +398,11 @@ private:
     // still contain some object...
     std::vector<InactiveAllocationBlock> allInactives;
 
+    // this is a region of RAM outside of all allocation blocks (typically an input page)
+    // that is being scanned by this thread; handles into it need no reference counting
+    char* borrowedStart = nullptr;
+    char* borrowedEnd = nullptr;
+
 public:
     // return true if allocations should not fail due to not enough RAM...
     // in this case, a null pointer is returned on a bad allocate, and NOT
@@ -443,6 +448,18 @@ public:
     // as of yet
     inline bool isManaged(void* here);
 
+    // tells the allocator that the specified RAM (e.g. a page being scanned by a pipeline)
+    // is not managed by it and will stay valid until returnBorrowedRegion () is called, so
+    // that copying and destroying handles into it can skip the search for their block;
+    // returns false (and borrows nothing) if the RAM is in fact managed
+    inline bool borrowRegion(void* start, size_t numBytes);
+
+    // forgets the region set by borrowRegion ()
+    inline void returnBorrowedRegion();
+
+    // returns true if and only if the RAM is in the borrowed region
+    inline bool isBorrowed(void* here);
+
 // returns some RAM... this can throw an exception if the request is too large
 // to be handled because there is not enough RAM in the current allocation block
 // JIA NOTE: enable DEBUG_OBJECT_MODEL will bring significant performance overhead, and should be
@@ -9,128 +9,130 @@
 #define Avg_TYPEID 7
 #define AvgResult_TYPEID 8
 #define BackendExecuteSelection_TYPEID 9
-#define BackendTestSetCopy_TYPEID 10
-#define BackendTestSetScan_TYPEID 11
-#define BaseQuery_TYPEID 12
-#define BroadcastJoinBuildHTJobStage_TYPEID 13
-#define BuiltinPartialResult_TYPEID 14
-#define CatCreateDatabaseRequest_TYPEID 15
-#define CatCreateSetRequest_TYPEID 16
-#define CatDeleteDatabaseRequest_TYPEID 17
-#define CatDeleteSetRequest_TYPEID 18
-#define CatGetDatabaseRequest_TYPEID 19
-#define CatGetDatabaseResult_TYPEID 20
-#define CatGetSetRequest_TYPEID 21
-#define CatGetSetResult_TYPEID 22
-#define CatGetType_TYPEID 23
-#define CatGetTypeResult_TYPEID 24
-#define CatPrintCatalogRequest_TYPEID 25
-#define CatPrintCatalogResult_TYPEID 26
-#define CatRegisterType_TYPEID 27
-#define CatSetObjectTypeRequest_TYPEID 28
-#define CatSharedLibraryByNameRequest_TYPEID 29
-#define CatSharedLibraryResult_TYPEID 30
-#define CatSyncRequest_TYPEID 31
-#define CatSyncResult_TYPEID 32
-#define CatTypeNameSearchResult_TYPEID 33
-#define CatalogUserTypeMetadata_TYPEID 34
-#define CloseConnection_TYPEID 35
-#define ComputePlan_TYPEID 36
-#define Count_TYPEID 37
-#define DeleteSet_TYPEID 38
-#define DepartmentEmployeeAges_TYPEID 39
-#define DepartmentEmployees_TYPEID 40
-#define DepartmentTotal_TYPEID 41
-#define DispatcherAddData_TYPEID 42
-#define DispatcherRegisterPartitionPolicy_TYPEID 43
-#define DistributedStorageAddDatabase_TYPEID 44
-#define DistributedStorageAddSet_TYPEID 45
-#define DistributedStorageAddSetWithPartition_TYPEID 46
-#define DistributedStorageAddTempSet_TYPEID 47
-#define DistributedStorageCleanup_TYPEID 48
-#define DistributedStorageClearSet_TYPEID 49
-#define DistributedStorageExportSet_TYPEID 50
-#define DistributedStorageRemoveDatabase_TYPEID 51
-#define DistributedStorageRemoveHashSet_TYPEID 52
-#define DistributedStorageRemoveSet_TYPEID 53
-#define DistributedStorageRemoveTempSet_TYPEID 54
-#define DoneWithResult_TYPEID 55
-#define DoubleSumResult_TYPEID 56
-#define DoubleVector_TYPEID 57
-#define DoubleVectorResult_TYPEID 58
-#define Employee_TYPEID 59
-#define ExecuteComputation_TYPEID 60
-#define ExecuteQuery_TYPEID 61
-#define GenericBlock_TYPEID 62
-#define GetListOfNodes_TYPEID 63
-#define HashPartitionedJoinBuildHTJobStage_TYPEID 64
-#define Holder_TYPEID 65
-#define JoinMap_TYPEID 66
-#define JoinPairArray_TYPEID 67
-#define KMeansDoubleVector_TYPEID 68
-#define KeepGoing_TYPEID 69
-#define LambdaIdentifier_TYPEID 70
-#define ListOfNodes_TYPEID 71
-#define Map_TYPEID 72
-#define MyEmployee_TYPEID 73
-#define NodeDispatcherData_TYPEID 74
-#define NodeInfo_TYPEID 75
-#define Nothing_TYPEID 76
-#define Object_TYPEID 77
-#define OptimizedDepartmentEmployees_TYPEID 78
-#define OptimizedEmployee_TYPEID 79
-#define OptimizedSupervisor_TYPEID 80
-#define PairArray_TYPEID 81
-#define PlaceOfQueryPlanner_TYPEID 82
-#define QueriesAndPlan_TYPEID 83
-#define QueryDone_TYPEID 84
-#define QueryOutput_TYPEID 85
-#define QueryPermit_TYPEID 86
-#define QueryPermitResponse_TYPEID 87
-#define RequestResources_TYPEID 88
-#define ResourceInfo_TYPEID 89
-#define ScanDoubleVectorSet_TYPEID 90
-#define ScanUserSet_TYPEID 91
-#define Set_TYPEID 92
-#define SetIdentifier_TYPEID 93
-#define SetScan_TYPEID 94
-#define ShutDown_TYPEID 95
-#define SimpleRequestResult_TYPEID 96
-#define StorageAddData_TYPEID 97
-#define StorageAddDatabase_TYPEID 98
-#define StorageAddObject_TYPEID 99
-#define StorageAddObjectInLoop_TYPEID 100
-#define StorageAddSet_TYPEID 101
-#define StorageAddTempSet_TYPEID 102
-#define StorageAddTempSetResult_TYPEID 103
-#define StorageAddType_TYPEID 104
-#define StorageBytesPinned_TYPEID 105
-#define StorageCleanup_TYPEID 106
-#define StorageClearSet_TYPEID 107
-#define StorageCollectStats_TYPEID 108
-#define StorageCollectStatsResponse_TYPEID 109
-#define StorageExportSet_TYPEID 110
-#define StorageGetData_TYPEID 111
-#define StorageGetDataResponse_TYPEID 112
-#define StorageGetSetPages_TYPEID 113
-#define StorageGetStats_TYPEID 114
-#define StorageNoMorePage_TYPEID 115
-#define StoragePagePinned_TYPEID 116
-#define StoragePinBytes_TYPEID 117
-#define StoragePinPage_TYPEID 118
-#define StorageRemoveDatabase_TYPEID 119
-#define StorageRemoveHashSet_TYPEID 120
-#define StorageRemoveTempSet_TYPEID 121
-#define StorageRemoveUserSet_TYPEID 122
-#define StorageTestSetCopy_TYPEID 123
-#define StorageTestSetScan_TYPEID 124
-#define StorageUnpinPage_TYPEID 125
-#define StringIntPair_TYPEID 126
-#define SumResult_TYPEID 127
-#define Supervisor_TYPEID 128
-#define TopKQueue_TYPEID 129
-#define TupleSetExecuteQuery_TYPEID 130
-#define TupleSetJobStage_TYPEID 131
-#define Vector_TYPEID 132
-#define WriteUserSet_TYPEID 133
-#define ZB_Company_TYPEID 134
+#define BackendPing_TYPEID 10
+#define BackendTestSetCopy_TYPEID 11
+#define BackendTestSetScan_TYPEID 12
+#define BaseQuery_TYPEID 13
+#define BroadcastJoinBuildHTJobStage_TYPEID 14
+#define BuiltinPartialResult_TYPEID 15
+#define CatCreateDatabaseRequest_TYPEID 16
+#define CatCreateSetRequest_TYPEID 17
+#define CatDeleteDatabaseRequest_TYPEID 18
+#define CatDeleteSetRequest_TYPEID 19
+#define CatGetDatabaseRequest_TYPEID 20
+#define CatGetDatabaseResult_TYPEID 21
+#define CatGetSetRequest_TYPEID 22
+#define CatGetSetResult_TYPEID 23
+#define CatGetType_TYPEID 24
+#define CatGetTypeResult_TYPEID 25
+#define CatPrintCatalogRequest_TYPEID 26
+#define CatPrintCatalogResult_TYPEID 27
+#define CatRegisterType_TYPEID 28
+#define CatSetObjectTypeRequest_TYPEID 29
+#define CatSetPartitioningRequest_TYPEID 30
+#define CatSharedLibraryByNameRequest_TYPEID 31
+#define CatSharedLibraryResult_TYPEID 32
+#define CatSyncRequest_TYPEID 33
+#define CatSyncResult_TYPEID 34
+#define CatTypeNameSearchResult_TYPEID 35
+#define CatalogUserTypeMetadata_TYPEID 36
+#define CloseConnection_TYPEID 37
+#define ComputePlan_TYPEID 38
+#define Count_TYPEID 39
+#define DeleteSet_TYPEID 40
+#define DepartmentEmployeeAges_TYPEID 41
+#define DepartmentEmployees_TYPEID 42
+#define DepartmentTotal_TYPEID 43
+#define DispatcherAddData_TYPEID 44
+#define DispatcherRegisterPartitionPolicy_TYPEID 45
+#define DistributedStorageAddDatabase_TYPEID 46
+#define DistributedStorageAddSet_TYPEID 47
+#define DistributedStorageAddSetWithPartition_TYPEID 48
+#define DistributedStorageAddTempSet_TYPEID 49
+#define DistributedStorageCleanup_TYPEID 50
+#define DistributedStorageClearSet_TYPEID 51
+#define DistributedStorageExportSet_TYPEID 52
+#define DistributedStorageRemoveDatabase_TYPEID 53
+#define DistributedStorageRemoveHashSet_TYPEID 54
+#define DistributedStorageRemoveSet_TYPEID 55
+#define DistributedStorageRemoveTempSet_TYPEID 56
+#define DoneWithResult_TYPEID 57
+#define DoubleSumResult_TYPEID 58
+#define DoubleVector_TYPEID 59
+#define DoubleVectorResult_TYPEID 60
+#define Employee_TYPEID 61
+#define ExecuteComputation_TYPEID 62
+#define ExecuteQuery_TYPEID 63
+#define GenericBlock_TYPEID 64
+#define GetListOfNodes_TYPEID 65
+#define HashPartitionedJoinBuildHTJobStage_TYPEID 66
+#define Holder_TYPEID 67
+#define JoinMap_TYPEID 68
+#define JoinPairArray_TYPEID 69
+#define KMeansDoubleVector_TYPEID 70
+#define KeepGoing_TYPEID 71
+#define LambdaIdentifier_TYPEID 72
+#define ListOfNodes_TYPEID 73
+#define Map_TYPEID 74
+#define MyEmployee_TYPEID 75
+#define NodeDispatcherData_TYPEID 76
+#define NodeInfo_TYPEID 77
+#define Nothing_TYPEID 78
+#define Object_TYPEID 79
+#define OptimizedDepartmentEmployees_TYPEID 80
+#define OptimizedEmployee_TYPEID 81
+#define OptimizedSupervisor_TYPEID 82
+#define PairArray_TYPEID 83
+#define PlaceOfQueryPlanner_TYPEID 84
+#define QueriesAndPlan_TYPEID 85
+#define QueryDone_TYPEID 86
+#define QueryOutput_TYPEID 87
+#define QueryPermit_TYPEID 88
+#define QueryPermitResponse_TYPEID 89
+#define RequestResources_TYPEID 90
+#define ResourceInfo_TYPEID 91
+#define ScanDoubleVectorSet_TYPEID 92
+#define ScanUserSet_TYPEID 93
+#define Set_TYPEID 94
+#define SetIdentifier_TYPEID 95
+#define SetScan_TYPEID 96
+#define ShutDown_TYPEID 97
+#define SimpleRequestResult_TYPEID 98
+#define StorageAddData_TYPEID 99
+#define StorageAddDatabase_TYPEID 100
+#define StorageAddObject_TYPEID 101
+#define StorageAddObjectInLoop_TYPEID 102
+#define StorageAddSet_TYPEID 103
+#define StorageAddTempSet_TYPEID 104
+#define StorageAddTempSetResult_TYPEID 105
+#define StorageAddType_TYPEID 106
+#define StorageBytesPinned_TYPEID 107
+#define StorageCleanup_TYPEID 108
+#define StorageClearSet_TYPEID 109
+#define StorageCollectStats_TYPEID 110
+#define StorageCollectStatsResponse_TYPEID 111
+#define StorageExportSet_TYPEID 112
+#define StorageGetData_TYPEID 113
+#define StorageGetDataResponse_TYPEID 114
+#define StorageGetSetPages_TYPEID 115
+#define StorageGetStats_TYPEID 116
+#define StorageNoMorePage_TYPEID 117
+#define StoragePagePinned_TYPEID 118
+#define StoragePinBytes_TYPEID 119
+#define StoragePinPage_TYPEID 120
+#define StorageRemoveDatabase_TYPEID 121
+#define StorageRemoveHashSet_TYPEID 122
+#define StorageRemoveTempSet_TYPEID 123
+#define StorageRemoveUserSet_TYPEID 124
+#define StorageTestSetCopy_TYPEID 125
+#define StorageTestSetScan_TYPEID 126
+#define StorageUnpinPage_TYPEID 127
+#define StringIntPair_TYPEID 128
+#define SumResult_TYPEID 129
+#define Supervisor_TYPEID 130
+#define TopKQueue_TYPEID 131
+#define TupleSetExecuteQuery_TYPEID 132
+#define TupleSetJobStage_TYPEID 133
+#define Vector_TYPEID 134
+#define WriteUserSet_TYPEID 135
+#define ZB_Company_TYPEID 136
@@ -8,131 +8,133 @@ objectTypeNamesList [getTypeName <Array <Nothing>> ()] = 6;
 objectTypeNamesList [getTypeName <Avg> ()] = 7;
 objectTypeNamesList [getTypeName <AvgResult> ()] = 8;
 objectTypeNamesList [getTypeName <BackendExecuteSelection> ()] = 9;
-objectTypeNamesList [getTypeName <BackendTestSetCopy> ()] = 10;
-objectTypeNamesList [getTypeName <BackendTestSetScan> ()] = 11;
-objectTypeNamesList [getTypeName <BaseQuery> ()] = 12;
-objectTypeNamesList [getTypeName <BroadcastJoinBuildHTJobStage> ()] = 13;
-objectTypeNamesList [getTypeName <BuiltinPartialResult> ()] = 14;
-objectTypeNamesList [getTypeName <CatCreateDatabaseRequest> ()] = 15;
-objectTypeNamesList [getTypeName <CatCreateSetRequest> ()] = 16;
-objectTypeNamesList [getTypeName <CatDeleteDatabaseRequest> ()] = 17;
-objectTypeNamesList [getTypeName <CatDeleteSetRequest> ()] = 18;
-objectTypeNamesList [getTypeName <CatGetDatabaseRequest> ()] = 19;
-objectTypeNamesList [getTypeName <CatGetDatabaseResult> ()] = 20;
-objectTypeNamesList [getTypeName <CatGetSetRequest> ()] = 21;
-objectTypeNamesList [getTypeName <CatGetSetResult> ()] = 22;
-objectTypeNamesList [getTypeName <CatGetType> ()] = 23;
-objectTypeNamesList [getTypeName <CatGetTypeResult> ()] = 24;
-objectTypeNamesList [getTypeName <CatPrintCatalogRequest> ()] = 25;
-objectTypeNamesList [getTypeName <CatPrintCatalogResult> ()] = 26;
-objectTypeNamesList [getTypeName <CatRegisterType> ()] = 27;
-objectTypeNamesList [getTypeName <CatSetObjectTypeRequest> ()] = 28;
-objectTypeNamesList [getTypeName <CatSharedLibraryByNameRequest> ()] = 29;
-objectTypeNamesList [getTypeName <CatSharedLibraryResult> ()] = 30;
-objectTypeNamesList [getTypeName <CatSyncRequest> ()] = 31;
-objectTypeNamesList [getTypeName <CatSyncResult> ()] = 32;
-objectTypeNamesList [getTypeName <CatTypeNameSearchResult> ()] = 33;
-objectTypeNamesList [getTypeName <CatalogUserTypeMetadata> ()] = 34;
-objectTypeNamesList [getTypeName <CloseConnection> ()] = 35;
-objectTypeNamesList [getTypeName <ComputePlan> ()] = 36;
-objectTypeNamesList [getTypeName <Count> ()] = 37;
-objectTypeNamesList [getTypeName <DeleteSet> ()] = 38;
-objectTypeNamesList [getTypeName <DepartmentEmployeeAges> ()] = 39;
-objectTypeNamesList [getTypeName <DepartmentEmployees> ()] = 40;
-objectTypeNamesList [getTypeName <DepartmentTotal> ()] = 41;
-objectTypeNamesList [getTypeName <DispatcherAddData> ()] = 42;
-objectTypeNamesList [getTypeName <DispatcherRegisterPartitionPolicy> ()] = 43;
-objectTypeNamesList [getTypeName <DistributedStorageAddDatabase> ()] = 44;
-objectTypeNamesList [getTypeName <DistributedStorageAddSet> ()] = 45;
-objectTypeNamesList [getTypeName <DistributedStorageAddSetWithPartition> ()] = 46;
-objectTypeNamesList [getTypeName <DistributedStorageAddTempSet> ()] = 47;
-objectTypeNamesList [getTypeName <DistributedStorageCleanup> ()] = 48;
-objectTypeNamesList [getTypeName <DistributedStorageClearSet> ()] = 49;
-objectTypeNamesList [getTypeName <DistributedStorageExportSet> ()] = 50;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveDatabase> ()] = 51;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveHashSet> ()] = 52;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveSet> ()] = 53;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveTempSet> ()] = 54;
-objectTypeNamesList [getTypeName <DoneWithResult> ()] = 55;
-objectTypeNamesList [getTypeName <DoubleSumResult> ()] = 56;
-objectTypeNamesList [getTypeName <DoubleVector> ()] = 57;
-objectTypeNamesList [getTypeName <DoubleVectorResult> ()] = 58;
-objectTypeNamesList [getTypeName <Employee> ()] = 59;
-objectTypeNamesList [getTypeName <ExecuteComputation> ()] = 60;
-objectTypeNamesList [getTypeName <ExecuteQuery> ()] = 61;
-objectTypeNamesList [getTypeName <GenericBlock> ()] = 62;
-objectTypeNamesList [getTypeName <GetListOfNodes> ()] = 63;
-objectTypeNamesList [getTypeName <HashPartitionedJoinBuildHTJobStage> ()] = 64;
-objectTypeNamesList [getTypeName <Holder<Nothing>> ()] = 65;
-objectTypeNamesList [getTypeName <JoinMap <Nothing>> ()] = 66;
-objectTypeNamesList [getTypeName <JoinPairArray <Nothing>> ()] = 67;
-objectTypeNamesList [getTypeName <KMeansDoubleVector> ()] = 68;
-objectTypeNamesList [getTypeName <KeepGoing> ()] = 69;
-objectTypeNamesList [getTypeName <LambdaIdentifier> ()] = 70;
-objectTypeNamesList [getTypeName <ListOfNodes> ()] = 71;
-objectTypeNamesList [getTypeName <Map <Nothing>> ()] = 72;
-objectTypeNamesList [getTypeName <MyEmployee> ()] = 73;
-objectTypeNamesList [getTypeName <NodeDispatcherData> ()] = 74;
-objectTypeNamesList [getTypeName <NodeInfo> ()] = 75;
-objectTypeNamesList [getTypeName <Nothing> ()] = 76;
-objectTypeNamesList [getTypeName <Object> ()] = 77;
-objectTypeNamesList [getTypeName <OptimizedDepartmentEmployees> ()] = 78;
-objectTypeNamesList [getTypeName <OptimizedEmployee> ()] = 79;
-objectTypeNamesList [getTypeName <OptimizedSupervisor> ()] = 80;
-objectTypeNamesList [getTypeName <PairArray <Nothing>> ()] = 81;
-objectTypeNamesList [getTypeName <PlaceOfQueryPlanner> ()] = 82;
-objectTypeNamesList [getTypeName <QueriesAndPlan> ()] = 83;
-objectTypeNamesList [getTypeName <QueryDone> ()] = 84;
-objectTypeNamesList [getTypeName <QueryOutput <Nothing>> ()] = 85;
-objectTypeNamesList [getTypeName <QueryPermit> ()] = 86;
-objectTypeNamesList [getTypeName <QueryPermitResponse> ()] = 87;
-objectTypeNamesList [getTypeName <RequestResources> ()] = 88;
-objectTypeNamesList [getTypeName <ResourceInfo> ()] = 89;
-objectTypeNamesList [getTypeName <ScanDoubleVectorSet> ()] = 90;
-objectTypeNamesList [getTypeName <ScanUserSet <Nothing>> ()] = 91;
-objectTypeNamesList [getTypeName <Set <Nothing>> ()] = 92;
-objectTypeNamesList [getTypeName <SetIdentifier> ()] = 93;
-objectTypeNamesList [getTypeName <SetScan> ()] = 94;
-objectTypeNamesList [getTypeName <ShutDown> ()] = 95;
-objectTypeNamesList [getTypeName <SimpleRequestResult> ()] = 96;
-objectTypeNamesList [getTypeName <StorageAddData> ()] = 97;
-objectTypeNamesList [getTypeName <StorageAddDatabase> ()] = 98;
-objectTypeNamesList [getTypeName <StorageAddObject> ()] = 99;
-objectTypeNamesList [getTypeName <StorageAddObjectInLoop> ()] = 100;
-objectTypeNamesList [getTypeName <StorageAddSet> ()] = 101;
-objectTypeNamesList [getTypeName <StorageAddTempSet> ()] = 102;
-objectTypeNamesList [getTypeName <StorageAddTempSetResult> ()] = 103;
-objectTypeNamesList [getTypeName <StorageAddType> ()] = 104;
-objectTypeNamesList [getTypeName <StorageBytesPinned> ()] = 105;
-objectTypeNamesList [getTypeName <StorageCleanup> ()] = 106;
-objectTypeNamesList [getTypeName <StorageClearSet> ()] = 107;
-objectTypeNamesList [getTypeName <StorageCollectStats> ()] = 108;
-objectTypeNamesList [getTypeName <StorageCollectStatsResponse> ()] = 109;
-objectTypeNamesList [getTypeName <StorageExportSet> ()] = 110;
-objectTypeNamesList [getTypeName <StorageGetData> ()] = 111;
-objectTypeNamesList [getTypeName <StorageGetDataResponse> ()] = 112;
-objectTypeNamesList [getTypeName <StorageGetSetPages> ()] = 113;
-objectTypeNamesList [getTypeName <StorageGetStats> ()] = 114;
-objectTypeNamesList [getTypeName <StorageNoMorePage> ()] = 115;
-objectTypeNamesList [getTypeName <StoragePagePinned> ()] = 116;
-objectTypeNamesList [getTypeName <StoragePinBytes> ()] = 117;
-objectTypeNamesList [getTypeName <StoragePinPage> ()] = 118;
-objectTypeNamesList [getTypeName <StorageRemoveDatabase> ()] = 119;
-objectTypeNamesList [getTypeName <StorageRemoveHashSet> ()] = 120;
-objectTypeNamesList [getTypeName <StorageRemoveTempSet> ()] = 121;
-objectTypeNamesList [getTypeName <StorageRemoveUserSet> ()] = 122;
-objectTypeNamesList [getTypeName <StorageTestSetCopy> ()] = 123;
-objectTypeNamesList [getTypeName <StorageTestSetScan> ()] = 124;
-objectTypeNamesList [getTypeName <StorageUnpinPage> ()] = 125;
-objectTypeNamesList [getTypeName <StringIntPair> ()] = 126;
-objectTypeNamesList [getTypeName <SumResult> ()] = 127;
-objectTypeNamesList [getTypeName <Supervisor> ()] = 128;
-objectTypeNamesList [getTypeName <TopKQueue <Nothing>> ()] = 129;
-objectTypeNamesList [getTypeName <TupleSetExecuteQuery> ()] = 130;
-objectTypeNamesList [getTypeName <TupleSetJobStage> ()] = 131;
-objectTypeNamesList [getTypeName <Vector <Nothing>> ()] = 132;
-objectTypeNamesList [getTypeName <WriteUserSet <Nothing>> ()] = 133;
-objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
+objectTypeNamesList [getTypeName <BackendPing> ()] = 10;
+objectTypeNamesList [getTypeName <BackendTestSetCopy> ()] = 11;
+objectTypeNamesList [getTypeName <BackendTestSetScan> ()] = 12;
+objectTypeNamesList [getTypeName <BaseQuery> ()] = 13;
+objectTypeNamesList [getTypeName <BroadcastJoinBuildHTJobStage> ()] = 14;
+objectTypeNamesList [getTypeName <BuiltinPartialResult> ()] = 15;
+objectTypeNamesList [getTypeName <CatCreateDatabaseRequest> ()] = 16;
+objectTypeNamesList [getTypeName <CatCreateSetRequest> ()] = 17;
+objectTypeNamesList [getTypeName <CatDeleteDatabaseRequest> ()] = 18;
+objectTypeNamesList [getTypeName <CatDeleteSetRequest> ()] = 19;
+objectTypeNamesList [getTypeName <CatGetDatabaseRequest> ()] = 20;
+objectTypeNamesList [getTypeName <CatGetDatabaseResult> ()] = 21;
+objectTypeNamesList [getTypeName <CatGetSetRequest> ()] = 22;
+objectTypeNamesList [getTypeName <CatGetSetResult> ()] = 23;
+objectTypeNamesList [getTypeName <CatGetType> ()] = 24;
+objectTypeNamesList [getTypeName <CatGetTypeResult> ()] = 25;
+objectTypeNamesList [getTypeName <CatPrintCatalogRequest> ()] = 26;
+objectTypeNamesList [getTypeName <CatPrintCatalogResult> ()] = 27;
+objectTypeNamesList [getTypeName <CatRegisterType> ()] = 28;
+objectTypeNamesList [getTypeName <CatSetObjectTypeRequest> ()] = 29;
+objectTypeNamesList [getTypeName <CatSetPartitioningRequest> ()] = 30;
+objectTypeNamesList [getTypeName <CatSharedLibraryByNameRequest> ()] = 31;
+objectTypeNamesList [getTypeName <CatSharedLibraryResult> ()] = 32;
+objectTypeNamesList [getTypeName <CatSyncRequest> ()] = 33;
+objectTypeNamesList [getTypeName <CatSyncResult> ()] = 34;
+objectTypeNamesList [getTypeName <CatTypeNameSearchResult> ()] = 35;
+objectTypeNamesList [getTypeName <CatalogUserTypeMetadata> ()] = 36;
+objectTypeNamesList [getTypeName <CloseConnection> ()] = 37;
+objectTypeNamesList [getTypeName <ComputePlan> ()] = 38;
+objectTypeNamesList [getTypeName <Count> ()] = 39;
+objectTypeNamesList [getTypeName <DeleteSet> ()] = 40;
+objectTypeNamesList [getTypeName <DepartmentEmployeeAges> ()] = 41;
+objectTypeNamesList [getTypeName <DepartmentEmployees> ()] = 42;
+objectTypeNamesList [getTypeName <DepartmentTotal> ()] = 43;
+objectTypeNamesList [getTypeName <DispatcherAddData> ()] = 44;
+objectTypeNamesList [getTypeName <DispatcherRegisterPartitionPolicy> ()] = 45;
+objectTypeNamesList [getTypeName <DistributedStorageAddDatabase> ()] = 46;
+objectTypeNamesList [getTypeName <DistributedStorageAddSet> ()] = 47;
+objectTypeNamesList [getTypeName <DistributedStorageAddSetWithPartition> ()] = 48;
+objectTypeNamesList [getTypeName <DistributedStorageAddTempSet> ()] = 49;
+objectTypeNamesList [getTypeName <DistributedStorageCleanup> ()] = 50;
+objectTypeNamesList [getTypeName <DistributedStorageClearSet> ()] = 51;
+objectTypeNamesList [getTypeName <DistributedStorageExportSet> ()] = 52;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveDatabase> ()] = 53;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveHashSet> ()] = 54;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveSet> ()] = 55;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveTempSet> ()] = 56;
+objectTypeNamesList [getTypeName <DoneWithResult> ()] = 57;
+objectTypeNamesList [getTypeName <DoubleSumResult> ()] = 58;
+objectTypeNamesList [getTypeName <DoubleVector> ()] = 59;
+objectTypeNamesList [getTypeName <DoubleVectorResult> ()] = 60;
+objectTypeNamesList [getTypeName <Employee> ()] = 61;
+objectTypeNamesList [getTypeName <ExecuteComputation> ()] = 62;
+objectTypeNamesList [getTypeName <ExecuteQuery> ()] = 63;
+objectTypeNamesList [getTypeName <GenericBlock> ()] = 64;
+objectTypeNamesList [getTypeName <GetListOfNodes> ()] = 65;
+objectTypeNamesList [getTypeName <HashPartitionedJoinBuildHTJobStage> ()] = 66;
+objectTypeNamesList [getTypeName <Holder<Nothing>> ()] = 67;
+objectTypeNamesList [getTypeName <JoinMap <Nothing>> ()] = 68;
+objectTypeNamesList [getTypeName <JoinPairArray <Nothing>> ()] = 69;
+objectTypeNamesList [getTypeName <KMeansDoubleVector> ()] = 70;
+objectTypeNamesList [getTypeName <KeepGoing> ()] = 71;
+objectTypeNamesList [getTypeName <LambdaIdentifier> ()] = 72;
+objectTypeNamesList [getTypeName <ListOfNodes> ()] = 73;
+objectTypeNamesList [getTypeName <Map <Nothing>> ()] = 74;
+objectTypeNamesList [getTypeName <MyEmployee> ()] = 75;
+objectTypeNamesList [getTypeName <NodeDispatcherData> ()] = 76;
+objectTypeNamesList [getTypeName <NodeInfo> ()] = 77;
+objectTypeNamesList [getTypeName <Nothing> ()] = 78;
+objectTypeNamesList [getTypeName <Object> ()] = 79;
+objectTypeNamesList [getTypeName <OptimizedDepartmentEmployees> ()] = 80;
+objectTypeNamesList [getTypeName <OptimizedEmployee> ()] = 81;
+objectTypeNamesList [getTypeName <OptimizedSupervisor> ()] = 82;
+objectTypeNamesList [getTypeName <PairArray <Nothing>> ()] = 83;
+objectTypeNamesList [getTypeName <PlaceOfQueryPlanner> ()] = 84;
+objectTypeNamesList [getTypeName <QueriesAndPlan> ()] = 85;
+objectTypeNamesList [getTypeName <QueryDone> ()] = 86;
+objectTypeNamesList [getTypeName <QueryOutput <Nothing>> ()] = 87;
+objectTypeNamesList [getTypeName <QueryPermit> ()] = 88;
+objectTypeNamesList [getTypeName <QueryPermitResponse> ()] = 89;
+objectTypeNamesList [getTypeName <RequestResources> ()] = 90;
+objectTypeNamesList [getTypeName <ResourceInfo> ()] = 91;
+objectTypeNamesList [getTypeName <ScanDoubleVectorSet> ()] = 92;
+objectTypeNamesList [getTypeName <ScanUserSet <Nothing>> ()] = 93;
+objectTypeNamesList [getTypeName <Set <Nothing>> ()] = 94;
+objectTypeNamesList [getTypeName <SetIdentifier> ()] = 95;
+objectTypeNamesList [getTypeName <SetScan> ()] = 96;
+objectTypeNamesList [getTypeName <ShutDown> ()] = 97;
+objectTypeNamesList [getTypeName <SimpleRequestResult> ()] = 98;
+objectTypeNamesList [getTypeName <StorageAddData> ()] = 99;
+objectTypeNamesList [getTypeName <StorageAddDatabase> ()] = 100;
+objectTypeNamesList [getTypeName <StorageAddObject> ()] = 101;
+objectTypeNamesList [getTypeName <StorageAddObjectInLoop> ()] = 102;
+objectTypeNamesList [getTypeName <StorageAddSet> ()] = 103;
+objectTypeNamesList [getTypeName <StorageAddTempSet> ()] = 104;
+objectTypeNamesList [getTypeName <StorageAddTempSetResult> ()] = 105;
+objectTypeNamesList [getTypeName <StorageAddType> ()] = 106;
+objectTypeNamesList [getTypeName <StorageBytesPinned> ()] = 107;
+objectTypeNamesList [getTypeName <StorageCleanup> ()] = 108;
+objectTypeNamesList [getTypeName <StorageClearSet> ()] = 109;
+objectTypeNamesList [getTypeName <StorageCollectStats> ()] = 110;
+objectTypeNamesList [getTypeName <StorageCollectStatsResponse> ()] = 111;
+objectTypeNamesList [getTypeName <StorageExportSet> ()] = 112;
+objectTypeNamesList [getTypeName <StorageGetData> ()] = 113;
+objectTypeNamesList [getTypeName <StorageGetDataResponse> ()] = 114;
+objectTypeNamesList [getTypeName <StorageGetSetPages> ()] = 115;
+objectTypeNamesList [getTypeName <StorageGetStats> ()] = 116;
+objectTypeNamesList [getTypeName <StorageNoMorePage> ()] = 117;
+objectTypeNamesList [getTypeName <StoragePagePinned> ()] = 118;
+objectTypeNamesList [getTypeName <StoragePinBytes> ()] = 119;
+objectTypeNamesList [getTypeName <StoragePinPage> ()] = 120;
+objectTypeNamesList [getTypeName <StorageRemoveDatabase> ()] = 121;
+objectTypeNamesList [getTypeName <StorageRemoveHashSet> ()] = 122;
+objectTypeNamesList [getTypeName <StorageRemoveTempSet> ()] = 123;
+objectTypeNamesList [getTypeName <StorageRemoveUserSet> ()] = 124;
+objectTypeNamesList [getTypeName <StorageTestSetCopy> ()] = 125;
+objectTypeNamesList [getTypeName <StorageTestSetScan> ()] = 126;
+objectTypeNamesList [getTypeName <StorageUnpinPage> ()] = 127;
+objectTypeNamesList [getTypeName <StringIntPair> ()] = 128;
+objectTypeNamesList [getTypeName <SumResult> ()] = 129;
+objectTypeNamesList [getTypeName <Supervisor> ()] = 130;
+objectTypeNamesList [getTypeName <TopKQueue <Nothing>> ()] = 131;
+objectTypeNamesList [getTypeName <TupleSetExecuteQuery> ()] = 132;
+objectTypeNamesList [getTypeName <TupleSetJobStage> ()] = 133;
+objectTypeNamesList [getTypeName <Vector <Nothing>> ()] = 134;
+objectTypeNamesList [getTypeName <WriteUserSet <Nothing>> ()] = 135;
+objectTypeNamesList [getTypeName <ZB_Company> ()] = 136;
 
 // now, record all of the vTables
 {
@@ -208,8 +210,18 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 {
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
-		BackendTestSetCopy tempObject;
+		BackendPing tempObject;
 		allVTables [10] = tempObject.getVTablePtr ();
+	} catch (NotEnoughSpace &e) {
+		std :: cout << "Not enough memory to allocate BackendPing to extract the vTable.\n";
+	}
+}
+
+{
+	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
+	try {
+		BackendTestSetCopy tempObject;
+		allVTables [11] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate BackendTestSetCopy to extract the vTable.\n";
 	}
@@ -219,7 +231,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		BackendTestSetScan tempObject;
-		allVTables [11] = tempObject.getVTablePtr ();
+		allVTables [12] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate BackendTestSetScan to extract the vTable.\n";
 	}
@@ -229,7 +241,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		BaseQuery tempObject;
-		allVTables [12] = tempObject.getVTablePtr ();
+		allVTables [13] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate BaseQuery to extract the vTable.\n";
 	}
@@ -239,7 +251,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		BroadcastJoinBuildHTJobStage tempObject;
-		allVTables [13] = tempObject.getVTablePtr ();
+		allVTables [14] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate BroadcastJoinBuildHTJobStage to extract the vTable.\n";
 	}
@@ -249,7 +261,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		BuiltinPartialResult tempObject;
-		allVTables [14] = tempObject.getVTablePtr ();
+		allVTables [15] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate BuiltinPartialResult to extract the vTable.\n";
 	}
@@ -259,7 +271,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatCreateDatabaseRequest tempObject;
-		allVTables [15] = tempObject.getVTablePtr ();
+		allVTables [16] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatCreateDatabaseRequest to extract the vTable.\n";
 	}
@@ -269,7 +281,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatCreateSetRequest tempObject;
-		allVTables [16] = tempObject.getVTablePtr ();
+		allVTables [17] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatCreateSetRequest to extract the vTable.\n";
 	}
@@ -279,7 +291,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatDeleteDatabaseRequest tempObject;
-		allVTables [17] = tempObject.getVTablePtr ();
+		allVTables [18] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatDeleteDatabaseRequest to extract the vTable.\n";
 	}
@@ -289,7 +301,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatDeleteSetRequest tempObject;
-		allVTables [18] = tempObject.getVTablePtr ();
+		allVTables [19] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatDeleteSetRequest to extract the vTable.\n";
 	}
@@ -299,7 +311,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatGetDatabaseRequest tempObject;
-		allVTables [19] = tempObject.getVTablePtr ();
+		allVTables [20] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatGetDatabaseRequest to extract the vTable.\n";
 	}
@@ -309,7 +321,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatGetDatabaseResult tempObject;
-		allVTables [20] = tempObject.getVTablePtr ();
+		allVTables [21] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatGetDatabaseResult to extract the vTable.\n";
 	}
@@ -319,7 +331,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatGetSetRequest tempObject;
-		allVTables [21] = tempObject.getVTablePtr ();
+		allVTables [22] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatGetSetRequest to extract the vTable.\n";
 	}
@@ -329,7 +341,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatGetSetResult tempObject;
-		allVTables [22] = tempObject.getVTablePtr ();
+		allVTables [23] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatGetSetResult to extract the vTable.\n";
 	}
@@ -339,7 +351,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatGetType tempObject;
-		allVTables [23] = tempObject.getVTablePtr ();
+		allVTables [24] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatGetType to extract the vTable.\n";
 	}
@@ -349,7 +361,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatGetTypeResult tempObject;
-		allVTables [24] = tempObject.getVTablePtr ();
+		allVTables [25] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatGetTypeResult to extract the vTable.\n";
 	}
@@ -359,7 +371,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatPrintCatalogRequest tempObject;
-		allVTables [25] = tempObject.getVTablePtr ();
+		allVTables [26] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatPrintCatalogRequest to extract the vTable.\n";
 	}
@@ -369,7 +381,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatPrintCatalogResult tempObject;
-		allVTables [26] = tempObject.getVTablePtr ();
+		allVTables [27] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatPrintCatalogResult to extract the vTable.\n";
 	}
@@ -379,7 +391,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatRegisterType tempObject;
-		allVTables [27] = tempObject.getVTablePtr ();
+		allVTables [28] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatRegisterType to extract the vTable.\n";
 	}
@@ -389,17 +401,27 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatSetObjectTypeRequest tempObject;
-		allVTables [28] = tempObject.getVTablePtr ();
+		allVTables [29] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatSetObjectTypeRequest to extract the vTable.\n";
 	}
 }
 
+{
+	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
+	try {
+		CatSetPartitioningRequest tempObject;
+		allVTables [30] = tempObject.getVTablePtr ();
+	} catch (NotEnoughSpace &e) {
+		std :: cout << "Not enough memory to allocate CatSetPartitioningRequest to extract the vTable.\n";
+	}
+}
+
 {
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatSharedLibraryByNameRequest tempObject;
-		allVTables [29] = tempObject.getVTablePtr ();
+		allVTables [31] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatSharedLibraryByNameRequest to extract the vTable.\n";
 	}
@@ -409,7 +431,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatSharedLibraryResult tempObject;
-		allVTables [30] = tempObject.getVTablePtr ();
+		allVTables [32] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatSharedLibraryResult to extract the vTable.\n";
 	}
@@ -419,7 +441,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatSyncRequest tempObject;
-		allVTables [31] = tempObject.getVTablePtr ();
+		allVTables [33] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatSyncRequest to extract the vTable.\n";
 	}
@@ -429,7 +451,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatSyncResult tempObject;
-		allVTables [32] = tempObject.getVTablePtr ();
+		allVTables [34] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatSyncResult to extract the vTable.\n";
 	}
@@ -439,7 +461,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatTypeNameSearchResult tempObject;
-		allVTables [33] = tempObject.getVTablePtr ();
+		allVTables [35] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatTypeNameSearchResult to extract the vTable.\n";
 	}
@@ -449,7 +471,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CatalogUserTypeMetadata tempObject;
-		allVTables [34] = tempObject.getVTablePtr ();
+		allVTables [36] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CatalogUserTypeMetadata to extract the vTable.\n";
 	}
@@ -459,7 +481,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		CloseConnection tempObject;
-		allVTables [35] = tempObject.getVTablePtr ();
+		allVTables [37] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate CloseConnection to extract the vTable.\n";
 	}
@@ -469,7 +491,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ComputePlan tempObject;
-		allVTables [36] = tempObject.getVTablePtr ();
+		allVTables [38] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ComputePlan to extract the vTable.\n";
 	}
@@ -479,7 +501,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Count tempObject;
-		allVTables [37] = tempObject.getVTablePtr ();
+		allVTables [39] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Count to extract the vTable.\n";
 	}
@@ -489,7 +511,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DeleteSet tempObject;
-		allVTables [38] = tempObject.getVTablePtr ();
+		allVTables [40] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DeleteSet to extract the vTable.\n";
 	}
@@ -499,7 +521,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DepartmentEmployeeAges tempObject;
-		allVTables [39] = tempObject.getVTablePtr ();
+		allVTables [41] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DepartmentEmployeeAges to extract the vTable.\n";
 	}
@@ -509,7 +531,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DepartmentEmployees tempObject;
-		allVTables [40] = tempObject.getVTablePtr ();
+		allVTables [42] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DepartmentEmployees to extract the vTable.\n";
 	}
@@ -519,7 +541,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DepartmentTotal tempObject;
-		allVTables [41] = tempObject.getVTablePtr ();
+		allVTables [43] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DepartmentTotal to extract the vTable.\n";
 	}
@@ -529,7 +551,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DispatcherAddData tempObject;
-		allVTables [42] = tempObject.getVTablePtr ();
+		allVTables [44] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DispatcherAddData to extract the vTable.\n";
 	}
@@ -539,7 +561,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DispatcherRegisterPartitionPolicy tempObject;
-		allVTables [43] = tempObject.getVTablePtr ();
+		allVTables [45] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DispatcherRegisterPartitionPolicy to extract the vTable.\n";
 	}
@@ -549,7 +571,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageAddDatabase tempObject;
-		allVTables [44] = tempObject.getVTablePtr ();
+		allVTables [46] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageAddDatabase to extract the vTable.\n";
 	}
@@ -559,7 +581,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageAddSet tempObject;
-		allVTables [45] = tempObject.getVTablePtr ();
+		allVTables [47] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageAddSet to extract the vTable.\n";
 	}
@@ -569,7 +591,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageAddSetWithPartition tempObject;
-		allVTables [46] = tempObject.getVTablePtr ();
+		allVTables [48] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageAddSetWithPartition to extract the vTable.\n";
 	}
@@ -579,7 +601,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageAddTempSet tempObject;
-		allVTables [47] = tempObject.getVTablePtr ();
+		allVTables [49] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageAddTempSet to extract the vTable.\n";
 	}
@@ -589,7 +611,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageCleanup tempObject;
-		allVTables [48] = tempObject.getVTablePtr ();
+		allVTables [50] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageCleanup to extract the vTable.\n";
 	}
@@ -599,7 +621,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageClearSet tempObject;
-		allVTables [49] = tempObject.getVTablePtr ();
+		allVTables [51] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageClearSet to extract the vTable.\n";
 	}
@@ -609,7 +631,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageExportSet tempObject;
-		allVTables [50] = tempObject.getVTablePtr ();
+		allVTables [52] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageExportSet to extract the vTable.\n";
 	}
@@ -619,7 +641,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveDatabase tempObject;
-		allVTables [51] = tempObject.getVTablePtr ();
+		allVTables [53] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveDatabase to extract the vTable.\n";
 	}
@@ -629,7 +651,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveHashSet tempObject;
-		allVTables [52] = tempObject.getVTablePtr ();
+		allVTables [54] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveHashSet to extract the vTable.\n";
 	}
@@ -639,7 +661,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveSet tempObject;
-		allVTables [53] = tempObject.getVTablePtr ();
+		allVTables [55] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveSet to extract the vTable.\n";
 	}
@@ -649,7 +671,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveTempSet tempObject;
-		allVTables [54] = tempObject.getVTablePtr ();
+		allVTables [56] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveTempSet to extract the vTable.\n";
 	}
@@ -659,7 +681,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoneWithResult tempObject;
-		allVTables [55] = tempObject.getVTablePtr ();
+		allVTables [57] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoneWithResult to extract the vTable.\n";
 	}
@@ -669,7 +691,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoubleSumResult tempObject;
-		allVTables [56] = tempObject.getVTablePtr ();
+		allVTables [58] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoubleSumResult to extract the vTable.\n";
 	}
@@ -679,7 +701,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoubleVector tempObject;
-		allVTables [57] = tempObject.getVTablePtr ();
+		allVTables [59] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoubleVector to extract the vTable.\n";
 	}
@@ -689,7 +711,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoubleVectorResult tempObject;
-		allVTables [58] = tempObject.getVTablePtr ();
+		allVTables [60] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoubleVectorResult to extract the vTable.\n";
 	}
@@ -699,7 +721,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Employee tempObject;
-		allVTables [59] = tempObject.getVTablePtr ();
+		allVTables [61] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Employee to extract the vTable.\n";
 	}
@@ -709,7 +731,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ExecuteComputation tempObject;
-		allVTables [60] = tempObject.getVTablePtr ();
+		allVTables [62] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ExecuteComputation to extract the vTable.\n";
 	}
@@ -719,7 +741,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ExecuteQuery tempObject;
-		allVTables [61] = tempObject.getVTablePtr ();
+		allVTables [63] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ExecuteQuery to extract the vTable.\n";
 	}
@@ -729,7 +751,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		GenericBlock tempObject;
-		allVTables [62] = tempObject.getVTablePtr ();
+		allVTables [64] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate GenericBlock to extract the vTable.\n";
 	}
@@ -739,7 +761,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		GetListOfNodes tempObject;
-		allVTables [63] = tempObject.getVTablePtr ();
+		allVTables [65] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate GetListOfNodes to extract the vTable.\n";
 	}
@@ -749,7 +771,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		HashPartitionedJoinBuildHTJobStage tempObject;
-		allVTables [64] = tempObject.getVTablePtr ();
+		allVTables [66] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate HashPartitionedJoinBuildHTJobStage to extract the vTable.\n";
 	}
@@ -759,7 +781,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Holder<Nothing> tempObject;
-		allVTables [65] = tempObject.getVTablePtr ();
+		allVTables [67] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Holder<Nothing> to extract the vTable.\n";
 	}
@@ -769,7 +791,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		JoinMap <Nothing> tempObject;
-		allVTables [66] = tempObject.getVTablePtr ();
+		allVTables [68] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate JoinMap <Nothing> to extract the vTable.\n";
 	}
@@ -779,7 +801,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		JoinPairArray <Nothing> tempObject;
-		allVTables [67] = tempObject.getVTablePtr ();
+		allVTables [69] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate JoinPairArray <Nothing> to extract the vTable.\n";
 	}
@@ -789,7 +811,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		KMeansDoubleVector tempObject;
-		allVTables [68] = tempObject.getVTablePtr ();
+		allVTables [70] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate KMeansDoubleVector to extract the vTable.\n";
 	}
@@ -799,7 +821,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		KeepGoing tempObject;
-		allVTables [69] = tempObject.getVTablePtr ();
+		allVTables [71] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate KeepGoing to extract the vTable.\n";
 	}
@@ -809,7 +831,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		LambdaIdentifier tempObject;
-		allVTables [70] = tempObject.getVTablePtr ();
+		allVTables [72] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate LambdaIdentifier to extract the vTable.\n";
 	}
@@ -819,7 +841,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ListOfNodes tempObject;
-		allVTables [71] = tempObject.getVTablePtr ();
+		allVTables [73] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ListOfNodes to extract the vTable.\n";
 	}
@@ -829,7 +851,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Map <Nothing> tempObject;
-		allVTables [72] = tempObject.getVTablePtr ();
+		allVTables [74] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Map <Nothing> to extract the vTable.\n";
 	}
@@ -839,7 +861,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		MyEmployee tempObject;
-		allVTables [73] = tempObject.getVTablePtr ();
+		allVTables [75] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate MyEmployee to extract the vTable.\n";
 	}
@@ -849,7 +871,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		NodeDispatcherData tempObject;
-		allVTables [74] = tempObject.getVTablePtr ();
+		allVTables [76] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate NodeDispatcherData to extract the vTable.\n";
 	}
@@ -859,7 +881,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		NodeInfo tempObject;
-		allVTables [75] = tempObject.getVTablePtr ();
+		allVTables [77] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate NodeInfo to extract the vTable.\n";
 	}
@@ -869,7 +891,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Nothing tempObject;
-		allVTables [76] = tempObject.getVTablePtr ();
+		allVTables [78] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Nothing to extract the vTable.\n";
 	}
@@ -879,7 +901,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Object tempObject;
-		allVTables [77] = tempObject.getVTablePtr ();
+		allVTables [79] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Object to extract the vTable.\n";
 	}
@@ -889,7 +911,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		OptimizedDepartmentEmployees tempObject;
-		allVTables [78] = tempObject.getVTablePtr ();
+		allVTables [80] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate OptimizedDepartmentEmployees to extract the vTable.\n";
 	}
@@ -899,7 +921,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		OptimizedEmployee tempObject;
-		allVTables [79] = tempObject.getVTablePtr ();
+		allVTables [81] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate OptimizedEmployee to extract the vTable.\n";
 	}
@@ -909,7 +931,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		OptimizedSupervisor tempObject;
-		allVTables [80] = tempObject.getVTablePtr ();
+		allVTables [82] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate OptimizedSupervisor to extract the vTable.\n";
 	}
@@ -919,7 +941,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		PairArray <Nothing> tempObject;
-		allVTables [81] = tempObject.getVTablePtr ();
+		allVTables [83] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate PairArray <Nothing> to extract the vTable.\n";
 	}
@@ -929,7 +951,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		PlaceOfQueryPlanner tempObject;
-		allVTables [82] = tempObject.getVTablePtr ();
+		allVTables [84] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate PlaceOfQueryPlanner to extract the vTable.\n";
 	}
@@ -939,7 +961,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueriesAndPlan tempObject;
-		allVTables [83] = tempObject.getVTablePtr ();
+		allVTables [85] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueriesAndPlan to extract the vTable.\n";
 	}
@@ -949,7 +971,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryDone tempObject;
-		allVTables [84] = tempObject.getVTablePtr ();
+		allVTables [86] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryDone to extract the vTable.\n";
 	}
@@ -959,7 +981,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryOutput <Nothing> tempObject;
-		allVTables [85] = tempObject.getVTablePtr ();
+		allVTables [87] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryOutput <Nothing> to extract the vTable.\n";
 	}
@@ -969,7 +991,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryPermit tempObject;
-		allVTables [86] = tempObject.getVTablePtr ();
+		allVTables [88] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryPermit to extract the vTable.\n";
 	}
@@ -979,7 +1001,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryPermitResponse tempObject;
-		allVTables [87] = tempObject.getVTablePtr ();
+		allVTables [89] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryPermitResponse to extract the vTable.\n";
 	}
@@ -989,7 +1011,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		RequestResources tempObject;
-		allVTables [88] = tempObject.getVTablePtr ();
+		allVTables [90] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate RequestResources to extract the vTable.\n";
 	}
@@ -999,7 +1021,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ResourceInfo tempObject;
-		allVTables [89] = tempObject.getVTablePtr ();
+		allVTables [91] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ResourceInfo to extract the vTable.\n";
 	}
@@ -1009,7 +1031,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ScanDoubleVectorSet tempObject;
-		allVTables [90] = tempObject.getVTablePtr ();
+		allVTables [92] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ScanDoubleVectorSet to extract the vTable.\n";
 	}
@@ -1019,7 +1041,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ScanUserSet <Nothing> tempObject;
-		allVTables [91] = tempObject.getVTablePtr ();
+		allVTables [93] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ScanUserSet <Nothing> to extract the vTable.\n";
 	}
@@ -1029,7 +1051,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Set <Nothing> tempObject;
-		allVTables [92] = tempObject.getVTablePtr ();
+		allVTables [94] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Set <Nothing> to extract the vTable.\n";
 	}
@@ -1039,7 +1061,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SetIdentifier tempObject;
-		allVTables [93] = tempObject.getVTablePtr ();
+		allVTables [95] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SetIdentifier to extract the vTable.\n";
 	}
@@ -1049,7 +1071,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SetScan tempObject;
-		allVTables [94] = tempObject.getVTablePtr ();
+		allVTables [96] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SetScan to extract the vTable.\n";
 	}
@@ -1059,7 +1081,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ShutDown tempObject;
-		allVTables [95] = tempObject.getVTablePtr ();
+		allVTables [97] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ShutDown to extract the vTable.\n";
 	}
@@ -1069,7 +1091,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SimpleRequestResult tempObject;
-		allVTables [96] = tempObject.getVTablePtr ();
+		allVTables [98] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SimpleRequestResult to extract the vTable.\n";
 	}
@@ -1079,7 +1101,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddData tempObject;
-		allVTables [97] = tempObject.getVTablePtr ();
+		allVTables [99] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddData to extract the vTable.\n";
 	}
@@ -1089,7 +1111,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddDatabase tempObject;
-		allVTables [98] = tempObject.getVTablePtr ();
+		allVTables [100] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddDatabase to extract the vTable.\n";
 	}
@@ -1099,7 +1121,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddObject tempObject;
-		allVTables [99] = tempObject.getVTablePtr ();
+		allVTables [101] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddObject to extract the vTable.\n";
 	}
@@ -1109,7 +1131,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddObjectInLoop tempObject;
-		allVTables [100] = tempObject.getVTablePtr ();
+		allVTables [102] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddObjectInLoop to extract the vTable.\n";
 	}
@@ -1119,7 +1141,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddSet tempObject;
-		allVTables [101] = tempObject.getVTablePtr ();
+		allVTables [103] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddSet to extract the vTable.\n";
 	}
@@ -1129,7 +1151,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddTempSet tempObject;
-		allVTables [102] = tempObject.getVTablePtr ();
+		allVTables [104] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddTempSet to extract the vTable.\n";
 	}
@@ -1139,7 +1161,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddTempSetResult tempObject;
-		allVTables [103] = tempObject.getVTablePtr ();
+		allVTables [105] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddTempSetResult to extract the vTable.\n";
 	}
@@ -1149,7 +1171,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddType tempObject;
-		allVTables [104] = tempObject.getVTablePtr ();
+		allVTables [106] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddType to extract the vTable.\n";
 	}
@@ -1159,7 +1181,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageBytesPinned tempObject;
-		allVTables [105] = tempObject.getVTablePtr ();
+		allVTables [107] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageBytesPinned to extract the vTable.\n";
 	}
@@ -1169,7 +1191,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageCleanup tempObject;
-		allVTables [106] = tempObject.getVTablePtr ();
+		allVTables [108] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageCleanup to extract the vTable.\n";
 	}
@@ -1179,7 +1201,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageClearSet tempObject;
-		allVTables [107] = tempObject.getVTablePtr ();
+		allVTables [109] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageClearSet to extract the vTable.\n";
 	}
@@ -1189,7 +1211,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageCollectStats tempObject;
-		allVTables [108] = tempObject.getVTablePtr ();
+		allVTables [110] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageCollectStats to extract the vTable.\n";
 	}
@@ -1199,7 +1221,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageCollectStatsResponse tempObject;
-		allVTables [109] = tempObject.getVTablePtr ();
+		allVTables [111] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageCollectStatsResponse to extract the vTable.\n";
 	}
@@ -1209,7 +1231,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageExportSet tempObject;
-		allVTables [110] = tempObject.getVTablePtr ();
+		allVTables [112] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageExportSet to extract the vTable.\n";
 	}
@@ -1219,7 +1241,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetData tempObject;
-		allVTables [111] = tempObject.getVTablePtr ();
+		allVTables [113] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetData to extract the vTable.\n";
 	}
@@ -1229,7 +1251,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetDataResponse tempObject;
-		allVTables [112] = tempObject.getVTablePtr ();
+		allVTables [114] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetDataResponse to extract the vTable.\n";
 	}
@@ -1239,7 +1261,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetSetPages tempObject;
-		allVTables [113] = tempObject.getVTablePtr ();
+		allVTables [115] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetSetPages to extract the vTable.\n";
 	}
@@ -1249,7 +1271,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetStats tempObject;
-		allVTables [114] = tempObject.getVTablePtr ();
+		allVTables [116] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetStats to extract the vTable.\n";
 	}
@@ -1259,7 +1281,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageNoMorePage tempObject;
-		allVTables [115] = tempObject.getVTablePtr ();
+		allVTables [117] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageNoMorePage to extract the vTable.\n";
 	}
@@ -1269,7 +1291,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StoragePagePinned tempObject;
-		allVTables [116] = tempObject.getVTablePtr ();
+		allVTables [118] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StoragePagePinned to extract the vTable.\n";
 	}
@@ -1279,7 +1301,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StoragePinBytes tempObject;
-		allVTables [117] = tempObject.getVTablePtr ();
+		allVTables [119] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StoragePinBytes to extract the vTable.\n";
 	}
@@ -1289,7 +1311,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StoragePinPage tempObject;
-		allVTables [118] = tempObject.getVTablePtr ();
+		allVTables [120] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StoragePinPage to extract the vTable.\n";
 	}
@@ -1299,7 +1321,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveDatabase tempObject;
-		allVTables [119] = tempObject.getVTablePtr ();
+		allVTables [121] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveDatabase to extract the vTable.\n";
 	}
@@ -1309,7 +1331,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveHashSet tempObject;
-		allVTables [120] = tempObject.getVTablePtr ();
+		allVTables [122] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveHashSet to extract the vTable.\n";
 	}
@@ -1319,7 +1341,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveTempSet tempObject;
-		allVTables [121] = tempObject.getVTablePtr ();
+		allVTables [123] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveTempSet to extract the vTable.\n";
 	}
@@ -1329,7 +1351,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveUserSet tempObject;
-		allVTables [122] = tempObject.getVTablePtr ();
+		allVTables [124] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveUserSet to extract the vTable.\n";
 	}
@@ -1339,7 +1361,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageTestSetCopy tempObject;
-		allVTables [123] = tempObject.getVTablePtr ();
+		allVTables [125] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageTestSetCopy to extract the vTable.\n";
 	}
@@ -1349,7 +1371,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageTestSetScan tempObject;
-		allVTables [124] = tempObject.getVTablePtr ();
+		allVTables [126] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageTestSetScan to extract the vTable.\n";
 	}
@@ -1359,7 +1381,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageUnpinPage tempObject;
-		allVTables [125] = tempObject.getVTablePtr ();
+		allVTables [127] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageUnpinPage to extract the vTable.\n";
 	}
@@ -1369,7 +1391,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StringIntPair tempObject;
-		allVTables [126] = tempObject.getVTablePtr ();
+		allVTables [128] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StringIntPair to extract the vTable.\n";
 	}
@@ -1379,7 +1401,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SumResult tempObject;
-		allVTables [127] = tempObject.getVTablePtr ();
+		allVTables [129] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SumResult to extract the vTable.\n";
 	}
@@ -1389,7 +1411,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Supervisor tempObject;
-		allVTables [128] = tempObject.getVTablePtr ();
+		allVTables [130] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Supervisor to extract the vTable.\n";
 	}
@@ -1399,7 +1421,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TopKQueue <Nothing> tempObject;
-		allVTables [129] = tempObject.getVTablePtr ();
+		allVTables [131] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TopKQueue <Nothing> to extract the vTable.\n";
 	}
@@ -1409,7 +1431,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TupleSetExecuteQuery tempObject;
-		allVTables [130] = tempObject.getVTablePtr ();
+		allVTables [132] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TupleSetExecuteQuery to extract the vTable.\n";
 	}
@@ -1419,7 +1441,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TupleSetJobStage tempObject;
-		allVTables [131] = tempObject.getVTablePtr ();
+		allVTables [133] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TupleSetJobStage to extract the vTable.\n";
 	}
@@ -1429,7 +1451,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Vector <Nothing> tempObject;
-		allVTables [132] = tempObject.getVTablePtr ();
+		allVTables [134] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Vector <Nothing> to extract the vTable.\n";
 	}
@@ -1439,7 +1461,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		WriteUserSet <Nothing> tempObject;
-		allVTables [133] = tempObject.getVTablePtr ();
+		allVTables [135] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate WriteUserSet <Nothing> to extract the vTable.\n";
 	}
@@ -1449,7 +1471,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 134;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ZB_Company tempObject;
-		allVTables [134] = tempObject.getVTablePtr ();
+		allVTables [136] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ZB_Company to extract the vTable.\n";
 	}
@@ -10,6 +10,7 @@
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/Supervisor.h"
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/TopKQueue.h"
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/CatSetObjectTypeRequest.h"
+#include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/CatSetPartitioningRequest.h"
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/DistributedStorageRemoveSet.h"
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/CatSyncRequest.h"
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/GenericBlock.h"
@@ -132,3 +133,4 @@
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/PDBObjectPrototype.h"
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/AggregationJobStage.h"
 #include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/NodeDispatcherData.h"
+#include "/home/ubuntu/lachesis/src/builtInPDBObjects/headers/BackendPing.h"
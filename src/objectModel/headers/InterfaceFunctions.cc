@@ -18,6 +18,7 @@
 #include "TypeName.h"
 #include "VTableMap.h"
 #include "Holder.h"
+#include "HugePages.h"
 
 namespace pdb {
 
@@ -56,6 +57,11 @@ inline void makeObjectAllocatorBlock(size_t numBytesIn, bool throwExceptionOnFai
         std::cout << "Fatal Error in makeObjectAllocatorBlock(): out of memory" << std::endl;
         exit(-1);
     }
+    // large blocks (e.g. the ones holding hash tables) are randomly accessed, so back them
+    // with huge pages to cut down TLB misses
+    if (numBytesIn >= HUGE_PAGE_ADVISE_THRESHOLD) {
+        adviseHugePages(space, numBytesIn);
+    }
     getAllocator().setupBlock(space, numBytesIn, throwExceptionOnFail);
 }
 
@@ -263,6 +263,21 @@ inline void* VTableMap::getVTablePtr(int16_t objectTypeID) {
     }
 }
 
+inline void VTableMap::preloadTypes(std::vector<std::string> typeNames) {
+    for (auto& typeName : typeNames) {
+        if (typeName == "") {
+            continue;
+        }
+        int16_t typeId = getIDByName(getInternalTypeName(typeName));
+        // built-in types are compiled in, so only user types need to be loaded
+        if (typeId > TYPE_NOT_RECOGNIZED) {
+            if (getVTablePtr(typeId) == nullptr) {
+                std::cout << "Can't preload type " << typeName << std::endl;
+            }
+        }
+    }
+}
+
 inline std::vector<std::pair<std::string, int16_t>> pdb::VTableMap::getBuiltInTypes() {
 
   // make are return value
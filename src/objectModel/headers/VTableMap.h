@@ -64,6 +64,10 @@ public:
     // look up the vtable using the given catalog
     static void* getVTablePtrUsingCatalog(int16_t objectTypeID);
 
+    // fix the vTablePtrs of the given user types now, so that the shared libraries are not
+    // loaded one by one by the threads that first use each type
+    static void preloadTypes(std::vector<std::string> typeNames);
+
     // print out the contents of the vTableMap
     static void listVtableEntries();
     static void listVtableLabels();
@@ -18,10 +18,64 @@
 #include "PDBDebug.h"
 #include "PDBLogger.h"
 #include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <sys/stat.h>
 #include "CatalogClient.h"
+#include "CatalogUserTypeMetadata.h"
+
+// shared libraries fetched from the catalog are kept in this node-local cache under the content
+// hash the catalog returns for them, so that they are fetched once per node rather than once per
+// process, and a type registered again never maps to a stale library; the files match
+// /var/tmp/*.so, so they are removed with the other shared libraries when a node is cleaned up
+#ifndef SHARED_LIBRARY_CACHE_PREFIX
+#define SHARED_LIBRARY_CACHE_PREFIX "/var/tmp/pdbSharedLibrary."
+#endif
 
 namespace pdb {
 
+// returns the path of the cached shared library with the given content hash, or an empty
+// string if no library with that content has been cached on this node
+static std::string getCachedSharedLibrary(std::string soHash) {
+    std::string contentFile = std::string(SHARED_LIBRARY_CACHE_PREFIX) + soHash + ".so";
+    struct stat st;
+    if (stat(contentFile.c_str(), &st) != 0) {
+        return "";
+    }
+    return contentFile;
+}
+
+// moves a freshly fetched shared library into the cache under the content hash the catalog
+// returned for it; returns the path of the cached file, or the fetched file itself if it can
+// not be cached, e.g. because the type was registered again after its hash was returned
+static std::string cacheSharedLibrary(std::string soHash, std::string fetchedFile) {
+    if (soHash == "") {
+        return fetchedFile;
+    }
+    std::ifstream in(fetchedFile, std::ios::in | std::ios::binary);
+    if (!in) {
+        return fetchedFile;
+    }
+    std::stringstream bytes;
+    bytes << in.rdbuf();
+    std::string content = bytes.str();
+    in.close();
+    if (CatalogUserTypeMetadata::getLibraryHash(content.data(), content.size()) != soHash) {
+        return fetchedFile;
+    }
+    std::string contentFile = std::string(SHARED_LIBRARY_CACHE_PREFIX) + soHash + ".so";
+    struct stat st;
+    if (stat(contentFile.c_str(), &st) == 0) {
+        // another process has cached the same library
+        unlink(fetchedFile.c_str());
+    } else if (rename(fetchedFile.c_str(), contentFile.c_str()) != 0) {
+        // rename is atomic, so other processes either see no file or a complete one
+        return fetchedFile;
+    }
+    return contentFile;
+}
+
 // note: this should only be called while protected by a lock on the vTableMap
 void* VTableMap::getVTablePtrUsingCatalog(int16_t objectTypeID) {
 
@@ -44,16 +98,32 @@ void* VTableMap::getVTablePtrUsingCatalog(int16_t objectTypeID) {
         return nullptr;
     }
 
-    std::string sharedLibraryFile = "/var/tmp/objectFile.";
-    sharedLibraryFile += to_string(getpid()) + "." + to_string(objectTypeID) + ".so";
-    PDB_COUT << "VTableMap:: to get sharedLibraryFile =" << sharedLibraryFile << std::endl;
-    if (theVTable->logger != nullptr) {
-        theVTable->logger->debug(std::string("VTableMap:: to get sharedLibraryFile =") +
-                                 sharedLibraryFile);
+    // first, check whether this node has already fetched the library the catalog has now
+    bool ret = true;
+    std::string errMsg;
+    std::string soHash = theVTable->catalog->getSharedLibraryHash(objectTypeID, errMsg);
+    std::string sharedLibraryFile = "";
+    if (soHash != "") {
+        sharedLibraryFile = getCachedSharedLibrary(soHash);
+    }
+    if (sharedLibraryFile != "") {
+        PDB_COUT << "VTableMap:: to use cached sharedLibraryFile =" << sharedLibraryFile
+                 << std::endl;
+    } else {
+        sharedLibraryFile = "/var/tmp/objectFile.";
+        sharedLibraryFile += to_string(getpid()) + "." + to_string(objectTypeID) + ".so";
+        PDB_COUT << "VTableMap:: to get sharedLibraryFile =" << sharedLibraryFile << std::endl;
+        if (theVTable->logger != nullptr) {
+            PDB_LOG_DEBUG(theVTable->logger, std::string("VTableMap:: to get sharedLibraryFile =") +
+                                     sharedLibraryFile);
+        }
+        unlink(sharedLibraryFile.c_str());
+        PDB_COUT << "VTableMap:: to get shared for objectTypeID=" << objectTypeID << std::endl;
+        ret = theVTable->catalog->getSharedLibrary(objectTypeID, sharedLibraryFile);
+        if (ret == true) {
+            sharedLibraryFile = cacheSharedLibrary(soHash, sharedLibraryFile);
+        }
     }
-    unlink(sharedLibraryFile.c_str());
-    PDB_COUT << "VTableMap:: to get shared for objectTypeID=" << objectTypeID << std::endl;
-    bool ret = theVTable->catalog->getSharedLibrary(objectTypeID, sharedLibraryFile);
 
     // JiaNote: we should stop here if someone else updated VTable
     void* returnVal = theVTable->allVTables[objectTypeID];
@@ -0,0 +1,158 @@
+
+#ifndef PDB_BACKEND_POOL_H
+#define PDB_BACKEND_POOL_H
+
+#include <functional>
+#include <memory>
+#include <pthread.h>
+#include <set>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+#include "PDBLogger.h"
+
+// how many backends are started ahead of time, ready to take over as soon as the running backend
+// dies; with 0, a backend is only forked once the running one is found dead
+#ifndef PDB_NUM_SPARE_BACKENDS
+#define PDB_NUM_SPARE_BACKENDS 1
+#endif
+
+// how often the frontend checks that the running backend is alive, in milliseconds
+#ifndef PDB_BACKEND_CHECK_INTERVAL_MS
+#define PDB_BACKEND_CHECK_INTERVAL_MS 1000
+#endif
+
+// how long the running backend may take to answer a ping before the check counts it as missed,
+// in milliseconds
+#ifndef PDB_BACKEND_PING_TIMEOUT_MS
+#define PDB_BACKEND_PING_TIMEOUT_MS 10000
+#endif
+
+// after how many missed pings in a row the running backend is taken as hung, and is killed and
+// replaced
+#ifndef PDB_BACKEND_MAX_MISSED_PINGS
+#define PDB_BACKEND_MAX_MISSED_PINGS 3
+#endif
+
+// This class keeps the backend of a worker running.  The backend is a long-lived process that
+// keeps its worker threads, its allocator blocks and the type libraries it has loaded from one
+// job to the next; if it crashes, a spare backend that was forked ahead of time, and whose
+// server is already listening, takes over, and a new spare is forked.
+//
+// The backends are not forked by the frontend itself, since forking a process that runs many
+// threads leaves the child with whatever locks those threads held.  Instead, the constructor
+// forks a small launcher process while the frontend still has a single thread, and the launcher
+// forks the backends when the frontend asks for them.  Each backend listens to its own IPC file,
+// the IPC file of the worker followed by a generation number, and the frontend is told about
+// the file of every backend that becomes the running one.
+//
+// The launcher reaps the backends itself and tells the frontend about every backend that exits,
+// so that a backend is taken as dead from the moment it exits, even once its pid is reused.  A
+// backend that is alive but hung is found by pinging it over its IPC file; it is killed through
+// the launcher and replaced.  Either way, the connections of the stages it was running are
+// closed, so those stages fail rather than wait for it.
+
+namespace pdb {
+
+class BackendPool;
+typedef std::shared_ptr<BackendPool> BackendPoolPtr;
+
+class BackendPool {
+
+public:
+    // runs a backend server that listens to the given IPC file
+    typedef std::function<void(std::string ipcFile)> BackendMain;
+
+    // forks the launcher; must be called while the calling process runs a single thread
+    BackendPool(std::string ipcFile, BackendMain backendMain, PDBLoggerPtr logger);
+
+    // stops the launcher, which stops all the backends
+    ~BackendPool();
+
+    // forks the running backend and the spares, and starts the thread that replaces dead
+    // backends; onNewBackend is called with the IPC file of each backend that becomes the running
+    // one, starting with the first
+    void start(std::function<void(std::string)> onNewBackend);
+
+    // returns the IPC file of the running backend
+    std::string getIpcFile();
+
+private:
+    struct Backend {
+        pid_t pid;
+        std::string ipcFile;
+    };
+
+    // what the frontend and the launcher send each other over the pipes
+    enum LauncherMessageType { ForkBackend, KillBackend, BackendForked, BackendExited };
+
+    struct LauncherMessage {
+        int type;
+        // the generation of the backend to fork, or the pid of a backend
+        int value;
+    };
+
+    // the loop of the launcher process, never returns
+    void runLauncher(int requestFd, int responseFd);
+
+    // asks the launcher for a new backend; returns false if the launcher is gone
+    bool forkBackend(Backend& backend);
+
+    // asks the launcher to kill a backend that is hung
+    void killBackend(Backend& backend);
+
+    // reads a message from the launcher; if wait is false, returns false right away when there is
+    // none, and the exits that it reports are recorded either way
+    bool readLauncherMessage(LauncherMessage& message, bool wait);
+
+    // records the exits that the launcher has reported so far
+    void readExits();
+
+    // returns true if the launcher has not reported the backend as exited
+    bool isAlive(Backend& backend);
+
+    // returns true if the backend that listens to the given IPC file takes a ping but does not
+    // answer it in time
+    bool missesPing(std::string backendIpcFile);
+
+    // the loop of the thread that checks the running backend
+    static void* monitor(void* pool);
+
+    std::string ipcFile;
+
+    BackendMain backendMain;
+
+    PDBLoggerPtr logger;
+
+    // the launcher, and the pipes we talk to it through
+    pid_t launcherPid;
+    int requestFd;
+    int responseFd;
+
+    // the number of backends forked so far, which numbers their IPC files
+    int generation;
+
+    // protects the backends below
+    pthread_mutex_t mutex;
+
+    Backend running;
+
+    std::vector<Backend> spares;
+
+    // the backends that the launcher reported as exited, until they are replaced
+    std::set<pid_t> exitedBackends;
+
+    // the number of pings in a row that the running backend has missed
+    int missedPings;
+
+    std::function<void(std::string)> onNewBackend;
+
+    pthread_t monitorThread;
+
+    bool monitorStarted;
+
+    volatile bool stopping;
+};
+}
+
+#endif
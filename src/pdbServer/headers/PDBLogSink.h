@@ -0,0 +1,142 @@
+
+#ifndef PDB_LOG_SINK_H
+#define PDB_LOG_SINK_H
+
+#include <atomic>
+#include <pthread.h>
+#include <string>
+#include <time.h>
+#include <vector>
+#include "LogLevel.h"
+
+// the longest message that is queued, longer messages are written synchronously
+#ifndef PDB_LOG_RECORD_TEXT_SIZE
+#define PDB_LOG_RECORD_TEXT_SIZE 240
+#endif
+
+// the number of records each thread can queue before it falls back to writing synchronously
+#ifndef PDB_LOG_RING_CAPACITY
+#define PDB_LOG_RING_CAPACITY 256
+#endif
+
+// how long the writer thread sleeps when it finds nothing to write, in microseconds
+#ifndef PDB_LOG_DRAIN_INTERVAL_US
+#define PDB_LOG_DRAIN_INTERVAL_US 10000
+#endif
+
+// this is the asynchronous sink behind PDBLogger: each thread appends binary log records to
+// its own single-producer ring without taking any lock, and a background thread formats the
+// records and writes them to the file of the logger they belong to
+
+namespace pdb {
+
+class PDBLogger;
+
+// a log message, formatted only when it is written
+struct PDBLogRecord {
+
+    PDBLogger* logger;
+
+    LogLevel level;
+
+    pthread_t threadId;
+
+    time_t time;
+
+    unsigned int length;
+
+    char text[PDB_LOG_RECORD_TEXT_SIZE];
+};
+
+// a ring of records, which is written by one thread and read by whoever holds its read lock
+struct PDBLogRing {
+
+    PDBLogRing() {
+        pthread_mutex_init(&readLock, nullptr);
+    }
+
+    ~PDBLogRing() {
+        pthread_mutex_destroy(&readLock);
+    }
+
+    // serializes the readers of the ring: the writer thread and the owner flushing its own ring
+    pthread_mutex_t readLock;
+
+    // the next record to read
+    std::atomic<size_t> head{0};
+
+    // the next record to write
+    std::atomic<size_t> tail{0};
+
+    // set when the thread owning the ring exits, so the ring can be freed once it is empty
+    std::atomic<bool> orphaned{false};
+
+    PDBLogRecord records[PDB_LOG_RING_CAPACITY];
+};
+
+class PDBLogSink {
+
+public:
+    // returns the sink of this process
+    static PDBLogSink& getSink();
+
+    // queues a message on the ring of the calling thread; returns false if the message is too
+    // long or the ring is full, in which case the caller should write it synchronously
+    bool append(PDBLogger* logger, LogLevel level, const std::string& text);
+
+    // writes all queued records
+    void flush();
+
+    // writes the records queued by the calling thread, so that a message written synchronously
+    // comes after them; this does not wait for the records of other threads
+    void flushThread();
+
+    // stops the writer thread and writes all queued records; after this, append returns false,
+    // so all messages are written synchronously
+    void stop();
+
+private:
+    PDBLogSink();
+
+    // returns the ring of the calling thread, creating it on first use
+    PDBLogRing* getRing();
+
+    // writes all queued records and frees the rings of exited threads; the caller must hold
+    // the mutex; returns true if anything was written
+    bool drain();
+
+    // writes the queued records of one ring and adds the loggers written to to touchedLoggers
+    static void drainRing(PDBLogRing* ring, std::vector<PDBLogger*>& touchedLoggers);
+
+    // starts the writer thread if it is not running in this process
+    void startWriter();
+
+    // the loop of the writer thread
+    static void* runWriter(void* sink);
+
+    // fork handlers, so that a forked backend starts with an empty sink and its own writer
+    static void prepareFork();
+    static void parentAfterFork();
+    static void childAfterFork();
+
+    // protects the list of rings and the state of the writer thread
+    pthread_mutex_t mutex;
+
+    // wakes up the writer thread when it is stopped
+    pthread_cond_t writerSignal;
+
+    // the writer thread, valid while writerStarted is set
+    pthread_t writerThread;
+
+    // the rings of all threads that have logged
+    std::vector<PDBLogRing*> rings;
+
+    // whether the writer thread is running in this process
+    std::atomic<bool> writerStarted{false};
+
+    // set by stop, so that the writer thread exits and is not started again
+    std::atomic<bool> writerStopped{false};
+};
+}
+
+#endif
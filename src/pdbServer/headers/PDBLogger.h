@@ -9,13 +9,42 @@
 #ifndef PDBLOGGER_H
 #define PDBLOGGER_H
 
+#include <atomic>
 #include <memory>
+#include <string>
 #include "LogLevel.h"
+#include "PDBLogSink.h"
 
 #include <pthread.h>
-
-
-// used to log client and server activity to a text file
+#include <stdio.h>
+
+// log statements above this level are compiled out when they use the PDB_LOG macros
+#ifndef PDB_LOG_MIN_LEVEL
+#define PDB_LOG_MIN_LEVEL TRACE
+#endif
+
+// logs a message if its level is enabled; unlike calling logger->trace(...) directly, the
+// message expression is not evaluated at all if the level is disabled, so it is cheap to
+// build messages like "wrote " + std::to_string(numBytes) on hot paths
+#define PDB_LOG(logger, level, message)                                  \
+    do {                                                                 \
+        if ((level) <= PDB_LOG_MIN_LEVEL && (logger)->isEnabled(level)) { \
+            (logger)->log((level), (message));                           \
+        }                                                                \
+    } while (0)
+
+#define PDB_LOG_FATAL(logger, message) PDB_LOG(logger, FATAL, message)
+#define PDB_LOG_ERROR(logger, message) PDB_LOG(logger, ERROR, message)
+#define PDB_LOG_WARN(logger, message) PDB_LOG(logger, WARN, message)
+#define PDB_LOG_INFO(logger, message) PDB_LOG(logger, INFO, message)
+#define PDB_LOG_DEBUG(logger, message) PDB_LOG(logger, DEBUG, message)
+#define PDB_LOG_TRACE(logger, message) PDB_LOG(logger, TRACE, message)
+
+
+// used to log client and server activity to a text file; messages at WARN and below, and
+// lines written by writeLn, are queued and written by a background thread (see PDBLogSink),
+// ERROR and FATAL messages are written synchronously after everything the same thread queued
+// before them
 
 namespace pdb {
 
@@ -41,6 +70,23 @@ public:
     // added by Jia, so that we can disable debug for performance testing
     void setEnabled(bool enabled);
 
+    // to write all messages synchronously, as before the asynchronous sink was added
+    void setAsync(bool async);
+
+    // returns whether a message at the given level would be written
+    bool isEnabled(LogLevel level) {
+        return enabled && level <= loglevel;
+    }
+
+    // writes a message at the given level, which must be enabled
+    void log(LogLevel level, const std::string& writeMe);
+
+    // writes a queued record to the log file, called by the sink
+    void writeRecord(PDBLogRecord& record);
+
+    // flushes the log file, called by the sink
+    void flushFile();
+
     // writes a line of text to the log file
     void writeLn(std::string writeMe);
 
@@ -66,25 +112,44 @@ public:
 
     // writes a line of text to the log file, if log level FATAL, ERROR, WARN, INFO, DEBUG or TRACE
     // is activated
-    void fatal(std::string writeMe);
+    void fatal(const std::string& writeMe) {
+        PDB_LOG(this, FATAL, writeMe);
+    }
 
     // writes a line of text to the log file, if log level ERROR, WARN, INFO, DEBUG or TRACE is
     // activated
-    void error(std::string writeMe);
+    void error(const std::string& writeMe) {
+        PDB_LOG(this, ERROR, writeMe);
+    }
 
     // writes a line of text to the log file, if log level WARN, INFO, DEBUG or TRACE is activated
-    void warn(std::string writeMe);
+    void warn(const std::string& writeMe) {
+        PDB_LOG(this, WARN, writeMe);
+    }
 
     // writes a line of text to the log file, if log level 	INFO, DEBUG or TRACE is activated
-    void info(std::string writeMe);
+    void info(const std::string& writeMe) {
+        PDB_LOG(this, INFO, writeMe);
+    }
 
     // writes a line of text to the log file, if log level 	DEBUG or TRACE is activated
-    void debug(std::string writeMe);
+    void debug(const std::string& writeMe) {
+        PDB_LOG(this, DEBUG, writeMe);
+    }
 
     // writes a line of text to the log file, if log level 	TRACE is activated
-    void trace(std::string writeMe);
+    void trace(const std::string& writeMe) {
+        PDB_LOG(this, TRACE, writeMe);
+    }
 
 private:
+    // queues a message on the sink and counts it as queued for this logger
+    bool append(PDBLogSink& sink, LogLevel level, const std::string& writeMe);
+
+    // writes a line with the thread id and time prefix; the caller must hold fileLock
+    void writeLine(pthread_t threadId, time_t when, const char* levelTag, const char* text,
+                   size_t length);
+
     // prohibits two people from writing to the file at the same time
     pthread_mutex_t fileLock;
 
@@ -94,6 +159,11 @@ private:
     bool enabled = true;
 
     LogLevel loglevel = WARN;
+
+    bool async = true;
+
+    // the number of messages of this logger that are queued on the sink
+    std::atomic<long> numQueued{0};
 };
 }
 
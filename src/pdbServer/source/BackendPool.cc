@@ -0,0 +1,368 @@
+
+#ifndef PDB_BACKEND_POOL_CC
+#define PDB_BACKEND_POOL_CC
+
+#include "BackendPool.h"
+#include "BackendPing.h"
+#include "InterfaceFunctions.h"
+#include "PDBCommunicator.h"
+#include "SimpleRequestResult.h"
+#include "UseTemporaryAllocationBlock.h"
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+
+namespace pdb {
+
+BackendPool::BackendPool(std::string ipcFileIn, BackendMain backendMainIn, PDBLoggerPtr loggerIn) {
+    ipcFile = ipcFileIn;
+    backendMain = backendMainIn;
+    logger = loggerIn;
+    launcherPid = -1;
+    requestFd = -1;
+    responseFd = -1;
+    generation = 0;
+    running.pid = -1;
+    missedPings = 0;
+    monitorStarted = false;
+    stopping = false;
+    pthread_mutex_init(&mutex, nullptr);
+
+    int requestPipe[2];
+    int responsePipe[2];
+    if (pipe(requestPipe) != 0) {
+        logger->error("BackendPool: could not create a pipe to the launcher");
+        return;
+    }
+    if (pipe(responsePipe) != 0) {
+        logger->error("BackendPool: could not create a pipe to the launcher");
+        close(requestPipe[0]);
+        close(requestPipe[1]);
+        return;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // I'm the launcher
+        close(requestPipe[1]);
+        close(responsePipe[0]);
+        runLauncher(requestPipe[0], responsePipe[1]);
+    }
+    close(requestPipe[0]);
+    close(responsePipe[1]);
+    if (pid == -1) {
+        logger->error("BackendPool: could not fork the launcher");
+        close(requestPipe[1]);
+        close(responsePipe[0]);
+        return;
+    }
+    launcherPid = pid;
+    requestFd = requestPipe[1];
+    responseFd = responsePipe[0];
+}
+
+BackendPool::~BackendPool() {
+    stopping = true;
+    if (monitorStarted) {
+        pthread_join(monitorThread, nullptr);
+    }
+
+    // the launcher stops the backends once it sees the pipe closed
+    if (requestFd != -1) {
+        close(requestFd);
+        close(responseFd);
+        waitpid(launcherPid, nullptr, 0);
+    }
+    pthread_mutex_destroy(&mutex);
+}
+
+void BackendPool::runLauncher(int requestFd, int responseFd) {
+
+    // go away with the frontend
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+
+    // the backends we forked and have not reaped yet; a pid stays ours until it is reaped, so
+    // that we never kill a process that merely got the pid of a dead backend
+    std::set<pid_t> backends;
+    while (true) {
+
+        // tell the frontend about the backends that exited since we last looked
+        bool frontendGone = false;
+        pid_t pid;
+        while ((pid = waitpid(-1, nullptr, WNOHANG)) > 0) {
+            backends.erase(pid);
+            LauncherMessage exited{BackendExited, pid};
+            if (write(responseFd, &exited, sizeof(exited)) != sizeof(exited)) {
+                frontendGone = true;
+                break;
+            }
+        }
+        if (frontendGone) {
+            break;
+        }
+
+        struct pollfd request {
+            requestFd, POLLIN, 0
+        };
+        int res = poll(&request, 1, PDB_BACKEND_CHECK_INTERVAL_MS / 10 + 1);
+        if (res < 0 && errno != EINTR) {
+            break;
+        }
+        if (res <= 0) {
+            continue;
+        }
+        LauncherMessage message;
+        if (read(requestFd, &message, sizeof(message)) != sizeof(message)) {
+            break;
+        }
+
+        if (message.type == KillBackend) {
+            if (backends.count(message.value) != 0) {
+                kill(message.value, SIGKILL);
+            }
+            continue;
+        }
+
+        pid = fork();
+        if (pid == 0) {
+            // I'm a backend
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            close(requestFd);
+            close(responseFd);
+            backendMain(ipcFile + "." + std::to_string(message.value));
+            exit(0);
+        }
+        if (pid > 0) {
+            backends.insert(pid);
+        }
+        LauncherMessage forked{BackendForked, pid};
+        if (write(responseFd, &forked, sizeof(forked)) != sizeof(forked)) {
+            break;
+        }
+    }
+
+    // the frontend is gone, so the backends have nothing left to do
+    for (pid_t pid : backends) {
+        kill(pid, SIGTERM);
+    }
+    exit(0);
+}
+
+bool BackendPool::readLauncherMessage(LauncherMessage& message, bool wait) {
+    if (responseFd == -1) {
+        return false;
+    }
+    if (!wait) {
+        struct pollfd response {
+            responseFd, POLLIN, 0
+        };
+        if (poll(&response, 1, 0) <= 0) {
+            return false;
+        }
+    }
+    if (read(responseFd, &message, sizeof(message)) != sizeof(message)) {
+        // without the launcher no backend can be forked, and the backends went away with it
+        logger->error("BackendPool: the launcher is gone");
+        close(requestFd);
+        close(responseFd);
+        waitpid(launcherPid, nullptr, 0);
+        requestFd = -1;
+        responseFd = -1;
+        return false;
+    }
+    if (message.type == BackendExited) {
+        exitedBackends.insert(message.value);
+    }
+    return true;
+}
+
+void BackendPool::readExits() {
+    LauncherMessage message;
+    while (readLauncherMessage(message, false)) {
+    }
+}
+
+bool BackendPool::forkBackend(Backend& backend) {
+    if (requestFd == -1) {
+        return false;
+    }
+    int backendGeneration = generation++;
+    LauncherMessage request{ForkBackend, backendGeneration};
+    if (write(requestFd, &request, sizeof(request)) != sizeof(request)) {
+        logger->error("BackendPool: could not fork a backend");
+        return false;
+    }
+
+    // exits may be reported before the pid of the new backend
+    LauncherMessage message{BackendExited, -1};
+    while (readLauncherMessage(message, true) && message.type != BackendForked) {
+    }
+    if (message.type != BackendForked || message.value <= 0) {
+        logger->error("BackendPool: could not fork a backend");
+        return false;
+    }
+    backend.pid = message.value;
+    backend.ipcFile = ipcFile + "." + std::to_string(backendGeneration);
+
+    // an exited backend whose pid was reused by this one is long replaced
+    exitedBackends.erase(backend.pid);
+    return true;
+}
+
+void BackendPool::killBackend(Backend& backend) {
+    LauncherMessage request{KillBackend, backend.pid};
+    if (requestFd == -1 || write(requestFd, &request, sizeof(request)) != sizeof(request)) {
+        logger->error("BackendPool: could not kill the backend with pid " +
+                      std::to_string(backend.pid));
+    }
+}
+
+bool BackendPool::isAlive(Backend& backend) {
+    return backend.pid > 0 && exitedBackends.count(backend.pid) == 0;
+}
+
+bool BackendPool::missesPing(std::string backendIpcFile) {
+    const UseTemporaryAllocationBlock block{1024};
+    std::string errMsg;
+    PDBCommunicator communicator;
+    if (communicator.connectToLocalServer(logger, backendIpcFile, errMsg)) {
+        // not listening yet, or gone, which the launcher tells us about
+        return false;
+    }
+
+    // a hung backend may take the connection but never answer
+    struct timeval timeout;
+    timeout.tv_sec = PDB_BACKEND_PING_TIMEOUT_MS / 1000;
+    timeout.tv_usec = (PDB_BACKEND_PING_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(communicator.getSocketFD(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(communicator.getSocketFD(), SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    Handle<BackendPing> request = makeObject<BackendPing>();
+    if (!communicator.sendObject(request, errMsg)) {
+        return true;
+    }
+    bool success;
+    Handle<SimpleRequestResult> result =
+        communicator.getNextObject<SimpleRequestResult>(success, errMsg);
+    return !success || result == nullptr || !result->getRes().first;
+}
+
+void BackendPool::start(std::function<void(std::string)> onNewBackendIn) {
+    onNewBackend = onNewBackendIn;
+
+    pthread_mutex_lock(&mutex);
+    bool res = forkBackend(running);
+    for (int i = 0; res && i < PDB_NUM_SPARE_BACKENDS; i++) {
+        Backend spare;
+        if (forkBackend(spare)) {
+            spares.push_back(spare);
+        }
+    }
+    pthread_mutex_unlock(&mutex);
+    if (!res) {
+        return;
+    }
+    onNewBackend(running.ipcFile);
+
+    if (pthread_create(&monitorThread, nullptr, monitor, this) == 0) {
+        monitorStarted = true;
+    } else {
+        logger->error("BackendPool: could not start the thread that checks the backend");
+    }
+}
+
+std::string BackendPool::getIpcFile() {
+    pthread_mutex_lock(&mutex);
+    std::string file = running.ipcFile;
+    pthread_mutex_unlock(&mutex);
+    return file;
+}
+
+void* BackendPool::monitor(void* poolIn) {
+    BackendPool* pool = (BackendPool*)poolIn;
+    while (!pool->stopping) {
+        usleep(PDB_BACKEND_CHECK_INTERVAL_MS * 1000);
+
+        // ping the running backend without holding the lock, since it may take a while
+        std::string pingedIpcFile = pool->getIpcFile();
+        if (pool->missesPing(pingedIpcFile)) {
+            pool->missedPings++;
+        } else {
+            pool->missedPings = 0;
+        }
+
+        std::string newIpcFile;
+        pthread_mutex_lock(&pool->mutex);
+        pool->readExits();
+
+        // forget the spares that died before they were needed
+        pool->spares.erase(std::remove_if(pool->spares.begin(),
+                                          pool->spares.end(),
+                                          [pool](Backend& spare) {
+                                              if (pool->isAlive(spare)) {
+                                                  return false;
+                                              }
+                                              pool->exitedBackends.erase(spare.pid);
+                                              return true;
+                                          }),
+                           pool->spares.end());
+
+        // replace the running backend if it died or hung, with a spare if we have one
+        bool hung = pool->missedPings >= PDB_BACKEND_MAX_MISSED_PINGS &&
+            pool->running.ipcFile == pingedIpcFile;
+        bool dead = !pool->isAlive(pool->running);
+        if (hung) {
+            pool->logger->error("BackendPool: the backend with pid " +
+                                std::to_string(pool->running.pid) + " missed " +
+                                std::to_string(pool->missedPings) + " pings, killing it");
+            pool->killBackend(pool->running);
+        } else if (dead) {
+            pool->logger->error("BackendPool: the backend with pid " +
+                                std::to_string(pool->running.pid) + " is gone, replacing it");
+            pool->exitedBackends.erase(pool->running.pid);
+        }
+        if (hung || dead) {
+            pool->missedPings = 0;
+            std::string deadIpcFile = pool->running.ipcFile;
+            bool res = true;
+            if (!pool->spares.empty()) {
+                pool->running = pool->spares.front();
+                pool->spares.erase(pool->spares.begin());
+            } else {
+                res = pool->forkBackend(pool->running);
+            }
+            if (res) {
+                unlink(deadIpcFile.c_str());
+                newIpcFile = pool->running.ipcFile;
+            } else {
+                // try again at the next check
+                pool->running.pid = -1;
+            }
+        }
+
+        // and keep enough spares
+        while (pool->spares.size() < PDB_NUM_SPARE_BACKENDS) {
+            Backend spare;
+            if (!pool->forkBackend(spare)) {
+                break;
+            }
+            pool->spares.push_back(spare);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (!newIpcFile.empty()) {
+            pool->onNewBackend(newIpcFile);
+        }
+    }
+    return nullptr;
+}
+}
+
+#endif
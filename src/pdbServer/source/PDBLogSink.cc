@@ -0,0 +1,206 @@
+
+#ifndef PDB_LOG_SINK_CC
+#define PDB_LOG_SINK_CC
+
+#include "PDBLogSink.h"
+#include "PDBLogger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+namespace pdb {
+
+namespace {
+
+// the ring of the calling thread, which is handed back to the sink when the thread exits
+struct ThreadLogRing {
+
+    PDBLogRing* ring = nullptr;
+
+    ~ThreadLogRing() {
+        if (ring != nullptr) {
+            ring->orphaned = true;
+        }
+    }
+};
+
+thread_local ThreadLogRing threadLogRing;
+
+void stopAtExit() {
+    PDBLogSink::getSink().stop();
+}
+
+void flushFiles(std::vector<PDBLogger*>& loggers) {
+    for (PDBLogger* logger : loggers) {
+        logger->flushFile();
+    }
+}
+}
+
+PDBLogSink& PDBLogSink::getSink() {
+    // never destroyed, so that loggers can still flush while static objects are destroyed
+    static PDBLogSink* sink = new PDBLogSink();
+    return *sink;
+}
+
+PDBLogSink::PDBLogSink() {
+    pthread_mutex_init(&mutex, nullptr);
+    pthread_cond_init(&writerSignal, nullptr);
+    pthread_atfork(prepareFork, parentAfterFork, childAfterFork);
+    atexit(stopAtExit);
+}
+
+PDBLogRing* PDBLogSink::getRing() {
+    if (threadLogRing.ring == nullptr) {
+        PDBLogRing* ring = new PDBLogRing();
+        pthread_mutex_lock(&mutex);
+        rings.push_back(ring);
+        pthread_mutex_unlock(&mutex);
+        threadLogRing.ring = ring;
+    }
+    return threadLogRing.ring;
+}
+
+bool PDBLogSink::append(PDBLogger* logger, LogLevel level, const std::string& text) {
+
+    if (text.size() > PDB_LOG_RECORD_TEXT_SIZE || writerStopped) {
+        return false;
+    }
+    if (!writerStarted) {
+        startWriter();
+    }
+    PDBLogRing* ring = getRing();
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) >= PDB_LOG_RING_CAPACITY) {
+        return false;
+    }
+    PDBLogRecord& record = ring->records[tail % PDB_LOG_RING_CAPACITY];
+    record.logger = logger;
+    record.level = level;
+    record.threadId = pthread_self();
+    record.time = time(0);
+    record.length = text.size();
+    memcpy(record.text, text.data(), text.size());
+    ring->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+void PDBLogSink::drainRing(PDBLogRing* ring, std::vector<PDBLogger*>& touchedLoggers) {
+    pthread_mutex_lock(&ring->readLock);
+    size_t head = ring->head.load(std::memory_order_relaxed);
+    size_t tail = ring->tail.load(std::memory_order_acquire);
+    for (; head != tail; head++) {
+        PDBLogRecord& record = ring->records[head % PDB_LOG_RING_CAPACITY];
+        record.logger->writeRecord(record);
+        if (std::find(touchedLoggers.begin(), touchedLoggers.end(), record.logger) ==
+            touchedLoggers.end()) {
+            touchedLoggers.push_back(record.logger);
+        }
+    }
+    ring->head.store(head, std::memory_order_release);
+    pthread_mutex_unlock(&ring->readLock);
+}
+
+bool PDBLogSink::drain() {
+
+    std::vector<PDBLogger*> touchedLoggers;
+    for (auto it = rings.begin(); it != rings.end();) {
+        PDBLogRing* ring = *it;
+        bool orphaned = ring->orphaned;
+        drainRing(ring, touchedLoggers);
+        // the owner sets orphaned after its last append, so the ring is complete here
+        if (orphaned) {
+            delete ring;
+            it = rings.erase(it);
+        } else {
+            it++;
+        }
+    }
+    flushFiles(touchedLoggers);
+    return touchedLoggers.size() > 0;
+}
+
+void PDBLogSink::flush() {
+    pthread_mutex_lock(&mutex);
+    drain();
+    pthread_mutex_unlock(&mutex);
+}
+
+void PDBLogSink::flushThread() {
+    // the ring of a thread is only freed after the thread exits, so no lock on the list is needed
+    if (threadLogRing.ring == nullptr) {
+        return;
+    }
+    std::vector<PDBLogger*> touchedLoggers;
+    drainRing(threadLogRing.ring, touchedLoggers);
+    flushFiles(touchedLoggers);
+}
+
+void PDBLogSink::stop() {
+    pthread_mutex_lock(&mutex);
+    writerStopped = true;
+    bool joinWriter = writerStarted;
+    writerStarted = false;
+    pthread_cond_signal(&writerSignal);
+    pthread_mutex_unlock(&mutex);
+    if (joinWriter) {
+        pthread_join(writerThread, nullptr);
+    }
+    flush();
+}
+
+void PDBLogSink::startWriter() {
+    pthread_mutex_lock(&mutex);
+    if (!writerStarted && !writerStopped) {
+        if (pthread_create(&writerThread, nullptr, runWriter, this) == 0) {
+            writerStarted = true;
+        }
+    }
+    pthread_mutex_unlock(&mutex);
+}
+
+void* PDBLogSink::runWriter(void* sink) {
+    PDBLogSink* me = (PDBLogSink*)sink;
+    pthread_mutex_lock(&me->mutex);
+    while (!me->writerStopped) {
+        if (me->drain()) {
+            // let threads registering their rings in
+            pthread_mutex_unlock(&me->mutex);
+            pthread_mutex_lock(&me->mutex);
+            continue;
+        }
+        struct timespec wakeUpTime;
+        clock_gettime(CLOCK_REALTIME, &wakeUpTime);
+        wakeUpTime.tv_nsec += PDB_LOG_DRAIN_INTERVAL_US * 1000L;
+        wakeUpTime.tv_sec += wakeUpTime.tv_nsec / 1000000000L;
+        wakeUpTime.tv_nsec %= 1000000000L;
+        pthread_cond_timedwait(&me->writerSignal, &me->mutex, &wakeUpTime);
+    }
+    pthread_mutex_unlock(&me->mutex);
+    return nullptr;
+}
+
+void PDBLogSink::prepareFork() {
+    PDBLogSink& sink = getSink();
+    pthread_mutex_lock(&sink.mutex);
+    sink.drain();
+}
+
+void PDBLogSink::parentAfterFork() {
+    pthread_mutex_unlock(&getSink().mutex);
+}
+
+void PDBLogSink::childAfterFork() {
+    // the writer thread does not survive the fork, and all rings were drained before it; a
+    // thread that was flushing its own ring does not survive either, so its lock is reset
+    PDBLogSink& sink = getSink();
+    pthread_mutex_init(&sink.mutex, nullptr);
+    pthread_cond_init(&sink.writerSignal, nullptr);
+    for (PDBLogRing* ring : sink.rings) {
+        pthread_mutex_init(&ring->readLock, nullptr);
+    }
+    sink.writerStarted = false;
+}
+}
+
+#endif
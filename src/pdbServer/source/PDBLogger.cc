@@ -57,6 +57,11 @@ void PDBLogger::open(std::string fName) {
 
 PDBLogger::~PDBLogger() {
 
+    // write what is still queued for this logger, the queued records point to it
+    if (numQueued > 0) {
+        PDBLogSink::getSink().flush();
+    }
+
     if (outputFile != nullptr)
         fclose(outputFile);
 
@@ -97,55 +102,58 @@ void PDBLogger::writeInt(int writeMe) {
 //	DEBUG,
 //	TRACE
 
-void PDBLogger::trace(std::string writeMe) {
-    if (!this->enabled || this->loglevel == OFF || this->loglevel == FATAL ||
-        this->loglevel == ERROR || this->loglevel == WARN || this->loglevel == INFO ||
-        this->loglevel == DEBUG) {
-        return;
-    }
-    this->writeLn("[TRACE] " + writeMe);
+namespace {
+const char* levelTags[] = {"", "[FATAL] ", "[ERROR] ", "[WARN] ", "[INFO] ", "[DEBUG] ", "[TRACE] "};
 }
 
-void PDBLogger::debug(std::string writeMe) {
-    if (!this->enabled || this->loglevel == OFF || this->loglevel == FATAL ||
-        this->loglevel == ERROR || this->loglevel == WARN || this->loglevel == INFO) {
+void PDBLogger::log(LogLevel level, const std::string& writeMe) {
+    PDBLogSink& sink = PDBLogSink::getSink();
+    if (level > ERROR && this->async && append(sink, level, writeMe)) {
         return;
     }
-    this->writeLn("[DEBUG] " + writeMe);
-}
-
-
-void PDBLogger::info(std::string writeMe) {
-    if (!this->enabled || this->loglevel == OFF || this->loglevel == FATAL ||
-        this->loglevel == ERROR || this->loglevel == WARN) {
-        return;
+    // keep the order with the messages this thread queued before
+    if (this->async) {
+        sink.flushThread();
     }
-    this->writeLn("[INFO] " + writeMe);
+    const LockGuard guard{fileLock};
+    writeLine(pthread_self(), time(0), levelTags[level], writeMe.c_str(), writeMe.length());
+    fflush(outputFile);
 }
 
-
-void PDBLogger::warn(std::string writeMe) {
-    if (!this->enabled || this->loglevel == OFF || this->loglevel == FATAL ||
-        this->loglevel == ERROR) {
-        return;
+bool PDBLogger::append(PDBLogSink& sink, LogLevel level, const std::string& writeMe) {
+    numQueued++;
+    if (sink.append(this, level, writeMe)) {
+        return true;
     }
-    this->writeLn("[WARN] " + writeMe);
+    numQueued--;
+    return false;
 }
 
+void PDBLogger::writeRecord(PDBLogRecord& record) {
+    const LockGuard guard{fileLock};
+    writeLine(record.threadId, record.time, levelTags[record.level], record.text, record.length);
+    numQueued--;
+}
 
-void PDBLogger::error(std::string writeMe) {
-    if (!this->enabled || this->loglevel == OFF || this->loglevel == FATAL) {
-        return;
-    }
-    this->writeLn("[ERROR] " + writeMe);
+void PDBLogger::flushFile() {
+    const LockGuard guard{fileLock};
+    fflush(outputFile);
 }
 
+void PDBLogger::writeLine(pthread_t threadId, time_t when, const char* levelTag, const char* text,
+                          size_t length) {
 
-void PDBLogger::fatal(std::string writeMe) {
-    if (!this->enabled || this->loglevel == OFF) {
-        return;
+    // get the date and time
+    struct tm tstruct;
+    char buf[80];
+    localtime_r(&when, &tstruct);
+    strftime(buf, sizeof(buf), "[%Y-%m-%d-%X] ", &tstruct);
+
+    if (length > 0 && text[length - 1] == '\n') {
+        length--;
     }
-    this->writeLn("[FATAL] " + writeMe);
+    // JiaNote: to get thread id for debugging
+    fprintf(outputFile, "[%lu]%s%s%.*s\n", threadId, buf, levelTag, (int)length, text);
 }
 
 
@@ -156,25 +164,15 @@ void PDBLogger::writeLn(std::string writeMe) {
         return;
     }
 
-    const LockGuard guard{fileLock};
-
-    // get the current time and date
-    time_t now = time(0);
-    struct tm tstruct;
-    char buf[80];
-    tstruct = *localtime(&now);
-    strftime(buf, sizeof(buf), "[%Y-%m-%d-%X] ", &tstruct);
-
-    // add date and time to the log
-    writeMe = buf + writeMe;
-
-    // JiaNote: to get thread id for debugging
-    pthread_t threadId = pthread_self();
-    if (writeMe[writeMe.length() - 1] != '\n') {
-        fprintf(outputFile, "[%lu]%s\n", threadId, writeMe.c_str());
-    } else {
-        fprintf(outputFile, "[%lu]%s", threadId, writeMe.c_str());
+    PDBLogSink& sink = PDBLogSink::getSink();
+    if (this->async) {
+        if (append(sink, OFF, writeMe)) {
+            return;
+        }
+        sink.flushThread();
     }
+    const LockGuard guard{fileLock};
+    writeLine(pthread_self(), time(0), levelTags[OFF], writeMe.c_str(), writeMe.length());
     fflush(outputFile);
 }
 
@@ -192,6 +190,10 @@ void PDBLogger::setEnabled(bool enabled) {
     this->enabled = enabled;
 }
 
+void PDBLogger::setAsync(bool async) {
+    this->async = async;
+}
+
 LogLevel PDBLogger::getLoglevel() {
     return this->loglevel;
 }
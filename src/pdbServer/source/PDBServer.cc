@@ -19,6 +19,7 @@
 #include <unistd.h>
 #include <signal.h>
 #include "PDBCommunicator.h"
+#include "BackendPing.h"
 #include "CloseConnection.h"
 #include "ShutDown.h"
 #include "ServerFunctionality.h"
@@ -115,7 +116,7 @@ void PDBServer::listen() {
             exit(0);
         }
 
-        myLogger->trace("PDBServer: about to listen to the Internet for a connection");
+        PDB_LOG_TRACE(myLogger, "PDBServer: about to listen to the Internet for a connection");
 
         // set the backlog on the socket
         if (::listen(sockFD, 100) != 0) {
@@ -125,7 +126,7 @@ void PDBServer::listen() {
             exit(0);
         }
 
-        myLogger->trace("PDBServer: ready to go!");
+        PDB_LOG_TRACE(myLogger, "PDBServer: ready to go!");
 
         // wait for someone to try to connect
         while (!allDone) {
@@ -134,7 +135,7 @@ void PDBServer::listen() {
                 myLogger->error("PDBServer: could not point to an internet socket: " + errMsg);
                 continue;
             }
-            myLogger->info(std::string("accepted the connection with sockFD=") +
+            PDB_LOG_INFO(myLogger, std::string("accepted the connection with sockFD=") +
                            std::to_string(myCommunicator->getSocketFD()));
             PDB_COUT << "||||||||||||||||||||||||||||||||||" << std::endl;
             PDB_COUT << "accepted the connection with sockFD=" << myCommunicator->getSocketFD()
@@ -145,7 +146,7 @@ void PDBServer::listen() {
         // second, we are connecting to a local UNIX socket
     } else {
 
-        myLogger->trace("PDBServer: getting socket to file");
+        PDB_LOG_TRACE(myLogger, "PDBServer: getting socket to file");
         sockFD = socket(PF_UNIX, SOCK_STREAM, 0);
 
         if (sockFD < 0) {
@@ -175,10 +176,10 @@ void PDBServer::listen() {
             }
         }
 
-        myLogger->debug("PDBServer: socket has name");
-        myLogger->debug(serv_addr.sun_path);
+        PDB_LOG_DEBUG(myLogger, "PDBServer: socket has name");
+        PDB_LOG_DEBUG(myLogger, serv_addr.sun_path);
 
-        myLogger->trace("PDBServer: about to listen to the file for a connection");
+        PDB_LOG_TRACE(myLogger, "PDBServer: about to listen to the file for a connection");
 
         // set the backlog on the socket
         if (::listen(sockFD, 100) != 0) {
@@ -187,7 +188,7 @@ void PDBServer::listen() {
             exit(0);
         }
 
-        myLogger->trace("PDBServer: ready to go!");
+        PDB_LOG_TRACE(myLogger, "PDBServer: ready to go!");
 
         // wait for someone to try to connect
         while (!allDone) {
@@ -241,14 +242,14 @@ bool PDBServer::handleOneRequest(PDBBuzzerPtr callerBuzzer, PDBCommunicatorPtr m
         if (!success) {
             myLogger->error("PDBServer: close connection request, but was an error: " + info);
         } else {
-            myLogger->trace("PDBServer: close connection request");
+            PDB_LOG_TRACE(myLogger, "PDBServer: close connection request");
         }
         return false;
     }
 
     if (requestID == NoMsg_TYPEID) {
         string err, info;
-        myLogger->trace("PDBServer: the other side closed the connection");
+        PDB_LOG_TRACE(myLogger, "PDBServer: the other side closed the connection");
         return false;
     }
 
@@ -259,7 +260,7 @@ bool PDBServer::handleOneRequest(PDBBuzzerPtr callerBuzzer, PDBCommunicatorPtr m
         if (!success) {
             myLogger->error("PDBServer: close connection request, but was an error: " + info);
         } else {
-            myLogger->trace("PDBServer: close connection request");
+            PDB_LOG_TRACE(myLogger, "PDBServer: close connection request");
         }
         PDB_COUT << "Cleanup server functionalities" << std::endl;
         // for each functionality, invoke its clean() method
@@ -285,6 +286,23 @@ bool PDBServer::handleOneRequest(PDBBuzzerPtr callerBuzzer, PDBCommunicatorPtr m
         return false;
     }
 
+    // if we are asked whether we still take requests, we do, since we got this far
+    if (requestID == BackendPing_TYPEID) {
+        UseTemporaryAllocationBlock tempBlock{2048};
+        Handle<BackendPing> pingMsg = myCommunicator->getNextObject<BackendPing>(success, info);
+        if (!success) {
+            myLogger->error("PDBServer: ping request, but was an error: " + info);
+            return false;
+        }
+        std::string errMsg;
+        Handle<SimpleRequestResult> result = makeObject<SimpleRequestResult>(true, "alive");
+        if (!myCommunicator->sendObject(result, errMsg)) {
+            myLogger->error("PDBServer: ping request, but could not send response: " + errMsg);
+            return false;
+        }
+        return true;
+    }
+
     // and get a worker plus the appropriate work to service it
     if (handlers.count(requestID) == 0) {
 
@@ -310,16 +328,16 @@ bool PDBServer::handleOneRequest(PDBBuzzerPtr callerBuzzer, PDBCommunicatorPtr m
         // Chris' old code: (Observed problem: sometimes, buzzer never get buzzed.)
         // get a worker to run the handler (this blocks if no workers available)
         PDBWorkerPtr tempWorker = myWorkers->getWorker();
-        myLogger->trace("PDBServer: got a worker, start to do something...");
-        myLogger->trace("PDBServer: requestID " + std::to_string(requestID));
+        PDB_LOG_TRACE(myLogger, "PDBServer: got a worker, start to do something...");
+        PDB_LOG_TRACE(myLogger, "PDBServer: requestID " + std::to_string(requestID));
 
         PDBCommWorkPtr tempWork = handlers[requestID]->clone();
 
-        myLogger->trace("PDBServer: setting guts");
+        PDB_LOG_TRACE(myLogger, "PDBServer: setting guts");
         tempWork->setGuts(myCommunicator);
         tempWorker->execute(tempWork, callerBuzzer);
         callerBuzzer->wait();
-        myLogger->trace("PDBServer: handler has completed its work");
+        PDB_LOG_TRACE(myLogger, "PDBServer: handler has completed its work");
         return true;
     }
 }
@@ -27,14 +27,14 @@ PDBBuzzerPtr ServerWork::getLinkedBuzzer() {
 void ServerWork::execute(PDBBuzzerPtr callerBuzzer) {
 
     // while there is still something to do on this connection
-    getLogger()->trace("ServerWork: about to handle a request");
+    PDB_LOG_TRACE(getLogger(), "ServerWork: about to handle a request");
     PDBBuzzerPtr myBuzzer{getLinkedBuzzer()};
     while (!wasEnError && workOnMe.handleOneRequest(myBuzzer, getCommunicator())) {
-        getLogger()->trace("ServerWork: just handled another request");
+        PDB_LOG_TRACE(getLogger(), "ServerWork: just handled another request");
         myBuzzer = getLinkedBuzzer();
     }
 
-    getLogger()->trace("ServerWork: done with this server work");
+    PDB_LOG_TRACE(getLogger(), "ServerWork: done with this server work");
     callerBuzzer->buzz(PDBAlarm::WorkAllDone);
 }
 }
@@ -145,6 +145,16 @@ if (typeName != getTypeName <Type> ()) {
     }
 
 
+    // to execute a query graph with several sinks that are only known at runtime
+    bool executeComputations(std::string& errMsg,
+                             std::string jobName,
+                             std::vector<Handle<Computation>>& sinks) {
+        for (int i = 0; i < sinks.size(); i++) {
+            queryGraph->push_back(sinks[i]);
+        }
+        return executeComputations(errMsg, jobName);
+    }
+
     bool executeComputations(std::string& errMsg, std::string jobName = "") {
 
         // this is the request
@@ -38,6 +38,12 @@ public:
     // must be called before free the data in output page
     virtual void clearOutputPage() = 0;
 
+    // writes the filled output page in a more compact form to another page before it is shipped;
+    // returns the number of bytes written there, or 0 if the output page goes out as it is
+    virtual size_t compactOutputPage(void* pageToWriteTo, size_t numBytesInPage) {
+        return 0;
+    }
+
     // must be called before free the data in input page
     virtual void clearInputPage() = 0;
 
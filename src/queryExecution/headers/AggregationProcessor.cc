@@ -33,6 +33,17 @@ void AggregationProcessor<KeyType, ValueType>::initialize() {
 
 template <class KeyType, class ValueType>
 void AggregationProcessor<KeyType, ValueType>::loadInputObject(Handle<Object>& objectToProcess) {
+    if (ColumnBlock<KeyType, ValueType>::isColumnBlock(objectToProcess)) {
+        curMap = nullptr;
+        curBlock.attach(objectToProcess);
+        posInBlock = 0;
+        hasBlock = (curBlock.getHashPartitionId() == id);
+        if (!hasBlock) {
+            curBlock.clear();
+        }
+        return;
+    }
+    hasBlock = false;
     curMap = unsafeCast<AggregationMap<KeyType, ValueType>, Object>(objectToProcess);
     HashPartitionID hashIdForCurrentMap = curMap->getHashPartitionId();
     if (curMap->getHashPartitionId() == id) {
@@ -63,32 +74,16 @@ void AggregationProcessor<KeyType, ValueType>::loadInputObject(Handle<Object>& o
 template <class KeyType, class ValueType>
 void AggregationProcessor<KeyType, ValueType>::loadInputPage(void* pageToProcess) {
     PDB_COUT << "AggregationProcessor-" << id << ": Loading input page" << std::endl;
-    Record<Vector<Handle<AggregationMap<KeyType, ValueType>>>>* myRec =
-        (Record<Vector<Handle<AggregationMap<KeyType, ValueType>>>>*)pageToProcess;
+    Record<Vector<Handle<Object>>>* myRec = (Record<Vector<Handle<Object>>>*)pageToProcess;
     inputData = myRec->getRootObject();
     int numPartitions = inputData->size();
     int i;
     for (i = 0; i < numPartitions; i++) {
-        curMap = (*inputData)[i];
-        HashPartitionID hashIdForCurrentMap = curMap->getHashPartitionId();
-        PDB_COUT << i << "-th map's partitionId is " << hashIdForCurrentMap << std::endl;
-        if (curMap->getHashPartitionId() == id) {
-            PDB_COUT << "this map has my id = " << id << std::endl;
-            if (begin != nullptr) {
-                PDB_COUT << "we delete the begin iterator of last input page" << std::endl;
-                delete begin;
-            }
-            if (end != nullptr) {
-                PDB_COUT << "we delete the end iterator of last input page" << std::endl;
-                delete end;
-            }
-            begin = new PDBMapIterator<KeyType, ValueType>(curMap->getArray(), true);
-            end = new PDBMapIterator<KeyType, ValueType>(curMap->getArray());
-
+        // the page holds either an AggregationMap or a column block for each partition
+        loadInputObject((*inputData)[i]);
+        if (needsProcessInput()) {
+            PDB_COUT << "the " << i << "-th partition has my id = " << id << std::endl;
             break;
-        } else {
-            // there is no hash partition for this thread
-            curMap = nullptr;
         }
     }
 }
@@ -113,7 +108,7 @@ bool AggregationProcessor<KeyType, ValueType>::fillNextOutputPage() {
     }
 
 
-    if (curMap == nullptr) {
+    if ((curMap == nullptr) && (!hasBlock)) {
         PDB_COUT << "this page doesn't have my map with id = " << id << std::endl;
         return false;
     }
@@ -122,6 +117,14 @@ bool AggregationProcessor<KeyType, ValueType>::fillNextOutputPage() {
     // we are not finalized, so process the page
     try {
 
+        // the pairs of a column block come straight out of its columns
+        if (hasBlock) {
+            curBlock.forEachPair(posInBlock, [this](KeyType curKey, ValueType curValue) {
+                aggregate(curKey, curValue);
+            });
+            return false;
+        }
+
         // see if there are any more items in current map to iterate over
         while (true) {
 
@@ -130,39 +133,8 @@ bool AggregationProcessor<KeyType, ValueType>::fillNextOutputPage() {
             }
             KeyType curKey = (*(*begin)).key;
             ValueType curValue = (*(*begin)).value;
-            // if the key is not there
-            if (outputData->count(curKey) == 0) {
-                ValueType* temp = nullptr;
-                temp = &((*outputData)[curKey]);
-                try {
-
-                    *temp = curValue;
-                    ++(*begin);
-                    numHashKeys++;
-                    // if we couldn't fit the value
-                } catch (NotEnoughSpace& n) {
-                    outputData->setUnused(curKey);
-                    throw n;
-                }
-                // the key is there
-            } else {
-                // get the value and copy of it
-                ValueType& temp = (*outputData)[curKey];
-                ValueType copy = temp;
-
-                // and add to old value, producing a new one
-                try {
-
-                    temp = copy + curValue;
-                    ++(*begin);
-
-                    // if we got here, it means we run out of RAM and we need to restore the old
-                    // value in the destination hash map
-                } catch (NotEnoughSpace& n) {
-                    temp = copy;
-                    throw n;
-                }
-            }
+            aggregate(curKey, curValue);
+            ++(*begin);
         }
 
     } catch (NotEnoughSpace& n) {
@@ -171,6 +143,42 @@ bool AggregationProcessor<KeyType, ValueType>::fillNextOutputPage() {
     }
 }
 
+template <class KeyType, class ValueType>
+void AggregationProcessor<KeyType, ValueType>::aggregate(KeyType& curKey, ValueType& curValue) {
+
+    // if the key is not there
+    if (outputData->count(curKey) == 0) {
+        ValueType* temp = nullptr;
+        temp = &((*outputData)[curKey]);
+        try {
+
+            *temp = curValue;
+            numHashKeys++;
+            // if we couldn't fit the value
+        } catch (NotEnoughSpace& n) {
+            outputData->setUnused(curKey);
+            throw n;
+        }
+        // the key is there
+    } else {
+        // get the value and copy of it
+        ValueType& temp = (*outputData)[curKey];
+        ValueType copy = temp;
+
+        // and add to old value, producing a new one
+        try {
+
+            temp = copy + curValue;
+
+            // if we got here, it means we run out of RAM and we need to restore the old
+            // value in the destination hash map
+        } catch (NotEnoughSpace& n) {
+            temp = copy;
+            throw n;
+        }
+    }
+}
+
 template <class KeyType, class ValueType>
 void AggregationProcessor<KeyType, ValueType>::finalize() {
     finalized = true;
@@ -185,12 +193,14 @@ void AggregationProcessor<KeyType, ValueType>::clearOutputPage() {
 template <class KeyType, class ValueType>
 void AggregationProcessor<KeyType, ValueType>::clearInputPage() {
     curMap = nullptr;
+    curBlock.clear();
+    hasBlock = false;
     inputData = nullptr;
 }
 
 template <class KeyType, class ValueType>
 bool AggregationProcessor<KeyType, ValueType>::needsProcessInput() {
-    if (curMap == nullptr) {
+    if ((curMap == nullptr) && (!hasBlock)) {
         return false;
     } else {
         return true;
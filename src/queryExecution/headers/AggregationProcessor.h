@@ -5,6 +5,7 @@
 #include "UseTemporaryAllocationBlock.h"
 #include "InterfaceFunctions.h"
 #include "AggregationMap.h"
+#include "ColumnBlock.h"
 #include "PDBMap.h"
 #include "PDBVector.h"
 #include "Handle.h"
@@ -31,8 +32,11 @@ public:
     int getNumHashKeys() override;
 
 private:
+    // adds a pair to the output map; throws NotEnoughSpace, leaving the map as it was
+    void aggregate(KeyType& curKey, ValueType& curValue);
+
     UseTemporaryAllocationBlockPtr blockPtr;
-    Handle<Vector<Handle<AggregationMap<KeyType, ValueType>>>> inputData;
+    Handle<Vector<Handle<Object>>> inputData;
     Handle<Map<KeyType, ValueType>> outputData;
     bool finalized;
     Handle<AggregationMap<KeyType, ValueType>> curMap;
@@ -42,6 +46,11 @@ private:
     PDBMapIterator<KeyType, ValueType>* begin;
     PDBMapIterator<KeyType, ValueType>* end;
 
+    // the column block of my partition that is being aggregated, if the page holds blocks
+    ColumnBlock<KeyType, ValueType> curBlock;
+    bool hasBlock = false;
+    size_t posInBlock = 0;
+
     // statistics
     int numHashKeys;
 };
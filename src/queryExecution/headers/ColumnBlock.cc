@@ -0,0 +1,111 @@
+#ifndef COLUMN_BLOCK_CC
+#define COLUMN_BLOCK_CC
+
+#include "ColumnBlock.h"
+#include <string.h>
+
+namespace pdb {
+
+
+template <class T>
+void Column<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>::write(
+    Vector<Handle<Object>>& block, std::vector<T*>& values) {
+    Handle<Vector<T>> column = makeObject<Vector<T>>(values.size(), values.size());
+    T* data = column->c_ptr();
+    for (size_t i = 0; i < values.size(); i++) {
+        data[i] = *(values[i]);
+    }
+    block.push_back(column);
+}
+
+template <class T>
+int Column<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>::attach(
+    Vector<Handle<Object>>& block, int where) {
+    values = unsafeCast<Vector<T>, Object>(block[where]);
+    data = values->c_ptr();
+    return where + 1;
+}
+
+inline void Column<String>::write(Vector<Handle<Object>>& block, std::vector<String*>& values) {
+    size_t numChars = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        numChars += values[i]->size() - 1;
+    }
+    Handle<Vector<char>> charColumn = makeObject<Vector<char>>(numChars, numChars);
+    Handle<Vector<uint32_t>> endColumn =
+        makeObject<Vector<uint32_t>>(values.size(), values.size());
+    char* chars = charColumn->c_ptr();
+    uint32_t* ends = endColumn->c_ptr();
+    uint32_t end = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        size_t length = values[i]->size() - 1;
+        memcpy(chars + end, values[i]->c_str(), length);
+        end += length;
+        ends[i] = end;
+    }
+    block.push_back(charColumn);
+    block.push_back(endColumn);
+}
+
+inline int Column<String>::attach(Vector<Handle<Object>>& block, int where) {
+    charColumn = unsafeCast<Vector<char>, Object>(block[where]);
+    endColumn = unsafeCast<Vector<uint32_t>, Object>(block[where + 1]);
+    chars = charColumn->c_ptr();
+    ends = endColumn->c_ptr();
+    return where + 2;
+}
+
+template <class KeyType, class ValueType>
+bool ColumnBlock<KeyType, ValueType>::isColumnBlock(Handle<Object>& object) {
+    return Supported::value && (object != nullptr) &&
+        (object.getTypeCode() == getTypeID<Vector<Handle<Object>>>());
+}
+
+template <class KeyType, class ValueType>
+Handle<Object> ColumnBlock<KeyType, ValueType>::write(AggregationMap<KeyType, ValueType>& map,
+                                                      std::true_type) {
+
+    // collect the pairs first, so that each column is allocated once with its final size
+    std::vector<KeyType*> keysToWrite;
+    std::vector<ValueType*> valuesToWrite;
+    keysToWrite.reserve(map.size());
+    valuesToWrite.reserve(map.size());
+    PDBMapIterator<KeyType, ValueType> begin(map.getArray(), true);
+    PDBMapIterator<KeyType, ValueType> end(map.getArray());
+    while (begin != end) {
+        keysToWrite.push_back(&((*begin).key));
+        valuesToWrite.push_back(&((*begin).value));
+        ++begin;
+    }
+
+    Handle<Vector<Handle<Object>>> block = makeObject<Vector<Handle<Object>>>(5);
+    Handle<Vector<uint32_t>> header = makeObject<Vector<uint32_t>>(2);
+    header->push_back(map.getHashPartitionId());
+    header->push_back(keysToWrite.size());
+    block->push_back(header);
+    Column<KeyType>::write(*block, keysToWrite);
+    Column<ValueType>::write(*block, valuesToWrite);
+    return block;
+}
+
+template <class KeyType, class ValueType>
+void ColumnBlock<KeyType, ValueType>::attach(Handle<Object>& object, std::true_type) {
+    block = unsafeCast<Vector<Handle<Object>>, Object>(object);
+    Handle<Vector<uint32_t>> header = unsafeCast<Vector<uint32_t>, Object>((*block)[0]);
+    hashPartitionId = (*header)[0];
+    numPairs = (*header)[1];
+    int where = keys.attach(*block, 1);
+    values.attach(*block, where);
+}
+
+template <class KeyType, class ValueType>
+void ColumnBlock<KeyType, ValueType>::clear(std::true_type) {
+    keys.clear();
+    values.clear();
+    block = nullptr;
+    numPairs = 0;
+}
+}
+
+
+#endif
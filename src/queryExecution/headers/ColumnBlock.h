@@ -0,0 +1,187 @@
+#ifndef COLUMN_BLOCK_H
+#define COLUMN_BLOCK_H
+
+
+#include "InterfaceFunctions.h"
+#include "AggregationMap.h"
+#include "PDBMap.h"
+#include "PDBVector.h"
+#include "PDBString.h"
+#include "Handle.h"
+#include "DataTypes.h"
+#include <type_traits>
+#include <vector>
+
+namespace pdb {
+
+// this class writes and reads one column of a column block; a type that can not be laid out as
+// a column has no column to write or read, so that using it does not compile, and ColumnBlock
+// only goes to the columns of pairs whose types are both columnar
+template <class T, class Enable = void>
+class Column {
+
+public:
+    static const bool isColumnar = false;
+};
+
+// a column of a primitive type is a Vector of that type
+template <class T>
+class Column<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+
+public:
+    static const bool isColumnar = true;
+
+    static void write(Vector<Handle<Object>>& block, std::vector<T*>& values);
+
+    // reads the column that starts at the given position of the block, and returns the position
+    // of the next column
+    int attach(Vector<Handle<Object>>& block, int where);
+
+    T get(size_t which) {
+        return data[which];
+    }
+
+    void clear() {
+        values = nullptr;
+        data = nullptr;
+    }
+
+private:
+    Handle<Vector<T>> values;
+
+    T* data = nullptr;
+};
+
+// a column of Strings is a Vector<char> with the characters of all strings, followed by a
+// Vector<uint32_t> with the offset where each string ends
+template <>
+class Column<String> {
+
+public:
+    static const bool isColumnar = true;
+
+    static void write(Vector<Handle<Object>>& block, std::vector<String*>& values);
+
+    int attach(Vector<Handle<Object>>& block, int where);
+
+    String get(size_t which) {
+        uint32_t begin = (which == 0) ? 0 : ends[which - 1];
+        return String(chars + begin, ends[which] - begin);
+    }
+
+    void clear() {
+        charColumn = nullptr;
+        endColumn = nullptr;
+        chars = nullptr;
+        ends = nullptr;
+    }
+
+private:
+    Handle<Vector<char>> charColumn;
+
+    Handle<Vector<uint32_t>> endColumn;
+
+    char* chars = nullptr;
+
+    uint32_t* ends = nullptr;
+};
+
+
+// A column block carries the key-value pairs of one hash partition of a combiner page column by
+// column: no empty hash slots, no per-pair headers, and String keys packed back to back.  It is
+// a Vector<Handle<Object>> holding a Vector<uint32_t> with the hash partition id and the number of
+// pairs, followed by the key column and the value column.  The aggregation reads the pairs
+// straight out of the columns into its own map.  Only combiner pages are written this way; the
+// hash partition, shuffle and broadcast sinks ship their pages as objects.
+
+template <class KeyType, class ValueType>
+class ColumnBlock {
+
+public:
+    // whether pairs of these types can be written as column blocks
+    static bool isSupported() {
+        return Supported::value;
+    }
+
+    // whether a shuffled object is a column block rather than an AggregationMap; never true for
+    // pairs that can not be written as column blocks
+    static bool isColumnBlock(Handle<Object>& object);
+
+    // writes the pairs of the map as a column block to the current allocation block; throws
+    // NotEnoughSpace if the block does not fit, and returns nullptr if the pairs are not supported
+    static Handle<Object> write(AggregationMap<KeyType, ValueType>& map) {
+        return write(map, Supported());
+    }
+
+    // reads the given column block
+    void attach(Handle<Object>& object) {
+        attach(object, Supported());
+    }
+
+    void clear() {
+        clear(Supported());
+    }
+
+    HashPartitionID getHashPartitionId() {
+        return hashPartitionId;
+    }
+
+    size_t size() {
+        return numPairs;
+    }
+
+    // calls process with each pair from the given position on; the position moves past a pair
+    // once it is processed, so that the pairs left are processed again after process throws
+    template <class Process>
+    void forEachPair(size_t& which, Process process) {
+        forEachPair(which, process, Supported());
+    }
+
+private:
+    typedef std::integral_constant<bool,
+                                   Column<KeyType>::isColumnar && Column<ValueType>::isColumnar>
+        Supported;
+
+    static Handle<Object> write(AggregationMap<KeyType, ValueType>& map, std::true_type);
+
+    static Handle<Object> write(AggregationMap<KeyType, ValueType>& map, std::false_type) {
+        return nullptr;
+    }
+
+    void attach(Handle<Object>& object, std::true_type);
+
+    void attach(Handle<Object>& object, std::false_type) {}
+
+    void clear(std::true_type);
+
+    void clear(std::false_type) {}
+
+    template <class Process>
+    void forEachPair(size_t& which, Process& process, std::true_type) {
+        while (which < numPairs) {
+            process(keys.get(which), values.get(which));
+            which++;
+        }
+    }
+
+    template <class Process>
+    void forEachPair(size_t& which, Process& process, std::false_type) {}
+
+
+    Handle<Vector<Handle<Object>>> block;
+
+    HashPartitionID hashPartitionId = 0;
+
+    size_t numPairs = 0;
+
+    Column<KeyType> keys;
+
+    Column<ValueType> values;
+};
+}
+
+
+#include "ColumnBlock.cc"
+
+
+#endif
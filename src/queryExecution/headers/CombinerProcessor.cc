@@ -215,6 +215,35 @@ void CombinerProcessor<KeyType, ValueType>::clearOutputPage() {
     curOutputMap = nullptr;
 }
 
+// writes each partition of the output page as a column block, if the pairs can be laid out as
+// columns and the blocks fit in the given page
+template <class KeyType, class ValueType>
+size_t CombinerProcessor<KeyType, ValueType>::compactOutputPage(void* pageToWriteTo,
+                                                                size_t numBytesInPage) {
+    if ((!ColumnBlock<KeyType, ValueType>::isSupported()) || (outputData == nullptr)) {
+        return 0;
+    }
+    // the blocks are let go only once the page is no longer the allocation block, as an output
+    // page is, so that they stay intact
+    Handle<Vector<Handle<Object>>> blocks = nullptr;
+    size_t numBytes = 0;
+    try {
+        const UseTemporaryAllocationBlock block{pageToWriteTo, numBytesInPage};
+        blocks = makeObject<Vector<Handle<Object>>>(this->numNodePartitions);
+        for (int i = 0; i < numNodePartitions; i++) {
+            blocks->push_back(ColumnBlock<KeyType, ValueType>::write(*((*outputData)[i])));
+        }
+        Record<Vector<Handle<Object>>>* record = getRecord(blocks);
+        numBytes = record->numBytes();
+    } catch (NotEnoughSpace& n) {
+        PDB_COUT << "CombinerProcessor: column blocks do not fit in a page, ship the maps"
+                 << std::endl;
+        numBytes = 0;
+    }
+    blocks = nullptr;
+    return numBytes;
+}
+
 template <class KeyType, class ValueType>
 void CombinerProcessor<KeyType, ValueType>::clearInputPage() {
     inputData = nullptr;
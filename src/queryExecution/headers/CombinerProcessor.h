@@ -6,6 +6,7 @@
 #include "InterfaceFunctions.h"
 #include "PDBMap.h"
 #include "AggregationMap.h"
+#include "ColumnBlock.h"
 #include "PDBVector.h"
 #include "Handle.h"
 #include "SimpleSingleTableQueryProcessor.h"
@@ -34,6 +35,7 @@ public:
     bool fillNextOutputPage() override;
     void finalize() override;
     void clearOutputPage() override;
+    size_t compactOutputPage(void* pageToWriteTo, size_t numBytesInPage) override;
     void clearInputPage() override;
     void addNodePartition(HashPartitionID partitionId);
 
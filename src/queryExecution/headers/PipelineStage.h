@@ -15,6 +15,7 @@
 #include "PartitionedHashSet.h"
 #include "SetSpecifier.h"
 #include "DataProxy.h"
+#include "ShuffleCodecPolicy.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -69,12 +70,18 @@ private:
     // shared memory
     SharedMemPtr shm;
 
+    // the scanner of the user set this stage reads, if it reads one
+    PageScannerPtr scanner = nullptr;
+
     // operator id
     OperatorID id;
 
     // vector of nodeId for shuffling
     std::vector<int> nodeIds;
 
+    // how the pages this stage shuffles or broadcasts are compressed
+    ShuffleCodecPolicyPtr codecPolicy;
+
 
 public:
     // destructor
@@ -89,20 +96,39 @@ public:
                   size_t batchSize,
                   int numThreads);
 
-    // store shuffle data
+    // store shuffle data; lastOfStream marks the last data this node sends to the set while the
+    // consumer of the set is already scanning it
     bool storeShuffleData(Handle<Vector<Handle<Object>>> data,
                           std::string databaseName,
                           std::string setName,
                           std::string address,
                           int port,
-                          std::string& errMsg);
+                          std::string& errMsg,
+                          bool lastOfStream = false);
+    // store shuffle data that compressPage has compressed
     bool storeCompressedShuffleData(char* bytes,
                                     size_t numBytes,
                                     std::string databaseName,
                                     std::string setName,
                                     std::string address,
                                     int port,
-                                    std::string& errMsg);
+                                    std::string& errMsg,
+                                    bool lastOfStream = false);
+
+    // compress a page of shuffle data and store it
+    bool compressAndStoreShuffleData(char* bytes,
+                                     size_t numBytes,
+                                     std::string databaseName,
+                                     std::string setName,
+                                     std::string address,
+                                     int port,
+                                     std::string& errMsg,
+                                     bool lastOfStream = false);
+
+    // compress a page with the codec of this stage into a frame taken from the PageCodec pool,
+    // which the caller releases; returns the size of the frame
+    size_t compressPage(char* bytes, size_t numBytes, char*& frame);
+
     // send Shuffle data
     bool sendData(PDBCommunicatorPtr conn,
                   char* bytes,
@@ -163,8 +189,9 @@ public:
     // run a pipeline without combining
     void runPipeline(HermesExecutionServer* server);
 
-    // run a pipeline with combiner queue
-    void runPipelineWithShuffleSink(HermesExecutionServer* server);
+    // run a pipeline with combiner queue; returns false with the error if some combined pages
+    // could not be sent
+    bool runPipelineWithShuffleSink(HermesExecutionServer* server, std::string& shuffleErrMsg);
 
     // run a pipeline with shuffle buffers
     void runPipelineWithBroadcastSink(HermesExecutionServer* server);
@@ -0,0 +1,80 @@
+
+#ifndef SHUFFLE_CODEC_POLICY_H
+#define SHUFFLE_CODEC_POLICY_H
+
+#include "PageCodec.h"
+#include <pthread.h>
+#include <memory>
+#include <string>
+
+// in adaptive mode, while compression does not pay, every so many pages are still compressed to
+// measure again whether it would
+#ifndef PDB_ADAPTIVE_PROBE_INTERVAL
+#define PDB_ADAPTIVE_PROBE_INTERVAL 16
+#endif
+
+// in adaptive mode, pages that do not shrink below this fraction of their size are sent as they
+// are, whatever the network
+#ifndef PDB_ADAPTIVE_MAX_RATIO
+#define PDB_ADAPTIVE_MAX_RATIO 0.9
+#endif
+
+namespace pdb {
+
+class ShuffleCodecPolicy;
+typedef std::shared_ptr<ShuffleCodecPolicy> ShuffleCodecPolicyPtr;
+
+// This class decides how the pages that a stage shuffles or broadcasts are compressed.  It is
+// configured with a codec name as PageCodec parses it, or with "adaptive", optionally followed by
+// the codec to use, e.g. "adaptive:zstd:1".
+//
+// In adaptive mode, the senders report how long compressing and sending took, and a page is
+// compressed only while the time that compression costs per byte is smaller than the time it
+// saves on the wire, i.e. while the network, not the CPU, is the bottleneck.  When the network
+// sits idle, sending is cheap, and the pages go out as they are.
+
+class ShuffleCodecPolicy {
+
+public:
+    // parses the codec of a stage; a name that can not be parsed is taken as "adaptive"
+    explicit ShuffleCodecPolicy(std::string spec);
+
+    ~ShuffleCodecPolicy();
+
+    // returns the codec to compress the next page with
+    PageCodecType nextCodec(int& level);
+
+    // reports that numBytes were compressed into frameSize bytes in nanos
+    void recordCompression(PageCodecType codec, size_t numBytes, size_t frameSize, long nanos);
+
+    // reports that numBytes went over the wire in nanos
+    void recordSend(size_t numBytes, long nanos);
+
+    // returns the codec and the mode, for the logs
+    std::string getName();
+
+private:
+    PageCodecType codec;
+
+    int level;
+
+    bool adaptive;
+
+    pthread_mutex_t mutex;
+
+    // whether the adaptive mode currently compresses
+    bool compressing;
+
+    int pagesSinceProbe;
+
+    // moving averages of the nanoseconds to compress an input byte, the nanoseconds to send a byte,
+    // and the size of a compressed page over the size of the page; negative until measured
+    double compressNanosPerByte;
+
+    double sendNanosPerByte;
+
+    double ratio;
+};
+}
+
+#endif
@@ -0,0 +1,86 @@
+
+#ifndef SHUFFLE_SENDER_H
+#define SHUFFLE_SENDER_H
+
+#include "PDBWorker.h"
+#include <pthread.h>
+#include <deque>
+#include <memory>
+#include <string>
+
+// how many pages can wait for a shuffle sender before the thread that hands them over blocks
+#ifndef PDB_SHUFFLE_SENDER_QUEUE_SIZE
+#define PDB_SHUFFLE_SENDER_QUEUE_SIZE 1
+#endif
+
+namespace pdb {
+
+class PipelineStage;
+
+class ShuffleSender;
+typedef std::shared_ptr<ShuffleSender> ShuffleSenderPtr;
+
+// This class compresses and sends the pages that a combiner produces for one node on a worker of
+// its own, so that the combiner goes on merging the next page while the previous one is being
+// compressed and sent.
+
+class ShuffleSender {
+
+public:
+    ShuffleSender(PipelineStage* stage,
+                  std::string address,
+                  int port,
+                  std::string databaseName,
+                  std::string setName);
+
+    ~ShuffleSender();
+
+    // starts sending on the given worker
+    void start(PDBWorkerPtr worker);
+
+    // hands over a page allocated with malloc, which is freed once it is sent; blocks while the
+    // queue is full
+    void send(char* page, size_t numBytes, bool lastOfStream = false);
+
+    // waits until every page handed over is sent; returns false with the error of the first page
+    // that could not be sent
+    bool close(std::string& errMsg);
+
+private:
+    struct PageToSend {
+        char* page;
+        size_t numBytes;
+        bool lastOfStream;
+    };
+
+    // the loop of the worker
+    void run();
+
+    PipelineStage* stage;
+
+    std::string address;
+
+    int port;
+
+    std::string databaseName;
+
+    std::string setName;
+
+    pthread_mutex_t mutex;
+
+    pthread_cond_t signal;
+
+    std::deque<PageToSend> pages;
+
+    bool closed;
+
+    bool done;
+
+    // set once a page could not be sent; the pages after it are dropped
+    bool failed;
+
+    std::string failure;
+};
+}
+
+#endif
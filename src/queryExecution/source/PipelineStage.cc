@@ -12,6 +12,7 @@
 #include "PDBDebug.h"
 #include "PipelineStage.h"
 #include "PageCircularBufferIterator.h"
+#include "HardwareCounters.h"
 #include "DataProxy.h"
 #include "PageScanner.h"
 #include "PageCircularBufferIterator.h"
@@ -29,9 +30,10 @@
 #include "ShuffleSink.h"
 #include "HashPartitionWork.h"
 #include "PartitionComp.h"
-#ifdef ENABLE_COMPRESSION
-#include <snappy.h>
-#endif
+#include "ExecutionProfiler.h"
+#include "PageCodec.h"
+#include "ShuffleSender.h"
+#include "LockGuard.h"
 
 #include <fstream>
 
@@ -67,6 +69,12 @@ PipelineStage::PipelineStage(Handle<TupleSetJobStage> stage,
     for (int i = 0; i < numNodes; i++) {
         nodeIds.push_back(i);
     }
+    std::string shuffleCodec = this->jobStage->getShuffleCodec();
+    if (shuffleCodec == "") {
+        shuffleCodec = conf->getShuffleCodec();
+    }
+    this->codecPolicy = make_shared<ShuffleCodecPolicy>(shuffleCodec);
+    PDB_COUT << "shuffle codec is " << codecPolicy->getName() << std::endl;
 }
 
 
@@ -88,14 +96,16 @@ bool PipelineStage::storeShuffleData(Handle<Vector<Handle<Object>>> data,
                                      std::string setName,
                                      std::string address,
                                      int port,
-                                     std::string& errMsg) {
+                                     std::string& errMsg,
+                                     bool lastOfStream) {
     if (port <= 0) {
         port = conf->getPort();
     }
     std::cout << "store shuffle data to address=" << address << " and port=" << port
               << ", with size = " << data->size() << " to database=" << databaseName
               << " and set=" << setName << " and type = IntermediateData" << std::endl;
-    return simpleSendDataRequest<StorageAddData, Handle<Object>, SimpleRequestResult, bool>(
+    long begin = ExecutionProfiler::now();
+    bool ret = simpleSendDataRequest<StorageAddData, Handle<Object>, SimpleRequestResult, bool>(
         logger,
         port,
         address,
@@ -114,7 +124,13 @@ bool PipelineStage::storeShuffleData(Handle<Vector<Handle<Object>>> data,
         setName,
         "IntermediateData",
         false,
-        false);
+        false,
+        false,
+        false,
+        lastOfStream);
+    ExecutionProfiler::record("shuffle send", ExecutionProfiler::now() - begin, data->size(), 0,
+                              getRecord(data)->numBytes());
+    return ret;
 }
 
 bool PipelineStage::storeCompressedShuffleData(char* bytes,
@@ -123,14 +139,16 @@ bool PipelineStage::storeCompressedShuffleData(char* bytes,
                                                std::string setName,
                                                std::string address,
                                                int port,
-                                               std::string& errMsg) {
+                                               std::string& errMsg,
+                                               bool lastOfStream) {
     if (port <= 0) {
         port = conf->getPort();
     }
     std::cout << "store shuffle data to address=" << address << " and port=" << port
               << ", with compressed byte size = " << numBytes << " to database=" << databaseName
               << " and set=" << setName << " and type = IntermediateData" << std::endl;
-    return simpleSendBytesRequest<StorageAddData, SimpleRequestResult, bool>(
+    long begin = ExecutionProfiler::now();
+    bool ret = simpleSendBytesRequest<StorageAddData, SimpleRequestResult, bool>(
         logger,
         port,
         address,
@@ -151,7 +169,45 @@ bool PipelineStage::storeCompressedShuffleData(char* bytes,
         "IntermediateData",
         false,
         false,
-        true);
+        true,
+        false,
+        lastOfStream);
+    long nanos = ExecutionProfiler::now() - begin;
+    codecPolicy->recordSend(numBytes, nanos);
+    ExecutionProfiler::record("shuffle send", nanos, 0, 0, numBytes);
+    return ret;
+}
+
+bool PipelineStage::compressAndStoreShuffleData(char* bytes,
+                                                size_t numBytes,
+                                                std::string databaseName,
+                                                std::string setName,
+                                                std::string address,
+                                                int port,
+                                                std::string& errMsg,
+                                                bool lastOfStream) {
+    char* frame = nullptr;
+    size_t frameSize = compressPage(bytes, numBytes, frame);
+    bool ret = storeCompressedShuffleData(
+        frame, frameSize, databaseName, setName, address, port, errMsg, lastOfStream);
+    PageCodec::releaseBuffer(frame);
+    return ret;
+}
+
+size_t PipelineStage::compressPage(char* bytes, size_t numBytes, char*& frame) {
+    int level;
+    PageCodecType codec = codecPolicy->nextCodec(level);
+    long begin = ExecutionProfiler::now();
+    frame = PageCodec::getBuffer(PageCodec::maxFrameSize(codec, numBytes));
+    size_t frameSize = PageCodec::compress(codec, level, bytes, numBytes, frame);
+    long nanos = ExecutionProfiler::now() - begin;
+    codecPolicy->recordCompression(codec, numBytes, frameSize, nanos);
+    if (codec != NoCodec) {
+        ExecutionProfiler::record("shuffle compress", nanos, 0, 0, numBytes);
+    }
+    PDB_COUT << "size before compression is " << numBytes << " and size after compression is "
+             << frameSize << std::endl;
+    return frameSize;
 }
 
 // broadcast data
@@ -163,6 +219,7 @@ bool PipelineStage::sendData(PDBCommunicatorPtr conn,
                              std::string& errMsg,
                              int counter) {
     bool success;
+    long sendBegin = ExecutionProfiler::now();
     if (data != nullptr) {
 #ifdef DEBUG_SHUFFLING
         // write the data to a test file
@@ -173,33 +230,32 @@ bool PipelineStage::sendData(PDBCommunicatorPtr conn,
         fclose(myFile);
 #endif
 
+        char* frame = nullptr;
+        size_t frameSize = compressPage(data, size, frame);
+        sendBegin = ExecutionProfiler::now();
         Handle<StorageAddObjectInLoop> request = makeObject<StorageAddObjectInLoop>(
             databaseName, setName, "IntermediateData", false, false);
         conn->sendObject(request, errMsg);
-#ifdef ENABLE_COMPRESSION
-        size_t maxSize = snappy::MaxCompressedLength(size);
-        char* compressedBytes = new char[maxSize];
-        if (compressedBytes == nullptr) {
-           std::cout << "PipelineStage.cc: failed to allocate memory with size=" << size << std::endl;
-           exit(1);
-        }
-        memset(compressedBytes, 0, maxSize);
-        size_t compressedSize = 0;
-        snappy::RawCompress((char*)data, size, compressedBytes, &compressedSize);
-        std::cout << "size before compression is " << size << " and size after compression is "
-                  << compressedSize << std::endl;
         errMsg = "";
-        conn->sendBytes(compressedBytes, compressedSize, errMsg);
-        delete[] compressedBytes;
-#else
-        conn->sendBytes(data, size, errMsg);
-#endif
+        conn->sendBytes(frame, frameSize, errMsg);
+        PageCodec::releaseBuffer(frame);
+        size = frameSize;
     } else {
         Handle<StorageAddObjectInLoop> request = makeObject<StorageAddObjectInLoop>();
         request->setLoopEnded();
         conn->sendObject(request, errMsg);
     }
     Handle<SimpleRequestResult> result = conn->getNextObject<SimpleRequestResult>(success, errMsg);
+    if (data != nullptr) {
+        long nanos = ExecutionProfiler::now() - sendBegin;
+        codecPolicy->recordSend(size, nanos);
+        ExecutionProfiler::record("shuffle send", nanos, 0, 0, size);
+    }
+    if (result != nullptr && !result->getRes().first) {
+        logger->error("Error sending data: " + result->getRes().second);
+        errMsg = "Error sending data: " + result->getRes().second;
+        return false;
+    }
     return true;
 }
 
@@ -236,16 +292,18 @@ std::vector<PageCircularBufferIteratorPtr> PipelineStage::getUserSetIterators(
     PDBLoggerPtr scannerLogger = make_shared<PDBLogger>("scanner.log");
     // getScanner
     int backendCircularBufferSize = getBackendCircularBufferSize(success, errMsg);
-    PageScannerPtr scanner = make_shared<PageScanner>(communicatorToFrontend,
-                                                      shm,
-                                                      scannerLogger,
-                                                      numScanThreads,
-                                                      backendCircularBufferSize,
-                                                      nodeId);
+    scanner = make_shared<PageScanner>(communicatorToFrontend,
+                                       shm,
+                                       scannerLogger,
+                                       numScanThreads,
+                                       backendCircularBufferSize,
+                                       nodeId);
 
     std::vector<PageCircularBufferIteratorPtr> iterators;
 
-    if (server->getFunctionality<HermesExecutionServer>().setCurPageScanner(scanner) == false) {
+    if (server->getFunctionality<HermesExecutionServer>().setCurPageScanner(
+            scanner, jobStage->isPipelinedWithConsumer()) == false) {
+        scanner = nullptr;
         success = false;
         errMsg = "Error: A job is already running!";
         std::cout << errMsg << std::endl;
@@ -1091,10 +1149,24 @@ void PipelineStage::runPipeline(HermesExecutionServer* server,
             // set allocator policy
             getAllocator().setPolicy(jobStage->getAllocatorPolicy());
 
+            // count TLB misses and page faults of this pipeline for the stage profile
+            HardwareCounters counters;
+            counters.start();
+
             // setup an output page to store intermediate results and final output
             executePipelineWork(
                 i, outputSet, iterators, hashSet, proxy, sinkBuffers, server, partitionedSetForSink, errMsg);
 
+            counters.stop();
+            if (counters.getDTLBMisses() >= 0) {
+                ExecutionProfiler::count("pipeline dTLB misses", counters.getDTLBMisses());
+            }
+            if (counters.getITLBMisses() >= 0) {
+                ExecutionProfiler::count("pipeline iTLB misses", counters.getITLBMisses());
+            }
+            ExecutionProfiler::count("pipeline minor faults", counters.getMinorFaults());
+            ExecutionProfiler::count("pipeline major faults", counters.getMajorFaults());
+
             // restore allocator policy
             getAllocator().setPolicy(AllocatorPolicy::defaultAllocator);
 #ifdef PROFILING
@@ -1199,19 +1271,17 @@ void PipelineStage::runPipeline(HermesExecutionServer* server,
     pthread_mutex_destroy(&connection_mutex);
 
 
-    if (server->getFunctionality<HermesExecutionServer>().setCurPageScanner(nullptr) == false) {
-        success = false;
-        errMsg = "Error: No job is running!";
-        std::cout << errMsg << std::endl;
-        return;
-    }
+    // the consumer of a pipeline may still be scanning, so only our own scanner goes
+    server->getFunctionality<HermesExecutionServer>().removePageScanner(scanner);
+    scanner = nullptr;
 
     return;
 }
 
 
 // below method will run the combiner
-void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
+bool PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server,
+                                               std::string& shuffleErrMsg) {
     bool success;
     std::string errMsg;
 
@@ -1262,6 +1332,11 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
     pthread_mutex_t connection_mutex;
     pthread_mutex_init(&connection_mutex, nullptr);
 
+    // the first failure of the combiners to send their pages
+    pthread_mutex_t shuffle_mutex;
+    pthread_mutex_init(&shuffle_mutex, nullptr);
+    bool shuffleSuccess = true;
+
     // create a buzzer and counter
     PDBBuzzerPtr combinerBuzzer =
         make_shared<PDBBuzzer>([&](PDBAlarm myAlarm, atomic_int& combinerCounter) {
@@ -1351,7 +1426,8 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
             // get combiner processor
             SimpleSingleTableQueryProcessorPtr combinerProcessor =
                 aggregate->getCombinerProcessor(stdPartitions);
-            size_t myCombinerPageSize = combinerPageSize;
+            // the page being filled and the page being sent share the memory tuned for one page
+            size_t myCombinerPageSize = combinerPageSize / 2;
             if (myCombinerPageSize > conf->getShufflePageSize() - 64) {
                 myCombinerPageSize = conf->getShufflePageSize() - 64;
             }
@@ -1366,6 +1442,48 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
                       << std::endl;
             combinerProcessor->loadOutputPage(combinerPage, myCombinerPageSize);
 
+            // the full pages are compressed and sent while we merge into the next one
+            ShuffleSenderPtr sender =
+                make_shared<ShuffleSender>(this,
+                                           address,
+                                           port,
+                                           this->jobStage->getSinkContext()->getDatabase(),
+                                           this->jobStage->getSinkContext()->getSetName());
+            sender->start(
+                server->getFunctionality<HermesExecutionServer>().getWorkers()->getWorker());
+
+            // ships the filled combiner page, as column blocks if the processor can write them,
+            // and leaves a free page in combinerPage
+            auto shipCombinerPage = [&](bool lastOfStream) {
+                void* compactPage = (void*)malloc(myCombinerPageSize * sizeof(char));
+                if (compactPage == nullptr) {
+                    std::cout << "Fatal Error: insufficient memory can be allocated from memory"
+                              << std::endl;
+                    exit(-1);
+                }
+                long compactBegin = ExecutionProfiler::now();
+                size_t numBytes =
+                    combinerProcessor->compactOutputPage(compactPage, myCombinerPageSize);
+                void* pageToSend = compactPage;
+                if (numBytes == 0) {
+                    Record<Vector<Handle<Object>>>* record =
+                        (Record<Vector<Handle<Object>>>*)combinerPage;
+                    numBytes = record->numBytes();
+                    pageToSend = combinerPage;
+                    combinerPage = compactPage;
+                    // counted rather than printed, as it happens for every page of some stages
+                    ExecutionProfiler::record("combiner map pages", 0, 0, 0, numBytes);
+                } else {
+                    ExecutionProfiler::record("combiner compact",
+                                              ExecutionProfiler::now() - compactBegin,
+                                              0,
+                                              0,
+                                              numBytes);
+                }
+                combinerProcessor->clearOutputPage();
+                sender->send((char*)pageToSend, numBytes, lastOfStream);
+            };
+
             PageCircularBufferIteratorPtr myIter = combinerIters[i];
             int numPages = 0;
             while (myIter->hasNext()) {
@@ -1375,62 +1493,26 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
                     // to load input page
                     numPages++;
                     std::cout << "to load a page to combiner processor" << std::endl;
+                    long mergeBegin = ExecutionProfiler::now();
                     combinerProcessor->loadInputPage(page->getBytes());
                     std::cout << "loaded a page to combiner processor" << std::endl;
-                    while (combinerProcessor->fillNextOutputPage()) {
+                    long mergeNanos = 0;
+                    // the time to send the output pages is recorded as shuffle send
+                    auto fillNextOutputPage = [&]() {
+                        bool full = combinerProcessor->fillNextOutputPage();
+                        mergeNanos += ExecutionProfiler::now() - mergeBegin;
+                        return full;
+                    };
+                    while (fillNextOutputPage()) {
                         // send out the output page
-                        Record<Vector<Handle<Object>>>* record =
-                            (Record<Vector<Handle<Object>>>*)combinerPage;
-#ifndef ENABLE_COMPRESSION
-                        std::cout << "to store shuffle data" << std::endl;
-                        this->storeShuffleData(record->getRootObject(),
-                                               this->jobStage->getSinkContext()->getDatabase(),
-                                               this->jobStage->getSinkContext()->getSetName(),
-                                               address,
-                                               port,
-                                               errMsg);
-#else
-                        char* compressedBytes =
-                            new char[snappy::MaxCompressedLength(record->numBytes())];
-                        if (compressedBytes == nullptr) {
-                            std::cout << "PipelineStage.cc: failed to allocate memory" << std::endl;
-                            exit(1);
-                        }
-                        size_t compressedSize;
-                        snappy::RawCompress(
-                            (char*)record, record->numBytes(), compressedBytes, &compressedSize);
-                        std::cout << "size before compression is " << record->numBytes()
-                                  << " and size after compression is " << compressedSize
-                                  << std::endl;
-                        this->storeCompressedShuffleData(
-                            compressedBytes,
-                            compressedSize,
-                            this->jobStage->getSinkContext()->getDatabase(),
-                            this->jobStage->getSinkContext()->getSetName(),
-                            address,
-                            port,
-                            errMsg);
-                        delete[] compressedBytes;
-
-#endif
-
-
-                        // free the output page
-                        combinerProcessor->clearOutputPage();
-                        free(combinerPage);
-                        // allocate a new page
-                        combinerPage = (void*)malloc(myCombinerPageSize * sizeof(char));
-                        if (combinerPage == nullptr) {
-                            std::cout
-                                << "Fatal Error: insufficient memory can be allocated from memory"
-                                << std::endl;
-                            exit(-1);
-                        }
+                        shipCombinerPage(false);
                         std::cout << "load a combiner page with size = " << myCombinerPageSize
                                   << std::endl;
                         // load the new page as output vector
                         combinerProcessor->loadOutputPage(combinerPage, myCombinerPageSize);
+                        mergeBegin = ExecutionProfiler::now();
                     }
+                    ExecutionProfiler::record("combiner merge", mergeNanos, 0, 0, page->getSize());
                     // unpin the input page
                     // combinerProcessor->clearInputPage();
                     page->decRefCount();
@@ -1444,38 +1526,15 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
             combinerProcessor->fillNextOutputPage();
             // send the output page
             std::cout << "processed " << numPages << " pages" << std::endl;
-            Record<Vector<Handle<Object>>>* record = (Record<Vector<Handle<Object>>>*)combinerPage;
-#ifndef ENABLE_COMPRESSION
-            this->storeShuffleData(record->getRootObject(),
-                                   this->jobStage->getSinkContext()->getDatabase(),
-                                   this->jobStage->getSinkContext()->getSetName(),
-                                   address,
-                                   port,
-                                   errMsg);
-#else
-            char* compressedBytes = new char[snappy::MaxCompressedLength(record->numBytes())];
-            if (compressedBytes == nullptr) {
-                std::cout << "PipelineStage.cc: failed to allocate memory" << std::endl;
-                exit(1);
+            shipCombinerPage(this->jobStage->isPipelinedWithConsumer());
+            std::string sendErrMsg;
+            if (!sender->close(sendErrMsg)) {
+                const LockGuard guard{shuffle_mutex};
+                if (shuffleSuccess) {
+                    shuffleSuccess = false;
+                    shuffleErrMsg = sendErrMsg;
+                }
             }
-            size_t compressedSize;
-            snappy::RawCompress(
-                (char*)record, record->numBytes(), compressedBytes, &compressedSize);
-            std::cout << "size before compression is " << record->numBytes()
-                      << " and size after compression is " << compressedSize << std::endl;
-            this->storeCompressedShuffleData(compressedBytes,
-                                             compressedSize,
-                                             this->jobStage->getSinkContext()->getDatabase(),
-                                             this->jobStage->getSinkContext()->getSetName(),
-                                             address,
-                                             port,
-                                             errMsg);
-            delete[] compressedBytes;
-
-#endif
-
-            // free the output page
-            combinerProcessor->clearOutputPage();
             free(combinerPage);
             getAllocator().setPolicy(defaultAllocator);
 #ifdef PROFILING
@@ -1510,7 +1569,8 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
     }
 
     combinerCounter = 0;
-    return;
+    pthread_mutex_destroy(&shuffle_mutex);
+    return shuffleSuccess;
 }
 
 // below method will run broadcasting
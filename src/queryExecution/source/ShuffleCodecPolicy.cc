@@ -0,0 +1,113 @@
+
+#ifndef SHUFFLE_CODEC_POLICY_CC
+#define SHUFFLE_CODEC_POLICY_CC
+
+#include "ShuffleCodecPolicy.h"
+#include "LockGuard.h"
+#include <iostream>
+
+namespace pdb {
+
+namespace {
+
+// the weight of the newest measurement in the moving averages
+const double newWeight = 0.25;
+
+void addToAverage(double& average, double value) {
+    if (average < 0) {
+        average = value;
+    } else {
+        average = (1 - newWeight) * average + newWeight * value;
+    }
+}
+}
+
+ShuffleCodecPolicy::ShuffleCodecPolicy(std::string spec) {
+    pthread_mutex_init(&mutex, nullptr);
+    adaptive = false;
+    compressing = true;
+    pagesSinceProbe = 0;
+    compressNanosPerByte = -1;
+    sendNanosPerByte = -1;
+    ratio = -1;
+
+    std::string codecName = spec;
+    if (spec.compare(0, 8, "adaptive") == 0) {
+        adaptive = true;
+        codecName = (spec.size() > 9) ? spec.substr(9) : "";
+    }
+    if (codecName == "" || !PageCodec::parse(codecName, codec, level)) {
+        if (codecName != "") {
+            std::cout << "ShuffleCodecPolicy: unknown codec " << spec << ", compress adaptively"
+                      << std::endl;
+            adaptive = true;
+        }
+        codec = PageCodec::isAvailable(LZ4Codec) ? LZ4Codec : SnappyCodec;
+        level = 0;
+    }
+    if (codec == NoCodec) {
+        adaptive = false;
+    }
+}
+
+ShuffleCodecPolicy::~ShuffleCodecPolicy() {
+    pthread_mutex_destroy(&mutex);
+}
+
+PageCodecType ShuffleCodecPolicy::nextCodec(int& level) {
+    level = this->level;
+    if (!adaptive) {
+        return codec;
+    }
+    const LockGuard guard{mutex};
+    if (compressing) {
+        return codec;
+    }
+    if (++pagesSinceProbe >= PDB_ADAPTIVE_PROBE_INTERVAL) {
+        pagesSinceProbe = 0;
+        return codec;
+    }
+    return NoCodec;
+}
+
+void ShuffleCodecPolicy::recordCompression(PageCodecType usedCodec,
+                                           size_t numBytes,
+                                           size_t frameSize,
+                                           long nanos) {
+    if (!adaptive || usedCodec == NoCodec || numBytes == 0) {
+        return;
+    }
+    const LockGuard guard{mutex};
+    addToAverage(compressNanosPerByte, (double)nanos / numBytes);
+    addToAverage(ratio, (double)frameSize / numBytes);
+}
+
+void ShuffleCodecPolicy::recordSend(size_t numBytes, long nanos) {
+    if (!adaptive || numBytes == 0) {
+        return;
+    }
+    const LockGuard guard{mutex};
+    addToAverage(sendNanosPerByte, (double)nanos / numBytes);
+    if (compressNanosPerByte < 0 || ratio < 0) {
+        return;
+    }
+
+    // compressing a byte costs compressNanosPerByte, and saves sending (1 - ratio) of it
+    bool pays = (ratio < PDB_ADAPTIVE_MAX_RATIO) &&
+        (compressNanosPerByte < sendNanosPerByte * (1 - ratio));
+    if (pays != compressing) {
+        std::cout << "ShuffleCodecPolicy: " << (pays ? "start" : "stop") << " compressing with "
+                  << PageCodec::getName(codec, level) << ", ratio=" << ratio
+                  << ", compress ns/byte=" << compressNanosPerByte
+                  << ", send ns/byte=" << sendNanosPerByte << std::endl;
+        compressing = pays;
+        pagesSinceProbe = 0;
+    }
+}
+
+std::string ShuffleCodecPolicy::getName() {
+    return (adaptive ? "adaptive:" : "") + PageCodec::getName(codec, level);
+}
+}
+
+#endif
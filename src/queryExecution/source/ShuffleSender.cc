@@ -0,0 +1,102 @@
+
+#ifndef SHUFFLE_SENDER_CC
+#define SHUFFLE_SENDER_CC
+
+#include "ShuffleSender.h"
+#include "PipelineStage.h"
+#include "GenericWork.h"
+#include "LockGuard.h"
+#include <iostream>
+#include <stdlib.h>
+
+namespace pdb {
+
+ShuffleSender::ShuffleSender(PipelineStage* stage,
+                             std::string address,
+                             int port,
+                             std::string databaseName,
+                             std::string setName)
+    : stage(stage), address(address), port(port), databaseName(databaseName), setName(setName) {
+    pthread_mutex_init(&mutex, nullptr);
+    pthread_cond_init(&signal, nullptr);
+    closed = false;
+    done = false;
+    failed = false;
+}
+
+ShuffleSender::~ShuffleSender() {
+    pthread_mutex_destroy(&mutex);
+    pthread_cond_destroy(&signal);
+}
+
+void ShuffleSender::start(PDBWorkerPtr worker) {
+    PDBWorkPtr myWork = make_shared<GenericWork>([this](PDBBuzzerPtr callerBuzzer) { run(); });
+    worker->execute(myWork, make_shared<PDBBuzzer>(nullptr));
+}
+
+void ShuffleSender::send(char* page, size_t numBytes, bool lastOfStream) {
+    const LockGuard guard{mutex};
+    while (pages.size() >= PDB_SHUFFLE_SENDER_QUEUE_SIZE) {
+        pthread_cond_wait(&signal, &mutex);
+    }
+    pages.push_back(PageToSend{page, numBytes, lastOfStream});
+    pthread_cond_broadcast(&signal);
+}
+
+bool ShuffleSender::close(std::string& errMsg) {
+    const LockGuard guard{mutex};
+    closed = true;
+    pthread_cond_broadcast(&signal);
+    while (!done) {
+        pthread_cond_wait(&signal, &mutex);
+    }
+    if (failed) {
+        errMsg = failure;
+        return false;
+    }
+    return true;
+}
+
+void ShuffleSender::run() {
+    while (true) {
+        PageToSend next;
+        {
+            const LockGuard guard{mutex};
+            while (pages.empty() && !closed) {
+                pthread_cond_wait(&signal, &mutex);
+            }
+            if (pages.empty()) {
+                break;
+            }
+            next = pages.front();
+            pages.pop_front();
+            pthread_cond_broadcast(&signal);
+        }
+        // once a page is lost the node has an incomplete stream, so the rest is only drained
+        if (!failed) {
+            std::string errMsg;
+            if (!stage->compressAndStoreShuffleData(next.page,
+                                                    next.numBytes,
+                                                    databaseName,
+                                                    setName,
+                                                    address,
+                                                    port,
+                                                    errMsg,
+                                                    next.lastOfStream)) {
+                std::cout << "Error: failed to send shuffle data to " << address << ":" << port
+                          << ": " << errMsg << std::endl;
+                const LockGuard guard{mutex};
+                failed = true;
+                failure = "failed to send shuffle data to " + address + ":" +
+                    std::to_string(port) + ": " + errMsg;
+            }
+        }
+        free(next.page);
+    }
+    const LockGuard guard{mutex};
+    done = true;
+    pthread_cond_broadcast(&signal);
+}
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef PDB_RESULT_CACHE_H
+#define PDB_RESULT_CACHE_H
+
+#include <memory>
+#include <pthread.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef DEFAULT_RESULT_CACHE_ENTRIES
+#define DEFAULT_RESULT_CACHE_ENTRIES 128
+#endif
+
+namespace pdb {
+
+class ResultCache;
+typedef std::shared_ptr<ResultCache> ResultCachePtr;
+
+// A cached result: the output sets a job wrote, with the versions they had
+// right after the job, and how expensive the job was to run
+
+struct ResultCacheEntry {
+
+  // (databaseName:setName, version) for each output set
+  std::vector<std::pair<std::string, long>> outputSets;
+
+  // seconds it took to compute the result
+  double cost = 0;
+
+  // priority for eviction, the entry with the lowest priority is evicted
+  double priority = 0;
+};
+
+// A class to remember which jobs have been run over which versions of their
+// input sets, so that a job can be skipped if its results are still in its
+// output sets. The key is the fingerprint of the TCAP program and input set
+// versions. When full, entries are evicted by cost-aware LRU (GreedyDual):
+// an entry's priority is the cost to recompute it plus the priority of the
+// last evicted entry, so cheap entries age out first and expensive ones stay
+// until they have not been used for long.
+
+class ResultCache {
+
+private:
+  std::unordered_map<std::string, ResultCacheEntry> entries;
+  size_t maxEntries;
+  double inflation = 0;
+  pthread_mutex_t mutex;
+
+public:
+  // constructor
+  ResultCache(size_t maxEntries = DEFAULT_RESULT_CACHE_ENTRIES) {
+    this->maxEntries = maxEntries;
+    pthread_mutex_init(&mutex, nullptr);
+  }
+
+  // destructor
+  ~ResultCache() { pthread_mutex_destroy(&mutex); }
+
+  // to look up a result, returns false if there is no entry for the key
+  bool lookup(std::string key,
+              std::vector<std::pair<std::string, long>> &outputSets) {
+    pthread_mutex_lock(&mutex);
+    if (entries.count(key) == 0) {
+      pthread_mutex_unlock(&mutex);
+      return false;
+    }
+    ResultCacheEntry &entry = entries[key];
+    entry.priority = inflation + entry.cost;
+    outputSets = entry.outputSets;
+    pthread_mutex_unlock(&mutex);
+    return true;
+  }
+
+  // to remember a result, evicting the entry with the lowest priority if full
+  void insert(std::string key,
+              std::vector<std::pair<std::string, long>> outputSets,
+              double cost) {
+    pthread_mutex_lock(&mutex);
+    if ((entries.count(key) == 0) && (entries.size() >= maxEntries) &&
+        (entries.size() > 0)) {
+      auto victim = entries.begin();
+      for (auto it = entries.begin(); it != entries.end(); it++) {
+        if (it->second.priority < victim->second.priority) {
+          victim = it;
+        }
+      }
+      inflation = victim->second.priority;
+      entries.erase(victim);
+    }
+    ResultCacheEntry &entry = entries[key];
+    entry.outputSets = outputSets;
+    entry.cost = cost;
+    entry.priority = inflation + cost;
+    pthread_mutex_unlock(&mutex);
+  }
+
+  // to forget a result, e.g. when its output sets have been changed
+  void remove(std::string key) {
+    pthread_mutex_lock(&mutex);
+    entries.erase(key);
+    pthread_mutex_unlock(&mutex);
+  }
+
+  // to return number of cached results
+  size_t size() {
+    pthread_mutex_lock(&mutex);
+    size_t numEntries = entries.size();
+    pthread_mutex_unlock(&mutex);
+    return numEntries;
+  }
+};
+}
+
+#endif
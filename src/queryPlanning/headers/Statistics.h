@@ -4,6 +4,7 @@
 #include <memory>
 #include <pthread.h>
 #include <unordered_map>
+#include <map>
 
 namespace pdb {
 
@@ -21,6 +22,12 @@ struct DataStatistics {
   size_t numBytes = 0;
   int numTuples = 0;
   size_t avgTupleSize = 0;
+  // number of pages reported by each storage node
+  std::map<int, int> numPagesPerNode;
+  // version of the set last reported by each storage node
+  std::map<int, long> versionPerNode;
+  // bumped whenever the set is known to have changed
+  long version = 0;
 };
 
 class Statistics {
@@ -73,6 +80,55 @@ public:
     }
   }
 
+  // to apply the number of pages that one storage node reports for a set;
+  // the previous report of the same node is replaced, so reports can be
+  // applied repeatedly without re-collecting stats from other nodes;
+  // nodeVersion is the version of the set on that node, or 0 if unknown
+  void setNodeStats(int nodeId, std::string databaseName, std::string setName,
+                    int numPages, size_t pageSize, long nodeVersion = 0) {
+    std::string key = databaseName + ":" + setName;
+    pthread_mutex_lock(&mutex);
+    DataStatistics &stats = dataStatistics[key];
+    if ((nodeVersion > 0) && (stats.versionPerNode.count(nodeId) > 0) &&
+        (stats.versionPerNode[nodeId] == nodeVersion)) {
+      // we have seen this version of the set on that node
+      pthread_mutex_unlock(&mutex);
+      return;
+    }
+    if (nodeVersion > 0) {
+      stats.versionPerNode[nodeId] = nodeVersion;
+    }
+    stats.version++;
+    stats.databaseName = databaseName;
+    stats.setName = setName;
+    int oldNumPages = 0;
+    if (stats.numPagesPerNode.count(nodeId) > 0) {
+      oldNumPages = stats.numPagesPerNode[nodeId];
+    }
+    stats.numPagesPerNode[nodeId] = numPages;
+    stats.numPages += numPages - oldNumPages;
+    if (stats.numPages < 0) {
+      stats.numPages = 0;
+    }
+    if (pageSize > 0) {
+      stats.pageSize = pageSize;
+    }
+    stats.numBytes = (size_t)stats.numPages * stats.pageSize;
+    pthread_mutex_unlock(&mutex);
+  }
+
+  // to return the version of a set, which changes whenever the set changes
+  long getVersion(std::string databaseName, std::string setName) {
+    std::string key = databaseName + ":" + setName;
+    long version = 0;
+    pthread_mutex_lock(&mutex);
+    if (dataStatistics.count(key) > 0) {
+      version = dataStatistics[key].version;
+    }
+    pthread_mutex_unlock(&mutex);
+    return version;
+  }
+
   // to return number of pages of a set
   int getNumPages(std::string databaseName, std::string setName) {
     std::string key = databaseName + ":" + setName;
@@ -89,6 +145,9 @@ public:
     std::string key = databaseName + ":" + setName;
     pthread_mutex_lock(&mutex);
     dataStatistics[key].numPages = numPages;
+    dataStatistics[key].numPagesPerNode.clear();
+    dataStatistics[key].versionPerNode.clear();
+    dataStatistics[key].version++;
     pthread_mutex_unlock(&mutex);
   }
 
@@ -98,6 +157,7 @@ public:
     std::string key = databaseName + ":" + setName;
     pthread_mutex_lock(&mutex);
     dataStatistics[key].numPages += numPages;
+    dataStatistics[key].version++;
     pthread_mutex_unlock(&mutex);
 
   }
@@ -193,11 +253,13 @@ public:
 
   // to return selectivity of an atomic computation
   double getAtomicComputationSelectivity(std::string atomicComputationType) {
-    if (atomicComputationSelectivity.count(atomicComputationType) == 0) {
-      return 0;
-    } else {
-      return atomicComputationSelectivity[atomicComputationType];
+    double selectivity = 0;
+    pthread_mutex_lock(&mutex);
+    if (atomicComputationSelectivity.count(atomicComputationType) > 0) {
+      selectivity = atomicComputationSelectivity[atomicComputationType];
     }
+    pthread_mutex_unlock(&mutex);
+    return selectivity;
   }
 
   // to set selectivity for an atomic computation
@@ -208,6 +270,29 @@ public:
     pthread_mutex_unlock(&mutex);
   }
 
+  // to check whether selectivity of an atomic computation has been learned
+  bool hasAtomicComputationSelectivity(std::string atomicComputationType) {
+    pthread_mutex_lock(&mutex);
+    bool learned = atomicComputationSelectivity.count(atomicComputationType) > 0;
+    pthread_mutex_unlock(&mutex);
+    return learned;
+  }
+
+  // to fold a selectivity observed at runtime into the learned selectivity
+  // of an atomic computation, so that estimates follow the latest runs
+  void learnAtomicComputationSelectivity(std::string atomicComputationType,
+                                         double observedSelectivity) {
+    pthread_mutex_lock(&mutex);
+    if (atomicComputationSelectivity.count(atomicComputationType) == 0) {
+      atomicComputationSelectivity[atomicComputationType] = observedSelectivity;
+    } else {
+      atomicComputationSelectivity[atomicComputationType] =
+          0.5 * atomicComputationSelectivity[atomicComputationType] +
+          0.5 * observedSelectivity;
+    }
+    pthread_mutex_unlock(&mutex);
+  }
+
   // to return selectivity of a lambda
   double getLambdaSelectivity(std::string lambdaType) {
     if (lambdaSelectivity.count(lambdaType) == 0) {
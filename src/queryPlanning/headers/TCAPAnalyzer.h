@@ -13,9 +13,12 @@
 #include "Statistics.h"
 #include "TupleSetJobStage.h"
 #include "SelfLearningDB.h"
+#include "PDBCatalogSet.h"
+#include <functional>
 
 namespace pdb {
 
+class CatalogClient;
 
 // This class encapsulates the analyzer for TCAP string
 // You can use this class transform a TCAP string into a physical plan: a
@@ -157,9 +160,43 @@ public:
   // to return the index of the best source
   int getBestSource(StatisticsPtr stats);
 
+  // to enumerate the orders to join the current sources that reach joins with
+  // dynamic programming, and to rank those sources in the order the cheapest
+  // plan builds them
+  void enumerateJoinOrder(StatisticsPtr stats);
+
   // to return the cost of the i-th source
   size_t getCostOfSource(int index, StatisticsPtr stats);
 
+  // to return the estimated size of the data the i-th source feeds into its
+  // next pipeline breaker, based on the selectivity learned from prior runs
+  double getEstimatedCostOfSource(int index, StatisticsPtr stats);
+
+  // to return the estimated size of the data a set feeds into its next
+  // pipeline breaker, based on the selectivity learned so far
+  double getEstimatedSizeOfSet(std::string databaseName, std::string setName,
+                               StatisticsPtr stats);
+
+  // to learn the selectivity of the pipeline starting from a source, given the
+  // number of bytes the pipeline actually wrote to intermediate sets; if
+  // replace is true, the observation overrides what was learned before
+  void learnSelectivity(Handle<SetIdentifier> sourceSet, size_t outputBytes,
+                        StatisticsPtr stats, bool replace = false);
+
+  // to check whether the current source wrote far more or far less data than
+  // it was estimated to, so that the remaining stages should be re-planned
+  bool isMisestimated(size_t outputBytes);
+
+  // to re-plan the remaining stages from the given statistics: sources that
+  // were deferred under the old estimates are reconsidered, and the join
+  // order is enumerated again
+  void replan(StatisticsPtr stats);
+
+  // to decide whether the join that the current source reaches should be
+  // hash partitioned instead of broadcasting the current source
+  bool isPartitionedJoinPreferred(Handle<Computation> joinComputation,
+                                  Handle<SetIdentifier> curInputSetIdentifier);
+
   // to return the index of next consumer to process for a certain source
   unsigned int getNextConsumerIndex(std::string name);
 
@@ -174,7 +211,8 @@ public:
                                                      std::shared_ptr<ApplyJoin> joinNode,
                                                      LogicalPlanPtr logicalPlan);                                                     
 
-  // to check whether the source partition lambda matches query lambda
+  // to check whether the source partition lambda matches query lambda; if the
+  // catalog knows how the set is partitioned, only the catalog is asked
   bool matchSourceWithQuery(std::string jobInstanceId, 
                             AtomicComputationPtr curSource,
                             std::shared_ptr<ApplyJoin> joinNode,
@@ -183,7 +221,62 @@ public:
                             std::string & computationName,
                             std::string & lambdaName);
 
+  // to check whether the catalog says the set is partitioned by the lambda
+  // that the join hashes the source on; the self-learning database is not
+  // asked, since it may still know an older partitioning of the set
+  bool isPartitionedOnJoinKey(AtomicComputationPtr curSource,
+                              std::shared_ptr<ApplyJoin> joinNode,
+                              Handle<SetIdentifier> sourceSetIdentifier);
+
+  // to compare the lambda that the catalog says the set is partitioned by
+  // with the lambda that the join hashes the source on
+  bool matchPartitioningWithQuery(PDBCatalogSetPtr partitioning,
+                                  std::pair<std::string, std::string> hashSource,
+                                  Handle<SetIdentifier> sourceSetIdentifier);
+
+  // to return the other set that the join reads, nullptr if there is none
+  Handle<SetIdentifier> getOtherJoinSource(Handle<Computation> joinComputation,
+                                           Handle<SetIdentifier> curInputSetIdentifier);
+
+  // to get how a set is partitioned from the catalog, nullptr if we do not know
+  PDBCatalogSetPtr getPartitioning(Handle<SetIdentifier> setIdentifier);
+
+  // to check whether the catalog partitioning of a set is how its data is
+  // really placed, as told by the partitioning validator
+  bool isValidPartitioning(Handle<SetIdentifier> setIdentifier,
+                           PDBCatalogSetPtr partitioning);
+
+  // to check whether partition i of both sets lives on the same node; both
+  // sets must have a validated partitioning in the catalog, since the
+  // self-learning database only knows how a set was meant to be partitioned
+  bool isPlacedAlike(Handle<SetIdentifier> lhs, Handle<SetIdentifier> rhs);
+
+  // to check whether the catalog says both sources are partitioned on the
+  // join key, and both sets are placed alike
+  bool isCoPartitioned(AtomicComputationPtr lhsSource,
+                       Handle<SetIdentifier> lhs,
+                       AtomicComputationPtr rhsSource,
+                       Handle<SetIdentifier> rhs,
+                       std::shared_ptr<ApplyJoin> joinNode);
+
+  // to check whether both inputs of the join are partitioned on the join key
+  // and placed alike, so that the join can be done locally without a shuffle
+  bool isCoPartitionedJoin(AtomicComputationPtr curSource,
+                           std::shared_ptr<ApplyJoin> joinNode,
+                           Handle<Computation> joinComputation,
+                           Handle<SetIdentifier> curInputSetIdentifier);
+
+  // to set the catalog that knows how sets are partitioned
+  void setCatalogClient (CatalogClient* catalogClient) {
+      this->catalogClient = catalogClient;
+  }
 
+  // to set the check that the data of a set is placed as its catalog
+  // partitioning says, without it no set counts as partitioned
+  void setPartitioningValidator (
+      std::function<bool(const PDBCatalogSet &)> partitioningValidator) {
+      this->partitioningValidator = partitioningValidator;
+  }
 
   // to set number of nodes
   void setNumNodes (int numNodes) {
@@ -199,6 +292,12 @@ private:
   //selfLearning db
   std::shared_ptr<SelfLearningDB> db = nullptr;
 
+  // the catalog that knows how sets are partitioned
+  CatalogClient* catalogClient = nullptr;
+
+  // checks that the data of a set is placed as its catalog partitioning says
+  std::function<bool(const PDBCatalogSet &)> partitioningValidator = nullptr;
+
 
   // hash sets to probe in current stage
   // needs to be cleared after execution of each stage
@@ -253,12 +352,26 @@ private:
   // the vector of set names
   std::vector<std::string> curSourceSetNames;
 
+  // the rank of each source in the cheapest join order found by
+  // enumerateJoinOrder(), sources that reach no join are not ranked
+  std::map<std::string, int> joinOrderRanks;
+
   // the size of current source
   double costOfCurSource;
 
   // the exact size of current source
   size_t exactSizeOfCurSource;
 
+  // the estimated size of data current source feeds into its pipeline breaker
+  double estimatedSizeOfCurSource;
+
+  // whether current source has been put to the penalized list, which forces
+  // any join it reaches to be hash partitioned
+  bool curSourceIsPenalized = false;
+
+  // the statistics used to select current source
+  StatisticsPtr stats = nullptr;
+
 
   // the name of current chosen source set
   std::string curSourceSetName;
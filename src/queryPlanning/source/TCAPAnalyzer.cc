@@ -8,11 +8,26 @@
 #include "ScanUserSet.h"
 #include "SelectionComp.h"
 #include "PartitionComp.h"
+#include "CatalogClient.h"
 #include <cfloat>
+#include <climits>
+#include <algorithm>
 
 #ifndef JOIN_COST_THRESHOLD
 #define JOIN_COST_THRESHOLD 15000
 #endif
+
+// the factor by which the observed output of a pipeline may differ from its
+// estimate before the remaining stages are re-planned
+#ifndef REOPTIMIZATION_THRESHOLD
+#define REOPTIMIZATION_THRESHOLD 2.0
+#endif
+
+// joins over more source sets than this are ordered by source cost only,
+// since the join order enumeration is exponential in the number of sets
+#ifndef MAX_DP_JOIN_RELATIONS
+#define MAX_DP_JOIN_RELATIONS 12
+#endif
 namespace pdb {
 
 TCAPAnalyzer::TCAPAnalyzer(std::string jobId,
@@ -43,6 +58,9 @@ TCAPAnalyzer::TCAPAnalyzer(std::string jobId,
     this->sources.clear();
   }
   hashSetsToProbe = nullptr;
+  this->costOfCurSource = 0;
+  this->exactSizeOfCurSource = 0;
+  this->estimatedSizeOfCurSource = 0;
   this->dynamicPlanningOrNot = isDynamicPlanning;
   if (this->dynamicPlanningOrNot == true) {
     // initialize source sets and source nodes;
@@ -534,7 +552,7 @@ bool TCAPAnalyzer::analyze(
       // to create the producing job stage for aggregation
       Handle<SetIdentifier> aggregator = makeObject<SetIdentifier>(
           this->jobId, outputName + "_aggregationData");
-      size_t desiredSize = this->exactSizeOfCurSource/conf->getShufflePageSize()/this->numNodesInCluster;
+      size_t desiredSize = (size_t)this->estimatedSizeOfCurSource/conf->getShufflePageSize()/this->numNodesInCluster;
       if (desiredSize == 0) {
           desiredSize = 1;
       }
@@ -640,7 +658,7 @@ bool TCAPAnalyzer::analyze(
     if (curNode->getAtomicComputationType() == "Aggregate") {
       Handle<SetIdentifier> aggregator = makeObject<SetIdentifier>(
           this->jobId, outputName + "_aggregationData");
-      size_t desiredSize = this->exactSizeOfCurSource/conf->getShufflePageSize()/this->numNodesInCluster;
+      size_t desiredSize = (size_t)this->estimatedSizeOfCurSource/conf->getShufflePageSize()/this->numNodesInCluster;
       if (desiredSize == 0) {
           desiredSize = 1;
       }
@@ -711,8 +729,16 @@ bool TCAPAnalyzer::analyze(
       Handle<SetIdentifier> sink = nullptr;
       std::string hashSetName = "";
       if (joinNode->isTraversed() == false) {
-        if ((isProbing == true) &&
-            (this->costOfCurSource <= JOIN_COST_THRESHOLD)) {
+        bool partitionedJoin =
+            isPartitionedJoinPreferred(myComputation, curInputSetIdentifier);
+        if ((partitionedJoin == false) &&
+            (isCoPartitionedJoin(curSource, joinNode, myComputation,
+                                 curInputSetIdentifier) == true)) {
+          // both inputs are already partitioned on the join key, so the join
+          // is done locally and ships nothing, which beats broadcasting
+          partitionedJoin = true;
+        }
+        if ((isProbing == true) && (partitionedJoin == false)) {
           // this is too bad that we we've already probed join tables and join
           // results
           // could be huge.
@@ -734,9 +760,9 @@ bool TCAPAnalyzer::analyze(
           }
           return false;
         }
-        if (this->costOfCurSource > JOIN_COST_THRESHOLD) {
-          // data is larger than the cost threshold, so we do hash partition
-          // join.
+        if (partitionedJoin == true) {
+          // shuffling both sides is cheaper than broadcasting this side, or
+          // this side is too large to broadcast, so we do hash partition join.
           joinNode->setPartitioningLHS(true);
           Handle<JoinComp<Object, Object, Object>> join =
               unsafeCast<JoinComp<Object, Object, Object>, Computation>(
@@ -751,7 +777,7 @@ bool TCAPAnalyzer::analyze(
           std::cout << "this->exactSizeOfCurSource" << this->exactSizeOfCurSource << std::endl;
           std::cout << "conf->getBroadcastPageSize()" << conf->getBroadcastPageSize() << std::endl;
           std::cout << "this->numNodesInCluster" << this->numNodesInCluster << std::endl;
-          size_t desiredSize = (size_t)this->exactSizeOfCurSource/(size_t)conf->getBroadcastPageSize()/(size_t)this->numNodesInCluster;
+          size_t desiredSize = (size_t)this->estimatedSizeOfCurSource/(size_t)conf->getBroadcastPageSize()/(size_t)this->numNodesInCluster;
           if (desiredSize == 0) {
               desiredSize = 1;
           }
@@ -794,23 +820,14 @@ bool TCAPAnalyzer::analyze(
           curInputSetIdentifier->setIndexInInputs(indexInInputs);
 
           //we need to probe the other side
-          std::vector<std::pair<std::string, std::string>> scannerSources;
-          std::pair<std::string, std::string> curScannerSource;
-          join->getSources(scannerSources);
-          Handle<SetIdentifier> rhsSourceIdentifier = nullptr;
-          for (int k = 0; k < scannerSources.size(); k++) {
-              curScannerSource = scannerSources[k];
-              if ((curScannerSource.first == curInputSetIdentifier->getDatabase())
-                  &&(curScannerSource.second == curInputSetIdentifier->getSetName())) {
-                  continue;
-              } else {
-                  rhsSourceIdentifier = makeObject<SetIdentifier>(curScannerSource.first, curScannerSource.second);
-                  break;
-              }
+          Handle<SetIdentifier> rhsSourceIdentifier =
+              getOtherJoinSource(myComputation, curInputSetIdentifier);
+          std::vector<AtomicComputationPtr> rhsSources;
+          if (rhsSourceIdentifier != nullptr) {
+              std::string otherSourceSetName = rhsSourceIdentifier->getDatabase() + ":" + rhsSourceIdentifier->getSetName();
+              std::cout << "otherSourceSetName: " << otherSourceSetName << std::endl;
+              rhsSources = curSourceNodes[otherSourceSetName];
           }
-          std::string otherSourceSetName = curScannerSource.first + ":" + curScannerSource.second;
-          std::cout << "otherSourceSetName: " << otherSourceSetName << std::endl;
-          std::vector<AtomicComputationPtr> rhsSources = curSourceNodes[otherSourceSetName];
           std::cout << "Sources: " << std::endl;
           for (auto a : curSourceNodes) {
               std::cout << a.first << std::endl;
@@ -832,6 +849,12 @@ bool TCAPAnalyzer::analyze(
                     << ", rhsPartitionLambdaName: " << rhsPartitionLambdaName << std::endl;
 
           }
+          if ((matchOrNot == true)&&(otherMatchOrNot == true)) {
+              //the catalog must say both sides are partitioned on the join key, and both sides
+              //must have partition i on the same node
+              otherMatchOrNot = isCoPartitioned(curSource, curInputSetIdentifier,
+                                                rhsSources[0], rhsSourceIdentifier, joinNode);
+          }
           if ((matchOrNot == false)||(otherMatchOrNot == false)) {
               join->setJoinType(HashPartitionedJoin);
               std::cout << "to create TupleSetJobStage to repartition data for join" << std::endl; 
@@ -882,7 +905,7 @@ bool TCAPAnalyzer::analyze(
           sink = makeObject<SetIdentifier>(this->jobId,
                                            outputName + "_broadcastData");
           sink->setPageSize(conf->getBroadcastPageSize());
-          size_t desiredSize = this->exactSizeOfCurSource/conf->getBroadcastPageSize()/this->numNodesInCluster;
+          size_t desiredSize = (size_t)this->estimatedSizeOfCurSource/conf->getBroadcastPageSize()/this->numNodesInCluster;
           if (desiredSize == 0) {
               desiredSize = 1;
           }
@@ -954,7 +977,7 @@ bool TCAPAnalyzer::analyze(
           sink = makeObject<SetIdentifier>(this->jobId,
                                            outputName + "_repartitionData");
           sink->setPageSize(conf->getBroadcastPageSize());
-          size_t desiredSize = this->exactSizeOfCurSource/conf->getBroadcastPageSize()/this->numNodesInCluster;
+          size_t desiredSize = (size_t)this->estimatedSizeOfCurSource/conf->getBroadcastPageSize()/this->numNodesInCluster;
           if (desiredSize == 0) {
               desiredSize = 1;
           }
@@ -1089,7 +1112,7 @@ bool TCAPAnalyzer::analyze(
       myComputation->setOutput(this->jobId, outputName);
       sink = makeObject<SetIdentifier>(this->jobId, outputName);
       sink->setPageSize(conf->getPageSize());
-      size_t desiredSize = this->exactSizeOfCurSource/conf->getPageSize()/this->numNodesInCluster;
+      size_t desiredSize = (size_t)this->estimatedSizeOfCurSource/conf->getPageSize()/this->numNodesInCluster;
       if (desiredSize == 0) {
           desiredSize = 1;
       }
@@ -1125,7 +1148,7 @@ bool TCAPAnalyzer::analyze(
       Handle<SetIdentifier> aggregator = makeObject<SetIdentifier>(
           this->jobId, outputName + "_aggregationData");
       aggregator->setPageSize(conf->getShufflePageSize());
-      size_t desiredSize = this->exactSizeOfCurSource/conf->getShufflePageSize()/this->numNodesInCluster;
+      size_t desiredSize = (size_t)this->estimatedSizeOfCurSource/conf->getShufflePageSize()/this->numNodesInCluster;
       if (desiredSize == 0) {
           desiredSize = 1;
       }
@@ -1231,40 +1254,61 @@ int TCAPAnalyzer::getNumSources() { return curSourceSetNames.size(); }
 
 // to return the index of the best source
 int TCAPAnalyzer::getBestSource(StatisticsPtr stats) {
-  // use the cost model to return the index of the best source
-  
+  // use the cost model to return the index of the best source:
+  // sources that are not penalized are always preferred; among the sources
+  // that reach joins, the one that the cheapest join order builds first is
+  // selected, and otherwise the one feeding the least data into its pipeline
+  // breaker is selected, so that the smaller inputs are the ones built into
+  // join hash tables
+
   if (stats == 0) {
     return 0;
   } else {
+    this->stats = stats;
+    enumerateJoinOrder(stats);
     int bestIndexToReturn = 0;
     double minCost = DBL_MAX;
+    int minRank = INT_MAX;
+    bool minIsPenalized = true;
     for (size_t i = 0; i < curSourceSetNames.size(); i++) {
-      size_t curSize = getCostOfSource(i, stats);
-      double curCost = double(curSize / 1000000);
+      double curCost = getEstimatedCostOfSource(i, stats) / 1000000;
       if (curCost < 1) {
           curCost = 1;
       }
+      int curRank = INT_MAX;
+      if (joinOrderRanks.count(curSourceSetNames[i]) > 0) {
+        curRank = joinOrderRanks[curSourceSetNames[i]];
+      }
+      bool isPenalized = false;
       for (size_t j = 0; j < penalizedSourceSets.size(); j++) {
         if (curSourceSetNames[i] == penalizedSourceSets[j]) {
-          if (stats->getPenalizedCost(curSourceSetNames[i]) > 0) {
-              curCost = stats->getPenalizedCost(curSourceSetNames[i]);
-          }
-          curCost = curCost * 1000;
-          stats->setPenalizedCost(curSourceSetNames[i], curCost);
           std::cout << "Meet a penalized source set: " << curSourceSetNames[i]
-                    << ", we increase its cost by 1000 times to be " << curCost
+                    << " with cost " << curCost
+                    << ", it will only be selected after other sources"
                     << std::endl;
+          isPenalized = true;
           break;
         }
       }
-      if (curCost < minCost) {
+      bool isBetter = false;
+      if (isPenalized != minIsPenalized) {
+        isBetter = (isPenalized == false);
+      } else if ((curRank != INT_MAX) && (minRank != INT_MAX)) {
+        isBetter = (curRank < minRank);
+      } else {
+        isBetter = (curCost < minCost);
+      }
+      if (isBetter == true) {
         minCost = curCost;
-        this->exactSizeOfCurSource = curSize;
+        minRank = curRank;
+        minIsPenalized = isPenalized;
+        this->exactSizeOfCurSource = getCostOfSource(i, stats);
+        this->estimatedSizeOfCurSource = getEstimatedCostOfSource(i, stats);
         bestIndexToReturn = i;
       }
       // below is optimization for nearest neighbor search
       if (JOIN_HASH_TABLE_SIZE_RATIO > 1.5) {
-        if (curCost == minCost) {
+        if ((curCost == minCost) && (isPenalized == minIsPenalized)) {
           minCost = curCost;
           bestIndexToReturn = i;
         }
@@ -1274,11 +1318,170 @@ int TCAPAnalyzer::getBestSource(StatisticsPtr stats) {
               << bestIndexToReturn << ": "
               << curSourceSetNames[bestIndexToReturn] << std::endl;
     this->costOfCurSource = minCost;
+    this->curSourceIsPenalized = minIsPenalized;
     this->curSourceSetName = curSourceSetNames[bestIndexToReturn];
     return bestIndexToReturn;
   }
 }
 
+// to return the network cost of joining two inputs of the given sizes, either
+// by broadcasting the smaller input or by hash partitioning both of them
+static double getJoinNetworkCost(double leftBytes, double rightBytes,
+                                 int numNodes) {
+  if (numNodes <= 1) {
+    return 0;
+  }
+  double broadcastCost = std::min(leftBytes, rightBytes) * (numNodes - 1);
+  double partitionCost = (leftBytes + rightBytes) * (numNodes - 1) / numNodes;
+  return std::min(broadcastCost, partitionCost);
+}
+
+// to rank the sources joined by the best plan for a set of relations in the
+// order they are scheduled: for every join, the smaller side is built first
+static void rankJoinLeaves(unsigned int relations,
+                           std::vector<unsigned int>& bestLeft,
+                           std::vector<double>& bytes,
+                           std::vector<std::string>& names,
+                           std::map<std::string, int>& ranks) {
+  if ((relations & (relations - 1)) == 0) {
+    int rank = ranks.size();
+    ranks[names[__builtin_ctz(relations)]] = rank;
+    return;
+  }
+  unsigned int left = bestLeft[relations];
+  unsigned int right = relations & ~left;
+  if (bytes[left] <= bytes[right]) {
+    rankJoinLeaves(left, bestLeft, bytes, names, ranks);
+    rankJoinLeaves(right, bestLeft, bytes, names, ranks);
+  } else {
+    rankJoinLeaves(right, bestLeft, bytes, names, ranks);
+    rankJoinLeaves(left, bestLeft, bytes, names, ranks);
+  }
+}
+
+// to enumerate join orders over the current sources that reach joins: every
+// subset of sources connected by joins is planned by combining the cheapest
+// plans of two connected subsets, costing each join by its network cost plus
+// its output, which is estimated as the larger input, as for a join on keys
+void TCAPAnalyzer::enumerateJoinOrder(StatisticsPtr stats) {
+  joinOrderRanks.clear();
+  if ((stats == nullptr) || (this->computations == nullptr)) {
+    return;
+  }
+  // to collect the current sources that are joined with each other
+  std::vector<std::string> names;
+  std::vector<std::vector<int>> joins;
+  for (int i = 0; i < this->computations->size(); i++) {
+    Handle<Computation> computation = (*(this->computations))[i];
+    if (computation->getComputationType() != "JoinComp") {
+      continue;
+    }
+    Handle<JoinComp<Object, Object, Object>> join =
+        unsafeCast<JoinComp<Object, Object, Object>, Computation>(computation);
+    std::vector<std::pair<std::string, std::string>> scannerSources;
+    join->getSources(scannerSources);
+    std::vector<int> members;
+    for (int j = 0; j < scannerSources.size(); j++) {
+      std::string name = scannerSources[j].first + ":" + scannerSources[j].second;
+      if (curSourceSets.count(name) == 0) {
+        // this input is not a current source, for example it is processed
+        continue;
+      }
+      int k = std::find(names.begin(), names.end(), name) - names.begin();
+      if (k == names.size()) {
+        names.push_back(name);
+      }
+      members.push_back(k);
+    }
+    joins.push_back(members);
+  }
+  int numRelations = names.size();
+  if ((numRelations < 2) || (numRelations > MAX_DP_JOIN_RELATIONS)) {
+    return;
+  }
+  std::vector<unsigned int> neighbors(numRelations, 0);
+  for (int i = 0; i < joins.size(); i++) {
+    for (int a = 0; a < joins[i].size(); a++) {
+      for (int b = 0; b < joins[i].size(); b++) {
+        if (joins[i][a] != joins[i][b]) {
+          neighbors[joins[i][a]] |= (1u << joins[i][b]);
+        }
+      }
+    }
+  }
+  // the cheapest plan for every connected subset of relations
+  unsigned int all = (1u << numRelations) - 1;
+  std::vector<double> bytes(all + 1, 0);
+  std::vector<double> cost(all + 1, DBL_MAX);
+  std::vector<unsigned int> bestLeft(all + 1, 0);
+  for (int i = 0; i < numRelations; i++) {
+    Handle<SetIdentifier> set = curSourceSets[names[i]];
+    bytes[1u << i] =
+        getEstimatedSizeOfSet(set->getDatabase(), set->getSetName(), stats);
+    cost[1u << i] = 0;
+  }
+  for (unsigned int relations = 1; relations <= all; relations++) {
+    if ((relations & (relations - 1)) == 0) {
+      continue;
+    }
+    for (unsigned int left = (relations - 1) & relations; left > 0;
+         left = (left - 1) & relations) {
+      unsigned int right = relations & ~left;
+      if ((left > right) || (cost[left] == DBL_MAX) ||
+          (cost[right] == DBL_MAX)) {
+        continue;
+      }
+      unsigned int leftNeighbors = 0;
+      for (int i = 0; i < numRelations; i++) {
+        if ((left & (1u << i)) != 0) {
+          leftNeighbors |= neighbors[i];
+        }
+      }
+      if ((leftNeighbors & right) == 0) {
+        // never plan a cross product
+        continue;
+      }
+      double outputBytes = std::max(bytes[left], bytes[right]);
+      double curCost = cost[left] + cost[right] + outputBytes +
+                       getJoinNetworkCost(bytes[left], bytes[right],
+                                          this->numNodesInCluster);
+      if (curCost < cost[relations]) {
+        cost[relations] = curCost;
+        bytes[relations] = outputBytes;
+        bestLeft[relations] = left;
+      }
+    }
+  }
+  // to rank the sources of each group of joined sources, cheapest group first
+  std::vector<std::pair<double, unsigned int>> groups;
+  unsigned int grouped = 0;
+  for (int i = 0; i < numRelations; i++) {
+    if ((grouped & (1u << i)) != 0) {
+      continue;
+    }
+    unsigned int group = (1u << i);
+    unsigned int lastGroup = 0;
+    while (group != lastGroup) {
+      lastGroup = group;
+      for (int j = 0; j < numRelations; j++) {
+        if ((group & (1u << j)) != 0) {
+          group |= neighbors[j];
+        }
+      }
+    }
+    grouped |= group;
+    groups.push_back(std::make_pair(cost[group], group));
+  }
+  std::sort(groups.begin(), groups.end());
+  for (int i = 0; i < groups.size(); i++) {
+    rankJoinLeaves(groups[i].second, bestLeft, bytes, names, joinOrderRanks);
+  }
+  for (int i = 0; i < numRelations; i++) {
+    std::cout << "Join order rank of " << names[i] << " is "
+              << joinOrderRanks[names[i]] << std::endl;
+  }
+}
+
 // to return the cost of the i-th source
 size_t TCAPAnalyzer::getCostOfSource(int index, StatisticsPtr stats) {
   std::string key = curSourceSetNames[index];
@@ -1291,6 +1494,152 @@ size_t TCAPAnalyzer::getCostOfSource(int index, StatisticsPtr stats) {
   return cost;
 }
 
+// the key of the selectivity learned for the pipeline starting from a source:
+// intermediate sets live in a database named by the job id, so only the set
+// name is used, qualified by the TCAP program that is stable across runs
+static std::string getSelectivityKey(std::string tcapString,
+                                     std::string sourceSetName) {
+  return std::to_string(std::hash<std::string>()(tcapString)) + ":" +
+         sourceSetName;
+}
+
+// to return the estimated size of data the i-th source feeds into its
+// pipeline breaker
+double TCAPAnalyzer::getEstimatedCostOfSource(int index, StatisticsPtr stats) {
+  double cost = getCostOfSource(index, stats);
+  Handle<SetIdentifier> curSet =
+      this->getSourceSetIdentifier(curSourceSetNames[index]);
+  if (curSet == nullptr) {
+    return cost;
+  }
+  std::string key = getSelectivityKey(this->tcapString, curSet->getSetName());
+  if (stats->hasAtomicComputationSelectivity(key)) {
+    cost = cost * stats->getAtomicComputationSelectivity(key);
+  }
+  return cost;
+}
+
+// to return the estimated size of data a set feeds into its pipeline breaker
+double TCAPAnalyzer::getEstimatedSizeOfSet(std::string databaseName,
+                                           std::string setName,
+                                           StatisticsPtr stats) {
+  double size = stats->getNumBytes(databaseName, setName);
+  std::string key = getSelectivityKey(this->tcapString, setName);
+  if (stats->hasAtomicComputationSelectivity(key)) {
+    size = size * stats->getAtomicComputationSelectivity(key);
+  }
+  return size;
+}
+
+// to check whether the observed output of the current source differs from the
+// estimate it was planned with by more than REOPTIMIZATION_THRESHOLD
+bool TCAPAnalyzer::isMisestimated(size_t outputBytes) {
+  double estimate = this->estimatedSizeOfCurSource;
+  double observed = outputBytes;
+  if (estimate < 1) {
+    estimate = 1;
+  }
+  if (observed < 1) {
+    observed = 1;
+  }
+  bool misestimated = (observed > estimate * REOPTIMIZATION_THRESHOLD) ||
+                      (estimate > observed * REOPTIMIZATION_THRESHOLD);
+  if (misestimated == true) {
+    std::cout << "Source " << this->curSourceSetName << " was estimated to output "
+              << this->estimatedSizeOfCurSource << " bytes, but it output "
+              << outputBytes << " bytes, to re-plan remaining stages"
+              << std::endl;
+  }
+  return misestimated;
+}
+
+// to re-plan the remaining stages: a source is penalized when it reaches a
+// join that was to broadcast it after probing, and that choice was made from
+// the old estimates; joins that are not traversed yet choose between
+// broadcasting and partitioning again when they are reached
+void TCAPAnalyzer::replan(StatisticsPtr stats) {
+  if (stats == nullptr) {
+    return;
+  }
+  this->stats = stats;
+  penalizedSourceSets.clear();
+  enumerateJoinOrder(stats);
+  std::cout << "Re-planned the remaining stages for " << curSourceSetNames.size()
+            << " sources" << std::endl;
+}
+
+// to learn the selectivity of the pipeline starting from a source
+void TCAPAnalyzer::learnSelectivity(Handle<SetIdentifier> curSet,
+                                    size_t outputBytes, StatisticsPtr stats,
+                                    bool replace) {
+  if ((curSet == nullptr) || (stats == nullptr)) {
+    return;
+  }
+  size_t inputBytes =
+      stats->getNumBytes(curSet->getDatabase(), curSet->getSetName());
+  if (inputBytes == 0) {
+    return;
+  }
+  double selectivity = (double)outputBytes / (double)inputBytes;
+  std::string key = getSelectivityKey(this->tcapString, curSet->getSetName());
+  if (replace == true) {
+    // the learned selectivity was far off, so we trust the observation only
+    stats->setAtomicComputationSelectivity(key, selectivity);
+  } else {
+    stats->learnAtomicComputationSelectivity(key, selectivity);
+  }
+  std::cout << "Learned selectivity " << stats->getAtomicComputationSelectivity(key)
+            << " for source " << curSet->getDatabase() << ":"
+            << curSet->getSetName() << std::endl;
+}
+
+// to decide whether the join that the current source reaches should be hash
+// partitioned: broadcasting ships the current source to every other node,
+// while partitioning ships a share of both sides; so we broadcast only when
+// the current source is smaller than the other side divided by (numNodes - 1)
+bool TCAPAnalyzer::isPartitionedJoinPreferred(
+    Handle<Computation> joinComputation,
+    Handle<SetIdentifier> curInputSetIdentifier) {
+  if (this->curSourceIsPenalized == true) {
+    return true;
+  }
+  if (this->costOfCurSource > JOIN_COST_THRESHOLD) {
+    // the hash table would be too large to be replicated on every node
+    return true;
+  }
+  if ((this->stats == nullptr) || (this->numNodesInCluster <= 1) ||
+      (curInputSetIdentifier == nullptr)) {
+    return false;
+  }
+  Handle<JoinComp<Object, Object, Object>> join =
+      unsafeCast<JoinComp<Object, Object, Object>, Computation>(
+          joinComputation);
+  std::vector<std::pair<std::string, std::string>> scannerSources;
+  join->getSources(scannerSources);
+  double otherBytes = 0;
+  for (int i = 0; i < scannerSources.size(); i++) {
+    if ((scannerSources[i].first == curInputSetIdentifier->getDatabase()) &&
+        (scannerSources[i].second == curInputSetIdentifier->getSetName())) {
+      continue;
+    }
+    otherBytes += getEstimatedSizeOfSet(scannerSources[i].first,
+                                        scannerSources[i].second, this->stats);
+  }
+  if (otherBytes == 0) {
+    // we know nothing about the other side
+    return false;
+  }
+  double broadcastCost =
+      this->estimatedSizeOfCurSource * (this->numNodesInCluster - 1);
+  double partitionCost = (this->estimatedSizeOfCurSource + otherBytes) *
+                         (this->numNodesInCluster - 1) /
+                         this->numNodesInCluster;
+  std::cout << "Join cost of broadcasting " << this->curSourceSetName << ": "
+            << broadcastCost << ", cost of hash partitioning: " << partitionCost
+            << std::endl;
+  return partitionCost < broadcastCost;
+}
+
 // to return the index of next consumer to process for a certain source
 unsigned int TCAPAnalyzer::getNextConsumerIndex(std::string name) {
   return curProcessedConsumers[name];
@@ -1359,6 +1708,18 @@ bool TCAPAnalyzer::matchSourceWithQuery(std::string jobInstanceId,
           if ((res.first == "") && (res.second == "")) {
               return false;
           }
+
+          //the catalog knows the lambda the set was partitioned with when it was loaded, while
+          //the self-learning database may still know an older partitioning of the set
+          PDBCatalogSetPtr partitioning = getPartitioning(sourceSetIdentifier);
+          if ((partitioning != nullptr) && (partitioning->isPartitioned() == true)) {
+              computationName = res.first;
+              lambdaName = res.second;
+              return matchPartitioningWithQuery(partitioning, res, sourceSetIdentifier);
+          }
+          if (this->db == nullptr) {
+              return false;
+          }
           std::string origJobName = this->db->getJobName(jobInstanceId);
           //we ignore everything in jobName after # so that users can pack additional runtime information after #
           size_t pos = origJobName.find('#');
@@ -1394,6 +1755,9 @@ bool TCAPAnalyzer::matchSourceWithQuery(std::string jobInstanceId,
 
                   Handle<LambdaIdentifier> queryLambda =
                     this->db->getLambda(jobName, res.first, res.second);
+                  if (queryLambda == nullptr) {
+                      continue;
+                  }
                   std::cout << "Query: lambdaIdentifier is " << queryLambda->getLambdaIdentifier() << ", lambdaInputClass is " << queryLambda->getLambdaInputClass() << std::endl;
                   std::cout << "PartitionLambda: lambdaIdentifier is " << partitionLambda->getLambdaIdentifier() << ", lambdaInputClass is " << partitionLambda->getLambdaInputClass() << std::endl;
 
@@ -1412,6 +1776,150 @@ bool TCAPAnalyzer::matchSourceWithQuery(std::string jobInstanceId,
 
 }
 
+
+bool TCAPAnalyzer::matchPartitioningWithQuery(
+    PDBCatalogSetPtr partitioning,
+    std::pair<std::string, std::string> hashSource,
+    Handle<SetIdentifier> sourceSetIdentifier) {
+  ComputationNode &node = this->logicalPlan->getNode(hashSource.first);
+  GenericLambdaObjectPtr queryLambda = node.getLambda(hashSource.second);
+  unsigned int indexInInputs = queryLambda->getInputIndex(0);
+  if (hashSource.first.find("Aggregation") != std::string::npos) {
+    indexInInputs = 0;
+  }
+  std::string inputClass = "";
+  if (indexInInputs < node.getComputation().getNumInputs()) {
+    inputClass = node.getComputation().getIthInputType(indexInInputs);
+  }
+  std::cout << "Query: lambda is " << queryLambda->getIdentifierOfLambda()
+            << " on " << inputClass
+            << ", Catalog: " << sourceSetIdentifier->getDatabase() << ":"
+            << sourceSetIdentifier->getSetName() << " is partitioned by "
+            << partitioning->partitionLambda << " on "
+            << partitioning->partitionLambdaInputClass << std::endl;
+  return (queryLambda->getIdentifierOfLambda() ==
+          partitioning->partitionLambda) &&
+         (inputClass == partitioning->partitionLambdaInputClass);
+}
+
+bool TCAPAnalyzer::isPartitionedOnJoinKey(
+    AtomicComputationPtr curSource, std::shared_ptr<ApplyJoin> joinNode,
+    Handle<SetIdentifier> sourceSetIdentifier) {
+  std::pair<std::string, std::string> res =
+      getHashSource(curSource, joinNode, logicalPlan);
+  if ((res.first == "") && (res.second == "")) {
+    return false;
+  }
+  PDBCatalogSetPtr partitioning = getPartitioning(sourceSetIdentifier);
+  if ((partitioning == nullptr) || (partitioning->isPartitioned() == false)) {
+    std::cout << sourceSetIdentifier->getDatabase() << ":"
+              << sourceSetIdentifier->getSetName()
+              << " has no partitioning in the catalog" << std::endl;
+    return false;
+  }
+  return matchPartitioningWithQuery(partitioning, res, sourceSetIdentifier);
+}
+
+Handle<SetIdentifier> TCAPAnalyzer::getOtherJoinSource(
+    Handle<Computation> joinComputation,
+    Handle<SetIdentifier> curInputSetIdentifier) {
+  Handle<JoinComp<Object, Object, Object>> join =
+      unsafeCast<JoinComp<Object, Object, Object>, Computation>(
+          joinComputation);
+  std::vector<std::pair<std::string, std::string>> scannerSources;
+  join->getSources(scannerSources);
+  for (int i = 0; i < scannerSources.size(); i++) {
+    if ((scannerSources[i].first == curInputSetIdentifier->getDatabase()) &&
+        (scannerSources[i].second == curInputSetIdentifier->getSetName())) {
+      continue;
+    }
+    return makeObject<SetIdentifier>(scannerSources[i].first,
+                                     scannerSources[i].second);
+  }
+  return nullptr;
+}
+
+PDBCatalogSetPtr
+TCAPAnalyzer::getPartitioning(Handle<SetIdentifier> setIdentifier) {
+  if ((this->catalogClient == nullptr) || (setIdentifier == nullptr)) {
+    return nullptr;
+  }
+  std::string errMsg;
+  return this->catalogClient->getSet(setIdentifier->getDatabase(),
+                                     setIdentifier->getSetName(), errMsg);
+}
+
+bool TCAPAnalyzer::isValidPartitioning(Handle<SetIdentifier> setIdentifier,
+                                       PDBCatalogSetPtr partitioning) {
+  if ((partitioning == nullptr) || (partitioning->isPartitioned() == false)) {
+    std::cout << setIdentifier->getDatabase() << ":"
+              << setIdentifier->getSetName()
+              << " has no partitioning in the catalog" << std::endl;
+    return false;
+  }
+  if ((this->partitioningValidator == nullptr) ||
+      (this->partitioningValidator(*partitioning) == false)) {
+    std::cout << setIdentifier->getDatabase() << ":"
+              << setIdentifier->getSetName() << " is not placed by "
+              << partitioning->partitionLambda << " as the catalog says"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TCAPAnalyzer::isPlacedAlike(Handle<SetIdentifier> lhs,
+                                 Handle<SetIdentifier> rhs) {
+  PDBCatalogSetPtr lhsPartitioning = getPartitioning(lhs);
+  PDBCatalogSetPtr rhsPartitioning = getPartitioning(rhs);
+  if ((isValidPartitioning(lhs, lhsPartitioning) == false) ||
+      (isValidPartitioning(rhs, rhsPartitioning) == false)) {
+    return false;
+  }
+  if (lhsPartitioning->isPlacedLike(*rhsPartitioning) == false) {
+    std::cout << lhs->getDatabase() << ":" << lhs->getSetName() << " has "
+              << lhsPartitioning->numPartitions << " partitions on "
+              << lhsPartitioning->partitionNodes << ", but "
+              << rhs->getDatabase() << ":" << rhs->getSetName() << " has "
+              << rhsPartitioning->numPartitions << " partitions on "
+              << rhsPartitioning->partitionNodes << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TCAPAnalyzer::isCoPartitioned(AtomicComputationPtr lhsSource,
+                                   Handle<SetIdentifier> lhs,
+                                   AtomicComputationPtr rhsSource,
+                                   Handle<SetIdentifier> rhs,
+                                   std::shared_ptr<ApplyJoin> joinNode) {
+  return isPartitionedOnJoinKey(lhsSource, joinNode, lhs) &&
+         isPartitionedOnJoinKey(rhsSource, joinNode, rhs) &&
+         isPlacedAlike(lhs, rhs);
+}
+
+bool TCAPAnalyzer::isCoPartitionedJoin(
+    AtomicComputationPtr curSource, std::shared_ptr<ApplyJoin> joinNode,
+    Handle<Computation> joinComputation,
+    Handle<SetIdentifier> curInputSetIdentifier) {
+  if (curInputSetIdentifier == nullptr) {
+    return false;
+  }
+  Handle<SetIdentifier> rhsSourceIdentifier =
+      getOtherJoinSource(joinComputation, curInputSetIdentifier);
+  if (rhsSourceIdentifier == nullptr) {
+    return false;
+  }
+  auto rhsSources =
+      curSourceNodes.find(rhsSourceIdentifier->getDatabase() + ":" +
+                          rhsSourceIdentifier->getSetName());
+  if ((rhsSources == curSourceNodes.end()) ||
+      (rhsSources->second.size() == 0)) {
+    return false;
+  }
+  return isCoPartitioned(curSource, curInputSetIdentifier,
+                         rhsSources->second[0], rhsSourceIdentifier, joinNode);
+}
 }
 
 #endif
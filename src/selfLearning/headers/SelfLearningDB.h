@@ -2,7 +2,10 @@
 #define SELFLEARNING_DB_H
 
 #include <sqlite3.h>
+#include <pthread.h>
+#include <map>
 #include <memory>
+#include <vector>
 #include "ServerFunctionality.h"
 #include "JobStageSelfLearningInfo.h"
 #include "LoadJobSelfLearningInfo.h"
@@ -13,12 +16,22 @@
 #include "LambdaIdentifier.h"
 #include "PairKey.h"
 #include "RLState.h"
+#include "SelfLearningEvent.h"
+
+// the writer thread applies at most this many events in one transaction
+#ifndef SELF_LEARNING_DB_MAX_BATCH_SIZE
+#define SELF_LEARNING_DB_MAX_BATCH_SIZE 1024
+#endif
 
 namespace pdb {
 
 
 
 // Manage a sqlite3 database for statistics.
+// Writes are queued as events and applied by a background writer thread in batched
+// transactions, through its own connection and cached prepared statements, so that the
+// query path does not wait for sqlite. Reads first wait for the queued writes to be
+// applied, and then see a consistent snapshot of the database (which runs in WAL mode).
 class SelfLearningDB {
 
 public:
@@ -37,6 +50,12 @@ public:
     // query the database
     bool execDB(std::string cmdString);
 
+    // to queue a write for the writer thread
+    void enqueueEvent(SelfLearningEvent event);
+
+    // to block until all queued writes have been applied
+    void waitForPendingWrites();
+
     // create directories
     bool createDir();
 
@@ -232,6 +251,19 @@ public:
 
 protected:
 
+    // to prepare a read statement, after all queued writes have been applied
+    int prepareQuery(const char * queryString, int numBytes, sqlite3_stmt ** statement,
+                     const char ** tail);
+
+    // the loop of the writer thread
+    void runWriter();
+
+    // to apply a batch of events in one transaction
+    void applyEvents(std::vector<SelfLearningEvent> & events);
+
+    // to get the current local time in seconds, as strftime('%s', 'now', 'localtime') does
+    static long getLocalTime();
+
     // to quote a string
     std::string quoteStr(std::string& s);
 
@@ -269,6 +301,36 @@ private:
     //configuration
     ConfigurationPtr conf;
 
+    //connection used by the writer thread
+    sqlite3 * writerHandler = nullptr;
+
+    //prepared statements of the writer thread, keyed by their SQL
+    std::map<std::string, sqlite3_stmt *> cachedStatements;
+
+    //writes that are not yet picked up by the writer thread
+    std::vector<SelfLearningEvent> pendingEvents;
+
+    //number of writes that the writer thread is applying
+    size_t numEventsInFlight = 0;
+
+    //whether the writer thread should exit
+    bool stopWriter = false;
+
+    //the writer thread
+    pthread_t writerThread;
+
+    //whether the writer thread was started
+    bool writerStarted = false;
+
+    //to protect above fields
+    pthread_mutex_t eventMutex;
+
+    //signalled when events are queued
+    pthread_cond_t eventSignal;
+
+    //signalled when the writer thread has applied all events it picked up
+    pthread_cond_t drainedSignal;
+
 
 
 };
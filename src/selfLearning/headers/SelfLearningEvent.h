@@ -0,0 +1,85 @@
+#ifndef SELF_LEARNING_EVENT_H
+#define SELF_LEARNING_EVENT_H
+
+//class to describe a write to the self learning database, which is applied in the background
+
+#include <string>
+#include <vector>
+
+namespace pdb {
+
+//a typed value to bind to a parameter of a statement
+struct SelfLearningValue {
+
+    enum ValueType { Integer, Real, Text, Blob, Null };
+
+    ValueType type;
+
+    long intValue = 0;
+
+    double realValue = 0;
+
+    //the bytes for Text and Blob values
+    std::string bytes;
+};
+
+class SelfLearningEvent {
+
+public:
+
+    //constructor, the statement must only use ? for its parameters, so that it can be
+    //prepared once and reused for all events
+    SelfLearningEvent (std::string sql) {
+        this->sql = sql;
+    }
+
+    SelfLearningEvent & addInteger (long value) {
+        SelfLearningValue curValue;
+        curValue.type = SelfLearningValue::Integer;
+        curValue.intValue = value;
+        values.push_back(curValue);
+        return *this;
+    }
+
+    SelfLearningEvent & addReal (double value) {
+        SelfLearningValue curValue;
+        curValue.type = SelfLearningValue::Real;
+        curValue.realValue = value;
+        values.push_back(curValue);
+        return *this;
+    }
+
+    SelfLearningEvent & addText (std::string value) {
+        SelfLearningValue curValue;
+        curValue.type = SelfLearningValue::Text;
+        curValue.bytes = value;
+        values.push_back(curValue);
+        return *this;
+    }
+
+    SelfLearningEvent & addBlob (const void * bytes, size_t numBytes) {
+        SelfLearningValue curValue;
+        curValue.type = SelfLearningValue::Blob;
+        curValue.bytes = std::string((const char *) bytes, numBytes);
+        values.push_back(curValue);
+        return *this;
+    }
+
+    SelfLearningEvent & addNull () {
+        SelfLearningValue curValue;
+        curValue.type = SelfLearningValue::Null;
+        values.push_back(curValue);
+        return *this;
+    }
+
+    //the parameterized statement
+    std::string sql;
+
+    //the values to bind to the parameters, in order
+    std::vector<SelfLearningValue> values;
+
+};
+
+}
+
+#endif
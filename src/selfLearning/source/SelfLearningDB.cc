@@ -13,11 +13,38 @@
 
 namespace pdb {
 
-SelfLearningDB :: ~SelfLearningDB() {}
+SelfLearningDB :: ~SelfLearningDB() {
+
+    //let the writer thread apply what is left and exit
+    if (writerStarted) {
+        pthread_mutex_lock(&eventMutex);
+        stopWriter = true;
+        pthread_cond_signal(&eventSignal);
+        pthread_mutex_unlock(&eventMutex);
+        pthread_join(writerThread, nullptr);
+    }
+    for (auto & a : cachedStatements) {
+        sqlite3_finalize(a.second);
+    }
+    if (writerHandler != nullptr) {
+        sqlite3_close(writerHandler);
+    }
+    if (selfLearningDBHandler != nullptr) {
+        sqlite3_close(selfLearningDBHandler);
+    }
+    pthread_cond_destroy(&drainedSignal);
+    pthread_cond_destroy(&eventSignal);
+    pthread_mutex_destroy(&eventMutex);
+
+}
 
 
 SelfLearningDB :: SelfLearningDB(ConfigurationPtr conf) {
 
+    pthread_mutex_init(&eventMutex, nullptr);
+    pthread_cond_init(&eventSignal, nullptr);
+    pthread_cond_init(&drainedSignal, nullptr);
+
     this->conf = conf;
     this->pathToDBFile = "file:" + this->conf->getSelfLearningDB() + "/dbFile";
 
@@ -38,6 +65,149 @@ SelfLearningDB :: SelfLearningDB(ConfigurationPtr conf) {
     lambdaId = getLatestLambdaId() + 1;
     dataToJobStageMappingId = getLatestDataJobStageId() + 1;
 
+    //start the writer thread with its own connection
+    if (sqlite3_open_v2(this->pathToDBFile.c_str(), &writerHandler,
+                    SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI, NULL) == SQLITE_OK) {
+        sqlite3_busy_timeout(writerHandler, 10000);
+        if (pthread_create(&writerThread, nullptr, [](void * db) -> void * {
+                ((SelfLearningDB *) db)->runWriter();
+                return nullptr;
+            }, this) == 0) {
+            writerStarted = true;
+        }
+    }
+    if (!writerStarted) {
+        std::cout << "failure in starting the self learning database writer, "
+                  << "writes will be applied synchronously" << std::endl;
+    }
+
+}
+
+long SelfLearningDB :: getLocalTime() {
+
+    time_t now = time(nullptr);
+    struct tm localNow;
+    localtime_r(&now, &localNow);
+    return (long) now + localNow.tm_gmtoff;
+
+}
+
+void SelfLearningDB :: enqueueEvent(SelfLearningEvent event) {
+
+    if (!writerStarted) {
+        std::vector<SelfLearningEvent> events;
+        events.push_back(event);
+        pthread_mutex_lock(&eventMutex);
+        applyEvents(events);
+        pthread_mutex_unlock(&eventMutex);
+        return;
+    }
+    pthread_mutex_lock(&eventMutex);
+    pendingEvents.push_back(event);
+    pthread_cond_signal(&eventSignal);
+    pthread_mutex_unlock(&eventMutex);
+
+}
+
+void SelfLearningDB :: waitForPendingWrites() {
+
+    pthread_mutex_lock(&eventMutex);
+    while (!pendingEvents.empty() || numEventsInFlight > 0) {
+        pthread_cond_wait(&drainedSignal, &eventMutex);
+    }
+    pthread_mutex_unlock(&eventMutex);
+
+}
+
+int SelfLearningDB :: prepareQuery(const char * queryString, int numBytes,
+                                   sqlite3_stmt ** statement, const char ** tail) {
+
+    waitForPendingWrites();
+    return sqlite3_prepare_v2(selfLearningDBHandler, queryString, numBytes, statement, tail);
+
+}
+
+void SelfLearningDB :: runWriter() {
+
+    pthread_mutex_lock(&eventMutex);
+    while (true) {
+        while (pendingEvents.empty() && !stopWriter) {
+            pthread_cond_wait(&eventSignal, &eventMutex);
+        }
+        if (pendingEvents.empty()) {
+            break;
+        }
+        //pick up a batch
+        std::vector<SelfLearningEvent> events;
+        if (pendingEvents.size() <= SELF_LEARNING_DB_MAX_BATCH_SIZE) {
+            events.swap(pendingEvents);
+        } else {
+            events.assign(pendingEvents.begin(),
+                          pendingEvents.begin() + SELF_LEARNING_DB_MAX_BATCH_SIZE);
+            pendingEvents.erase(pendingEvents.begin(),
+                                pendingEvents.begin() + SELF_LEARNING_DB_MAX_BATCH_SIZE);
+        }
+        numEventsInFlight = events.size();
+        pthread_mutex_unlock(&eventMutex);
+
+        applyEvents(events);
+
+        pthread_mutex_lock(&eventMutex);
+        numEventsInFlight = 0;
+        pthread_cond_broadcast(&drainedSignal);
+    }
+    pthread_mutex_unlock(&eventMutex);
+
+}
+
+void SelfLearningDB :: applyEvents(std::vector<SelfLearningEvent> & events) {
+
+    sqlite3 * handler = (writerHandler != nullptr) ? writerHandler : selfLearningDBHandler;
+    sqlite3_exec(handler, "BEGIN TRANSACTION", NULL, NULL, NULL);
+    for (auto & event : events) {
+        sqlite3_stmt * statement = nullptr;
+        auto cached = cachedStatements.find(event.sql);
+        if (cached != cachedStatements.end()) {
+            statement = cached->second;
+        } else if (sqlite3_prepare_v2(handler, event.sql.c_str(), -1, &statement,
+                     NULL) == SQLITE_OK) {
+            cachedStatements[event.sql] = statement;
+        } else {
+            std::cout << "failed to prepare " << event.sql << ": "
+                      << (std::string)(sqlite3_errmsg(handler)) << std::endl;
+            sqlite3_finalize(statement);
+            continue;
+        }
+        for (int i = 0; i < event.values.size(); i++) {
+            SelfLearningValue & value = event.values[i];
+            switch (value.type) {
+                case SelfLearningValue::Integer:
+                    sqlite3_bind_int64(statement, i + 1, value.intValue);
+                    break;
+                case SelfLearningValue::Real:
+                    sqlite3_bind_double(statement, i + 1, value.realValue);
+                    break;
+                case SelfLearningValue::Text:
+                    sqlite3_bind_text(statement, i + 1, value.bytes.c_str(),
+                                      value.bytes.size(), SQLITE_STATIC);
+                    break;
+                case SelfLearningValue::Blob:
+                    sqlite3_bind_blob(statement, i + 1, value.bytes.data(),
+                                      value.bytes.size(), SQLITE_STATIC);
+                    break;
+                default:
+                    sqlite3_bind_null(statement, i + 1);
+            }
+        }
+        if (sqlite3_step(statement) != SQLITE_DONE) {
+            std::cout << "failed to apply " << event.sql << ": "
+                      << (std::string)(sqlite3_errmsg(handler)) << std::endl;
+        }
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+    }
+    sqlite3_exec(handler, "COMMIT TRANSACTION", NULL, NULL, NULL);
+
 }
 
 
@@ -154,55 +324,55 @@ bool SelfLearningDB :: createTables() {
 bool SelfLearningDB :: createData (std::string databaseName, std::string setName, std::string created_jobId,
                 std::string setType, std::string className, int typeId, size_t pageSize, long lambdaId,
                 int replicationFactor, long& id, long lambdaId1) {
-     std::cout << "to create data..." << std::endl;
      id = dataId;
      dataId ++;
-     string cmdString = "INSERT INTO DATA "
+     std::cout << "CreateData: " << id << ", " << databaseName << ":" << setName << std::endl;
+     enqueueEvent(SelfLearningEvent("INSERT INTO DATA "
                 " (ID, DATABASE_NAME, SET_NAME, CREATED_JOBID, IS_REMOVED, SET_TYPE, "
                 "CLASS_NAME, TYPE_ID, SIZE, PAGE_SIZE, LAMBDA_ID, REPLICATION, MODIFICATION_TIME, LAMBDA_ID1) "
-                "VALUES(" + std::to_string(id) + "," 
-                          + quoteStr(databaseName) + ","
-                          + quoteStr(setName) + ","
-                          + quoteStr(created_jobId) + ","
-                          + "0,"
-                          + quoteStr(setType) + ","
-                          + quoteStr(className) + ","
-                          + std::to_string(typeId) + ","
-                          + "0,"
-                          + std::to_string(pageSize) + ","
-                          + std::to_string(lambdaId) + ","
-                          + std::to_string(replicationFactor)+","
-                          + "strftime('%s', 'now', 'localtime'),"
-                          + std::to_string(lambdaId1)+");";
-      std::cout << "CreateData: " << cmdString << std::endl;
-      return execDB(cmdString);
+                "VALUES(?,?,?,?,0,?,?,?,0,?,?,?,?,?);")
+                     .addInteger(id)
+                     .addText(databaseName)
+                     .addText(setName)
+                     .addText(created_jobId)
+                     .addText(setType)
+                     .addText(className)
+                     .addInteger(typeId)
+                     .addInteger(pageSize)
+                     .addInteger(lambdaId)
+                     .addInteger(replicationFactor)
+                     .addInteger(getLocalTime())
+                     .addInteger(lambdaId1));
+     return true;
 
 }
 
 bool SelfLearningDB :: updateDataForSize (long id, size_t size) {
-      std::string cmdString = "UPDATE DATA set SIZE = " + std::to_string(size) + 
-                              ", MODIFICATION_TIME = strftime('%s', 'now', 'localtime') where ID = " +
-                              std::to_string(id);
-      std::cout << "UpdateDataForSize: " << cmdString << std::endl;
-      return execDB(cmdString);
+      std::cout << "UpdateDataForSize: " << id << ", " << size << std::endl;
+      enqueueEvent(SelfLearningEvent("UPDATE DATA set SIZE = ?, MODIFICATION_TIME = ? where ID = ?")
+                      .addInteger(size)
+                      .addInteger(getLocalTime())
+                      .addInteger(id));
+      return true;
 
 }
 
 bool SelfLearningDB :: updateJobForInitialLatency (long id, double initialLatency, long initialJobInstanceId) {
-      std::string cmdString = "UPDATE JOB set INITIAL_LATENCY = " + std::to_string(initialLatency) + ", INITIAL_JOB_INSTANCE_ID = " + std::to_string(initialJobInstanceId) +
-                              " where ID = " +
-                              std::to_string(id);
-      std::cout << "UpdateJobForInitialLatency: " << cmdString << std::endl;
-      return execDB(cmdString);
+      std::cout << "UpdateJobForInitialLatency: " << id << ", " << initialLatency << std::endl;
+      enqueueEvent(SelfLearningEvent("UPDATE JOB set INITIAL_LATENCY = ?, INITIAL_JOB_INSTANCE_ID = ? where ID = ?")
+                      .addReal(initialLatency)
+                      .addInteger(initialJobInstanceId)
+                      .addInteger(id));
+      return true;
 }
 
 
 bool SelfLearningDB :: updateDataForRemoval (long id) {
-      std::string cmdString = std::string("UPDATE DATA set IS_REMOVED = 1") + 
-                              std::string(", MODIFICATION_TIME = strftime('%s', 'now', 'localtime') where ID = ") +
-                              std::to_string(id);
-      std::cout << "UpdateDataForRemoval: " << cmdString << std::endl;
-      return execDB(cmdString);
+      std::cout << "UpdateDataForRemoval: " << id << std::endl;
+      enqueueEvent(SelfLearningEvent("UPDATE DATA set IS_REMOVED = 1, MODIFICATION_TIME = ? where ID = ?")
+                      .addInteger(getLocalTime())
+                      .addInteger(id));
+      return true;
 
 }
 
@@ -216,30 +386,18 @@ bool SelfLearningDB :: createJob (std::string jobName, std::string tcap, Handle<
       } else {
            id = jobId;
            jobId ++;
-           sqlite3_stmt * statement;
-           replaceStr(tcap, "'", "''");
-           string cmdString = "INSERT INTO JOB "
+           std::cout << "CreateJob: " << id << ", " << jobName << std::endl;
+           //to get the bytes, which are copied into the event
+           Record<Vector<Handle<Computation>>> * record =
+                getRecord<Vector<Handle<Computation>>>(computations);
+           enqueueEvent(SelfLearningEvent("INSERT INTO JOB "
                 " (ID, NAME, TCAP, COMPUTATIONS, INITIAL_LATENCY, INITIAL_JOB_INSTANCE_ID) "
-                "VALUES(" + std::to_string(id) + ","
-                          + quoteStr(jobName) + ","
-                          + quoteStr(tcap) + ","
-                          + "?,-1.0, -1.0);";
-           std::cout << "CreateJob: " << cmdString << std::endl;
-           if (sqlite3_prepare_v2(selfLearningDBHandler, cmdString.c_str(),
-             -1, &statement, NULL) == SQLITE_OK) {
-                //to get the bytes
-                Record<Vector<Handle<Computation>>> * record =
-                     getRecord<Vector<Handle<Computation>>>(computations);
-                sqlite3_bind_blob(statement, 1, record, record->numBytes(), SQLITE_STATIC);
-                sqlite3_step(statement);
-                sqlite3_finalize(statement);
-
-                return true;
-           } else {
-                std::cout << (std::string)(sqlite3_errmsg(selfLearningDBHandler)) << std::endl;
-                sqlite3_finalize(statement);
-                return false;
-           }
+                "VALUES(?,?,?,?,-1.0, -1.0);")
+                     .addInteger(id)
+                     .addText(jobName)
+                     .addText(tcap)
+                     .addBlob(record, record->numBytes()));
+           return true;
 
       }
 }
@@ -250,7 +408,7 @@ bool SelfLearningDB :: existsJob (std::string jobName, long& id) {
       sqlite3_stmt * statement;
       std::string queryString = "SELECT ID from JOB WHERE NAME = " + quoteStr(jobName);
       std::cout << "ExistsJob: " << queryString << std::endl;
-      if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+      if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
 
           int res = sqlite3_step(statement);
@@ -277,7 +435,7 @@ long SelfLearningDB::getLatestId (std::string tableName) {
      long id;
      sqlite3_stmt * statement;
      std::string queryString = "SELECT MAX(ID) from " + tableName;
-     if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
+     if (prepareQuery(queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
          int res = sqlite3_step(statement);
          if (res == SQLITE_ROW) {
             id = sqlite3_column_int(statement, 0);
@@ -300,7 +458,7 @@ long SelfLearningDB::getLatestDataIdForLoadJob (std::string loadJobName) {
      long id;
      sqlite3_stmt * statement;
      std::string queryString = "SELECT MAX(ID) from DATA WHERE CREATED_JOBID = " + quoteStr(loadJobName);
-     if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
+     if (prepareQuery(queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
          int res = sqlite3_step(statement);
          if (res == SQLITE_ROW) {
             id = sqlite3_column_int(statement, 0);
@@ -352,7 +510,7 @@ Record<Vector<Handle<Computation>>> * SelfLearningDB :: getComputations (long id
       sqlite3_stmt * statement;
       std::string queryString = "SELECT COMPUTATIONS from JOB WHERE ID = " + std::to_string(id);
       std::cout << "GetComputations: " << queryString << std::endl;
-      if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+      if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
            int res = sqlite3_step(statement);
            if (res == SQLITE_ROW) {
@@ -380,7 +538,7 @@ Handle<Computation> SelfLearningDB :: getComputation(std::string jobName, std::s
      void * buffer = nullptr;
      std::string queryString = "SELECT COMPUTATIONS from JOB WHERE NAME = " + quoteStr(jobName);
      std::cout << "GetComputations: " << queryString << std::endl;
-      if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+      if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
            int res = sqlite3_step(statement);
            if (res == SQLITE_ROW) {
@@ -419,24 +577,25 @@ bool SelfLearningDB :: createJobInstance (long jobId, std::string jobIdForInstan
 
      id = jobInstanceId;
      jobInstanceId ++;
-     string cmdString = "INSERT INTO JOB_INSTANCE "
+     std::cout << "CreateJobInstance: " << id << ", " << jobIdForInstance << std::endl;
+     enqueueEvent(SelfLearningEvent("INSERT INTO JOB_INSTANCE "
                 " (ID, JOB_ID, JOB_INSTANCE_ID, STATUS, SUBMIT_TIME, FINISH_TIME) "
-                "VALUES(" + std::to_string(id) + ","
-                          + std::to_string(jobId) + ","
-                          + quoteStr(jobIdForInstance) + ","
-                          + "'Running',"
-                          + "strftime('%s', 'now', 'localtime'), null);";
-      std::cout << "CreateJobInstance: " << cmdString << std::endl;
-      return execDB(cmdString);
+                "VALUES(?,?,?,'Running',?, null);")
+                     .addInteger(id)
+                     .addInteger(jobId)
+                     .addText(jobIdForInstance)
+                     .addInteger(getLocalTime()));
+     return true;
 }
 
 bool SelfLearningDB :: updateJobInstanceForCompletion (long id, std::string status) {
 
-      std::string cmdString = std::string("UPDATE JOB_INSTANCE set STATUS = ") + quoteStr(status) +
-                              std::string(", FINISH_TIME = strftime('%s', 'now', 'localtime') where ID = ") +
-                              std::to_string(id);
-      std::cout << "UpdateJobInstanceForCompletion: " << cmdString << std::endl;
-      return execDB(cmdString);
+      std::cout << "UpdateJobInstanceForCompletion: " << id << ", " << status << std::endl;
+      enqueueEvent(SelfLearningEvent("UPDATE JOB_INSTANCE set STATUS = ?, FINISH_TIME = ? where ID = ?")
+                      .addText(status)
+                      .addInteger(getLocalTime())
+                      .addInteger(id));
+      return true;
 
 }
 
@@ -450,75 +609,65 @@ bool SelfLearningDB :: createJobStage (long jobInstanceId, int jobStageId,
 
      id = jobInstanceStageId;
      jobInstanceStageId ++;
-     sqlite3_stmt * statement;
-     string cmdString = "INSERT INTO JOB_STAGE "
+     std::cout << "CreateJobStage: " << id << ", " << stageType << std::endl;
+     SelfLearningEvent event("INSERT INTO JOB_STAGE "
                 " (ID, JOB_INSTANCE_ID, STAGE_ID, STAGE_TYPE, STATUS, "
                 "SOURCE_TYPE, SINK_TYPE, PROBE_TYPE, TUPLESET_SPECIFIERS, "
                 "NUM_HASH_KEYS, NUM_PARTITIONS, TARGET_COMPUTATION_SPECIFIER, "
                 "AGG_COMPUTATION, START_TIME, FINISH_TIME) "
-                "VALUES(" + std::to_string(id) + ","
-                          + std::to_string(jobInstanceId) + ","
-                          + std::to_string(jobStageId) + ","
-                          + quoteStr(stageType) + ","
-                          + quoteStr(status) + ","
-                          + quoteStr(sourceType) + ","
-                          + quoteStr(sinkType) + ","
-                          + quoteStr(probeType) + ","
-                          + "?,"
-                          + "0,"
-                          + std::to_string(numPartitions) + ","
-                          + quoteStr(targetComputationSpecifier) + ","
-                          + "?,"
-                          + "strftime('%s', 'now', 'localtime'), null);";
-      std::cout << "CreateJobStage: " << cmdString << std::endl;
-      char buffer[1];
-      buffer[0]=0;
-      if (sqlite3_prepare_v2(selfLearningDBHandler, cmdString.c_str(),
-             -1, &statement, NULL) == SQLITE_OK) {
-                //to get the bytes
-                if (buildTheseTupleSets == nullptr) {
-                   sqlite3_bind_blob(statement, 1, buffer, 1, SQLITE_STATIC);
-                } else {
-                   Record<Vector<String>> * record =
-                     getRecord<Vector<String>>(buildTheseTupleSets);
-                   sqlite3_bind_blob(statement, 1, record, record->numBytes(), SQLITE_STATIC);
-                }
-                if (aggregationComputation == nullptr) {
-                   sqlite3_bind_blob(statement, 2, buffer, 1, SQLITE_STATIC);
-                } else {
-                   Record<Computation> * record1 =
-                     getRecord<Computation>(aggregationComputation);
-                   sqlite3_bind_blob(statement, 2, record1, record1->numBytes(), SQLITE_STATIC);
-                }
-                sqlite3_step(statement);
-                sqlite3_finalize(statement);
-                return true;
-      } else {
-                std::cout << (std::string)(sqlite3_errmsg(selfLearningDBHandler)) << std::endl;
-                sqlite3_finalize(statement);
-                return false;
-      }
+                "VALUES(?,?,?,?,?,?,?,?,?,0,?,?,?,?, null);");
+     event.addInteger(id)
+          .addInteger(jobInstanceId)
+          .addInteger(jobStageId)
+          .addText(stageType)
+          .addText(status)
+          .addText(sourceType)
+          .addText(sinkType)
+          .addText(probeType);
+     //to get the bytes, which are copied into the event
+     char buffer[1];
+     buffer[0]=0;
+     if (buildTheseTupleSets == nullptr) {
+          event.addBlob(buffer, 1);
+     } else {
+          Record<Vector<String>> * record =
+               getRecord<Vector<String>>(buildTheseTupleSets);
+          event.addBlob(record, record->numBytes());
+     }
+     event.addInteger(numPartitions)
+          .addText(targetComputationSpecifier);
+     if (aggregationComputation == nullptr) {
+          event.addBlob(buffer, 1);
+     } else {
+          Record<Computation> * record1 =
+               getRecord<Computation>(aggregationComputation);
+          event.addBlob(record1, record1->numBytes());
+     }
+     event.addInteger(getLocalTime());
+     enqueueEvent(event);
+     return true;
 
 }
 
 
 bool SelfLearningDB :: updateJobStageForCompletion (long id, std::string status) {
 
-      std::string cmdString = std::string("UPDATE JOB_STAGE set STATUS = ") + quoteStr(status) +
-                              std::string(", FINISH_TIME = strftime('%s', 'now', 'localtime') where ID = ") +
-                              std::to_string(id);
-      std::cout << "UpdateJobStageForCompletion: " << cmdString << std::endl;
-      return execDB(cmdString);
+      std::cout << "UpdateJobStageForCompletion: " << id << ", " << status << std::endl;
+      enqueueEvent(SelfLearningEvent("UPDATE JOB_STAGE set STATUS = ?, FINISH_TIME = ? where ID = ?")
+                      .addText(status)
+                      .addInteger(getLocalTime())
+                      .addInteger(id));
+      return true;
 
 }
 
 bool SelfLearningDB :: updateJobStageForKeyDistribution (long id, int numHashKeys) {
 
-      std::string cmdString = std::string("UPDATE JOB_STAGE set NUM_HASH_KEYS = ") + std::to_string(numHashKeys) +
-                              std::string(" where ID = ") +
-                              std::to_string(id);
-      std::cout << "UpdateJobStageForKeyDistribution: " << cmdString << std::endl;
-      return execDB(cmdString);
+      std::cout << "UpdateJobStageForKeyDistribution: " << id << ", " << numHashKeys << std::endl;
+      enqueueEvent(SelfLearningEvent("UPDATE JOB_STAGE set NUM_HASH_KEYS = ? where ID = ?")
+                      .addInteger(numHashKeys)
+                      .addInteger(id));
+      return true;
 
 }
 
@@ -527,16 +676,16 @@ bool SelfLearningDB :: createDataJobStageMapping (long dataId, long jobInstanceS
 
      id = dataToJobStageMappingId;
      dataToJobStageMappingId ++;
-     string cmdString = "INSERT INTO DATA_JOB_STAGE "
+     std::cout << "CreateJobStageMapping: " << id << ", " << dataId << ", " << jobInstanceStageId << std::endl;
+     enqueueEvent(SelfLearningEvent("INSERT INTO DATA_JOB_STAGE "
                 " (ID, DATA_ID, JOB_STAGE_ID, INDEX_IN_INPUTS, DATA_TYPE) "
-                "VALUES(" + std::to_string(id) + ","
-                          + std::to_string(dataId) + ","
-                          + std::to_string(jobInstanceStageId) + ","
-                          + std::to_string(indexInInputs) + ","
-                          + quoteStr(type)+");";
-      std::cout << "CreateJobStageMapping: " << cmdString << std::endl;
-      return execDB(cmdString);
-     
+                "VALUES(?,?,?,?,?);")
+                     .addInteger(id)
+                     .addInteger(dataId)
+                     .addInteger(jobInstanceStageId)
+                     .addInteger(indexInInputs)
+                     .addText(type));
+     return true;
 
 }
 
@@ -552,25 +701,23 @@ bool SelfLearningDB :: createLambda (long jobId,
 
      id = lambdaId;
      lambdaId ++;
-     sqlite3_initialize();
-     string cmdString = "INSERT INTO LAMBDA "
+     std::cout << "CreateLambda: " << id << ", " << lambdaIdentifier << std::endl;
+     enqueueEvent(SelfLearningEvent("INSERT INTO LAMBDA "
                  " (ID, JOB_ID, LAMBDA_TYPE, LAMBDA_IDENTIFIER, "
                  "COMPUTATION_NAME, LAMBDA_NAME, "
                  "LAMBDA_INPUT_INDEX_IN_COMPUTATION_INPUTS, LAMBDA_INPUT_CLASS,"
                  " LAMBDA_OUTPUT_CLASS)"
-                 " VALUES(" + std::to_string(id) + ","
-                            + std::to_string(jobId) + ","
-                            + quoteStr(lambdaType) + ","
-                            + quoteStr(lambdaIdentifier) + ","
-                            + quoteStr(computationName) + ","
-                            + quoteStr(lambdaName) + ","
-                            + std::to_string(lambdaInputIndexInComputationInputs) + ","
-                            + quoteStr(lambdaInputClass) + ","
-                            + quoteStr(lambdaOutputClass) + ");";
-     std::cout << "CreateLambda: " << cmdString << std::endl;
-     bool ret = execDB(cmdString);
-     sqlite3_shutdown();
-     return ret;
+                 " VALUES(?,?,?,?,?,?,?,?,?);")
+                     .addInteger(id)
+                     .addInteger(jobId)
+                     .addText(lambdaType)
+                     .addText(lambdaIdentifier)
+                     .addText(computationName)
+                     .addText(lambdaName)
+                     .addInteger(lambdaInputIndexInComputationInputs)
+                     .addText(lambdaInputClass)
+                     .addText(lambdaOutputClass));
+     return true;
 }
 
 bool SelfLearningDB :: getInfoForLoadJob (std::string loadJobName, double & average, double & variance) {
@@ -580,7 +727,7 @@ bool SelfLearningDB :: getInfoForLoadJob (std::string loadJobName, double & aver
     std::string queryString = "SELECT SIZE from DATA WHERE CREATED_JOBID = " + quoteStr(loadJobName);
     double totalSize = 0;
     int count = 0;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
           while (1) {
               int res = sqlite3_step(statement);
@@ -622,7 +769,7 @@ bool SelfLearningDB :: getAllLambdaCandidates(std::string loadJobName, std::stri
     std::map<std::string, std::vector<LambdaContext>> lambdas;
     std::string queryString = "SELECT ID, JOB_ID, COMPUTATION_NAME, LAMBDA_NAME, LAMBDA_TYPE, LAMBDA_IDENTIFIER, LAMBDA_INPUT_INDEX_IN_COMPUTATION_INPUTS from LAMBDA WHERE LAMBDA_INPUT_CLASS = " + quoteStr(dataType);
     std::cout << "Get lambda context: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         while (1) {
             int res = sqlite3_step(statement);
@@ -696,7 +843,7 @@ bool SelfLearningDB :: getAllLambdaCandidates(std::string loadJobName, std::stri
             std::cout << "Get <JOB_INSTANCEID, JOB_STAGE_ID, JOB_ID, SINK_TYPE, DATA_ID, INPUT_SIZE, STAGE_ID, OUTPUT_SIZE>: " << queryString << std::endl;
              // get the historical runs
              // and for each run, we should find out
-            if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+            if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
                while (1) {
                  int res = sqlite3_step(statement);
@@ -745,7 +892,7 @@ bool SelfLearningDB :: getAllLambdaCandidates(std::string loadJobName, std::stri
              int jobStageId = relatedStages[j].stageId;
              std::string queryString = "SELECT NUM_HASH_KEYS from JOB_STAGE WHERE JOB_INSTANCE_ID = " + std::to_string(jobInstanceId) + " AND ID = " + std::to_string(jobStageId);
              std::cout << "Get NUM_HASH_KEYS: " << queryString << std::endl;
-             if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
+             if (prepareQuery(queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
                  int res = sqlite3_step(statement);
                  if (res == SQLITE_ROW) {
                      double  curNumHashKeys = (double)sqlite3_column_int(statement, 0)/(double)(100000);
@@ -885,7 +1032,7 @@ bool SelfLearningDB :: getAllLambdaCandidates1(std::string loadJobName, std::str
     int count = 0;
     std::string queryString = "SELECT ID, JOB_ID, COMPUTATION_NAME, LAMBDA_NAME, LAMBDA_INPUT_INDEX_IN_COMPUTATION_INPUTS from LAMBDA WHERE LAMBDA_INPUT_CLASS = " + quoteStr(dataType);
     std::cout << "Get lambda context: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         while (1) {
             int res = sqlite3_step(statement);
@@ -937,7 +1084,7 @@ bool SelfLearningDB :: getAllLambdaCandidates1(std::string loadJobName, std::str
         std::cout << "Get <JOB_INSTANCEID, JOB_STAGE_ID, JOB_ID, SINK_TYPE, DATA_ID, INPUT_SIZE, STAGE_ID, OUTPUT_SIZE>: " << queryString << std::endl;
         std::set<long> joinConsumers;
         std::set<long> aggConsumers;
-        if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+        if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
              while (1) {
                  int res = sqlite3_step(statement);
@@ -1014,7 +1161,7 @@ bool SelfLearningDB :: getAllLambdaCandidates1(std::string loadJobName, std::str
              int jobStageId = relatedStages[j].stageId;
              std::string queryString = "SELECT NUM_HASH_KEYS from JOB_STAGE WHERE JOB_INSTANCE_ID = " + std::to_string(jobInstanceId) + " AND STAGE_ID = " + std::to_string(jobStageId + 1);
              std::cout << "Get NUM_HASH_KEYS: " << queryString << std::endl;
-             if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
+             if (prepareQuery(queryString.c_str(), -1, &statement, NULL) == SQLITE_OK) {
                  int res = sqlite3_step(statement);
                  if (res == SQLITE_ROW) {
                      int numHashKeys = sqlite3_column_int(statement, 0);
@@ -1047,7 +1194,7 @@ bool SelfLearningDB :: getAllLambdaCandidates1(std::string loadJobName, std::str
                     " AND JOB_STAGE.JOB_INSTANCE_ID = " + std::to_string(jobInstanceId) +
                     " AND DATA_JOB_STAGE1.INDEX_IN_INPUTS = " + std::to_string(inputIndex);
                 std::cout << "Get Direct Consumer: " << queryString << std::endl;
-                if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+                if (prepareQuery(queryString.c_str(), -1, &statement,
                       NULL) == SQLITE_OK) {
                      int res = sqlite3_step(statement);
                      if (res == SQLITE_ROW) {
@@ -1162,7 +1309,7 @@ bool SelfLearningDB :: getProducerConsumerInfoForLoadJob(std::string loadJobName
       std::cout << "Get data: " << queryString << std::endl;
     size_t totalSize = 0;
     int numInstances = 0;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
           while (1) {
               std::cout << "the " << numInstances << " row:" << std::endl;
@@ -1205,7 +1352,7 @@ bool SelfLearningDB :: getProducerConsumerInfoForLoadJob(std::string loadJobName
               + " AND DATA_TYPE = 'Source'";
         std::cout << "Get JOB_STAGE: " << queryString << std::endl;
         long jobStageId = -1;
-        if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+        if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
               while (1) {
                   int res = sqlite3_step(statement);
@@ -1241,7 +1388,7 @@ bool SelfLearningDB :: getProducerConsumerInfoForLoadJob(std::string loadJobName
             //for each consumer job stage, we update the consumers map;
             queryString = "SELECT JOB_ID, STAGE_ID, SINK_TYPE, TARGET_COMPUTATION_SPECIFIER FROM JOB_INSTANCE, JOB_STAGE WHERE JOB_STAGE.ID = " + std::to_string(jobStageId) + " AND JOB_STAGE.JOB_INSTANCE_ID = JOB_INSTANCE.ID";
             std::cout << "Get info from JOB_STAGE: " << queryString << std::endl;
-            if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+            if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
                 int res = sqlite3_step(statement);
                 if (res == SQLITE_ROW) {
@@ -1283,7 +1430,7 @@ Handle<LambdaIdentifier> SelfLearningDB :: getLambda(long jobId, std::string com
     //first to get job name
     std::string queryString = "SELECT NAME from JOB WHERE ID = " + std::to_string(jobId);
       std::cout << "Get JobName: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1302,7 +1449,7 @@ Handle<LambdaIdentifier> SelfLearningDB :: getLambda(long jobId, std::string com
          + " AND LAMBDA_INPUT_CLASS = " + quoteStr(inputType) 
          + " AND LAMBDA_INPUT_INDEX_IN_COMPUTATION_INPUTS = " + std::to_string(indexInInputs);
     std::cout << "Get LambdaName: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         while (1) {
            int res = sqlite3_step(statement);
@@ -1344,7 +1491,7 @@ Handle<LambdaIdentifier> SelfLearningDB::getLambda(std::string jobName, std::str
          + std::to_string(jobId) + " AND COMPUTATION_NAME = " + quoteStr(computationName)
          + " AND LAMBDA_NAME = " + quoteStr(lambdaName);
     std::cout << "Get LambdaName: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         while (1) {
            int res = sqlite3_step(statement);
@@ -1379,7 +1526,7 @@ Handle<Vector<Handle<LambdaIdentifier>>> SelfLearningDB::getPartitionLambdas(std
     //first to get lambdaId
     std::string queryString = "SELECT LAMBDA_ID, LAMBDA_ID1 from DATA WHERE DATABASE_NAME = " + quoteStr(databaseName) + " AND SET_NAME = " + quoteStr(setName) + " ORDER BY MODIFICATION_TIME DESC";
     std::cout << "Get LAMBDA_IDs: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1412,7 +1559,7 @@ Handle<Vector<Handle<LambdaIdentifier>>> SelfLearningDB::getPartitionLambdas(std
         queryString = "SELECT JOB_ID, LAMBDA_IDENTIFIER, COMPUTATION_NAME, LAMBDA_NAME, LAMBDA_INPUT_CLASS from LAMBDA WHERE ID = "
              + std::to_string(lambdaIds[i]);
         std::cout << "Get LambdaName: " << queryString << std::endl;
-        if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+        if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
             while (1) {
                 int res = sqlite3_step(statement);
@@ -1455,7 +1602,7 @@ Handle<LambdaIdentifier> SelfLearningDB::getPartitionLambda(std::string database
     //first to get lambdaId
     std::string queryString = "SELECT LAMBDA_ID from DATA WHERE DATABASE_NAME = " + quoteStr(databaseName) + " AND SET_NAME = " + quoteStr(setName) + " ORDER BY MODIFICATION_TIME DESC";
     std::cout << "Get LAMBDA_ID: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1482,7 +1629,7 @@ Handle<LambdaIdentifier> SelfLearningDB::getPartitionLambda(std::string database
     queryString = "SELECT JOB_ID, LAMBDA_IDENTIFIER, COMPUTATION_NAME, LAMBDA_NAME, LAMBDA_INPUT_CLASS from LAMBDA WHERE ID = "
          + std::to_string(lambdaId);
     std::cout << "Get LambdaName: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         while (1) {
            int res = sqlite3_step(statement);
@@ -1524,7 +1671,7 @@ size_t SelfLearningDB::getDataSize (std::string loadJobName, long jobInstanceId)
 
     std::cout << "GET DATA size: " << queryString << std::endl;
     size_t size = 0;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1553,7 +1700,7 @@ bool SelfLearningDB::getReward(std::string loadJobName, double &reward) {
                                          "WHERE DATA.ID = " + std::to_string(lastDataId) + 
                                          " AND DATA_JOB_STAGE.DATA_TYPE = 'Source' AND JOB_INSTANCE.STATUS = 'Succeeded'";
      std::cout << "GET Execution time: " << queryString << std::endl;
-     if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+     if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         
         while (1) {
@@ -1643,7 +1790,7 @@ bool SelfLearningDB::getSinkData (long jobStageId, std::pair<std::string, std::s
     std::string queryString = "SELECT DATABASE_NAME, SET_NAME FROM DATA WHERE ID = "
         + std::to_string(dataId);
     std::cout << "GET DATA info: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1666,7 +1813,7 @@ long SelfLearningDB::getJobId (std::string jobName) {
    long jobId = -1;
    std::string queryString = "SELECT ID FROM JOB WHERE NAME = " + quoteStr(jobName);
    std::cout << "Get JOB_ID: " << queryString << std::endl;
-   if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+   if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1687,7 +1834,7 @@ long SelfLearningDB::getLambdaId (long dataId) {
    std::string queryString = "SELECT LAMBDA_ID FROM DATA WHERE ID = " +
          std::to_string(dataId);
    std::cout << "Get LAMBDA_ID: " << queryString << std::endl;
-   if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+   if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1711,7 +1858,7 @@ long SelfLearningDB::getLambdaId (std::string jobName, std::string computationNa
                               + " AND COMPUTATION_NAME = " + quoteStr(computationName)
                               + " AND LAMBDA_NAME = " + quoteStr(lambdaName);
     std::cout << "Get LAMBDA_ID: " << queryString << std::endl;
-   if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+   if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1733,7 +1880,7 @@ long SelfLearningDB::getSinkDataId (long jobStageId) {
     std::string queryString = "SELECT DATA_ID FROM DATA_JOB_STAGE WHERE JOB_STAGE_ID = "
          + std::to_string(jobStageId) + " AND DATA_TYPE = 'Sink'";
     std::cout << "Get DATA_ID: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1754,7 +1901,7 @@ std::string SelfLearningDB::getDataType (long dataId) {
     std::string queryString = "SELECT CLASS_NAME FROM DATA WHERE ID = "
          + std::to_string(dataId);
     std::cout << "Get CLASS_NAME: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1775,7 +1922,7 @@ std::string SelfLearningDB::getJobName (long jobId) {
     std::string queryString = "SELECT NAME FROM JOB WHERE ID = "
          + std::to_string(jobId);
     std::cout << "Get NAME: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1799,7 +1946,7 @@ std::string SelfLearningDB::getJobName (std::string job_instance_id) {
     std::string queryString = "SELECT JOB_ID FROM JOB_INSTANCE WHERE JOB_INSTANCE_ID = "
          + quoteStr(job_instance_id);
     std::cout << "Get JOB_ID: " << queryString << std::endl;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
         int res = sqlite3_step(statement);
         if (res == SQLITE_ROW) {
@@ -1826,7 +1973,7 @@ bool SelfLearningDB::getConsumerInfoForData(long dataId,
           + " AND DATA_TYPE = 'Source'";
     std::cout << "Get JOB_STAGES: " << queryString << std::endl;
     long jobStageId = -1;
-    if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+    if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
           while (1) {
               int res = sqlite3_step(statement);
@@ -1858,7 +2005,7 @@ bool SelfLearningDB::getConsumerInfoForData(long dataId,
            //for each consumer job stage, we update the consumers map;
            queryString = "SELECT JOB_ID, STAGE_ID, SINK_TYPE, TARGET_COMPUTATION_SPECIFIER FROM JOB_INSTANCE, JOB_STAGE WHERE JOB_STAGE.ID = " + std::to_string(jobStageId) + " AND JOB_STAGE.JOB_INSTANCE_ID = JOB_INSTANCE.ID";
            std::cout << "Get info from JOB_STAGE: " << queryString << std::endl;
-           if (sqlite3_prepare_v2(selfLearningDBHandler, queryString.c_str(), -1, &statement,
+           if (prepareQuery(queryString.c_str(), -1, &statement,
                      NULL) == SQLITE_OK) {
                 int res = sqlite3_step(statement);
                 if (res == SQLITE_ROW) {
@@ -18,7 +18,12 @@
 #ifndef CATALOG_CLIENT_H
 #define CATALOG_CLIENT_H
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <PDBCatalogSet.h>
+#include <PDBCatalogDatabase.h>
+#include <PDBCatalogType.h>
 #include "CatSharedLibraryByNameRequest.h"
 #include "CatSyncRequest.h"
 #include "CatPrintCatalogRequest.h"
@@ -26,6 +31,12 @@
 #include "PDBServer.h"
 #include "ServerFunctionality.h"
 
+// how long a Catalog Client serves a type, set or database it has fetched from its cache, before
+// it asks the catalog again, in milliseconds; 0 disables the cache
+#ifndef PDB_CATALOG_CACHE_TTL_MS
+#define PDB_CATALOG_CACHE_TTL_MS 5000
+#endif
+
 namespace pdb {
 
 class CatalogClient : public ServerFunctionality {
@@ -67,6 +78,10 @@ public:
   /* Retrieves the content of a Shared Library given it's Type Id */
   bool getSharedLibrary(int16_t identifier, std::string sharedLibraryFileName);
 
+  /* Retrieves the content hash of a Shared Library given its Type Id, without its bytes,
+   * returns "" on err */
+  std::string getSharedLibraryHash(int16_t identifier, std::string &errMsg);
+
   /* Retrieves the content of a Shared Library along with its registered
    * metadata,
    * given it's typeName. Typically this method is invoked by a remote machine
@@ -116,6 +131,13 @@ public:
   bool createSet(const std::string &typeName, int16_t typeID, const std::string &databaseName,
                  const std::string &setName, std::string &errMsg);
 
+  /* Sends a request to the Catalog Server to record how a registered set is
+   * partitioned, the partition lambda, the number of partitions and the nodes
+   * they are placed on, or to clear it if the set has no partitions; returns
+   * true on success, false on fail
+   */
+  bool setPartitioning(const pdb::PDBCatalogSet &set, std::string &errMsg);
+
   /* Sends a request to the Catalog Server to delete a database; returns true on
    * success, false on
    * fail
@@ -164,6 +186,10 @@ public:
   /* Lists the user-defined types registered in the catalog. */
   string listUserDefinedTypes(std::string &errMsg);
 
+  /* Called by the Catalog Server of this process every time its catalog changes, drops the
+   * metadata cached by all the Catalog Clients of this process */
+  static void catalogChanged();
+
 
 private:
   /* True if this Catalog Client points to the Manager Catalog Server */
@@ -180,6 +206,64 @@ private:
 
   /* To ensure serialized access */
   pthread_mutex_t workingMutex;
+
+  /* An entry of the cache, along with the time it was fetched */
+  template <class Value>
+  struct CachedEntry {
+    Value value;
+    long fetchedAt;
+  };
+
+  /*
+   * The types, sets and databases this client has fetched. Only things that exist are cached, so
+   * creating something can never make the cache stale. The entries are dropped:
+   *   - when a response carries a catalog version newer than the one they were fetched at
+   *   - when the Catalog Server of this process reports a change
+   *   - when this client deletes a set or database
+   *   - once they are older than PDB_CATALOG_CACHE_TTL_MS, which bounds how long a client that
+   *     gets no pushes (one in another process) may see something deleted by someone else
+   * Copies of a client share its cache.
+   */
+  struct MetadataCache {
+
+    MetadataCache();
+    ~MetadataCache();
+
+    /* returns the entry with the key if it is still valid */
+    template <class Key, class Value>
+    bool find(std::map<Key, CachedEntry<Value>> &entries, const Key &key, Value &value);
+
+    /* caches a value fetched from a response with the given catalog version; changesBefore is the
+     * number of local catalog changes when the request was sent */
+    template <class Key, class Value>
+    void insert(std::map<Key, CachedEntry<Value>> &entries, const Key &key, const Value &value,
+                long version, long changesBefore);
+
+    /* drops all the entries */
+    void invalidate();
+
+    /* drops the entries if the catalog of this process changed, call with the mutex held */
+    void validate();
+
+    pthread_mutex_t mutex;
+
+    /* the newest catalog version we have seen in a response, -1 if none */
+    long catalogVersion = -1;
+
+    /* the number of local catalog changes the entries were fetched after */
+    long localChanges = 0;
+
+    std::map<std::string, CachedEntry<PDBCatalogTypePtr>> types;
+
+    std::map<std::pair<std::string, std::string>, CachedEntry<PDBCatalogSetPtr>> sets;
+
+    std::map<std::string, CachedEntry<PDBCatalogDatabasePtr>> databases;
+  };
+
+  std::shared_ptr<MetadataCache> cache;
+
+  /* The number of times the catalog of this process has changed */
+  static std::atomic<long> localCatalogChanges;
 };
 }
 
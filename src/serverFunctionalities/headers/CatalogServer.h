@@ -18,6 +18,7 @@
 #ifndef CATALOG_SERVER_H
 #define CATALOG_SERVER_H
 
+#include <atomic>
 #include <mutex>
 #include <CatDeleteDatabaseRequest.h>
 
@@ -45,6 +46,11 @@
  * object
  *    3) update catalog version
  *
+ *  Every change of the manager catalog is also appended to its change log, with
+ *  a version. A worker joining or restarting asks for the changes after the last
+ *  one it has applied, and fetches the libraries of the types it learns about
+ *  the first time they are needed.
+ *
  *  if this is the catalog instance of a worker node, it will receive a metadata
  * registration
  *  request from the manager catalog server and perform the following operations:
@@ -141,6 +147,19 @@ public:
    */
   std::mutex serverMutex;
 
+  /**
+   * The version of the catalog, sent with the metadata we hand out so that Catalog Clients know
+   * when what they have cached is stale. It starts at the time the server started, in
+   * microseconds, so that it keeps growing across restarts.
+   */
+  std::atomic<long> catalogVersion;
+
+  /**
+   * Bumps the catalog version and tells the Catalog Clients of this process, called after every
+   * change of the catalog
+   */
+  void catalogChanged();
+
   /**
    * Makes the directories of the catalog if needed
    */
@@ -158,10 +177,17 @@ public:
   void registerManager();
 
   /**
-   * sync the worker catalog with the manager.
+   * sync the worker catalog with the manager, by applying the changes of the manager catalog made since the
+   * last change we have applied
    */
   void syncWithManager();
 
+  /**
+   * Appends a change to the change log of the catalog, if this is the manager catalog
+   * @param change - the change
+   */
+  void recordChange(const PDBCatalogChange &change);
+
   /**
    * Adds a new object type... return -1 on failure, this is done on a worker node catalog
    * the typeID is given by the manager catalog
@@ -217,8 +243,8 @@ public:
   template <class Type>
   bool forwardRequest(pdb::Handle<Type> &request, const std::string &address, int port, std::string &errMsg) {
 
-    // make an allocation block
-    const UseTemporaryAllocationBlock tempBlock{1024};
+    // make an allocation block, large enough for a set partitioning that lists every node
+    const UseTemporaryAllocationBlock tempBlock{16 * 1024};
 
     // copy the request we want to forward
     Handle<Type> requestCopy = makeObject<Type>(request);
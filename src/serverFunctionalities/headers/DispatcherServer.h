@@ -10,10 +10,12 @@
 #include "PDBVector.h"
 
 #include "NodeDispatcherData.h"
+#include "PDBCatalogSet.h"
 #include "StorageClient.h"
 
 #include <string>
 #include <queue>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -65,6 +67,24 @@ public:
      */
     void deregisterSet(std::pair<std::string, std::string> setAndDatabase);
 
+    /**
+     * Returns true if all the data of a set is dispatched with a LambdaPolicy that applies the
+     * partition lambda of the given catalog set, into the same number of partitions
+     *
+     * @param setAndDatabase name of the set and its corresponding database
+     * @param partitioning the partitioning of the set as recorded in the catalog
+     */
+    bool isPartitionedAs(std::pair<std::string, std::string> setAndDatabase,
+                         const PDBCatalogSet& partitioning);
+
+    /**
+     * Records that data of a set was placed without its partition policy, for example dispatched
+     * as raw bytes or written by a query, and clears the partitioning of the set in the catalog
+     *
+     * @param setAndDatabase name of the set and its corresponding database
+     */
+    void bypassPartitionPolicy(std::pair<std::string, std::string> setAndDatabase);
+
 
 
 
@@ -117,6 +137,19 @@ private:
     Handle<Vector<Handle<NodeDispatcherData>>> storageNodes;
     std::map<std::pair<std::string, std::string>, PartitionPolicyPtr> partitionPolicies;
 
+    // the sets that got data placed without their partition policy
+    std::set<std::pair<std::string, std::string>> bypassedSets;
+
+    // protects partitionPolicies and bypassedSets
+    pthread_mutex_t policyMutex;
+
+    /**
+     * Returns the partition policy of a set, registering the default policy if it has none
+     * @param registeredDefault set to true if the default policy was registered
+     */
+    PartitionPolicyPtr getPartitionPolicy(std::pair<std::string, std::string> setAndDatabase,
+                                          bool& registeredDefault);
+
     /**
      * Validates with the catalog that a request to store data is correct
      * @return true if the type matches the known set
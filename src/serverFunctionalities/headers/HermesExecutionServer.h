@@ -10,6 +10,14 @@
 #include "HashSetManager.h"
 #include "DataProxy.h"
 #include <string>
+#include <vector>
+#include <pthread.h>
+
+// the share of the memory budget of an aggregation stage that it keeps when it runs next to the
+// stage that shuffles its input
+#ifndef PDB_PIPELINED_MEMORY_SHARE
+#define PDB_PIPELINED_MEMORY_SHARE 0.5
+#endif
 
 namespace pdb {
 
@@ -45,7 +53,8 @@ public:
         this->shm = shm;
         this->conf = conf;
         this->nodeId = nodeId;
-        this->curScanner = nullptr;
+        this->scannersPipelined = false;
+        pthread_mutex_init(&scannerMutex, nullptr);
         this->logger = logger;
         this->workers = workers;
         this->selfLearningOrNot = selfLearningOrNot;
@@ -98,28 +107,64 @@ public:
     void registerHandlers(PDBServer& forMe) override;
 
     // register the PageScanner for current job;
-    // now only one job is allowed to run in an execution server at a time
-    bool setCurPageScanner(PageScannerPtr curPageScanner) {
+    // now only one job is allowed to run in an execution server at a time, except for the stages
+    // of a pipeline, which run at the same time and each register their scanner as pipelined;
+    // registering nullptr removes all the scanners
+    bool setCurPageScanner(PageScannerPtr curPageScanner, bool pipelined = false) {
+        pthread_mutex_lock(&scannerMutex);
         if (curPageScanner == nullptr) {
-            this->curScanner = nullptr;
+            this->scanners.clear();
+            pthread_mutex_unlock(&scannerMutex);
             return true;
         }
 
-        if (this->curScanner == nullptr) {
-            this->curScanner = curPageScanner;
+        if (this->scanners.empty() || (pipelined && this->scannersPipelined)) {
+            this->scanners.push_back(curPageScanner);
+            this->scannersPipelined = pipelined;
+            pthread_mutex_unlock(&scannerMutex);
             PDB_COUT << "scanner set for current job\n";
             return true;
         } else {
             // a job is already running
+            pthread_mutex_unlock(&scannerMutex);
             cout << "PDBBackEnd: a job is already running...\n";
             return false;
         }
     }
 
+    // remove the PageScanner of a job that is done
+    void removePageScanner(PageScannerPtr curPageScanner) {
+        pthread_mutex_lock(&scannerMutex);
+        for (auto it = this->scanners.begin(); it != this->scanners.end(); ++it) {
+            if (*it == curPageScanner) {
+                this->scanners.erase(it);
+                break;
+            }
+        }
+        pthread_mutex_unlock(&scannerMutex);
+    }
 
-    // return the PageScanner of current job;
+    // return the PageScanner of current job, or the first one if a pipeline is running
     PageScannerPtr getCurPageScanner() {
-        return this->curScanner;
+        pthread_mutex_lock(&scannerMutex);
+        PageScannerPtr scanner = this->scanners.empty() ? nullptr : this->scanners.front();
+        pthread_mutex_unlock(&scannerMutex);
+        return scanner;
+    }
+
+    // return the PageScanner that scans the given set, or the PageScanner of current job if no
+    // scanner asked for that set
+    PageScannerPtr getPageScanner(DatabaseID dbId, UserTypeID typeId, SetID setId) {
+        pthread_mutex_lock(&scannerMutex);
+        PageScannerPtr scanner = this->scanners.empty() ? nullptr : this->scanners.front();
+        for (PageScannerPtr& candidate : this->scanners) {
+            if (candidate->isScanning(dbId, typeId, setId)) {
+                scanner = candidate;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&scannerMutex);
+        return scanner;
     }
 
     // set the logger
@@ -143,7 +188,9 @@ public:
     }
 
     // destructor
-    ~HermesExecutionServer() {}
+    ~HermesExecutionServer() {
+        pthread_mutex_destroy(&scannerMutex);
+    }
 
     // get hash set
     AbstractHashSetPtr getHashSet(std::string name) {
@@ -183,7 +230,10 @@ private:
     SharedMemPtr shm;
     PDBWorkerQueuePtr workers;
     NodeID nodeId;
-    PageScannerPtr curScanner;
+    // the scanners of the running job, or of the stages of the running pipeline
+    std::vector<PageScannerPtr> scanners;
+    bool scannersPipelined;
+    pthread_mutex_t scannerMutex;
     pdb::PDBLoggerPtr logger;
     HashSetManager hashSetMgr;
     bool selfLearningOrNot;
@@ -15,13 +15,32 @@
 #include "SharedMem.h"
 #include "TempSet.h"
 #include "PDBWork.h"
+#include "SetIdentifier.h"
 #include <vector>
 #include <string>
 #include <map>
 #include <boost/filesystem.hpp>
 #include <pthread.h>
 #include <memory>
+#include <tuple>
 
+// a record that fills at least this fraction of a page is adopted as a page of its own, instead
+// of having its objects copied one by one into a shared page
+#ifndef PDB_ADOPT_RECORD_MIN_FILL
+#define PDB_ADOPT_RECORD_MIN_FILL 0.5
+#endif
+
+// how many bytes of formatted objects each export worker collects before it appends them to
+// the output file
+#ifndef PDB_EXPORT_BUFFER_SIZE
+#define PDB_EXPORT_BUFFER_SIZE (4 * 1024 * 1024)
+#endif
+
+// how long the scan of a shuffle stream waits for new data before it gives up on the producers
+// that have not ended yet and fails the stage, in milliseconds
+#ifndef PDB_SHUFFLE_STREAM_TIMEOUT_MS
+#define PDB_SHUFFLE_STREAM_TIMEOUT_MS 600000
+#endif
 
 namespace pdb {
 
@@ -80,6 +99,26 @@ public:
     // this allocates a new page at the end of the indicated database/set combo
     PDBPagePtr getNewPage(pair<std::string, std::string> databaseAndSet);
 
+    // copies a record, which must fit in a page, as a whole into a new page of the indicated
+    // database/set combo, so that the page holds the record as it was built by the sender;
+    // the caller still owns the record
+    bool adoptRecord(pair<std::string, std::string> databaseAndSet,
+                     Record<Vector<Handle<Object>>>* record,
+                     bool flushOrNot);
+
+    // like adoptRecord, but for a record that is still a compressed frame, which is decompressed
+    // straight into the new page; returns false, and sets errMsg, if the frame does not hold a
+    // valid, non-empty record that fits in the page
+    bool adoptCompressedRecord(pair<std::string, std::string> databaseAndSet,
+                               char* frame,
+                               size_t frameSize,
+                               bool flushOrNot,
+                               std::string& errMsg);
+
+    // checks that a received record is self-consistent: its size fits in the bytes received,
+    // and its root object lies inside of it
+    static bool isValidRecord(Record<Vector<Handle<Object>>>* record, size_t numBytesReceived);
+
     // returns a set object referencing the given database/set pair
     SetPtr getSet(std::pair<std::string, std::string> databaseAndSet);
 
@@ -114,6 +153,74 @@ public:
      */
     string getPathToBackEndServer();
 
+    /**
+     * Points the frontend to a new backend, after the backend it talked to is replaced
+     */
+    void setPathToBackEndServer(string path);
+
+    /**
+     * Mark a set as a shuffle stream: a set that is scanned while numProducers senders are
+     * still adding data to it, each of which marks its last data as the end of its stream
+     */
+    void openShuffleStream(pair<std::string, std::string> databaseAndSet, int numProducers);
+
+    /**
+     * Called when a request to add data to a set is received, before the sender hears back,
+     * so that flushing a shuffle stream also waits for the data its producers consider as sent
+     */
+    void receiveShuffleData(pair<std::string, std::string> databaseAndSet);
+
+    /**
+     * Called before received data is stored to a set; waits while a round of the scan of the
+     * set as a shuffle stream runs
+     */
+    void beginStoringShuffleData(pair<std::string, std::string> databaseAndSet);
+
+    /**
+     * Called once received data was stored to a set, or was dropped; stored tells whether
+     * beginStoringShuffleData was called. Counts the data if the set is a shuffle stream, and
+     * counts the end of a stream if lastOfStream is set
+     */
+    void notifyShuffleStream(pair<std::string, std::string> databaseAndSet,
+                             bool stored,
+                             bool lastOfStream);
+
+    /**
+     * Returns true if the set is an open shuffle stream
+     */
+    bool isShuffleStream(pair<std::string, std::string> databaseAndSet);
+
+    /**
+     * Waits until data is added to a shuffle stream after the numAdds-th addition, or until all
+     * its producers have ended; updates numAdds, and returns true if no more data will come.
+     * timedOut is set if the producers did not all end in time, and then no more data is taken
+     */
+    bool waitForShuffleData(pair<std::string, std::string> databaseAndSet,
+                            long& numAdds,
+                            bool& timedOut);
+
+    /**
+     * Writes back the records of a shuffle stream that are still buffered, once all its
+     * producers have ended and all the data they sent is stored
+     */
+    void flushShuffleStream(pair<std::string, std::string> databaseAndSet);
+
+    /**
+     * Blocks storing data to a shuffle stream while a round of its scan runs, once the data
+     * being stored now is stored
+     */
+    void beginShuffleScan(pair<std::string, std::string> databaseAndSet);
+
+    /**
+     * Lets data be stored to a shuffle stream again after a round of its scan
+     */
+    void endShuffleScan(pair<std::string, std::string> databaseAndSet);
+
+    /**
+     * Forgets a shuffle stream once its consumer has scanned all of it
+     */
+    void closeShuffleStream(pair<std::string, std::string> databaseAndSet);
+
     /**
      * Returns logger
      */
@@ -276,7 +383,8 @@ public:
 
     void cleanup(bool flushOrNot = true);
 
-    // export to a local file
+    // export to a local file, in parallel; in the "binary" format, each page iterator writes
+    // the records of its pages to a file of its own, path.i, as ExportedSetFile lays it out
     bool exportToFile(std::string dbName,
                       std::string setName,
                       std::string path,
@@ -327,6 +435,31 @@ protected:
     void clearDB(DatabaseID dbId, string dbName);
 
 
+    /**
+     * Return stats of the user sets whose number of pages changed after sinceVersion
+     * (removed sets are returned with zero pages), and set version to the current
+     * stats version of this node
+     */
+    Handle<Vector<Handle<SetIdentifier>>> getStatsSince(long sinceVersion, long& version);
+
+    /**
+     * Asynchronously push the stats changed since the last push to the manager,
+     * so that the query scheduler can plan with a cached snapshot
+     */
+    void pushStatsToManager();
+
+    /**
+     * Stop the worker that pushes stats to the manager, and wait until it is done with
+     * statsMutex and statsSignal
+     */
+    void stopStatsPusher();
+
+    /**
+     * Mark a set as changed even if its number of pages stays the same, e.g. when data
+     * is appended to its last page, so that cached results over it become invalid
+     */
+    void bumpSetVersion(std::string databaseName, std::string setName);
+
     /**
      * Add an existing database based on Sequence file (deprecated)
      */
@@ -390,6 +523,9 @@ private:
     // Path to backend server
     string pathToBackEndServer;
 
+    // mutex for the path to backend server, which changes when the backend is replaced
+    pthread_mutex_t backEndPathMutex;
+
     // mutex for managing database
     pthread_mutex_t databaseLock;
 
@@ -449,6 +585,50 @@ private:
 
     pthread_mutex_t workingMutex;
     pthread_mutex_t counterMutex;
+
+    // stats version of this node, bumped whenever the number of pages of a set changes
+    long statsVersion = 0;
+
+    // the stats version last pushed to the manager
+    long pushedStatsVersion = 0;
+
+    // the number of pages and page size last observed for each set, and the stats
+    // version when that change was observed
+    std::map<pair<std::string, std::string>, std::tuple<int, size_t, long>> setStats;
+
+    pthread_mutex_t statsMutex;
+
+    // whether the stats pusher is started, stopped or done, and whether a push is requested;
+    // all protected by statsMutex, and statsSignal wakes up the pusher and stopStatsPusher ()
+    bool statsPusherStarted = false;
+    bool statsPusherStopped = false;
+    bool statsPusherDone = false;
+    bool statsPushRequested = false;
+    pthread_cond_t statsSignal;
+
+    // a set that is scanned while its producers are still adding data to it
+    struct ShuffleStream {
+        // the number of producers, 0 until the consumer opens the stream
+        int numProducers = 0;
+        // the number of producers that have sent their last data
+        int numEnded = 0;
+        // the number of times data was added to the set
+        long numAdds = 0;
+        // the number of requests to add data that are received and not stored yet
+        int numReceived = 0;
+        // the number of requests that are storing data right now
+        int numStoring = 0;
+        // whether a round of the scan runs, during which no data is stored
+        bool scanning = false;
+    };
+
+    std::map<pair<std::string, std::string>, ShuffleStream> shuffleStreams;
+
+    // protects the shuffle streams, and signals the data added to them and the end of the
+    // rounds of their scans; a set has an entry while data is added to it or while it is open
+    pthread_mutex_t streamMutex;
+    pthread_cond_t streamSignal;
+
     int numWaitingBufferDataRequests;
     double inflationFactor = 40.0;
 };
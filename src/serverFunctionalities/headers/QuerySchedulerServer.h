@@ -18,7 +18,16 @@
 #include "SequenceID.h"
 #include "TCAPAnalyzer.h"
 #include "ShuffleInfo.h"
+#include "ResultCache.h"
+#include "ExecutionProfiler.h"
 #include <vector>
+#include <map>
+
+// whether an aggregation stage runs at the same time as the combining shuffle stage that
+// produces its input, scanning the shuffled data as it arrives
+#ifndef PDB_PIPELINE_SHUFFLE_AGGREGATION
+#define PDB_PIPELINE_SHUFFLE_AGGREGATION true
+#endif
 
 namespace pdb {
 
@@ -96,6 +105,10 @@ public:
 
 
 
+    // returns true if the stage after the i-th stage aggregates the output of the i-th stage,
+    // which is a combining shuffle stage, so that both stages can run at the same time
+    bool canPipelineWithNextStage(std::vector<Handle<AbstractJobStage>>& stagesToSchedule, int i);
+
     // Jia: one TODO is to consolidate below three functions into one function.
     // to replace: bool schedule(Handle<JobStage> &stage, PDBCommunicatorPtr communicator,
     // ObjectCreationMode mode)
@@ -146,8 +159,30 @@ public:
         return this->jobId;
     }
 
-    void collectStats();
+    // collects the stats of the sets that changed on each storage node, and returns false if
+    // some node could not be reached
+    bool collectStats();
     void updateStats(Handle<SetIdentifier> setToUpdateStats);
+
+    // to remember the execution profile of a stage on the index-th node
+    void addStageProfile(JobStageID stageId, std::string stageType, int index, std::string profile);
+
+    // to assemble the profiles of all stages of the current job into one report, like the
+    // output of EXPLAIN ANALYZE: per stage, the operators with their counters summed over all
+    // nodes, and the node that took longest
+    std::string getJobProfile();
+
+    // to update stats with the set that a stage wrote on the index-th node
+    void updateStats(Handle<SetIdentifier> setToUpdateStats, int index);
+
+    // to apply stats reported by a storage node, for sets that changed since the version
+    // last seen from that node
+    void applyNodeStats(NodeID nodeId,
+                        long version,
+                        Handle<Vector<Handle<SetIdentifier>>> stats);
+
+    // to apply stats deltas that storage nodes pushed since the last query
+    void applyPendingStats();
     void resetStats(Handle<SetIdentifier> setToUpdateStats);
 
     void setSelfLearning (bool selfLearningOrNot) {
@@ -162,6 +197,31 @@ public:
 
     }    
 
+    void setResultCaching (bool resultCachingOrNot) {
+
+        this->resultCachingOrNot = resultCachingOrNot;
+
+    }
+
+    bool isResultCaching () {
+
+        return this->resultCachingOrNot;
+
+    }
+
+    // to return the fingerprint of a job: its TCAP program and the versions of the sets it
+    // scans, or an empty string if the results of the job can not be cached
+    std::string getResultCacheKey(Handle<Vector<Handle<Computation>>> computations,
+                                  std::string tcapString);
+
+    // to check whether the results of the job are cached and its output sets are unchanged
+    bool isResultCached(std::string key);
+
+    // to remember the output sets of a job that has just finished
+    void cacheResult(std::string key,
+                     Handle<Vector<Handle<Computation>>> computations,
+                     double cost);
+
     std::shared_ptr<ShuffleInfo> getShuffleInfo (); 
 
 protected:
@@ -185,6 +245,12 @@ protected:
 
     int numHashKeys = 0;
 
+    // the type of each stage of the current job
+    std::map<JobStageID, std::string> stageTypes;
+
+    // the execution profile of each stage of the current job on each node
+    std::map<JobStageID, std::map<int, std::map<std::string, OperatorProfile>>> stageProfiles;
+
 
     // logger
     PDBLoggerPtr logger;
@@ -216,10 +282,26 @@ protected:
 
     StatisticsPtr statsForOptimization;
 
+    // latest stats version applied from each storage node
+    std::map<NodeID, long> nodeStatsVersions;
+
+    // stats deltas pushed by storage nodes but not applied yet, as (nodeId, version, setName,
+    // databaseName, numPages, pageSize, setVersion)
+    std::vector<std::tuple<NodeID, long, std::string, std::string, int, size_t, long>>
+        pendingStats;
+
+    pthread_mutex_t statsMutex;
+
     std::shared_ptr<ShuffleInfo> shuffleInfo = nullptr;
 
     bool selfLearningOrNot;
 
+    // whether to skip jobs whose results are still in their output sets, set by the
+    // resultCaching key of the settings file
+    bool resultCachingOrNot = false;
+
+    ResultCachePtr resultCache = nullptr;
+
 
 };
 }
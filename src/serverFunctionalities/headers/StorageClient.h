@@ -65,6 +65,17 @@ public:
                    std::string typeName,
                    std::string& errMsg);
 
+    // this loads the files path.0, path.1, ... written by exporting a set in the "binary"
+    // format (see ExportedSetFile) into a set; each record in the files becomes a page of the set
+    // as it is, without unpacking its objects.  The files must hold typeName, or the type they
+    // name is used if typeName is "", and must be written with the library of the type that is
+    // registered here... returns true on success
+    bool importSet(std::string databaseName,
+                   std::string setName,
+                   std::string typeName,
+                   std::string path,
+                   std::string& errMsg);
+
 
     // this retrieves data into a set... returns true on success
     template <class DataType>
@@ -19,6 +19,7 @@
 #ifndef CATALOG_CLIENT_CC
 #define CATALOG_CLIENT_CC
 
+#include <chrono>
 #include <ctime>
 #include <fcntl.h>
 #include <fstream>
@@ -31,6 +32,7 @@
 #include "CatDeleteSetRequest.h"
 #include "CatRegisterType.h"
 #include "CatSetObjectTypeRequest.h"
+#include "CatSetPartitioningRequest.h"
 #include "CatGetType.h"
 #include "CatGetSetRequest.h"
 #include "CatGetSetResult.h"
@@ -47,16 +49,28 @@
 
 namespace pdb {
 
+std::atomic<long> CatalogClient::localCatalogChanges{0};
+
+namespace {
+
+long nowMillis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
 // Constructor
 CatalogClient::CatalogClient(int portIn, std::string addressIn,
                              PDBLoggerPtr myLoggerIn,
-                             bool pointsToCatalogManagerIn) {
+                             bool pointsToCatalogManagerIn) : CatalogClient(portIn, addressIn, myLoggerIn) {
   pointsToCatalogManager = pointsToCatalogManagerIn;
-  CatalogClient(portIn, addressIn, myLoggerIn);
 }
 
 // default constructor
-CatalogClient::CatalogClient() {}
+CatalogClient::CatalogClient() {
+  pointsToCatalogManager = false;
+  cache = std::make_shared<MetadataCache>();
+}
 
 // Constructor
 CatalogClient::CatalogClient(int portIn, std::string addressIn,
@@ -65,6 +79,7 @@ CatalogClient::CatalogClient(int portIn, std::string addressIn,
   // get the communicator information
   port = portIn;
   address = addressIn;
+  pointsToCatalogManager = false;
 
   myLogger = myLoggerIn;
 
@@ -75,6 +90,9 @@ CatalogClient::CatalogClient(int portIn, std::string addressIn,
 
   // set up the mutex
   pthread_mutex_init(&workingMutex, nullptr);
+
+  // start with an empty cache
+  cache = std::make_shared<MetadataCache>();
 }
 
 // destructor
@@ -90,6 +108,92 @@ CatalogClient::~CatalogClient() {
 /* no handlers for a catalog client!! */
 void CatalogClient::registerHandlers(PDBServer &forMe) {}
 
+void CatalogClient::catalogChanged() {
+  localCatalogChanges++;
+}
+
+CatalogClient::MetadataCache::MetadataCache() {
+  pthread_mutex_init(&mutex, nullptr);
+  localChanges = localCatalogChanges;
+}
+
+CatalogClient::MetadataCache::~MetadataCache() {
+  pthread_mutex_destroy(&mutex);
+}
+
+template <class Key, class Value>
+bool CatalogClient::MetadataCache::find(std::map<Key, CachedEntry<Value>> &entries, const Key &key, Value &value) {
+
+  if (PDB_CATALOG_CACHE_TTL_MS <= 0) {
+    return false;
+  }
+
+  const LockGuard guard{mutex};
+  validate();
+
+  // do we have the thing
+  auto it = entries.find(key);
+  if (it == entries.end()) {
+    return false;
+  }
+
+  // is it too old
+  if (nowMillis() - it->second.fetchedAt >= PDB_CATALOG_CACHE_TTL_MS) {
+    entries.erase(it);
+    return false;
+  }
+
+  // hand out a copy, so that the caller can not change the cached value
+  value = std::make_shared<typename Value::element_type>(*it->second.value);
+  return true;
+}
+
+template <class Key, class Value>
+void CatalogClient::MetadataCache::insert(std::map<Key, CachedEntry<Value>> &entries, const Key &key, const Value &value,
+                                          long version, long changesBefore) {
+
+  // a server that does not tell its version, or a change of the local catalog while the request
+  // was in flight, means we can not know if the value is still current
+  if (PDB_CATALOG_CACHE_TTL_MS <= 0 || version < 0 || changesBefore != localCatalogChanges) {
+    return;
+  }
+
+  const LockGuard guard{mutex};
+  validate();
+
+  // this response was overtaken by a response from a newer catalog
+  if (version < catalogVersion) {
+    return;
+  }
+
+  // the catalog changed since we cached the entries we have
+  if (version > catalogVersion) {
+    types.clear();
+    sets.clear();
+    databases.clear();
+    catalogVersion = version;
+  }
+
+  entries[key] = CachedEntry<Value>{std::make_shared<typename Value::element_type>(*value), nowMillis()};
+}
+
+void CatalogClient::MetadataCache::invalidate() {
+  const LockGuard guard{mutex};
+  types.clear();
+  sets.clear();
+  databases.clear();
+}
+
+void CatalogClient::MetadataCache::validate() {
+  long changes = localCatalogChanges;
+  if (changes != localChanges) {
+    types.clear();
+    sets.clear();
+    databases.clear();
+    localChanges = changes;
+  }
+}
+
 // sends a request to a Catalog Server to register a Data Type defined in a Shared Library
 bool CatalogClient::registerType(std::string fileContainingSharedLib, std::string &errMsg) {
 
@@ -161,13 +265,24 @@ bool CatalogClient::shutDownServer(std::string &errMsg) {
 // searches for a User-Defined Type give its name and returns it's TypeID
 PDBCatalogTypePtr CatalogClient::getType(const std::string &typeName, std::string &error) {
 
+  // serve the type from the cache if we have it
+  PDBCatalogTypePtr type;
+  if (cache->find(cache->types, typeName, type)) {
+    return type;
+  }
+  long changesBefore = localCatalogChanges;
+
   PDB_COUT << "Searching for type with the name : " << typeName << "\n";
   return simpleRequest<CatGetType, CatGetTypeResult, PDBCatalogTypePtr>(
       myLogger, port, address, nullptr, 1024 * 1024,
       [&](Handle<CatGetTypeResult> result) {
         if (result != nullptr) {
           PDB_COUT << "Got a type with the type id :" << result->typeID << "\n";
-          return std::make_shared<PDBCatalogType>(result->typeID, (std::string) result->typeCategory, result->typeName, std::vector<char>());
+          type = std::make_shared<PDBCatalogType>(result->typeID, (std::string) result->typeCategory, result->typeName, std::vector<char>());
+          if (result->typeID != -1) {
+            cache->insert(cache->types, typeName, type, result->catalogVersion, changesBefore);
+          }
+          return type;
         } else {
           PDB_COUT << "searchForObjectTypeName: error in getting typeId\n";
           return (PDBCatalogTypePtr) nullptr;
@@ -192,6 +307,23 @@ bool CatalogClient::getSharedLibrary(int16_t identifier,
   return res;
 }
 
+// retrieves the content hash of a Shared Library given it's Type Id
+std::string CatalogClient::getSharedLibraryHash(int16_t identifier, std::string &errMsg) {
+
+  PDB_COUT << "CatalogClient: getSharedLibraryHash for id=" << identifier << std::endl;
+
+  return simpleRequest<CatSharedLibraryByNameRequest, CatalogUserTypeMetadata, std::string>(
+      myLogger, port, address, "", 1024 * 1024,
+      [&](Handle<CatalogUserTypeMetadata> result) {
+        if ((result == nullptr) || (result->typeID == -1)) {
+          errMsg = "Error getting shared library hash: type not found in Catalog.\n";
+          return std::string("");
+        }
+        return (std::string) result->soHash;
+      },
+      identifier, String(""), true);
+}
+
 // retrieves a Shared Library given it's typeName
 bool CatalogClient::getSharedLibraryByTypeName(
     int16_t identifier, std::string &typeNameToSearch,
@@ -268,6 +400,12 @@ std::string CatalogClient::getObjectType(std::string databaseName,
                                          std::string setName,
                                          std::string &errMsg) {
 
+  // the type of a set we have cached
+  PDBCatalogSetPtr set;
+  if (cache->find(cache->sets, std::make_pair(databaseName, setName), set) && set->type != nullptr) {
+    return *set->type;
+  }
+
   return simpleRequest<CatSetObjectTypeRequest, CatTypeNameSearchResult, std::string>(
       myLogger, port, address, "", 1024,
       [&](Handle<CatTypeNameSearchResult> result) {
@@ -311,6 +449,30 @@ bool CatalogClient::createSet(const std::string &typeName, int16_t typeID, const
       databaseName, setName, typeName, typeID);
 }
 
+// sends a request to the Catalog Server to record the partitioning of a Set
+bool CatalogClient::setPartitioning(const pdb::PDBCatalogSet &set, std::string &errMsg) {
+
+  // the set we have cached does not know its partitioning
+  cache->invalidate();
+
+  return simpleRequest<CatSetPartitioningRequest, SimpleRequestResult, bool>(
+      myLogger, port, address, false, 16 * 1024,
+      [&](Handle<SimpleRequestResult> result) {
+        if (result != nullptr) {
+          if (!result->getRes().first) {
+            errMsg = "Error recording the partitioning of the set: " + result->getRes().second;
+            myLogger->error("Error recording the partitioning of the set: " + result->getRes().second);
+            return false;
+          }
+          return true;
+        }
+        errMsg = "Error recording the partitioning of the set: got nothing back from catalog";
+        return false;
+      },
+      set.database, set.name, set.partitionLambda, set.partitionLambdaInputClass, set.numPartitions,
+      set.partitionNodes);
+}
+
 // sends a request to the Catalog Server to create Metadata for a new Database
 bool CatalogClient::createDatabase(std::string databaseName,
                                    std::string &errMsg) {
@@ -337,6 +499,9 @@ bool CatalogClient::createDatabase(std::string databaseName,
 // deleted
 bool CatalogClient::deleteSet(const std::string &databaseName, const std::string &setName, std::string &errMsg) {
 
+  // whatever happens, the set may be gone
+  cache->invalidate();
+
   return simpleRequest<CatDeleteSetRequest, SimpleRequestResult, bool>(
       myLogger, port, address, false, 1024,
       [&](Handle<SimpleRequestResult> result) {
@@ -356,27 +521,25 @@ bool CatalogClient::deleteSet(const std::string &databaseName, const std::string
 
 bool CatalogClient::setExists(const std::string &dbName, const std::string &setName) {
 
-  return simpleRequest<CatGetSetRequest, CatGetSetResult, bool>(
-      myLogger, port, address, false, 1024 * 1024,
-      [&](Handle<CatGetSetResult> result) {
-        return result != nullptr && result->databaseName == dbName && result->setName == setName;
-      },
-      dbName, setName);
+  std::string errMsg;
+  return getSet(dbName, setName, errMsg) != nullptr;
 }
 
 bool CatalogClient::databaseExists(const std::string &dbName) {
 
-  // make a request and return the value
-  return simpleRequest<CatGetDatabaseRequest, CatGetDatabaseResult, bool>(
-      myLogger, port, address, false, 1024 * 1024,
-      [&](Handle<CatGetDatabaseResult> result) {
-        return result != nullptr && result->database == dbName;
-      },
-      dbName);
+  std::string errMsg;
+  return getDatabase(dbName, errMsg) != nullptr;
 }
 
 pdb::PDBCatalogSetPtr CatalogClient::getSet(const std::string &dbName, const std::string &setName, std::string &errMsg) {
 
+  // serve the set from the cache if we have it
+  pdb::PDBCatalogSetPtr set;
+  if (cache->find(cache->sets, std::make_pair(dbName, setName), set)) {
+    return set;
+  }
+  long changesBefore = localCatalogChanges;
+
   // make a request and return the value
   return simpleRequest<CatGetSetRequest, CatGetSetResult, pdb::PDBCatalogSetPtr>(
               myLogger, port, address, (pdb::PDBCatalogSetPtr) nullptr, 1024,
@@ -384,7 +547,13 @@ pdb::PDBCatalogSetPtr CatalogClient::getSet(const std::string &dbName, const std
 
                 // do we have the thing
                 if(result != nullptr && result->databaseName == dbName && result->setName == setName) {
-                  return std::make_shared<pdb::PDBCatalogSet>(result->databaseName, result->setName, result->type);
+                  set = std::make_shared<pdb::PDBCatalogSet>(result->databaseName, result->setName, result->type);
+                  set->partitionLambda = result->partitionLambda;
+                  set->partitionLambdaInputClass = result->partitionLambdaInputClass;
+                  set->numPartitions = result->numPartitions;
+                  set->partitionNodes = result->partitionNodes;
+                  cache->insert(cache->sets, std::make_pair(dbName, setName), set, result->catalogVersion, changesBefore);
+                  return set;
                 }
 
                 // return a null pointer otherwise
@@ -395,6 +564,13 @@ pdb::PDBCatalogSetPtr CatalogClient::getSet(const std::string &dbName, const std
 
 pdb::PDBCatalogDatabasePtr CatalogClient::getDatabase(const std::string &dbName, std::string &errMsg) {
 
+  // serve the database from the cache if we have it
+  pdb::PDBCatalogDatabasePtr db;
+  if (cache->find(cache->databases, dbName, db)) {
+    return db;
+  }
+  long changesBefore = localCatalogChanges;
+
   // make a request and return the value
   return simpleRequest<CatGetDatabaseRequest, CatGetDatabaseResult, pdb::PDBCatalogDatabasePtr>(
       myLogger, port, address, (pdb::PDBCatalogDatabasePtr) nullptr, 1024,
@@ -402,7 +578,9 @@ pdb::PDBCatalogDatabasePtr CatalogClient::getDatabase(const std::string &dbName,
 
         // do we have the thing
         if(result != nullptr && result->database == dbName) {
-          return std::make_shared<pdb::PDBCatalogDatabase>(result->database, result->createdOn);
+          db = std::make_shared<pdb::PDBCatalogDatabase>(result->database, result->createdOn);
+          cache->insert(cache->databases, dbName, db, result->catalogVersion, changesBefore);
+          return db;
         }
 
         // return a null pointer otherwise
@@ -415,6 +593,9 @@ pdb::PDBCatalogDatabasePtr CatalogClient::getDatabase(const std::string &dbName,
 // has been deleted
 bool CatalogClient::deleteDatabase(const std::string &databaseName, std::string &errMsg) {
 
+  // whatever happens, the database and its sets may be gone
+  cache->invalidate();
+
   return simpleRequest<CatDeleteDatabaseRequest, SimpleRequestResult, bool>(
       myLogger, port, address, false, 1024,
       [&](Handle<SimpleRequestResult> result) {
@@ -15,6 +15,7 @@
  *  limitations under the License.                                           *
  *                                                                           *
  *****************************************************************************/
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <ctime>
@@ -34,6 +35,7 @@
 #include "CatDeleteSetRequest.h"
 #include "CatRegisterType.h"
 #include "CatSetObjectTypeRequest.h"
+#include "CatSetPartitioningRequest.h"
 #include "CatSharedLibraryByNameRequest.h"
 #include "CatGetType.h"
 #include "CatTypeNameSearchResult.h"
@@ -70,6 +72,8 @@ CatalogServer::CatalogServer(const string &catalogDirectoryIn,
   this->catalogDirectory = catalogDirectoryIn;
   this->isManagerCatalogServer = isManagerCatalogServer;
   this->tempPath = catalogDirectory + "/tmp_so_files";
+  this->catalogVersion = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
 
   // create the directories for the catalog
   initDirectories();
@@ -84,8 +88,9 @@ CatalogServer::CatalogServer(const string &catalogDirectoryIn,
   // initialize the types
   initBuiltInTypes();
 
-  // if am a manager register me
+  // if am a manager make sure the change log covers the catalog, and register me
   if(isManagerCatalogServer) {
+    pdbCatalog->initChangeLog();
     registerManager();
   }
 
@@ -99,6 +104,11 @@ void CatalogServer::initComms() {
   }
 }
 
+void CatalogServer::catalogChanged() {
+  catalogVersion++;
+  CatalogClient::catalogChanged();
+}
+
 void CatalogServer::initDirectories() const {
 
   // creates the parent folder for the catalog if location exists, only opens it.
@@ -199,22 +209,23 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
                std::cout << "Node IP: " << item.first + (item.second.first ? " updated correctly!" : " couldn't be updated due to error: ") << item.second.second << "\n";
             }
  
-            pdbCatalog->registerNode(node, errMsg);
+            if (pdbCatalog->registerNode(node, errMsg)) {
+                recordChange(PDBCatalogChange::addNode(*node));
+            }
+        }
 
-            // grab the catalog bytes
-            auto catalogDump = pdbCatalog->serializeToBytes();
+        // grab the changes the node has not applied yet, a new node gets the whole log, a restarted node only
+        // what changed while it was down
+        std::vector<unsigned char> changes;
+        PDBCatalogChange::serialize(pdbCatalog->getChangesSince(request->sinceVersion), changes);
 
-            // make an allocation block
-            const UseTemporaryAllocationBlock tempBlock{catalogDump.size() + 1024};
-            Handle<CatSyncResult> response = makeObject<CatSyncResult>(catalogDump);
-            res = sendUsingMe->sendObject(response, errMsg);
-        }
-        else {
-            std::vector<unsigned char> empty;
-            Handle<CatSyncResult> response = makeObject<CatSyncResult>(empty, true);
-            res = sendUsingMe->sendObject(response, errMsg);
+        // log what is happening
+        PDB_COUT << "Sending the catalog changes since version " << request->sinceVersion << " to " << nodeID << "\n";
 
-        }
+        // make an allocation block
+        const UseTemporaryAllocationBlock tempBlock{changes.size() + 1024};
+        Handle<CatSyncResult> response = makeObject<CatSyncResult>(changes);
+        res = sendUsingMe->sendObject(response, errMsg);
 
         // sends result to requester
         return make_pair(res, errMsg);
@@ -303,6 +314,7 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
           // create an empty response since we haven't found it
           response = makeObject<CatGetTypeResult>();
         }
+        response->catalogVersion = catalogVersion;
 
         // sends result to requester
         std::string errMsg;
@@ -327,8 +339,31 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
         // log what is happening
         PDB_COUT << "Triggering Handler CatalogServer CatSharedLibraryByNameRequest for typeID=" << request->getTypeLibraryId() << "\n";
 
-        // check if the type is in the local catalog!
-        if(type != nullptr) {
+        // only the content hash is requested, so that a node can use the library it has cached
+        if (request->isHashOnly()) {
+
+          std::string errMsg;
+          std::string soHash;
+          if (type != nullptr && !type->soBytes.empty()) {
+            soHash = CatalogUserTypeMetadata::getLibraryHash(type->soBytes.data(), type->soBytes.size());
+          } else if (!this->isManagerCatalogServer) {
+            auto client = CatalogClient(managerPort, managerIP, make_shared<pdb::PDBLogger>("clientCatalogToServerLog"));
+            soHash = client.getSharedLibraryHash(request->getTypeLibraryId(), errMsg);
+          }
+
+          const UseTemporaryAllocationBlock tempBlock{1024 * 1024};
+          Handle<CatalogUserTypeMetadata> response = makeObject<CatalogUserTypeMetadata>();
+          if (!soHash.empty()) {
+            response->typeID = request->getTypeLibraryId();
+            response->soHash = soHash;
+          }
+          bool res = sendUsingMe->sendObject(response, errMsg);
+          return make_pair(res, errMsg);
+        }
+
+        // check if the type is in the local catalog! a worker learns about types from the change log of the
+        // manager, which does not carry the libraries, so it may have to fetch the library first
+        if(type != nullptr && (isManagerCatalogServer || !type->soBytes.empty())) {
 
           // create an allocation block that can fit .so library and allocate a response and init the response data
           const UseTemporaryAllocationBlock tempBlock{ type->soBytes.size() + 1024 * 1024 };
@@ -501,6 +536,10 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
 
             // store it locally
             bool res = pdbCatalog->registerDatabase(make_shared<PDBCatalogDatabase>(request->dbToCreate()), errMsg);
+            if (res) {
+              recordChange(PDBCatalogChange::addDatabase(request->dbToCreate()));
+            }
+            catalogChanged();
 
             // after we added the set to the local catalog, if this is the
             // manager catalog iterate over all nodes in the cluster and broadcast the
@@ -563,11 +602,21 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
         // ok this is a bit of an oddity in the system, essentially if create a set of a type like int, char or something similar.
         // the typeID is going to be 8191 or TYPE_NOT_RECOGNIZED so we have to register a type with the provided name and this type
         if(typeID == TYPE_NOT_RECOGNIZED && !pdbCatalog->typeExists(type)) {
-          res = pdbCatalog->registerType(make_shared<PDBCatalogType>(typeID, "built-in", type, vector<char>()), errMsg);
+          auto builtInType = make_shared<PDBCatalogType>(typeID, "built-in", type, vector<char>());
+          res = pdbCatalog->registerType(builtInType, errMsg);
+          if (res) {
+            recordChange(PDBCatalogChange::addType(*builtInType));
+          }
         }
 
         // register the set with the catalog
-        res = pdbCatalog->registerSet(make_shared<PDBCatalogSet>(setName, dbName, internalTypeName), errMsg) && res;
+        auto set = make_shared<PDBCatalogSet>(setName, dbName, internalTypeName);
+        if (pdbCatalog->registerSet(set, errMsg)) {
+          recordChange(PDBCatalogChange::addSet(*set));
+        } else {
+          res = false;
+        }
+        catalogChanged();
         if (res == false) {
              std::cout << "Error in registering set: " << setName << ":" << dbName << std::endl;
         }
@@ -608,6 +657,72 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
         return make_pair(res, errMsg);
       }));
 
+  // handle a request to record how an existing Set is partitioned
+  forMe.registerHandler(
+      CatSetPartitioningRequest_TYPEID,
+      make_shared<SimpleRequestHandler<CatSetPartitioningRequest>>([&](Handle<CatSetPartitioningRequest> request,
+                                                                       PDBCommunicatorPtr sendUsingMe) {
+        // lock the catalog server
+        std::lock_guard<std::mutex> guard(serverMutex);
+
+        // just a place to put the error message
+        std::string errMsg;
+
+        // the set with how it is partitioned, the type is kept as it is
+        PDBCatalogSet set(request->setName, request->dbName, "");
+        set.partitionLambda = request->partitionLambda;
+        set.partitionLambdaInputClass = request->partitionLambdaInputClass;
+        set.numPartitions = request->numPartitions;
+        set.partitionNodes = request->partitionNodes;
+
+        // record the partitioning
+        bool res = pdbCatalog->updateSetPartitioning(set, errMsg);
+        if (res) {
+          recordChange(PDBCatalogChange::setPartitioning(*pdbCatalog->getSet(set.database, set.name)));
+        } else {
+          std::cout << "Error in recording the partitioning of set: " << set.name << ":" << set.database << std::endl;
+        }
+        catalogChanged();
+
+        // after we updated the set in the local catalog, if this is the
+        // manager catalog iterate over all nodes in the cluster and broadcast the
+        // update to the distributed copies of the catalog
+        if (isManagerCatalogServer) {
+
+          // get the results of each broadcast
+          map<string, pair<bool, string>> updateResults;
+
+          // broadcast the update
+          broadcastRequest(request, updateResults, errMsg);
+
+          for (auto &item : updateResults) {
+
+            // if we failed res would be set to false
+            res = item.second.first && res;
+
+            // log what is happening
+            PDB_COUT << "Node IP: " << item.first + (item.second.first ? " updated correctly!" : " couldn't be updated due to error: ") << item.second.second << "\n";
+          }
+
+        } else {
+
+          // log what happened
+          PDB_COUT << "This is not Manager Catalog Node, thus metadata was only registered locally!\n";
+        }
+
+        // create an allocation block for the response
+        const UseTemporaryAllocationBlock tempBlock{1024};
+
+        // create the response
+        Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
+
+        // sends result to requester
+        res = sendUsingMe->sendObject(response, errMsg) && res;
+
+        // return
+        return make_pair(res, errMsg);
+      }));
+
   // handle a request to delete metadata for an existing Database in the catalog
   forMe.registerHandler(
       CatDeleteDatabaseRequest_TYPEID,
@@ -620,6 +735,10 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
             // invokes deleting database metadata from catalog
             std::string errMsg;
             bool res = pdbCatalog->removeDatabase(request->dbToDelete(), errMsg);
+            if (res) {
+              recordChange(PDBCatalogChange::removeDatabase(request->dbToDelete()));
+            }
+            catalogChanged();
 
             // after it deleted the database in the local catalog, if this is the
             // manager catalog iterate over all nodes in the cluster and broadcast the
@@ -670,6 +789,10 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
 
         // invokes deleting Set metadata from catalog
         bool res = pdbCatalog->removeSet(set.first, set.second, errMsg);
+        if (res) {
+          recordChange(PDBCatalogChange::removeSet(set.first, set.second));
+        }
+        catalogChanged();
 
         // after we deleted the set in the local catalog, if this is the
         // manager catalog iterate over all nodes in the cluster and broadcast the
@@ -727,6 +850,7 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
 
             // store it locally
             bool res = loadAndRegisterType(-1, bytes, request->getLibrarySize(), errMsg);
+            catalogChanged();
 
             // after we added the set to the local catalog, if this is the
             // manager catalog iterate over all nodes in the cluster and broadcast the
@@ -800,6 +924,7 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
               // create the response object in case of an error
               response = makeObject<CatGetDatabaseResult>("", -1);
             }
+            response->catalogVersion = catalogVersion;
 
             // sends result to requester
             res = sendUsingMe->sendObject(response, errMsg) && res;
@@ -825,14 +950,18 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
             // this is where we put the error
             std::string errMsg;
 
-            // allocate a block for the response
-            const UseTemporaryAllocationBlock tempBlock{1024};
+            // allocate a block for the response, the partitioning lists every node
+            const UseTemporaryAllocationBlock tempBlock{16 * 1024};
             Handle<CatGetSetResult> response;
 
             if(res) {
 
               // create the response object
               response = makeObject<CatGetSetResult>(set->database, set->name, *set->type, *set->type);
+              response->partitionLambda = set->partitionLambda;
+              response->partitionLambdaInputClass = set->partitionLambdaInputClass;
+              response->numPartitions = set->numPartitions;
+              response->partitionNodes = set->partitionNodes;
 
             } else {
 
@@ -842,6 +971,7 @@ void CatalogServer::registerHandlers(PDBServer &forMe) {
               // create the response object in case of an error
               response = makeObject<CatGetSetResult>();
             }
+            response->catalogVersion = catalogVersion;
 
             // sends result to requester
             res = sendUsingMe->sendObject(response, errMsg) && res;
@@ -859,7 +989,10 @@ void CatalogServer::registerManager() {
 
   // register the node
   std::string error;
-  pdbCatalog->registerNode(make_shared<PDBCatalogNode>(nodeIdentifier, managerIP, managerPort, "manager"), error);
+  auto node = make_shared<PDBCatalogNode>(nodeIdentifier, managerIP, managerPort, "manager");
+  if(pdbCatalog->registerNode(node, error)) {
+    recordChange(PDBCatalogChange::addNode(*node));
+  }
 
   // log the error
   PDB_COUT << error << "\n";
@@ -867,56 +1000,67 @@ void CatalogServer::registerManager() {
 
 void CatalogServer::syncWithManager() {
 
+  // the version of the last change we have from the manager
+  long sinceVersion;
+  {
+    lock_guard<mutex> guard(serverMutex);
+    sinceVersion = pdbCatalog->getLatestChange();
+  }
+
   // allocate a block for the response
   const UseTemporaryAllocationBlock tempBlock{1024};
-  Handle<CatSyncRequest> request = makeObject<CatSyncRequest>(nodeIP, nodePort, "worker");
 
   // sends the request to a node in the cluster
-  auto ret = simpleRequest<CatSyncRequest, CatSyncResult, std::shared_ptr<std::vector<unsigned char>> >(
+  auto ret = simpleRequest<CatSyncRequest, CatSyncResult, std::shared_ptr<std::vector<PDBCatalogChange>> >(
       this->logger, managerPort, managerIP, nullptr, 1024,
       [&](Handle<CatSyncResult> result) {
 
         // if the result is something else null we got a response
-        if (result != nullptr) {
+        if (result != nullptr && result->restart == false && result->bytes != nullptr) {
 
-          if (result->restart == false) {
-
-              // create the result vector
-              auto out = std::make_shared<std::vector<unsigned char>>();
-
-              // copy the result to the return value
-              out->reserve(result->bytes->size());
-              out->assign(result->bytes->c_ptr(), result->bytes->c_ptr() + result->bytes->size());
-
-              return out;
+          // read the changes
+          auto out = std::make_shared<std::vector<PDBCatalogChange>>();
+          if (PDBCatalogChange::deserialize(result->bytes->c_ptr(), result->bytes->size(), *out)) {
+            return out;
           }
-        }
 
-        return (std::shared_ptr<std::vector<unsigned char>>) nullptr;
-      }, nodeIP, nodePort, "worker");
+          // log what happened
+          PDB_COUT << "Could not read the catalog changes sent by the manager\n";
+        }
 
+        return (std::shared_ptr<std::vector<PDBCatalogChange>>) nullptr;
+      }, nodeIP, nodePort, "worker", sinceVersion);
 
-  if (ret != nullptr) {
+  if (ret == nullptr || ret->empty()) {
+    return;
+  }
 
-      ofstream file (catalogDirectory + "/catalog.sqlite", ios::trunc | ios::binary);
+  // apply the changes in order
+  lock_guard<mutex> guard(serverMutex);
+  for (const auto &change : *ret) {
 
-      // check if the file is open
-      if(!file.is_open()) {
+    std::string errMsg;
+    if (!pdbCatalog->applyChange(change, errMsg)) {
 
-           // log what happened
-           PDB_COUT << "Could not open out the catalog\n";
+      // log what happened, we stop here so that the next sync starts again from this change
+      std::cout << "Could not apply the catalog change " << change.version << " : " << errMsg << "\n";
+      break;
+    }
+  }
 
-           // just end
-           return;
-      }
+  // log what is happening
+  PDB_COUT << "Synced the catalog from version " << sinceVersion << " to " << pdbCatalog->getLatestChange() << "\n";
 
-      // write out the received catalog
-      file.write((char*) ret->data(), ret->size());
+  // whatever was cached from the old catalog is stale
+  catalogChanged();
+}
 
-      // close the file
-      file.close();
-   }
+void CatalogServer::recordChange(const PDBCatalogChange &change) {
 
+  // only the manager keeps the log, the workers get the changes from it
+  if (isManagerCatalogServer) {
+    pdbCatalog->logChange(change);
+  }
 }
 
 // adds metadata and bytes of a shared library in the catalog and returns its typeId
@@ -1025,13 +1169,22 @@ bool CatalogServer::loadAndRegisterType(int16_t typeIDFromManagerCatalog, const
 
     // register the type in the catalog
     std::string error;
-    pdbCatalog->registerType(std::make_shared<pdb::PDBCatalogType>(typeCode, "user-defined", typeName, std::move(soFileVector)), error);
+    auto type = std::make_shared<pdb::PDBCatalogType>(typeCode, "user-defined", typeName, std::move(soFileVector));
+    if(pdbCatalog->registerType(type, error)) {
+      recordChange(PDBCatalogChange::addType(*type));
+    }
 
     // return the new type code
     return true;
 
   } else {
 
+    // the type came with the change log of the manager, so we only have to store its library
+    if(!isManagerCatalogServer && pdbCatalog->getType(typeName)->soBytes.empty()) {
+      std::vector<char> soFileVector(soFile, soFile + soFileSize);
+      return pdbCatalog->updateTypeLibrary(typeName, soFileVector, errMsg);
+    }
+
     // otherwise return the already existing type code
     return true;
   }
@@ -3,6 +3,7 @@
 #define DISPATCHER_SERVER_CC
 
 #include "DispatcherServer.h"
+#include "CatalogClient.h"
 #include "CatalogServer.h"
 #include "PDBDebug.h"
 #include "SimpleRequestHandler.h"
@@ -16,7 +17,10 @@
 #include "DistributedStorageManagerServer.h"
 #include "PartitionPolicyFactory.h"
 #include "DispatcherRegisterPartitionPolicy.h"
+#include "LambdaPolicy.h"
+#include "LockGuard.h"
 #include <snappy.h>
+#include <algorithm>
 #define MAX_CONCURRENT_REQUESTS 10
 
 namespace pdb {
@@ -26,6 +30,7 @@ DispatcherServer::DispatcherServer(PDBLoggerPtr logger, bool selfLearningOrNot)
     this->storageNodes = pdb::makeObject<Vector<Handle<NodeDispatcherData>>>();
     this->partitionPolicies = std::map<std::pair<std::string, std::string>, PartitionPolicyPtr>();
     pthread_mutex_init(&mutex, nullptr);
+    pthread_mutex_init(&policyMutex, nullptr);
     numRequestsInProcessing = 0;
     this->selfLearningOrNot = selfLearningOrNot;
 }
@@ -34,6 +39,7 @@ void DispatcherServer::initialize() {}
 
 DispatcherServer::~DispatcherServer() {
     pthread_mutex_destroy(&mutex);
+    pthread_mutex_destroy(&policyMutex);
 }
 
 void DispatcherServer::registerHandlers(PDBServer& forMe) {
@@ -193,6 +199,7 @@ void DispatcherServer::registerStorageNodes(
                  << std::endl;
     }
 
+    const LockGuard guard{policyMutex};
     for (auto const partitionPolicy : partitionPolicies) {
         partitionPolicy.second->updateStorageNodes(storageNodes);
     }
@@ -200,6 +207,7 @@ void DispatcherServer::registerStorageNodes(
 
 void DispatcherServer::registerSet(std::pair<std::string, std::string> setAndDatabase,
                                    PartitionPolicyPtr partitionPolicy) {
+    const LockGuard guard{policyMutex};
     if (partitionPolicies.find(setAndDatabase) != partitionPolicies.end()) {
         std::cout << "Updating old set" << setAndDatabase.first << ":" << setAndDatabase.second
                  << std::endl;
@@ -215,34 +223,103 @@ void DispatcherServer::registerSet(std::pair<std::string, std::string> setAndDat
 void DispatcherServer::deregisterSet(std::pair<std::string, std::string> setAndDatabase) {
     std::cout << "to deregister partition policy for " << setAndDatabase.first << ":"
               << setAndDatabase.second << std::endl;
+    const LockGuard guard{policyMutex};
     partitionPolicies.erase(setAndDatabase);
+    bypassedSets.erase(setAndDatabase);
+}
 
+bool DispatcherServer::isPartitionedAs(std::pair<std::string, std::string> setAndDatabase,
+                                       const PDBCatalogSet& partitioning) {
+    if (!partitioning.isPartitioned()) {
+        return false;
+    }
+    const LockGuard guard{policyMutex};
+    if (bypassedSets.find(setAndDatabase) != bypassedSets.end()) {
+        return false;
+    }
+    auto iter = partitionPolicies.find(setAndDatabase);
+    if (iter == partitionPolicies.end()) {
+        return false;
+    }
+    LambdaPolicyPtr lambdaPolicy = std::dynamic_pointer_cast<LambdaPolicy>(iter->second);
+    if (lambdaPolicy == nullptr || lambdaPolicy->getLambda() == nullptr) {
+        return false;
+    }
+    if (lambdaPolicy->getLambda()->getIdentifierOfLambda() != partitioning.partitionLambda ||
+        lambdaPolicy->getNumPartitions() != partitioning.numPartitions) {
+        return false;
+    }
+    if (!partitioning.partitionNodes.empty()) {
+        int numNodes = std::count(partitioning.partitionNodes.begin(),
+                                  partitioning.partitionNodes.end(), ',') + 1;
+        if (lambdaPolicy->getNumNodes() != numNodes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DispatcherServer::bypassPartitionPolicy(std::pair<std::string, std::string> setAndDatabase) {
+    {
+        const LockGuard guard{policyMutex};
+        if (!bypassedSets.insert(setAndDatabase).second) {
+            return;
+        }
+    }
+
+    // the data of the set is no longer placed by the partition lambda the catalog may have
+    std::string errMsg;
+    PDBCatalogSetPtr set = getFunctionality<CatalogClient>().getSet(
+        setAndDatabase.second, setAndDatabase.first, errMsg);
+    if (set == nullptr || !set->isPartitioned()) {
+        return;
+    }
+    std::cout << "Data of set " << setAndDatabase.first << ":" << setAndDatabase.second
+              << " bypasses its partition policy, clearing its partitioning" << std::endl;
+    PDBCatalogSet cleared(set->name, set->database, *set->type);
+    if (!getFunctionality<CatalogClient>().setPartitioning(cleared, errMsg)) {
+        std::cout << "Could not clear the partitioning of the set, because: " << errMsg
+                  << std::endl;
+    }
+}
+
+PartitionPolicyPtr DispatcherServer::getPartitionPolicy(
+    std::pair<std::string, std::string> setAndDatabase, bool& registeredDefault) {
+    const LockGuard guard{policyMutex};
+    registeredDefault = false;
+    auto iter = partitionPolicies.find(setAndDatabase);
+    if (iter != partitionPolicies.end()) {
+        return iter->second;
+    }
+    PDB_COUT << "No partition policy was found for set: " << setAndDatabase.first << ":"
+             << setAndDatabase.second << std::endl;
+    PDB_COUT << "Defaulting to random policy" << std::endl;
+    PartitionPolicyPtr partitionPolicy = PartitionPolicyFactory::buildDefaultPartitionPolicy();
+    partitionPolicy->updateStorageNodes(storageNodes);
+    partitionPolicies[setAndDatabase] = partitionPolicy;
+    registeredDefault = true;
+    return partitionPolicy;
 }
 
 
 bool DispatcherServer::dispatchData(std::pair<std::string, std::string> setAndDatabase,
                                     std::string type,
                                     Handle<Vector<Handle<Object>>> toDispatch) {
-    // TODO: Implement this
-
-    if (partitionPolicies.find(setAndDatabase) == partitionPolicies.end()) {
-        std::cout << "No partition policy was found for set: " << setAndDatabase.first << ":"
-                 << setAndDatabase.second << std::endl;
-        std::cout << "Defaulting to random policy" << std::endl;
-        registerSet(setAndDatabase, PartitionPolicyFactory::buildDefaultPartitionPolicy());
-        return dispatchData(setAndDatabase, type, toDispatch);
-    } else {
-        auto mappedPartitions = partitionPolicies[setAndDatabase]->partition(toDispatch);
-        std::cout << "mappedPartitions size = " << mappedPartitions->size() << std::endl;
-        for (auto const& pair : (*mappedPartitions)) {
-            if (pair.second != nullptr) {           
-                if (!sendData(setAndDatabase, type, findNode(pair.first), pair.second)) {
-                     return false;
-                } 
+    bool registeredDefault;
+    PartitionPolicyPtr partitionPolicy = getPartitionPolicy(setAndDatabase, registeredDefault);
+    if (registeredDefault) {
+        bypassPartitionPolicy(setAndDatabase);
+    }
+    auto mappedPartitions = partitionPolicy->partition(toDispatch);
+    std::cout << "mappedPartitions size = " << mappedPartitions->size() << std::endl;
+    for (auto const& pair : (*mappedPartitions)) {
+        if (pair.second != nullptr) {
+            if (!sendData(setAndDatabase, type, findNode(pair.first), pair.second)) {
+                 return false;
             }
         }
-        return true;
     }
+    return true;
 }
 
 
@@ -250,24 +327,24 @@ bool DispatcherServer::dispatchBytes(std::pair<std::string, std::string> setAndD
                                      std::string type,
                                      char* bytes,
                                      size_t numBytes) {
-    // TODO: Implement this
-
-    if (partitionPolicies.find(setAndDatabase) == partitionPolicies.end()) {
-        PDB_COUT << "No partition policy was found for set: " << setAndDatabase.first << ":"
-                 << setAndDatabase.second << std::endl;
-        PDB_COUT << "Defaulting to random policy" << std::endl;
-        registerSet(setAndDatabase, PartitionPolicyFactory::buildDefaultPartitionPolicy());
-        return dispatchBytes(setAndDatabase, type, bytes, numBytes);
-    } else {
-        auto mappedPartitions = partitionPolicies[setAndDatabase]->partition(nullptr);
-        PDB_COUT << "mappedPartitions size = " << mappedPartitions->size() << std::endl;
-        for (auto const& pair : (*mappedPartitions)) {
-            if (!sendBytes(setAndDatabase, type, findNode(pair.first), bytes, numBytes)) {
-                return false;
-            }
+    bool registeredDefault;
+    PartitionPolicyPtr partitionPolicy = getPartitionPolicy(setAndDatabase, registeredDefault);
+    if (registeredDefault) {
+        bypassPartitionPolicy(setAndDatabase);
+    } else if (std::dynamic_pointer_cast<LambdaPolicy>(partitionPolicy) != nullptr) {
+        // raw bytes can not be partitioned by a lambda, so they are placed randomly instead
+        bypassPartitionPolicy(setAndDatabase);
+        partitionPolicy = PartitionPolicyFactory::buildDefaultPartitionPolicy();
+        partitionPolicy->updateStorageNodes(storageNodes);
+    }
+    auto mappedPartitions = partitionPolicy->partition(nullptr);
+    PDB_COUT << "mappedPartitions size = " << mappedPartitions->size() << std::endl;
+    for (auto const& pair : (*mappedPartitions)) {
+        if (!sendBytes(setAndDatabase, type, findNode(pair.first), bytes, numBytes)) {
+            return false;
         }
-        return true;
     }
+    return true;
 }
 
 
@@ -460,6 +460,30 @@ void DistributedStorageManagerServer::registerHandlers(PDBServer& forMe) {
 #ifndef TEST_LACHESIS_OVERHEAD
                              getFunctionality<DispatcherServer>().registerSet(std::pair<std::string, std::string>(request->getSetName(), request->getDatabase()), myLambdaPolicy);
 #endif
+                             //to record the partitioning in the catalog, so that joins on the partition key
+                             //of sets placed the same way can be done locally
+                             unsigned int indexInInputs = myLambda->getInputIndex(0);
+                             if (computationName.find("Aggregation") != std::string::npos) {
+                                 indexInInputs = 0;
+                             }
+                             PDBCatalogSet partitioning(set, database, request->getTypeName());
+                             partitioning.partitionLambda = myLambda->getIdentifierOfLambda();
+                             if (indexInInputs < myComputation->getNumInputs()) {
+                                 partitioning.partitionLambdaInputClass = myComputation->getIthInputType(indexInInputs);
+                             }
+                             partitioning.numPartitions = numPartitions;
+                             for (int i = 0; i < allNodes.size(); i++) {
+                                 partitioning.partitionNodes += (i == 0 ? "" : ",") + allNodes[i];
+                             }
+                             //the dispatcher keeps a policy it already has for the set, so only record the
+                             //partitioning if the data will really be dispatched with this lambda
+                             std::string partitioningErrMsg;
+                             if (!getFunctionality<DispatcherServer>().isPartitionedAs(std::pair<std::string, std::string>(set, database), partitioning)) {
+                                 std::cout << "Not recording the partitioning of the set, because the dispatcher does not place its data with "
+                                           << partitioning.partitionLambda << std::endl;
+                             } else if (!getFunctionality<CatalogClient>().setPartitioning(partitioning, partitioningErrMsg)) {
+                                 std::cout << "Could not record the partitioning of the set, because: " << partitioningErrMsg << std::endl;
+                             }
                          }
                      }
                      lambdaId = getFunctionality<SelfLearningServer>().getLambdaId(jobName, computationName, lambdaName);
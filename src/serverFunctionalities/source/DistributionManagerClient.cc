@@ -176,7 +176,7 @@ Handle<QueryPermitResponse> DistributionManagerClient::sendQueryPermitt(
         return nullptr;
     }
 
-    logger->trace("Got back From Server Query ID : " + string(response->getQueryId()));
+    PDB_LOG_TRACE(logger, "Got back From Server Query ID : " + string(response->getQueryId()));
 
     return response;
 }
@@ -211,7 +211,7 @@ Handle<Ack> DistributionManagerClient::sendQueryDone(string& hostName,
         return nullptr;
     }
 
-    logger->trace("Got back From Server Query ID : " + string(response->getInfo()));
+    PDB_LOG_TRACE(logger, "Got back From Server Query ID : " + string(response->getInfo()));
     return response;
 }
 
@@ -247,7 +247,7 @@ Handle<Ack> DistributionManagerClient::sendGetPlaceOfQueryPlanner(
         logger->error("ERROR sendQueryPermitt: Uh oh.  The type is not what I expected!!\n");
     }
 
-    logger->trace("sendGetPlaceOfQueryPlanner: Got back From Server Query ID : " +
+    PDB_LOG_TRACE(logger, "sendGetPlaceOfQueryPlanner: Got back From Server Query ID : " +
                   string(response->getInfo()));
 
     return response;
@@ -138,6 +138,7 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                 std::cout << "WARNING: repartitioned data size is 0" << std::endl;
             }
             int numHashKeys = 0;
+            std::string profile;
             if (!communicatorToBackend->sendObject(newRequest, errMsg)) {
                 std::cout << errMsg << std::endl;
                 errMsg = std::string("can't send message to backend: ") + errMsg;
@@ -150,8 +151,15 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                     std::cout << "Error waiting for backend to finish this job stage. " << errMsg
                               << std::endl;
                     errMsg = std::string("backend failure: ") + errMsg;
+                } else if (result != nullptr) {
+                    numHashKeys = result->getNumHashKeys();
+                    profile = result->getProfile();
+                    if (result->getRes().first == false) {
+                        errMsg = result->getRes().second;
+                        std::cout << "Backend failed this job stage: " << errMsg << std::endl;
+                        success = false;
+                    }
                 }
-                numHashKeys = result->getNumHashKeys();
             }
 
             // remove sets
@@ -167,19 +175,18 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
             result->setNumPages(inputSet->getNumPages());
             result->setPageSize(inputSet->getPageSize());
             result->setNumHashKeys(numHashKeys);
+            result->setProfile(profile);
             if (success == true) {
                 PDB_COUT << "Stage is done. " << std::endl;
                 errMsg = std::string("execution complete");
             } else {
                 std::cout << "Stage failed at server" << std::endl;
+                result->setFailure(errMsg);
             }
             // return the results
             if (!sendUsingMe->sendObject(result, errMsg)) {
                 return std::make_pair(false, errMsg);
             }
-            if (success == false) {
-                // TODO:restart backend
-            }
             return std::make_pair(success, errMsg);
         }));
 
@@ -264,6 +271,7 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
             // forward the request
             newRequest->print();
 
+            std::string profile;
             if (inputSet->getNumPages() != 0) {
 
                 if (!communicatorToBackend->sendObject(newRequest, errMsg)) {
@@ -273,11 +281,20 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                 } else {
                     PDB_COUT << "Frontend sent request to backend" << std::endl;
                     // wait for backend to finish.
-                    communicatorToBackend->getNextObject<SimpleRequestResult>(success, errMsg);
+                    Handle<SimpleRequestResult> backendResult =
+                        communicatorToBackend->getNextObject<SimpleRequestResult>(success, errMsg);
                     if (!success) {
                         std::cout << "Error waiting for backend to finish this job stage. "
                                   << errMsg << std::endl;
                         errMsg = std::string("backend failure: ") + errMsg;
+                    } else if (backendResult != nullptr) {
+                        profile = backendResult->getProfile();
+                        if (backendResult->getRes().first == false) {
+                            errMsg = backendResult->getRes().second;
+                            std::cout << "Backend failed this job stage: " << errMsg
+                                      << std::endl;
+                            success = false;
+                        }
                     }
                 }
             } else {
@@ -299,19 +316,18 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
             Handle<SetIdentifier> result = makeObject<SetIdentifier>(inDatabaseName, inSetName);
             result->setNumPages(inputSet->getNumPages());
             result->setPageSize(inputSet->getPageSize());
+            result->setProfile(profile);
             if (success == true) {
                 PDB_COUT << "Stage is done. " << std::endl;
                 errMsg = std::string("execution complete");
             } else {
                 std::cout << "Stage failed at server" << std::endl;
+                result->setFailure(errMsg);
             }
             // return the results
             if (!sendUsingMe->sendObject(result, errMsg)) {
                 return std::make_pair(false, errMsg);
             }
-            if (success == false) {
-                // TODO:restart backend
-            }
             return std::make_pair(success, errMsg);
 
         }
@@ -383,10 +399,17 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                 }
                 return std::make_pair(true, std::string("execution complete"));
 
+            } else if (request->getNumProducers() > 0) {
+                // the shuffle stage that produces the input is still running, so the input is
+                // scanned as it arrives, instead of after flushing it
+                getFunctionality<PangeaStorageServer>().openShuffleStream(
+                    std::pair<std::string, std::string>(inDatabaseName, inSetName),
+                    request->getNumProducers());
             } else {
                 getFunctionality<PangeaStorageServer>().cleanup(false);
                 PDB_COUT << "input set size=" << inputSet->getNumPages() << std::endl;
             }
+            newRequest->setNumProducers(request->getNumProducers());
             sourceContext->setDatabaseId(inputSet->getDbID());
             sourceContext->setTypeId(inputSet->getTypeID());
             sourceContext->setSetId(inputSet->getSetID());
@@ -446,6 +469,7 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
             // forward the request
             newRequest->print();
             int numHashKeys = 0;
+            std::string profile;
             if (!communicatorToBackend->sendObject(newRequest, errMsg)) {
                 std::cout << errMsg << std::endl;
                 errMsg = std::string("can't send message to backend: ") + errMsg;
@@ -458,8 +482,15 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                     std::cout << "Error waiting for backend to finish this job stage. " << errMsg
                               << std::endl;
                     errMsg = std::string("backend failure: ") + errMsg;
+                } else if (result != nullptr) {
+                    numHashKeys = result->getNumHashKeys();
+                    profile = result->getProfile();
+                    if (result->getRes().first == false) {
+                        errMsg = result->getRes().second;
+                        std::cout << "Backend failed this job stage: " << errMsg << std::endl;
+                        success = false;
+                    }
                 }
-                numHashKeys = result->getNumHashKeys();
             }
 
 
@@ -475,6 +506,7 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
 
             Handle<SetIdentifier> result = makeObject<SetIdentifier>(outDatabaseName, outSetName);
             result->setNumHashKeys(numHashKeys);
+            result->setProfile(profile);
             if (outSetType != PartitionedHashSetType) {
                 result->setNumPages(outputSet->getNumPages());
                 result->setPageSize(outputSet->getPageSize());
@@ -489,14 +521,12 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                 errMsg = std::string("execution complete");
             } else {
                 std::cout << "Stage failed at server" << std::endl;
+                result->setFailure(errMsg);
             }
             // return the results
             if (!sendUsingMe->sendObject(result, errMsg)) {
                 return std::make_pair(false, errMsg);
             }
-            if (success == false) {
-                // TODO:restart backend
-            }
             return std::make_pair(success, errMsg);
 
         }));
@@ -670,6 +700,7 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
             }
 
 
+            std::string profile;
             if (success == true) {
                 if (combinerSet != nullptr) {
                     Handle<SetIdentifier> combinerContext =
@@ -697,11 +728,20 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                 } else {
                     PDB_COUT << "Frontend sent request to backend" << std::endl;
                     // wait for backend to finish.
-                    communicatorToBackend->getNextObject<SimpleRequestResult>(success, errMsg);
+                    Handle<SimpleRequestResult> backendResult =
+                        communicatorToBackend->getNextObject<SimpleRequestResult>(success, errMsg);
                     if (!success) {
                         std::cout << "Error waiting for backend to finish this job stage. "
                                   << errMsg << std::endl;
                         errMsg = std::string("backend failure: ") + errMsg;
+                    } else if (backendResult != nullptr) {
+                        profile = backendResult->getProfile();
+                        if (backendResult->getRes().first == false) {
+                            errMsg = backendResult->getRes().second;
+                            std::cout << "Backend failed this job stage: " << errMsg
+                                      << std::endl;
+                            success = false;
+                        }
                     }
                 }
             }
@@ -732,20 +772,19 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                 result->setNumPages(outputSet->getNumPages());
                 result->setPageSize(outputSet->getPageSize());
             }
+            result->setProfile(profile);
             std::cout << "sending back result with " << result->getNumPages() << " pages" << std::endl;
             if (success == true) {
                 PDB_COUT << "Stage is done. " << std::endl;
                 errMsg = std::string("execution complete");
             } else {
                 std::cout << "Stage failed at server" << std::endl;
+                result->setFailure(errMsg);
             }
             // return the results
             if (!sendUsingMe->sendObject(result, errMsg)) {
                 return std::make_pair(false, errMsg);
             }
-            if (success == false) {
-                // TODO:restart backend
-            }
             return std::make_pair(success, errMsg);
 
         }));
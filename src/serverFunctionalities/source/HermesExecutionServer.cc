@@ -5,6 +5,7 @@
 #include "PDBDebug.h"
 #include "GenericWork.h"
 #include "HermesExecutionServer.h"
+#include "ExecutionProfiler.h"
 #include "StoragePagePinned.h"
 #include "StorageNoMorePage.h"
 #include "StorageRemoveHashSet.h"
@@ -54,7 +55,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
         PDB_COUT << "Start a handler to process StoragePagePinned messages\n";
         bool res;
         std::string errMsg;
-        PageScannerPtr scanner = getFunctionality<HermesExecutionServer>().getCurPageScanner();
+        PageScannerPtr scanner = getFunctionality<HermesExecutionServer>().getPageScanner(
+            request->getDatabaseID(), request->getUserTypeID(), request->getSetID());
         if (scanner == nullptr) {
           res = false;
           errMsg = "Fatal Error: No job is running in execution server.";
@@ -77,12 +79,19 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                           bool res;
                           std::string errMsg;
                           std::cout << "Got StorageNoMorePage object." << std::endl;
-                          PageScannerPtr scanner =
-                              getFunctionality<HermesExecutionServer>().getCurPageScanner();
+                          PageScannerPtr scanner = request->isForSet()
+                              ? getFunctionality<HermesExecutionServer>().getPageScanner(
+                                    request->getDatabaseID(),
+                                    request->getUserTypeID(),
+                                    request->getSetID())
+                              : getFunctionality<HermesExecutionServer>().getCurPageScanner();
                           std::cout << "To close the scanner..." << std::endl;
                           if (scanner == nullptr) {
                             std::cout << "The scanner has already been closed." << std::endl;
                           } else {
+                            if (!request->isComplete()) {
+                              scanner->setIncomplete();
+                            }
                             scanner->closeBuffer();
                             std::cout << "We closed the scanner buffer." << std::endl;
                           }
@@ -175,6 +184,11 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
       make_shared<SimpleRequestHandler<BroadcastJoinBuildHTJobStage>>([&](
           Handle<BroadcastJoinBuildHTJobStage> request, PDBCommunicatorPtr sendUsingMe) {
 
+        // the profile of this stage only, other stages may run at the same time
+        const char* profilerStage =
+            ExecutionProfiler::getStageKey(request->getJobId(), request->getStageId());
+        ExecutionProfiler::StageScope stageScope(profilerStage);
+        ExecutionProfiler::reset(profilerStage);
         getAllocator().cleanInactiveBlocks((size_t) ((size_t) 32 * (size_t) 1024 * (size_t) 1024));
         getAllocator().cleanInactiveBlocks((size_t) ((size_t) 256 * (size_t) 1024 * (size_t) 1024));
 
@@ -191,6 +205,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                  << std::endl;
         request->print();
 
+        // load the shared libraries of all types used by this stage before any thread uses them
+        request->getComputePlan()->preloadTypes(
+            std::vector<std::string>{request->getSourceContext()->getDataType()});
+
         // create a SharedHashSet instance
         size_t hashSetSize = conf->getBroadcastPageSize() * (size_t) (request->getNumPages()) *
             JOIN_HASH_TABLE_SIZE_RATIO;
@@ -333,7 +351,9 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
               if (record != nullptr) {
                 Handle<Object> theOtherMap = record->getRootObject();
                 // to merge the two maps
+                long begin = ExecutionProfiler::now();
                 merger->writeOut(theOtherMap, myMap);
+                ExecutionProfiler::record("hash table merge", ExecutionProfiler::now() - begin);
               }
             }
 
@@ -356,8 +376,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
 
         // return result to frontend
         PDB_COUT << "to send back reply" << std::endl;
-        const UseTemporaryAllocationBlock block1{1024};
+        std::string profile = ExecutionProfiler::collect(profilerStage);
+        const UseTemporaryAllocationBlock block1{1024 + profile.size()};
         Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(success, errMsg);
+        response->setProfile(profile);
         // return the result
         success = sendUsingMe->sendObject(response, errMsg);
         return make_pair(success, errMsg);
@@ -369,6 +391,11 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
       AggregationJobStage_TYPEID,
       make_shared<SimpleRequestHandler<AggregationJobStage>>([&](
                                                                  Handle<AggregationJobStage> request, PDBCommunicatorPtr sendUsingMe) {
+                                                               // the profile of this stage only, other stages may run at the same time
+                                                               const char* profilerStage =
+                                                                   ExecutionProfiler::getStageKey(request->getJobId(), request->getStageId());
+                                                               ExecutionProfiler::StageScope stageScope(profilerStage);
+                                                               ExecutionProfiler::reset(profilerStage);
                                                                getAllocator().cleanInactiveBlocks((size_t) ((size_t) 32 * (size_t) 1024 * (size_t) 1024));
                                                                getAllocator().cleanInactiveBlocks((size_t) ((size_t) 256 * (size_t) 1024 * (size_t) 1024));
                                                                const UseTemporaryAllocationBlock block{32 * 1024 * 1024};
@@ -379,6 +406,11 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                          << request->getStageId() << std::endl;
                                                                request->print();
 
+                                                               // load the shared libraries of the types used by this stage
+                                                               VTableMap::preloadTypes(std::vector<std::string>{
+                                                                   request->getSourceContext()->getDataType(),
+                                                                   request->getOutputTypeName()});
+
 #ifdef PROFILING
                                                                std::string out = getAllocator().printInactiveBlocks();
                                                                std::cout << "AggregationJobStage-backend: print inactive blocks:" << std::endl;
@@ -392,6 +424,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
 #else
                                                                double ratio = 0.8;
 #endif
+                                                               // the stage that shuffles the input runs next to this one
+                                                               if (request->getNumProducers() > 0) {
+                                                                 ratio *= PDB_PIPELINED_MEMORY_SHARE;
+                                                               }
 
 #ifdef AUTO_TUNING
                                                                size_t memSize = request->getTotalMemoryOnThisNode();
@@ -534,6 +570,7 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                          if (inputData != nullptr) {
                                                                            inputSize = inputData->size();
                                                                          }
+                                                                         long begin = ExecutionProfiler::now();
                                                                          for (int j = 0; j < inputSize; j++) {
                                                                            aggregateProcessor->loadInputObject((*inputData)[j]);
                                                                            if (aggregateProcessor->needsProcessInput() == false) {
@@ -565,6 +602,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                              break;
                                                                            }
                                                                          }
+                                                                         ExecutionProfiler::record(
+                                                                             "aggregation merge", ExecutionProfiler::now() - begin, inputSize, 0, page->getSize());
                                                                          // unpin user page
                                                                          // aggregateProcessor->clearInputPage();
                                                                          page->decRefCount();
@@ -614,6 +653,7 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                          if (inputData != nullptr) {
                                                                            inputSize = inputData->size();
                                                                          }
+                                                                         long begin = ExecutionProfiler::now();
                                                                          for (int j = 0; j < inputSize; j++) {
                                                                            aggregateProcessor->loadInputObject((*inputData)[j]);
                                                                            if (aggregateProcessor->needsProcessInput() == false) {
@@ -680,6 +720,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                              break;
                                                                            }
                                                                          }
+                                                                         ExecutionProfiler::record(
+                                                                             "aggregation merge", ExecutionProfiler::now() - begin, inputSize, 0, page->getSize());
                                                                          // aggregateProcessor->clearInputPage();
                                                                          // unpin the input page
                                                                          page->decRefCount();
@@ -773,7 +815,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                                                                  numThreads,
                                                                                                                  backendCircularBufferSize,
                                                                                                                  nodeId);
-                                                               if (getFunctionality<HermesExecutionServer>().setCurPageScanner(scanner) == false) {
+                                                               if (getFunctionality<HermesExecutionServer>().setCurPageScanner(
+                                                                       scanner, request->getNumProducers() > 0) == false) {
                                                                  success = false;
                                                                  errMsg = "Error: A job is already running!";
                                                                  std::cout << errMsg << std::endl;
@@ -876,16 +919,21 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                // reset scanner
                                                                pthread_mutex_destroy(&connection_mutex);
 
-                                                               if (getFunctionality<HermesExecutionServer>().setCurPageScanner(nullptr) == false) {
+                                                               // the frontend gave up waiting for the producers of the shuffle stream,
+                                                               // so the aggregation misses their data
+                                                               if (!scanner->isComplete()) {
                                                                  success = false;
-                                                                 errMsg = "Error: No job is running!";
+                                                                 errMsg = "Error: the producers of the shuffle stream did not all finish";
                                                                  std::cout << errMsg << std::endl;
                                                                }
+                                                               getFunctionality<HermesExecutionServer>().removePageScanner(scanner);
                                                                printCacheStats();
                                                                // return result to frontend
                                                                PDB_COUT << "to send back reply" << std::endl;
-                                                               const UseTemporaryAllocationBlock block1{1024};
+                                                               std::string profile = ExecutionProfiler::collect(profilerStage);
+                                                               const UseTemporaryAllocationBlock block1{1024 + profile.size()};
                                                                Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(success, errMsg);
+                                                               response->setProfile(profile);
                                                                response->setNumHashKeys(numHashKeys);
                                                                // return the result
                                                                success = sendUsingMe->sendObject(response, errMsg);
@@ -900,6 +948,11 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
       HashPartitionedJoinBuildHTJobStage_TYPEID,
       make_shared<SimpleRequestHandler<HashPartitionedJoinBuildHTJobStage>>([&](
           Handle<HashPartitionedJoinBuildHTJobStage> request, PDBCommunicatorPtr sendUsingMe) {
+        // the profile of this stage only, other stages may run at the same time
+        const char* profilerStage =
+            ExecutionProfiler::getStageKey(request->getJobId(), request->getStageId());
+        ExecutionProfiler::StageScope stageScope(profilerStage);
+        ExecutionProfiler::reset(profilerStage);
         getAllocator().cleanInactiveBlocks((size_t) ((size_t) 256 * (size_t) 1024 * (size_t) 1024));
         const UseTemporaryAllocationBlock block{32 * 1024 * 1024};
         bool success = true;
@@ -909,6 +962,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                   << request->getStageId() << std::endl;
         request->print();
 
+        // load the shared libraries of all types used by this stage before any thread uses them
+        request->getComputePlan()->preloadTypes(
+            std::vector<std::string>{request->getSourceContext()->getDataType()});
+
 #ifdef PROFILING
         std::string out = getAllocator().printInactiveBlocks();
         std::cout << "HashPartitionedJoinBuildHTJobStage-backend: print inactive blocks:"
@@ -1043,7 +1100,9 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                     if (record != nullptr) {
                       std::cout <<"get a non-empty record" << std::endl; 
                       Handle<Object> mapsToMerge = record->getRootObject();
+                      long begin = ExecutionProfiler::now();
                       merger->writeVectorOut(mapsToMerge, myMap);
+                      ExecutionProfiler::record("hash table merge", ExecutionProfiler::now() - begin);
                     }
                   }
                   // unpin the input page
@@ -1206,8 +1265,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
 
         // return result to frontend
         PDB_COUT << "to send back reply" << std::endl;
-        const UseTemporaryAllocationBlock block1{1024};
+        std::string profile = ExecutionProfiler::collect(profilerStage);
+        const UseTemporaryAllocationBlock block1{1024 + profile.size()};
         Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(success, errMsg);
+        response->setProfile(profile);
         response->setNumHashKeys(numHashKeys);
         // return the result
         success = sendUsingMe->sendObject(response, errMsg);
@@ -1221,12 +1282,21 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
       TupleSetJobStage_TYPEID,
       make_shared<SimpleRequestHandler<TupleSetJobStage>>([&](Handle<TupleSetJobStage> request,
                                                               PDBCommunicatorPtr sendUsingMe) {
+        // the profile of this stage only, other stages may run at the same time
+        const char* profilerStage =
+            ExecutionProfiler::getStageKey(request->getJobId(), request->getStageId());
+        ExecutionProfiler::StageScope stageScope(profilerStage);
+        ExecutionProfiler::reset(profilerStage);
         getAllocator().cleanInactiveBlocks((size_t) ((size_t) 32 * (size_t) 1024 * (size_t) 1024));
 
         getAllocator().cleanInactiveBlocks((size_t) ((size_t) 256 * (size_t) 1024 * (size_t) 1024));
         PDB_COUT << "Backend got Tuple JobStage message with Id=" << request->getStageId()
                  << std::endl;
         request->print();
+
+        // load the shared libraries of all types used by this stage before pipeline threads start
+        request->getComputePlan()->preloadTypes(std::vector<std::string>{
+            request->getSourceContext()->getDataType(), request->getOutputTypeName()});
         bool res = true;
         std::string errMsg;
 #ifdef ENABLE_LARGE_GRAPH
@@ -1240,7 +1310,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
         std::cout << out << std::endl;
 #endif
         Handle<SetIdentifier> sourceContext = request->getSourceContext();
-        if (getCurPageScanner() == nullptr) {
+        // the producer of a pipeline runs next to the consumer that scans its output
+        if ((getCurPageScanner() == nullptr) || (request->isPipelinedWithConsumer() == true)) {
           NodeID nodeId = getFunctionality<HermesExecutionServer>().getNodeID();
           pdb::PDBLoggerPtr logger = getFunctionality<HermesExecutionServer>().getLogger();
           SharedMemPtr shm = getFunctionality<HermesExecutionServer>().getSharedMem();
@@ -1266,7 +1337,11 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
             pipeline->runPipelineWithBroadcastSink(this);
           } else {
             std::cout << "run pipeline with combiner..." << std::endl;
-            pipeline->runPipelineWithShuffleSink(this);
+            // a lost page leaves the aggregation on its node incomplete
+            if (!pipeline->runPipelineWithShuffleSink(this, errMsg)) {
+              res = false;
+              std::cout << "Error: " << errMsg << std::endl;
+            }
           }
           if ((sourceContext->isAggregationResult() == true) &&
               (sourceContext->getSetType() == PartitionedHashSetType)) {
@@ -1318,8 +1393,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
         printCacheStats();
 
         PDB_COUT << "to send back reply" << std::endl;
-        const UseTemporaryAllocationBlock block2{1024};
+        std::string profile = ExecutionProfiler::collect(profilerStage);
+        const UseTemporaryAllocationBlock block2{1024 + profile.size()};
         Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
+        response->setProfile(profile);
         // return the result
         res = sendUsingMe->sendObject(response, errMsg);
         return make_pair(res, errMsg);
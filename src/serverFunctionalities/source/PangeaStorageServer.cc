@@ -38,6 +38,8 @@
 #include "StorageCollectStats.h"
 #include "StorageCollectStatsResponse.h"
 #include "PDBScanWork.h"
+#include "GenericWork.h"
+#include "SimpleRequest.h"
 #include "UseTemporaryAllocationBlock.h"
 #include "SimpleRequestHandler.h"
 #include "Record.h"
@@ -49,7 +51,9 @@
 #include "PDBFlushProducerWork.h"
 #include "PDBFlushConsumerWork.h"
 #include "ExportableObject.h"
+#include "ExportedSetFile.h"
 #include "JoinTupleBase.h"
+#include "PageCodec.h"
 //#include <hdfs/hdfs.h>
 #include <cstdio>
 #include <memory>
@@ -60,7 +64,10 @@
 #include <map>
 #include <iterator>
 #include <pthread.h>
-#include <snappy.h>
+#include <errno.h>
+#include <sys/time.h>
+#include <unordered_set>
+#include <algorithm>
 
 #define FLUSH_BUFFER_SIZE 3
 
@@ -101,6 +108,7 @@ PangeaStorageServer::PangeaStorageServer(SharedMemPtr shm,
     this->totalObjects = 0;
     // IPC file used to communicate with backend
     this->pathToBackEndServer = this->conf->getBackEndIpcFile();
+    pthread_mutex_init(&backEndPathMutex, nullptr);
 
     // initialize flush buffer
     // a producer work will periodically remove unpinned data from input buffer, and
@@ -126,6 +134,10 @@ PangeaStorageServer::PangeaStorageServer(SharedMemPtr shm,
     pthread_mutex_init(&(this->usersetLock), nullptr);
     pthread_mutex_init(&(this->workingMutex), nullptr);
     pthread_mutex_init(&(this->counterMutex), nullptr);
+    pthread_mutex_init(&(this->statsMutex), nullptr);
+    pthread_cond_init(&(this->statsSignal), nullptr);
+    pthread_mutex_init(&(this->streamMutex), nullptr);
+    pthread_cond_init(&(this->streamSignal), nullptr);
 
     this->databaseSeqId.initialize(1);  // DatabaseID starting from 1
     this->usersetSeqIds = new std::map<std::string, SequenceID*>();
@@ -170,15 +182,292 @@ void PangeaStorageServer::cleanup(bool flushOrNot) {
     PDB_COUT << "cleaned up for storage..." << std::endl;
 }
 
+Handle<Vector<Handle<SetIdentifier>>> PangeaStorageServer::getStatsSince(long sinceVersion,
+                                                                         long& version) {
+    Handle<Vector<Handle<SetIdentifier>>> stats = makeObject<Vector<Handle<SetIdentifier>>>();
+    const LockGuard guard{statsMutex};
+    std::map<pair<std::string, std::string>, bool> existingSets;
+    pthread_mutex_lock(&this->usersetLock);
+    for (auto& it : *(this->userSets)) {
+        SetPtr set = it.second;
+        DefaultDatabasePtr db = this->getDatabase(it.first.first);
+        if (db == nullptr) {
+            continue;
+        }
+        pair<std::string, std::string> key(db->getDatabaseName(), set->getSetName());
+        int numPages = set->getNumPages();
+        size_t pageSize = set->getPageSize();
+        existingSets[key] = true;
+        if ((setStats.count(key) == 0) || (std::get<0>(setStats[key]) != numPages) ||
+            (std::get<1>(setStats[key]) != pageSize)) {
+            statsVersion++;
+            setStats[key] = std::make_tuple(numPages, pageSize, statsVersion);
+        }
+    }
+    pthread_mutex_unlock(&this->usersetLock);
+    // sets that disappeared are reported once with zero pages
+    for (auto& it : setStats) {
+        if ((existingSets.count(it.first) == 0) && (std::get<0>(it.second) != 0)) {
+            statsVersion++;
+            it.second = std::make_tuple(0, std::get<1>(it.second), statsVersion);
+        }
+    }
+    for (auto& it : setStats) {
+        if (std::get<2>(it.second) > sinceVersion) {
+            Handle<SetIdentifier> setIdentifier =
+                makeObject<SetIdentifier>(it.first.first, it.first.second);
+            setIdentifier->setNumPages(std::get<0>(it.second));
+            setIdentifier->setPageSize(std::get<1>(it.second));
+            setIdentifier->setVersion(std::get<2>(it.second));
+            stats->push_back(setIdentifier);
+        }
+    }
+    version = statsVersion;
+    return stats;
+}
+
+void PangeaStorageServer::bumpSetVersion(std::string databaseName, std::string setName) {
+    const LockGuard guard{statsMutex};
+    pair<std::string, std::string> key(databaseName, setName);
+    statsVersion++;
+    if (setStats.count(key) == 0) {
+        // the number of pages will be filled in by the next scan of the sets
+        setStats[key] = std::make_tuple(-1, (size_t)0, statsVersion);
+    } else {
+        std::get<2>(setStats[key]) = statsVersion;
+    }
+}
+
+void PangeaStorageServer::openShuffleStream(pair<std::string, std::string> databaseAndSet,
+                                            int numProducers) {
+    const LockGuard guard{streamMutex};
+    // producers that ended before the consumer started are already counted
+    shuffleStreams[databaseAndSet].numProducers = numProducers;
+    pthread_cond_broadcast(&streamSignal);
+}
+
+void PangeaStorageServer::receiveShuffleData(pair<std::string, std::string> databaseAndSet) {
+    const LockGuard guard{streamMutex};
+    shuffleStreams[databaseAndSet].numReceived++;
+}
+
+void PangeaStorageServer::beginStoringShuffleData(pair<std::string, std::string> databaseAndSet) {
+    const LockGuard guard{streamMutex};
+    ShuffleStream& stream = shuffleStreams[databaseAndSet];
+    while (stream.scanning) {
+        pthread_cond_wait(&streamSignal, &streamMutex);
+    }
+    stream.numStoring++;
+}
+
+void PangeaStorageServer::notifyShuffleStream(pair<std::string, std::string> databaseAndSet,
+                                              bool stored,
+                                              bool lastOfStream) {
+    const LockGuard guard{streamMutex};
+    auto stream = shuffleStreams.find(databaseAndSet);
+    if (stream == shuffleStreams.end()) {
+        return;
+    }
+    ShuffleStream& myStream = stream->second;
+    myStream.numReceived--;
+    if (stored) {
+        myStream.numStoring--;
+    }
+    myStream.numAdds++;
+    if (lastOfStream == true) {
+        myStream.numEnded++;
+    }
+    // the ends of streams are kept for the consumer, even if it did not open the stream yet
+    if ((myStream.numProducers == 0) && (myStream.numEnded == 0) && (myStream.numReceived == 0)) {
+        shuffleStreams.erase(stream);
+    }
+    pthread_cond_broadcast(&streamSignal);
+}
+
+bool PangeaStorageServer::isShuffleStream(pair<std::string, std::string> databaseAndSet) {
+    const LockGuard guard{streamMutex};
+    auto stream = shuffleStreams.find(databaseAndSet);
+    return (stream != shuffleStreams.end()) && (stream->second.numProducers > 0);
+}
+
+bool PangeaStorageServer::waitForShuffleData(pair<std::string, std::string> databaseAndSet,
+                                             long& numAdds,
+                                             bool& timedOut) {
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    long nanos = now.tv_usec * 1000L + (PDB_SHUFFLE_STREAM_TIMEOUT_MS % 1000) * 1000000L;
+    struct timespec deadline;
+    deadline.tv_sec = now.tv_sec + PDB_SHUFFLE_STREAM_TIMEOUT_MS / 1000 + nanos / 1000000000L;
+    deadline.tv_nsec = nanos % 1000000000L;
+
+    timedOut = false;
+    const LockGuard guard{streamMutex};
+    while (true) {
+        auto stream = shuffleStreams.find(databaseAndSet);
+        if (stream == shuffleStreams.end()) {
+            return true;
+        }
+        ShuffleStream& myStream = stream->second;
+        bool ended = (myStream.numProducers > 0) && (myStream.numEnded >= myStream.numProducers);
+        if (ended || (myStream.numAdds != numAdds)) {
+            numAdds = myStream.numAdds;
+            return ended;
+        }
+        if (pthread_cond_timedwait(&streamSignal, &streamMutex, &deadline) == ETIMEDOUT) {
+            logger->error("PangeaStorageServer: only " + std::to_string(myStream.numEnded) +
+                          " of " + std::to_string(myStream.numProducers) +
+                          " producers ended the shuffle stream of " + databaseAndSet.first +
+                          ":" + databaseAndSet.second + ", failing its scan");
+            timedOut = true;
+            return true;
+        }
+    }
+}
+
+void PangeaStorageServer::flushShuffleStream(pair<std::string, std::string> databaseAndSet) {
+    // the last data of a producer may be stored before the data it sent earlier
+    {
+        const LockGuard guard{streamMutex};
+        while (true) {
+            auto stream = shuffleStreams.find(databaseAndSet);
+            if ((stream == shuffleStreams.end()) || (stream->second.numReceived == 0)) {
+                break;
+            }
+            pthread_cond_wait(&streamSignal, &streamMutex);
+        }
+    }
+    const LockGuard guard{workingMutex};
+    while (allRecords[databaseAndSet].size() > 0) {
+        writeBackRecords(databaseAndSet, false);
+    }
+}
+
+void PangeaStorageServer::beginShuffleScan(pair<std::string, std::string> databaseAndSet) {
+    const LockGuard guard{streamMutex};
+    ShuffleStream& stream = shuffleStreams[databaseAndSet];
+    stream.scanning = true;
+    while (stream.numStoring > 0) {
+        pthread_cond_wait(&streamSignal, &streamMutex);
+    }
+}
+
+void PangeaStorageServer::endShuffleScan(pair<std::string, std::string> databaseAndSet) {
+    const LockGuard guard{streamMutex};
+    shuffleStreams[databaseAndSet].scanning = false;
+    pthread_cond_broadcast(&streamSignal);
+}
+
+void PangeaStorageServer::closeShuffleStream(pair<std::string, std::string> databaseAndSet) {
+    const LockGuard guard{streamMutex};
+    auto stream = shuffleStreams.find(databaseAndSet);
+    if (stream == shuffleStreams.end()) {
+        return;
+    }
+    // data that is still being added to the set keeps the entry until it is counted
+    if (stream->second.numReceived == 0) {
+        shuffleStreams.erase(stream);
+    } else {
+        stream->second.numProducers = 0;
+        stream->second.numEnded = 0;
+        stream->second.numAdds = 0;
+        stream->second.scanning = false;
+    }
+    pthread_cond_broadcast(&streamSignal);
+}
+
+void PangeaStorageServer::pushStatsToManager() {
+    if ((this->standalone == true) || (this->conf->getIsMaster() == true)) {
+        return;
+    }
+    {
+        // pushes requested while one is in flight are coalesced into the next one
+        const LockGuard guard{statsMutex};
+        statsPushRequested = true;
+        if (statsPusherStarted == true) {
+            pthread_cond_signal(&statsSignal);
+            return;
+        }
+        statsPusherStarted = true;
+    }
+    // the first push starts the pusher, so that handlers never wait for a worker; the pusher
+    // keeps its worker from the pool until stopStatsPusher () is called
+    PDBWorkerPtr worker = getWorker();
+    PDBWorkPtr myWork = make_shared<GenericWork>([this](PDBBuzzerPtr callerBuzzer) {
+        while (true) {
+            long sinceVersion;
+            pthread_mutex_lock(&statsMutex);
+            while ((statsPushRequested == false) && (statsPusherStopped == false)) {
+                pthread_cond_wait(&statsSignal, &statsMutex);
+            }
+            if (statsPusherStopped == true) {
+                // tell stopStatsPusher () that the pusher no longer uses statsMutex
+                statsPusherDone = true;
+                pthread_cond_broadcast(&statsSignal);
+                pthread_mutex_unlock(&statsMutex);
+                break;
+            }
+            statsPushRequested = false;
+            sinceVersion = pushedStatsVersion;
+            pthread_mutex_unlock(&statsMutex);
+
+            const UseTemporaryAllocationBlock block{4 * 1024 * 1024};
+            long version;
+            Handle<Vector<Handle<SetIdentifier>>> stats = getStatsSince(sinceVersion, version);
+            if (stats->size() == 0) {
+                continue;
+            }
+            bool res = simpleRequest<StorageCollectStatsResponse, SimpleRequestResult, bool>(
+                logger,
+                conf->getMasterNodePort(),
+                conf->getMasterNodeHostName(),
+                false,
+                1024 + stats->size() * 256,
+                [&](Handle<SimpleRequestResult> result) {
+                    return (result != nullptr) && (result->getRes().first == true);
+                },
+                nodeId,
+                version,
+                stats);
+            if (res == true) {
+                const LockGuard guard{statsMutex};
+                if (version > pushedStatsVersion) {
+                    pushedStatsVersion = version;
+                }
+            } else {
+                logger->warn("PangeaStorageServer: failed to push stats to manager");
+            }
+        }
+        callerBuzzer->buzz(PDBAlarm::WorkAllDone);
+    });
+    worker->execute(myWork, make_shared<PDBBuzzer>(nullptr));
+}
+
+void PangeaStorageServer::stopStatsPusher() {
+    pthread_mutex_lock(&statsMutex);
+    statsPusherStopped = true;
+    pthread_cond_broadcast(&statsSignal);
+    // wait for a push in flight to finish, as the pusher still uses statsMutex and statsSignal
+    while ((statsPusherStarted == true) && (statsPusherDone == false)) {
+        pthread_cond_wait(&statsSignal, &statsMutex);
+    }
+    pthread_mutex_unlock(&statsMutex);
+}
+
 PangeaStorageServer::~PangeaStorageServer() {
 
     stopFlushConsumerThreads();
+    stopStatsPusher();
     pthread_mutex_destroy(&(this->databaseLock));
     pthread_mutex_destroy(&(this->typeLock));
     pthread_mutex_destroy(&(this->tempsetLock));
+    pthread_mutex_destroy(&(this->backEndPathMutex));
     pthread_mutex_destroy(&(this->usersetLock));
     pthread_mutex_destroy(&(this->workingMutex));
     pthread_mutex_destroy(&(this->counterMutex));
+    pthread_mutex_destroy(&(this->statsMutex));
+    pthread_mutex_destroy(&(this->streamMutex));
+    pthread_cond_destroy(&(this->streamSignal));
+    pthread_cond_destroy(&(this->statsSignal));
     delete this->dbs;
     delete this->name2id;
     delete this->tempSets;
@@ -200,6 +489,87 @@ PDBPagePtr PangeaStorageServer::getNewPage(pair<std::string, std::string> databa
 }
 
 
+bool PangeaStorageServer::adoptRecord(pair<std::string, std::string> databaseAndSet,
+                                      Record<Vector<Handle<Object>>>* record,
+                                      bool flushOrNot) {
+    PDBPagePtr myPage = getNewPage(databaseAndSet);
+    if (myPage == nullptr) {
+        std::cout << "FATAL ERROR: set to store data doesn't exist!" << std::endl;
+        return false;
+    }
+    CacheKey key;
+    key.dbId = myPage->getDbID();
+    key.typeId = myPage->getTypeID();
+    key.setId = myPage->getSetID();
+    key.pageId = myPage->getPageID();
+    bool fits = (record->numBytes() <= myPage->getSize());
+    if (fits) {
+        // the record is a complete allocation block, so its bytes are valid as they are
+        memcpy(myPage->getBytes(), record, record->numBytes());
+        totalObjects += record->getRootObject()->size();
+    } else {
+        // leave a valid, empty page behind
+        const UseTemporaryAllocationBlock block(myPage->getBytes(), myPage->getSize());
+        Handle<Vector<Handle<Object>>> data = makeObject<Vector<Handle<Object>>>();
+        getRecord(data);
+    }
+    this->getCache()->decPageRefCount(key);
+    if (flushOrNot == true) {
+        this->getCache()->flushPageWithoutEviction(key);
+    }
+    return fits;
+}
+
+bool PangeaStorageServer::adoptCompressedRecord(pair<std::string, std::string> databaseAndSet,
+                                                char* frame,
+                                                size_t frameSize,
+                                                bool flushOrNot,
+                                                std::string& errMsg) {
+    PDBPagePtr myPage = getNewPage(databaseAndSet);
+    if (myPage == nullptr) {
+        errMsg = "FATAL ERROR: set to store data doesn't exist!";
+        std::cout << errMsg << std::endl;
+        return false;
+    }
+    CacheKey key;
+    key.dbId = myPage->getDbID();
+    key.typeId = myPage->getTypeID();
+    key.setId = myPage->getSetID();
+    key.pageId = myPage->getPageID();
+    Record<Vector<Handle<Object>>>* record = (Record<Vector<Handle<Object>>>*)myPage->getBytes();
+    size_t pageSize = PageCodec::getPageSize(frame, frameSize);
+    bool ok = PageCodec::decompress(frame, frameSize, (char*)record, myPage->getSize()) &&
+        isValidRecord(record, pageSize) && record->getRootObject()->size() > 0;
+    if (ok) {
+        totalObjects += record->getRootObject()->size();
+    } else {
+        errMsg = "Error: received a malformed record of " + std::to_string(frameSize) +
+            " compressed bytes";
+        std::cout << errMsg << std::endl;
+        // leave a valid, empty page behind
+        const UseTemporaryAllocationBlock block(myPage->getBytes(), myPage->getSize());
+        Handle<Vector<Handle<Object>>> data = makeObject<Vector<Handle<Object>>>();
+        getRecord(data);
+    }
+    this->getCache()->decPageRefCount(key);
+    if (flushOrNot == true) {
+        this->getCache()->flushPageWithoutEviction(key);
+    }
+    return ok;
+}
+
+bool PangeaStorageServer::isValidRecord(Record<Vector<Handle<Object>>>* record,
+                                        size_t numBytesReceived) {
+    if (record == nullptr || numBytesReceived < 2 * sizeof(size_t)) {
+        return false;
+    }
+    size_t numBytes = record->numBytes();
+    size_t rootObjectOffset = record->rootObjectOffset();
+    return (numBytes >= 2 * sizeof(size_t)) && (numBytes <= numBytesReceived) &&
+        (rootObjectOffset >= 2 * sizeof(size_t)) &&
+        (rootObjectOffset + sizeof(Vector<Handle<Object>>) <= numBytes);
+}
+
 void PangeaStorageServer::writeBackRecords(pair<std::string, std::string> databaseAndSet,
                                            bool flushOrNot,
                                            bool directPutOrNot) {
@@ -345,20 +715,17 @@ void PangeaStorageServer::writeBackRecords(pair<std::string, std::string> databa
 }
 
 
-// export to a local file
+// export to a local file; the pages of the set are exported in parallel, by one worker per page
+// iterator. In the "binary" format, each worker writes the records of its pages as they are to a
+// file of its own, path.i, laid out as ExportedSetFile describes, which StorageClient::importSet
+// loads back; in the other formats, each worker formats its objects into a buffer of its own, and
+// appends the buffer to the single output file whenever it is full
 bool PangeaStorageServer::exportToFile(std::string dbName,
                                        std::string setName,
                                        std::string path,
                                        std::string format,
                                        std::string& errMsg) {
 
-    FILE* myFile = fopen(path.c_str(), "w+");
-    if (myFile == NULL) {
-        errMsg = "Error opening file for writing: " + path;
-        std::cout << errMsg << std::endl;
-        return false;
-    }
-
     SetPtr setToExport =
         getFunctionality<PangeaStorageServer>().getSet(std::make_pair(dbName, setName));
     if (setToExport == nullptr) {
@@ -367,36 +734,118 @@ bool PangeaStorageServer::exportToFile(std::string dbName,
         return false;
     }
 
+    bool binary = (format == "binary");
+    FILE* myFile = nullptr;
+    if (binary == false) {
+        myFile = fopen(path.c_str(), "w+");
+        if (myFile == NULL) {
+            errMsg = "Error opening file for writing: " + path;
+            std::cout << errMsg << std::endl;
+            return false;
+        }
+    }
+
+    // the binary files name the type of their records, and the library that lays them out
+    std::string typeName;
+    std::string schema;
+    if (binary == true) {
+        typeName = getFunctionality<CatalogClient>().getObjectType(dbName, setName, errMsg);
+        if (typeName == "") {
+            errMsg = "Error in exportToFile: can't find the type of " + dbName + ":" + setName +
+                ": " + errMsg;
+            std::cout << errMsg << std::endl;
+            return false;
+        }
+        // built-in types have no library
+        std::string hashErrMsg;
+        schema = getFunctionality<CatalogClient>().getSharedLibraryHash(setToExport->getTypeID(),
+                                                                         hashErrMsg);
+    }
+
+    // protects the output file, isHeadWritten and the result
+    pthread_mutex_t fileMutex;
+    pthread_mutex_init(&fileMutex, nullptr);
     bool isHeadWritten = false;
+    bool success = true;
+
     setToExport->setPinned(true);
     std::vector<PageIteratorPtr>* pageIters = setToExport->getIterators();
     int numIterators = pageIters->size();
+    PDBBuzzerPtr exportBuzzer = make_shared<PDBBuzzer>([](PDBAlarm myAlarm, atomic_int& counter) {
+        counter++;
+        PDB_COUT << "exportToFile: counter = " << counter << std::endl;
+    });
+    atomic_int counter;
+    counter = 0;
     for (int i = 0; i < numIterators; i++) {
-        PageIteratorPtr iter = pageIters->at(i);
-        while (iter->hasNext()) {
-            PDBPagePtr nextPage = iter->next();
-            if (nextPage != nullptr) {
+        PDBWorkerPtr worker = getWorker();
+        PDBWorkPtr myWork = make_shared<GenericWork>([&, i](PDBBuzzerPtr callerBuzzer) {
+            PageIteratorPtr iter = pageIters->at(i);
+            PageCachePtr cache = getFunctionality<PangeaStorageServer>().getCache();
+            FILE* partFile = myFile;
+            std::string partPath = path + "." + std::to_string(i);
+            if (binary == true) {
+                partFile = fopen(partPath.c_str(), "w");
+                if ((partFile == NULL) ||
+                    (ExportedSetFile::writeHeader(partFile, typeName, schema) == false)) {
+                    pthread_mutex_lock(&fileMutex);
+                    success = false;
+                    errMsg = "Error opening file for writing: " + partPath;
+                    pthread_mutex_unlock(&fileMutex);
+                }
+            }
+
+            // the objects formatted by this worker, and the header of their type
+            std::string buffer;
+            std::string header;
+            bool isHeadKnown = false;
+            auto appendToFile = [&]() {
+                pthread_mutex_lock(&fileMutex);
+                if ((isHeadWritten == false) && (isHeadKnown == true)) {
+                    fwrite(header.data(), 1, header.size(), myFile);
+                    isHeadWritten = true;
+                }
+                if (fwrite(buffer.data(), 1, buffer.size(), myFile) != buffer.size()) {
+                    success = false;
+                    errMsg = "Error writing to file: " + path;
+                }
+                pthread_mutex_unlock(&fileMutex);
+                buffer.clear();
+            };
+
+            while (iter->hasNext()) {
+                PDBPagePtr nextPage = iter->next();
+                if (nextPage == nullptr) {
+                    continue;
+                }
                 Record<Vector<Handle<Object>>>* myRec =
                     (Record<Vector<Handle<Object>>>*)(nextPage->getBytes());
-                Handle<Vector<Handle<Object>>> inputVec = myRec->getRootObject();
-                int vecSize = inputVec->size();
-                for (int j = 0; j < vecSize; j++) {
-                    Handle<ExportableObject> objectToExport =
-                        unsafeCast<ExportableObject, Object>((*inputVec)[j]);
-                    if (isHeadWritten == false) {
-                        std::string header = objectToExport->toSchemaString(format);
-                        if (header != "") {
-                            fprintf(myFile, "%s", header.c_str());
+                if (binary == true) {
+                    if ((partFile != NULL) && (myRec->numBytes() > 0) &&
+                        (ExportedSetFile::writeRecord(
+                             partFile, (char*)myRec, myRec->numBytes()) == false)) {
+                        pthread_mutex_lock(&fileMutex);
+                        success = false;
+                        errMsg = "Error writing to file: " + partPath;
+                        pthread_mutex_unlock(&fileMutex);
+                    }
+                } else {
+                    Handle<Vector<Handle<Object>>> inputVec = myRec->getRootObject();
+                    int vecSize = inputVec->size();
+                    for (int j = 0; j < vecSize; j++) {
+                        Handle<ExportableObject> objectToExport =
+                            unsafeCast<ExportableObject, Object>((*inputVec)[j]);
+                        if (isHeadKnown == false) {
+                            header = objectToExport->toSchemaString(format);
+                            isHeadKnown = true;
                         }
-                        isHeadWritten = true;
+                        buffer += objectToExport->toValueString(format);
                     }
-                    std::string value = objectToExport->toValueString(format);
-                    if (value != "") {
-                        fprintf(myFile, "%s", value.c_str());
+                    if (buffer.size() >= PDB_EXPORT_BUFFER_SIZE) {
+                        appendToFile();
                     }
                 }
                 // to evict this page
-                PageCachePtr cache = getFunctionality<PangeaStorageServer>().getCache();
                 CacheKey key;
                 key.dbId = nextPage->getDbID();
                 key.typeId = nextPage->getTypeID();
@@ -406,13 +855,32 @@ bool PangeaStorageServer::exportToFile(std::string dbName,
                 cache->evictPage(key);  // try to modify this to something like
                                         // evictPageWithoutFlush() or clear set in the end.
             }
-        }
+            if (binary == true) {
+                if (partFile != NULL) {
+                    fclose(partFile);
+                }
+            } else if ((buffer.size() > 0) || (isHeadKnown == true)) {
+                appendToFile();
+            }
+            callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
+        });
+        worker->execute(myWork, exportBuzzer);
+    }
+
+    while (counter < numIterators) {
+        exportBuzzer->wait();
     }
     setToExport->setPinned(false);
     delete pageIters;
-    fflush(myFile);
-    fclose(myFile);
-    return true;
+    pthread_mutex_destroy(&fileMutex);
+    if (myFile != nullptr) {
+        fflush(myFile);
+        fclose(myFile);
+    }
+    if (success == false) {
+        std::cout << errMsg << std::endl;
+    }
+    return success;
 }
 
 // export to a HDFS partition
@@ -445,6 +913,7 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 std::string errMsg;
                 bool res = true;
                 getFunctionality<PangeaStorageServer>().cleanup(request->isFlushing());
+                getFunctionality<PangeaStorageServer>().pushStatsToManager();
 
                 const UseTemporaryAllocationBlock tempBlock{1024};
                 Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
@@ -677,6 +1146,7 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
 
             // return the result
             res = sendUsingMe->sendObject(response, errMsg);
+            getFunctionality<PangeaStorageServer>().pushStatsToManager();
             return make_pair(res, errMsg);
         }
 
@@ -757,8 +1227,12 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             const UseTemporaryAllocationBlock tempBlock{1024};
             Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
 
+            if (res == true) {
+                getFunctionality<PangeaStorageServer>().bumpSetVersion(databaseName, setName);
+            }
             // return the result
             res = sendUsingMe->sendObject(response, errMsg);
+            getFunctionality<PangeaStorageServer>().pushStatsToManager();
             return make_pair(res, errMsg);
         }
 
@@ -858,7 +1332,11 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             Handle<StorageAddObjectInLoop> curRequest = request;
             void* requestInLoop = nullptr;
             int counter = 0;
+            // the first page that was not stored fails the whole loop
+            bool allStored = true;
+            std::string storeErrMsg;
             while (curRequest->isLoopEnded() == false) {
+                errMsg = "";
                 bool typeCheckOrNot = request->isTypeCheck();
                 if (typeCheckOrNot == true) {
 #ifdef DEBUG_SET_TYPE
@@ -879,82 +1357,87 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 // get the record
                 size_t numBytes = sendUsingMe->getSizeOfNextObject();
                 std::cout << "received " << numBytes << " bytes" << std::endl;
-#ifdef ENABLE_COMPRESSION
-                char* readToHere = new char[numBytes];
-#else
-                void* readToHere = malloc(numBytes);
-#endif
-                if (readToHere == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
-                    exit(1);
-                }
+                char* readToHere = PageCodec::getBuffer(numBytes);
                 everythingOK = sendUsingMe->receiveBytes(readToHere, errMsg);
-
-                {
-                    const UseTemporaryAllocationBlock block{1024};
-                    Handle<SimpleRequestResult> response =
-                        makeObject<SimpleRequestResult>(everythingOK, errMsg);
-
-                    // return the result
-                    everythingOK = sendUsingMe->sendObject(response, errMsg);
-                }
+                size_t sizeOfBytesToAdd = 0;
                 if (everythingOK) {
-#ifdef ENABLE_COMPRESSION
-                    size_t sizeOfBytesToAdd = 0;
-                    snappy::GetUncompressedLength(readToHere, numBytes, &sizeOfBytesToAdd);
-#else
-                    size_t sizeOfBytesToAdd = numBytes;
-#endif
+                    sizeOfBytesToAdd = PageCodec::getPageSize(readToHere, numBytes);
+                    if (sizeOfBytesToAdd == 0) {
+                        errMsg = "Error: received a malformed page of " +
+                            std::to_string(numBytes) + " bytes";
+                        std::cout << errMsg << std::endl;
+                        everythingOK = false;
+                    }
+                }
 
+                // the page is decompressed right where it is stored, and checked, before the
+                // sender hears back, so that it learns about a page that was not stored
+                if (everythingOK) {
                     auto databaseAndSet = make_pair((std::string)request->getDatabase(),
                                                     (std::string)request->getSetName());
-                    // now, get a page to write to
                     SetPtr mySet = getSet(databaseAndSet);
                     if (mySet == nullptr) {
-                        std::cout << "FATAL ERROR: set to store data doesn't exist!" << std::endl;
-                        std::cout << "databaseName" << databaseAndSet.first << std::endl;
-                        std::cout << "setName" << databaseAndSet.second << std::endl;
-                        return make_pair(
-                            false, std::string("FATAL ERROR: set to store data doesn't exist!"));
-                    }
-                    std::cout << "sizeOfBytesToAdd is " << sizeOfBytesToAdd << std::endl;
-                    char* myBytes = (char*)mySet->getNewBytes(sizeOfBytesToAdd);
-                    if (myBytes == nullptr) {
-                        return make_pair(false,
-                                         std::string("FATAL ERROR: can't get bytes from user set " +
-                                                     databaseAndSet.second));
-                    }
-#ifdef ENABLE_COMPRESSION
-                    snappy::RawUncompress(readToHere, numBytes, myBytes);
-#else
-                    memcpy(myBytes, readToHere, numBytes);
-#endif
-                    /*MD5_CTX md5;
-                    MD5_Init(&md5);
-                    MD5_Update(&md5, myBytes, numBytes);
-                    unsigned char output[MD5_DIGEST_LENGTH];
-                    MD5_Final(output, &md5);
-                    std::cout << "Hash received: " << output << std::endl;
-                    logger->writeLn("Hash received: "+string((char *)output));*/
+                        errMsg = "FATAL ERROR: set to store data doesn't exist: " +
+                            databaseAndSet.first + ":" + databaseAndSet.second;
+                        std::cout << errMsg << std::endl;
+                        everythingOK = false;
+                    } else {
+                        std::cout << "sizeOfBytesToAdd is " << sizeOfBytesToAdd << std::endl;
+                        // the bytes of a page that fails are given back to the set
+                        bool added = mySet->addNewBytes(sizeOfBytesToAdd, [&](void* myBytes) {
+                            if (!PageCodec::decompress(
+                                    readToHere, numBytes, (char*)myBytes, sizeOfBytesToAdd)) {
+                                errMsg = "Error: could not decompress a page of " +
+                                    std::to_string(numBytes) + " bytes";
+                                return false;
+                            }
+                            Record<Object>* record = (Record<Object>*)myBytes;
+                            if ((sizeOfBytesToAdd < 2 * sizeof(size_t)) ||
+                                (record->numBytes() > sizeOfBytesToAdd) ||
+                                (record->rootObjectOffset() < 2 * sizeof(size_t)) ||
+                                (record->rootObjectOffset() >= record->numBytes())) {
+                                errMsg = "Error: received a malformed record of " +
+                                    std::to_string(sizeOfBytesToAdd) + " bytes";
+                                return false;
+                            }
 #ifdef DEBUG_SHUFFLING
-                    // write the data to a test file
-                    std::string fileName =
-                      std::string(request->getDatabase()) + "_" + std::string(request->getSetName()) + "_shuffle-received"+std::to_string(counter);
-                    FILE* myFile = fopen(fileName.c_str(), "w");
-                    fwrite(myBytes, 1, sizeOfBytesToAdd, myFile);
-                    fclose(myFile);
+                            // write the data to a test file
+                            std::string fileName =
+                              std::string(request->getDatabase()) + "_" + std::string(request->getSetName()) + "_shuffle-received"+std::to_string(counter);
+                            FILE* myFile = fopen(fileName.c_str(), "w");
+                            fwrite(myBytes, 1, sizeOfBytesToAdd, myFile);
+                            fclose(myFile);
 #endif
-                } else {
+                            return true;
+                        });
+                        if (!added) {
+                            if (errMsg == "") {
+                                errMsg = "FATAL ERROR: can't get bytes from user set " +
+                                    databaseAndSet.second;
+                            }
+                            std::cout << errMsg << std::endl;
+                            everythingOK = false;
+                        }
+                    }
+                } else if (errMsg == "") {
                     errMsg =
                         "Tried to add data of the wrong type to a database set or database set "
                         "doesn't exit.\n";
-                    everythingOK = false;
                 }
-#ifdef ENABLE_COMPRESSION
-                delete[] readToHere;
-#else
-                free(readToHere);
-#endif
+                if (!everythingOK && allStored) {
+                    allStored = false;
+                    storeErrMsg = errMsg;
+                }
+
+                {
+                    const UseTemporaryAllocationBlock block{1024};
+                    Handle<SimpleRequestResult> response =
+                        makeObject<SimpleRequestResult>(everythingOK, errMsg);
+
+                    // return the result
+                    everythingOK = sendUsingMe->sendObject(response, errMsg);
+                }
+                PageCodec::releaseBuffer(readToHere);
                 counter++;
                 numBytes = sendUsingMe->getSizeOfNextObject();
                 if (requestInLoop != nullptr) {
@@ -972,6 +1455,10 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             if (requestInLoop != nullptr) {
                 free(requestInLoop);
             }
+            if (!allStored) {
+                everythingOK = false;
+                errMsg = storeErrMsg;
+            }
             {
                 const UseTemporaryAllocationBlock block{1024};
                 Handle<SimpleRequestResult> response =
@@ -1010,11 +1497,20 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
 #endif
             }
 
+            // the request is counted before the sender hears back, so that the flush of a
+            // shuffle stream also waits for the data that the sender considers as sent
+            auto databaseAndSet = make_pair((std::string)request->getDatabase(),
+                                            (std::string)request->getSetName());
+            getFunctionality<PangeaStorageServer>().receiveShuffleData(databaseAndSet);
+            bool stored = false;
+
             // get the record
             size_t numBytes = sendUsingMe->getSizeOfNextObject();
             bool compressedOrNot = request->isCompressed();
             Handle<Vector<Handle<Object>>> objectsToStore = nullptr;
             char* readToHere = nullptr;
+            size_t recordSize = 0;
+            bool adopted = false;
             if (compressedOrNot == false) {
                 readToHere = (char*)malloc(numBytes);
                 if(readToHere == nullptr) {
@@ -1023,30 +1519,58 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 }
                 objectsToStore = sendUsingMe->getNextObject<Vector<Handle<Object>>>(
                     readToHere, everythingOK, errMsg);
-                std::cout << "received " << objectsToStore->size() << " objects to store " << numBytes << " bytes" << std::endl;
+                recordSize = numBytes;
+                std::cout << "received " << numBytes << " bytes" << std::endl;
             } else {
-                char* temp = new char[numBytes];
-                if(temp == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
-                    exit(1);
-                }
+                char* frame = PageCodec::getBuffer(numBytes);
                 std::cout << "received " << numBytes << " bytes" << std::endl;
-                sendUsingMe->receiveBytes(temp, errMsg);
+                everythingOK = sendUsingMe->receiveBytes(frame, errMsg);
                 size_t uncompressedSize = 0;
-                snappy::GetUncompressedLength(temp, numBytes, &uncompressedSize);
-                readToHere = (char*)malloc(uncompressedSize);
-                if(readToHere == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
-                    exit(1);
+                if (everythingOK) {
+                    uncompressedSize = PageCodec::getPageSize(frame, numBytes);
                 }
-                snappy::RawUncompress(temp, numBytes, (char*)(readToHere));
-                Record<Vector<Handle<Object>>>* myRecord =
-                    (Record<Vector<Handle<Object>>>*)readToHere;
-                objectsToStore = myRecord->getRootObject();
-                delete[] temp;
+                SetPtr mySet = getFunctionality<PangeaStorageServer>().getSet(databaseAndSet);
+                if (everythingOK && uncompressedSize == 0) {
+                    everythingOK = false;
+                    errMsg = "Error: received a malformed page of " + std::to_string(numBytes) +
+                        " bytes";
+                    std::cout << errMsg << std::endl;
+                } else if (everythingOK && request->isDirectPut() == false && mySet != nullptr &&
+                           uncompressedSize >= mySet->getPageSize() * PDB_ADOPT_RECORD_MIN_FILL &&
+                           uncompressedSize <= mySet->getPageSize()) {
+                    // the record will be taken as a page, so decompress it right into the page
+                    getFunctionality<PangeaStorageServer>().beginStoringShuffleData(databaseAndSet);
+                    stored = true;
+                    const LockGuard guard{workingMutex};
+                    everythingOK = getFunctionality<PangeaStorageServer>().adoptCompressedRecord(
+                        databaseAndSet, frame, numBytes, request->isFlushing(), errMsg);
+                    adopted = everythingOK;
+                } else if (everythingOK) {
+                    readToHere = (char*)malloc(uncompressedSize);
+                    if(readToHere == nullptr) {
+                        std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << uncompressedSize << std::endl;
+                        exit(1);
+                    }
+                    everythingOK =
+                        PageCodec::decompress(frame, numBytes, readToHere, uncompressedSize);
+                    recordSize = uncompressedSize;
+                }
+                PageCodec::releaseBuffer(frame);
+            }
+
+            // check the record before anything in it is dereferenced
+            if (adopted) {
+                // adoptCompressedRecord did check it
+            } else if (everythingOK && !isValidRecord((Record<Vector<Handle<Object>>>*)readToHere, recordSize)) {
+                everythingOK = false;
+                errMsg = "Error: received a malformed record of " + std::to_string(recordSize) +
+                    " bytes";
+                std::cout << errMsg << std::endl;
+            } else if (everythingOK) {
+                objectsToStore = ((Record<Vector<Handle<Object>>>*)readToHere)->getRootObject();
             }
 
-            if (objectsToStore->size() == 0) {
+            if (everythingOK && !adopted && objectsToStore->size() == 0) {
                 everythingOK = false;
                 errMsg =
                     "Warning: client attemps to store a vector that contains zero objects, simply "
@@ -1054,6 +1578,15 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 std::cout << errMsg << std::endl;
             }
 
+            // the request is counted before the sender hears back, so that cleaning up waits for
+            // the data that the sender considers as sent
+            bool counted = everythingOK;
+            if (counted) {
+                pthread_mutex_lock(&counterMutex);
+                numWaitingBufferDataRequests++;
+                pthread_mutex_unlock(&counterMutex);
+            }
+
             if (request->isFlushing() == false) {
                 const UseTemporaryAllocationBlock block{1024};
                 Handle<SimpleRequestResult> response =
@@ -1063,14 +1596,13 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 everythingOK = sendUsingMe->sendObject(response, errMsg);
             }
             
-            if (everythingOK) {
-                pthread_mutex_lock(&counterMutex);
-                numWaitingBufferDataRequests++;
-                pthread_mutex_unlock(&counterMutex);
+            if (adopted) {
+                // already stored
+            } else if (everythingOK) {
+                getFunctionality<PangeaStorageServer>().beginStoringShuffleData(databaseAndSet);
+                stored = true;
                 const LockGuard guard{workingMutex};
                 // at this point, we have performed the serialization, so remember the record
-                auto databaseAndSet = make_pair((std::string)request->getDatabase(),
-                                                (std::string)request->getSetName());
                 std::cout << "to store data to " << request->getDatabase() <<
                         ":" << request->getSetName() << std::endl;
                 SetPtr mySet = getFunctionality<PangeaStorageServer>().getSet(databaseAndSet);
@@ -1079,10 +1611,22 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                    exit(1);
                 } 
                 size_t myPageSize = mySet->getPageSize();
-                if (request->isDirectPut() == false) {
+                Record<Vector<Handle<Object>>>* myRecord =
+                    (Record<Vector<Handle<Object>>>*)readToHere;
+                if ((request->isDirectPut() == false) &&
+                    (myRecord->numBytes() >= myPageSize * PDB_ADOPT_RECORD_MIN_FILL) &&
+                    (myRecord->numBytes() <= myPageSize)) {
+
+                    // the sender already laid the objects out as a page, so take the record as
+                    // it is, instead of copying it object by object
+                    getFunctionality<PangeaStorageServer>().adoptRecord(
+                        databaseAndSet, myRecord, request->isFlushing());
+                    free(readToHere);
+
+                } else if (request->isDirectPut() == false) {
 
                     getFunctionality<PangeaStorageServer>().bufferRecord(
-                        databaseAndSet, (Record<Vector<Handle<Object>>>*)readToHere);
+                        databaseAndSet, myRecord);
 
 
                     size_t numBytesToProcess = sizes[databaseAndSet];
@@ -1102,40 +1646,36 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                     }
 
                 } else {
-                    Record<Vector<Handle<Object>>>* myRecord =
-                        (Record<Vector<Handle<Object>>>*)readToHere;
-                    if (myRecord->numBytes() <= myPageSize) {
-                        PDBPagePtr myPage =
-                            getFunctionality<PangeaStorageServer>().getNewPage(databaseAndSet);
-                        // memory copy
-                        memcpy(myPage->getBytes(), readToHere, myRecord->numBytes());
-                        // unpin the page
-                        CacheKey key;
-                        key.dbId = myPage->getDbID();
-                        key.typeId = myPage->getTypeID();
-                        key.setId = myPage->getSetID();
-                        key.pageId = myPage->getPageID();
-                        getFunctionality<PangeaStorageServer>().getCache()->decPageRefCount(key);
-                        if (request->isFlushing() == true) {
-                            getFunctionality<PangeaStorageServer>()
-                                .getCache()
-                                ->flushPageWithoutEviction(key);
-                        }
-                    } else {
+                    if (myRecord->numBytes() > myPageSize ||
+                        !getFunctionality<PangeaStorageServer>().adoptRecord(
+                            databaseAndSet, myRecord, request->isFlushing())) {
                         errMsg = "Tried to directly put larger data than the page, size=" +
                             std::to_string(myRecord->numBytes());
                         std::cout << errMsg << std::endl;
                         everythingOK = false;
                     }
+                    free(readToHere);
+                }
+            } else {
+                if (errMsg == "") {
+                    errMsg =
+                        "Tried to add data of the wrong type to a database set or database set "
+                        "doesn't exit.\n";
                 }
+                everythingOK = false;
+                free(readToHere);
+            }
+            // the scan of a shuffle stream waits for this, even if the data was not stored
+            getFunctionality<PangeaStorageServer>().notifyShuffleStream(
+                databaseAndSet, stored, request->isLastOfStream());
+            if (counted) {
                 pthread_mutex_lock(&counterMutex);
                 numWaitingBufferDataRequests--;
                 pthread_mutex_unlock(&counterMutex);
-            } else {
-                errMsg =
-                    "Tried to add data of the wrong type to a database set or database set doesn't "
-                    "exit.\n";
-                everythingOK = false;
+            }
+            if (everythingOK == true) {
+                getFunctionality<PangeaStorageServer>().bumpSetVersion(request->getDatabase(),
+                                                                       request->getSetName());
             }
             if (request->isFlushing() == true) {  // this is a client query
                 const UseTemporaryAllocationBlock block{1024};
@@ -1144,6 +1684,7 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
 
                 // return the result
                 everythingOK = sendUsingMe->sendObject(response, errMsg);
+                getFunctionality<PangeaStorageServer>().pushStatsToManager();
             }
             return make_pair(everythingOK, errMsg);
         }));
@@ -1224,25 +1765,12 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             std::string errMsg;
             Handle<StorageCollectStatsResponse> response =
                 makeObject<StorageCollectStatsResponse>();
+            long version;
             Handle<Vector<Handle<SetIdentifier>>> stats =
-                makeObject<Vector<Handle<SetIdentifier>>>();
-            // iterate sets
-            for (std::map<std::pair<DatabaseID, SetID>, SetPtr>::iterator it =
-                     this->userSets->begin();
-                 it != this->userSets->end();
-                 ++it) {
-                std::pair<DatabaseID, SetID> idPair = it->first;
-                SetPtr set = it->second;
-                std::string setName = set->getSetName();
-                int numPages = set->getNumPages();
-                DatabaseID dbId = idPair.first;
-                DefaultDatabasePtr db = this->getDatabase(dbId);
-                std::string dbName = db->getDatabaseName();
-                Handle<SetIdentifier> setIdentifier = makeObject<SetIdentifier>(dbName, setName);
-                setIdentifier->setNumPages(numPages);
-                setIdentifier->setPageSize(set->getPageSize());
-                stats->push_back(setIdentifier);
-            }
+                getFunctionality<PangeaStorageServer>().getStatsSince(request->getSinceVersion(),
+                                                                      version);
+            response->setNodeId(this->nodeId);
+            response->setVersion(version);
             response->setStats(stats);
             bool res = sendUsingMe->sendObject<StorageCollectStatsResponse>(response, errMsg);
             return make_pair(res, errMsg);
@@ -1259,6 +1787,8 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 SetID setId = request->getSetID();
                 PageID pageId = request->getPageID();
                 bool wasNewPage = request->getWasNewPage();
+                // allocate the page on the NUMA node of the backend thread that will use it
+                const PreferredNodeGuard nodeGuard{request->getNumaNode()};
 
                 std::cout << "to pin page in set with pageId=" << pageId << ", setId=" << setId << std::endl;
                 bool res;
@@ -1287,7 +1817,7 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 }
 
                 if (page != nullptr) {
-                    logger->debug(
+                    PDB_LOG_DEBUG(logger,
                         std::string("Handling StoragePinPage: page is not null, we build the "
                                     "StoragePagePinned message"));
                     const UseTemporaryAllocationBlock myBlock{2048};
@@ -1299,10 +1829,10 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                     ack->setPageID(page->getPageID());
                     ack->setPageSize(page->getRawSize());
                     ack->setSharedMemOffset(page->getOffset());
-                    logger->debug(
+                    PDB_LOG_DEBUG(logger,
                         std::string("Handling StoragePinPage: to send StoragePagePinned message"));
                     res = sendUsingMe->sendObject<StoragePagePinned>(ack, errMsg);
-                    logger->debug(
+                    PDB_LOG_DEBUG(logger,
                         std::string("Handling StoragePinPage: sent StoragePagePinned message"));
                 } else {
                     res = false;
@@ -1413,15 +1943,26 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
 #endif
                 res = true;
             }
+            if ((res == true) && (request->getWasDirty() == true) &&
+                ((dbId != 0) || (typeId != 0))) {
+                // a page of a user set was written by the backend, e.g. a pipeline output
+                SetPtr set = getFunctionality<PangeaStorageServer>().getSet(dbId, typeId, setId);
+                DefaultDatabasePtr db = getFunctionality<PangeaStorageServer>().getDatabase(dbId);
+                if ((set != nullptr) && (db != nullptr)) {
+                    getFunctionality<PangeaStorageServer>().bumpSetVersion(db->getDatabaseName(),
+                                                                           set->getSetName());
+                    getFunctionality<PangeaStorageServer>().pushStatsToManager();
+                }
+            }
 
-            logger->debug(std::string("Making response object.\n"));
+            PDB_LOG_DEBUG(logger, std::string("Making response object.\n"));
             const UseTemporaryAllocationBlock block{1024};
             Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
 
             // return the result
-            logger->debug(std::string("Sending response object.\n"));
+            PDB_LOG_DEBUG(logger, std::string("Sending response object.\n"));
             res = sendUsingMe->sendObject(response, errMsg);
-            logger->debug(std::string("response sent for StorageUnpinPage.\n"));
+            PDB_LOG_DEBUG(logger, std::string("response sent for StorageUnpinPage.\n"));
 
             return make_pair(res, errMsg);
 
@@ -1450,37 +1991,128 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 return make_pair(res, errMsg);
             }
 
+            std::pair<std::string, std::string> databaseAndSet;
+            DefaultDatabasePtr db = getFunctionality<PangeaStorageServer>().getDatabase(dbId);
+            if (db != nullptr) {
+                databaseAndSet = make_pair(db->getDatabaseName(), set->getSetName());
+            }
+
             // use frontend iterators: one iterator for in-memory dirty pages, and one iterator for
             // each file partition
-            std::vector<PageIteratorPtr>* iterators = set->getIterators();
-            getFunctionality<PangeaStorageServer>().getCache()->pin(set, set->getReplacementPolicy(), Read);
+            auto scanSet = [&](std::function<bool(PDBPagePtr)> skipPage, bool blockAdds) {
+                // the workers are taken before adding data to the set is blocked, since the
+                // handlers that wait to add data hold workers themselves; there is at most one
+                // iterator for the dirty pages and one for each partition
+                std::vector<PDBWorkerPtr> workers;
+                if (blockAdds) {
+                    int maxIterators = std::max((int)set->getFile()->getNumPartitions(), 1) + 1;
+                    for (int i = 0; i < maxIterators; i++) {
+                        workers.push_back(getFunctionality<PangeaStorageServer>().getWorker());
+                    }
+                    getFunctionality<PangeaStorageServer>().beginShuffleScan(databaseAndSet);
+                }
 
-            set->setPinned(true);
-            int numIterators = iterators->size();
+                std::vector<PageIteratorPtr>* iterators = set->getIterators();
+                getFunctionality<PangeaStorageServer>().getCache()->pin(
+                    set, set->getReplacementPolicy(), Read);
+
+                set->setPinned(true);
+                int numIterators = iterators->size();
+
+                std::cout << "GetSetPages iterators:" << numIterators << std::endl;
+
+                PDBBuzzerPtr tempBuzzer =
+                    make_shared<PDBBuzzer>([](PDBAlarm myAlarm, atomic_int& counter) {
+                        counter++;
+                        std::cout << "GetSetPages: counter = " << counter << std::endl;
+                    });
+
+                // scan pages and load pages in a multi-threaded style
+
+                atomic_int counter;
+                counter = 0;
+                for (int i = 0; i < numIterators; i++) {
+                    PDBWorkerPtr worker = (i < (int)workers.size())
+                        ? workers[i]
+                        : getFunctionality<PangeaStorageServer>().getWorker();
+                    PDBScanWorkPtr scanWork =
+                        make_shared<PDBScanWork>(iterators->at(i),
+                                                 &getFunctionality<PangeaStorageServer>(),
+                                                 counter,
+                                                 skipPage);
+                    worker->execute(scanWork, tempBuzzer);
+                }
 
-            std::cout<<"GetSetPages iterators:" << numIterators << std::endl;
+                while (counter < numIterators) {
+                    tempBuzzer->wait();
+                }
+                set->setPinned(false);
+                delete iterators;
+                if (blockAdds) {
+                    getFunctionality<PangeaStorageServer>().endShuffleScan(databaseAndSet);
+                }
 
-            PDBBuzzerPtr tempBuzzer = make_shared<PDBBuzzer>([](PDBAlarm myAlarm, atomic_int& counter) {
-                counter++;
-                std::cout << "GetSetPages: counter = " << counter << std::endl;
-            });
-
-            // scan pages and load pages in a multi-threaded style
-
-            atomic_int counter;
-            counter = 0;
-            for (int i = 0; i < numIterators; i++) {
-                PDBWorkerPtr worker = getFunctionality<PangeaStorageServer>().getWorker();
-                PDBScanWorkPtr scanWork = make_shared<PDBScanWork>(
-                    iterators->at(i), &getFunctionality<PangeaStorageServer>(), counter);
-                worker->execute(scanWork, tempBuzzer);
-            }
+                // give back the workers that were not needed
+                for (int i = numIterators; i < (int)workers.size(); i++) {
+                    workers[i]->execute(make_shared<GenericWork>([](PDBBuzzerPtr callerBuzzer) {
+                                            callerBuzzer->buzz(PDBAlarm::WorkAllDone);
+                                        }),
+                                        make_shared<PDBBuzzer>(nullptr));
+                }
+            };
 
-            while (counter < numIterators) {
-                tempBuzzer->wait();
+            if ((db == nullptr) ||
+                !getFunctionality<PangeaStorageServer>().isShuffleStream(databaseAndSet)) {
+                scanSet(nullptr, false);
+            } else {
+                // the producers are still adding data to the set, so we scan it in rounds, each
+                // round sending the pages added since the previous one, until every producer has
+                // sent its last data; no data is stored to the set while a round runs, and if the
+                // producers do not all end in time, the scan fails instead of missing their data
+                std::unordered_set<PageID> sentPages;
+                pthread_mutex_t sentPagesMutex;
+                pthread_mutex_init(&sentPagesMutex, nullptr);
+                auto skipSentPage = [&](PDBPagePtr page) {
+                    pthread_mutex_lock(&sentPagesMutex);
+                    bool sent = (sentPages.insert(page->getPageID()).second == false);
+                    pthread_mutex_unlock(&sentPagesMutex);
+                    if (sent) {
+                        CacheKey key;
+                        key.dbId = page->getDbID();
+                        key.typeId = page->getTypeID();
+                        key.setId = page->getSetID();
+                        key.pageId = page->getPageID();
+                        getFunctionality<PangeaStorageServer>().getCache()->decPageRefCount(key);
+                    }
+                    return sent;
+                };
+
+                // so that the first round starts right away
+                long numAdds = -1;
+                bool lastRound = false;
+                bool timedOut = false;
+                while (lastRound == false) {
+                    lastRound = getFunctionality<PangeaStorageServer>().waitForShuffleData(
+                        databaseAndSet, numAdds, timedOut);
+                    if (timedOut) {
+                        res = false;
+                        errMsg = "Error: the producers of the shuffle stream of " +
+                            databaseAndSet.first + ":" + databaseAndSet.second +
+                            " did not all finish";
+                        std::cout << errMsg << std::endl;
+                        break;
+                    }
+                    if (lastRound) {
+                        getFunctionality<PangeaStorageServer>().flushShuffleStream(databaseAndSet);
+                    }
+                    std::cout << "GetSetPages: scan the shuffle stream of " << databaseAndSet.first
+                              << ":" << databaseAndSet.second << " after " << numAdds
+                              << " additions" << std::endl;
+                    scanSet(skipSentPage, true);
+                }
+                getFunctionality<PangeaStorageServer>().closeShuffleStream(databaseAndSet);
+                pthread_mutex_destroy(&sentPagesMutex);
             }
-            set->setPinned(false);
-            delete iterators;
 
             // here, we have already loaded all pages, and sent all information about those pages to
             // the other side, now we need inform the other side that this process has been done.
@@ -1497,8 +2129,12 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             }
 
             UseTemporaryAllocationBlock myBlock{1024};
-            Handle<StorageNoMorePage> noMorePage = makeObject<StorageNoMorePage>();
-            if (!communicatorToBackEnd->sendObject<StorageNoMorePage>(noMorePage, errMsg)) {
+            Handle<StorageNoMorePage> noMorePage =
+                makeObject<StorageNoMorePage>(dbId, typeId, setId);
+            noMorePage->setComplete(res);
+            std::string sendErrMsg;
+            if (!communicatorToBackEnd->sendObject<StorageNoMorePage>(noMorePage, sendErrMsg)) {
+                errMsg = sendErrMsg;
                 res = false;
                 std::cout << errMsg << std::endl;
                 return make_pair(res, errMsg);
@@ -1657,7 +2293,17 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
 
 // Returns ipc path to backend
 string PangeaStorageServer::getPathToBackEndServer() {
-    return this->pathToBackEndServer;
+    pthread_mutex_lock(&backEndPathMutex);
+    string path = this->pathToBackEndServer;
+    pthread_mutex_unlock(&backEndPathMutex);
+    return path;
+}
+
+// Points to a new backend
+void PangeaStorageServer::setPathToBackEndServer(string path) {
+    pthread_mutex_lock(&backEndPathMutex);
+    this->pathToBackEndServer = path;
+    pthread_mutex_unlock(&backEndPathMutex);
 }
 
 // Returns server name
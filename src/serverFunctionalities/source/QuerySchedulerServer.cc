@@ -4,6 +4,8 @@
 #include "PDBDebug.h"
 #include "InterfaceFunctions.h"
 #include "QuerySchedulerServer.h"
+#include "CatalogClient.h"
+#include "DispatcherServer.h"
 #include "DistributedStorageManagerClient.h"
 #include "DistributedStorageManagerServer.h"
 #include "QueryOutput.h"
@@ -42,12 +44,14 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <chrono>
+#include <algorithm>
 #include <fcntl.h>
 
 namespace pdb {
 
 QuerySchedulerServer::~QuerySchedulerServer() {
     pthread_mutex_destroy(&connection_mutex);
+    pthread_mutex_destroy(&statsMutex);
 }
 
 QuerySchedulerServer::QuerySchedulerServer(PDBLoggerPtr logger,
@@ -62,6 +66,7 @@ QuerySchedulerServer::QuerySchedulerServer(PDBLoggerPtr logger,
     this->conf = conf;
     this->pseudoClusterMode = pseudoClusterMode;
     pthread_mutex_init(&connection_mutex, nullptr);
+    pthread_mutex_init(&statsMutex, nullptr);
     this->jobStageId = 0;
     this->partitionToCoreRatio = partitionToCoreRatio;
     this->dynamicPlanningOrNot = isDynamicPlanning;
@@ -69,6 +74,7 @@ QuerySchedulerServer::QuerySchedulerServer(PDBLoggerPtr logger,
     this->statsForOptimization = nullptr;
     this->initializeStats();
     this->selfLearningOrNot = selfLearningOrNot;
+    this->resultCachingOrNot = (conf != nullptr) && (conf->getResultCaching() == true);
 }
 
 
@@ -85,6 +91,7 @@ QuerySchedulerServer::QuerySchedulerServer(int port,
     this->conf = conf;
     this->pseudoClusterMode = pseudoClusterMode;
     pthread_mutex_init(&connection_mutex, nullptr);
+    pthread_mutex_init(&statsMutex, nullptr);
     this->jobStageId = 0;
     this->partitionToCoreRatio = partitionToCoreRatio;
     this->dynamicPlanningOrNot = isDynamicPlanning;
@@ -92,6 +99,7 @@ QuerySchedulerServer::QuerySchedulerServer(int port,
     this->statsForOptimization = nullptr;
     this->initializeStats();
     this->selfLearningOrNot = selfLearningOrNot;
+    this->resultCachingOrNot = (conf != nullptr) && (conf->getResultCaching() == true);
 }
 
 void QuerySchedulerServer::cleanup() {
@@ -135,6 +143,8 @@ QuerySchedulerServer::QuerySchedulerServer(std::string resourceManagerIp,
     this->statsForOptimization = nullptr;
     this->initializeStats();
     this->selfLearningOrNot = selfLearningOrNot;
+    this->resultCachingOrNot = (conf != nullptr) && (conf->getResultCaching() == true);
+    pthread_mutex_init(&statsMutex, nullptr);
 }
 
 void QuerySchedulerServer::initialize(bool isRMRunAsServer) {
@@ -212,6 +222,72 @@ StatisticsPtr QuerySchedulerServer::getStats() {
     return statsForOptimization;
 }
 
+void QuerySchedulerServer::addStageProfile(JobStageID stageId,
+                                           std::string stageType,
+                                           int index,
+                                           std::string profile) {
+    pthread_mutex_lock(&connection_mutex);
+    stageTypes[stageId] = stageType;
+    ExecutionProfiler::merge(profile, stageProfiles[stageId][index]);
+    pthread_mutex_unlock(&connection_mutex);
+}
+
+std::string QuerySchedulerServer::getJobProfile() {
+    std::string report = "EXPLAIN ANALYZE " + this->jobId + "\n";
+    pthread_mutex_lock(&connection_mutex);
+    for (auto& stage : stageProfiles) {
+        std::map<std::string, OperatorProfile> total;
+        int slowestNode = -1;
+        long slowestNanos = -1;
+        for (auto& node : stage.second) {
+            long nodeNanos = 0;
+            for (auto& op : node.second) {
+                OperatorProfile& sum = total[op.first];
+                sum.numCalls += op.second.numCalls;
+                sum.nanos += op.second.nanos;
+                sum.rowsIn += op.second.rowsIn;
+                sum.rowsOut += op.second.rowsOut;
+                sum.bytes += op.second.bytes;
+                sum.count += op.second.count;
+                nodeNanos += op.second.nanos;
+            }
+            if (nodeNanos > slowestNanos) {
+                slowestNanos = nodeNanos;
+                slowestNode = node.first;
+            }
+        }
+        report += "stage " + std::to_string(stage.first) + ": " + stageTypes[stage.first] +
+            " on " + std::to_string(stage.second.size()) + " nodes, slowest is node " +
+            std::to_string(slowestNode) + " with " + std::to_string(slowestNanos / 1000000) +
+            "ms in operators\n";
+        report += ExecutionProfiler::format(total, "    ");
+    }
+    pthread_mutex_unlock(&connection_mutex);
+    return report;
+}
+
+bool QuerySchedulerServer::canPipelineWithNextStage(
+    std::vector<Handle<AbstractJobStage>>& stagesToSchedule, int i) {
+    if ((PDB_PIPELINE_SHUFFLE_AGGREGATION == false) ||
+        (i + 1 >= (int)stagesToSchedule.size()) ||
+        (stagesToSchedule[i]->getJobStageType() != "TupleSetJobStage") ||
+        (stagesToSchedule[i + 1]->getJobStageType() != "AggregationJobStage")) {
+        return false;
+    }
+    Handle<TupleSetJobStage> producer =
+        unsafeCast<TupleSetJobStage, AbstractJobStage>(stagesToSchedule[i]);
+    Handle<AggregationJobStage> consumer =
+        unsafeCast<AggregationJobStage, AbstractJobStage>(stagesToSchedule[i + 1]);
+    if (!producer->isRepartition() || !producer->isCombining() ||
+        producer->isRepartitionJoin() || producer->isBroadcasting()) {
+        return false;
+    }
+    Handle<SetIdentifier> sink = producer->getSinkContext();
+    Handle<SetIdentifier> source = consumer->getSourceContext();
+    return (sink->getDatabase() == source->getDatabase()) &&
+        (sink->getSetName() == source->getSetName());
+}
+
 // to schedule dynamic pipeline stages
 // this must be invoked after initialize() and before cleanup()
 void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>& stagesToSchedule,
@@ -225,6 +301,119 @@ void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>&
         PDB_COUT << "counter = " << counter << std::endl;
     });
 
+    // an aggregation stage that is dispatched together with the shuffle stage before it, and the
+    // number of nodes where it is done
+    int pipelinedStage = -1;
+    atomic_int pipelinedCounter;
+    pipelinedCounter = 0;
+    PDBBuzzerPtr pipelinedBuzzer =
+        make_shared<PDBBuzzer>([&](PDBAlarm myAlarm, atomic_int& counter) {
+            counter++;
+            PDB_COUT << "pipelined counter = " << counter << std::endl;
+        });
+
+    // dispatches the i-th stage to all nodes, each of which buzzes when it is done
+    auto dispatchStage = [&](int i, atomic_int& counter, PDBBuzzerPtr tempBuzzer) {
+        for (int j = 0; j < shuffleInfo->getNumNodes(); j++) {
+            PDBWorkerPtr myWorker = getWorker();
+            PDBWorkPtr myWork = make_shared<GenericWork>([&, i, j, stagesToSchedule](PDBBuzzerPtr callerBuzzer) {
+#ifdef PROFILING
+                auto scheduleBegin = std::chrono::high_resolution_clock::now();
+#endif
+
+
+                const UseTemporaryAllocationBlock block(256 * 1024 * 1024);
+
+
+                int port = (*(this->standardResources))[j]->getPort();
+                PDB_COUT << "port:" << port << std::endl;
+                std::string ip = (*(this->standardResources))[j]->getAddress();
+                PDB_COUT << "ip:" << ip << std::endl;
+                size_t memory = (*(this->standardResources))[j]->getMemSize();
+                // create PDBCommunicator
+                pthread_mutex_lock(&connection_mutex);
+                PDB_COUT << "to connect to the remote node" << std::endl;
+                PDBCommunicatorPtr communicator = std::make_shared<PDBCommunicator>();
+
+                string errMsg;
+                bool success;
+                if (communicator->connectToInternetServer(logger, port, ip, errMsg)) {
+                    success = false;
+                    std::cout << errMsg << std::endl;
+                    pthread_mutex_unlock(&connection_mutex);
+                    callerBuzzer->buzz(PDBAlarm::GenericError, counter);
+                    return;
+                }
+                pthread_mutex_unlock(&connection_mutex);
+
+                // get current stage to schedule
+                Handle<AbstractJobStage> stage = stagesToSchedule[i];
+
+                // schedule the stage
+                if (stage->getJobStageType() == "TupleSetJobStage") {
+                    Handle<TupleSetJobStage> tupleSetStage =
+                        unsafeCast<TupleSetJobStage, AbstractJobStage>(stage);
+                    tupleSetStage->setTotalMemoryOnThisNode(memory);
+                    success = scheduleStage(j, tupleSetStage, communicator, DeepCopy);
+                } else if (stage->getJobStageType() == "AggregationJobStage") {
+                    Handle<AggregationJobStage> aggStage =
+                        unsafeCast<AggregationJobStage, AbstractJobStage>(stage);
+                    int numPartitionsOnThisNode =
+                        (int)((double)(standardResources->at(j)->getNumCores()) *
+                              partitionToCoreRatio);
+                    if (numPartitionsOnThisNode == 0) {
+                        numPartitionsOnThisNode = 1;
+                    }
+                    aggStage->setNumNodePartitions(numPartitionsOnThisNode);
+                    aggStage->setAggTotalPartitions(shuffleInfo->getNumHashPartitions());
+                    aggStage->setAggBatchSize(DEFAULT_BATCH_SIZE);
+                    aggStage->setTotalMemoryOnThisNode(memory);
+                    success = scheduleStage(j, aggStage, communicator, DeepCopy);
+                } else if (stage->getJobStageType() == "BroadcastJoinBuildHTJobStage") {
+                    Handle<BroadcastJoinBuildHTJobStage> broadcastJoinStage =
+                        unsafeCast<BroadcastJoinBuildHTJobStage, AbstractJobStage>(stage);
+                    broadcastJoinStage->setTotalMemoryOnThisNode(memory);
+                    success = scheduleStage(j, broadcastJoinStage, communicator, DeepCopy);
+                } else if (stage->getJobStageType() == "HashPartitionedJoinBuildHTJobStage") {
+                    Handle<HashPartitionedJoinBuildHTJobStage> hashPartitionedJoinStage =
+                        unsafeCast<HashPartitionedJoinBuildHTJobStage, AbstractJobStage>(stage);
+                    int numPartitionsOnThisNode =
+                        (int)((double)(standardResources->at(j)->getNumCores()) *
+                              partitionToCoreRatio);
+                    if (numPartitionsOnThisNode == 0) {
+                        numPartitionsOnThisNode = 1;
+                    }
+                    hashPartitionedJoinStage->setNumNodePartitions(numPartitionsOnThisNode);
+                    hashPartitionedJoinStage->setTotalMemoryOnThisNode(memory);
+                    success = scheduleStage(j, hashPartitionedJoinStage, communicator, DeepCopy);
+                } else {
+                    errMsg = "Unrecognized job stage";
+                    std::cout << errMsg << std::endl;
+                    success = false;
+                }
+#ifdef PROFILING
+                auto scheduleEnd = std::chrono::high_resolution_clock::now();
+                std::cout << "Time Duration for Scheduling stage-" << stage->getStageId() << " on "
+                          << ip << ":"
+                          << std::chrono::duration_cast<std::chrono::duration<float>>(scheduleEnd -
+                                                                                      scheduleBegin)
+                                 .count()
+                          << " seconds." << std::endl;
+#endif
+                if (success == false) {
+                    errMsg = std::string("Can't execute the ") + std::to_string(i) +
+                        std::string("-th stage on the ") + std::to_string(j) +
+                        std::string("-th node");
+                    std::cout << errMsg << std::endl;
+                    callerBuzzer->buzz(PDBAlarm::GenericError, counter);
+                    return;
+                }
+                callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
+            });
+            myWorker->execute(myWork, tempBuzzer);
+        }
+    };
+
     int numStages = stagesToSchedule.size();
 
     for (int i = 0; i < numStages; i++) {
@@ -489,107 +678,28 @@ void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>&
         }
 
 
-        this->numHashKeys = 0;
-        for (int j = 0; j < shuffleInfo->getNumNodes(); j++) {
-            PDBWorkerPtr myWorker = getWorker();
-            PDBWorkPtr myWork = make_shared<GenericWork>([&, i, j, stagesToSchedule](PDBBuzzerPtr callerBuzzer) {
-#ifdef PROFILING
-                auto scheduleBegin = std::chrono::high_resolution_clock::now();
-#endif
-
-
-                const UseTemporaryAllocationBlock block(256 * 1024 * 1024);
-
-
-                int port = (*(this->standardResources))[j]->getPort();
-                PDB_COUT << "port:" << port << std::endl;
-                std::string ip = (*(this->standardResources))[j]->getAddress();
-                PDB_COUT << "ip:" << ip << std::endl;
-                size_t memory = (*(this->standardResources))[j]->getMemSize();
-                // create PDBCommunicator
-                pthread_mutex_lock(&connection_mutex);
-                PDB_COUT << "to connect to the remote node" << std::endl;
-                PDBCommunicatorPtr communicator = std::make_shared<PDBCommunicator>();
-
-                string errMsg;
-                bool success;
-                if (communicator->connectToInternetServer(logger, port, ip, errMsg)) {
-                    success = false;
-                    std::cout << errMsg << std::endl;
-                    pthread_mutex_unlock(&connection_mutex);
-                    callerBuzzer->buzz(PDBAlarm::GenericError, counter);
-                    return;
-                }
-                pthread_mutex_unlock(&connection_mutex);
-
-                // get current stage to schedule
-                Handle<AbstractJobStage> stage = stagesToSchedule[i];
-
-                // schedule the stage
-                if (stage->getJobStageType() == "TupleSetJobStage") {
-                    Handle<TupleSetJobStage> tupleSetStage =
-                        unsafeCast<TupleSetJobStage, AbstractJobStage>(stage);
-                    tupleSetStage->setTotalMemoryOnThisNode(memory);
-                    success = scheduleStage(j, tupleSetStage, communicator, DeepCopy);
-                } else if (stage->getJobStageType() == "AggregationJobStage") {
-                    Handle<AggregationJobStage> aggStage =
-                        unsafeCast<AggregationJobStage, AbstractJobStage>(stage);
-                    int numPartitionsOnThisNode =
-                        (int)((double)(standardResources->at(j)->getNumCores()) *
-                              partitionToCoreRatio);
-                    if (numPartitionsOnThisNode == 0) {
-                        numPartitionsOnThisNode = 1;
-                    }
-                    aggStage->setNumNodePartitions(numPartitionsOnThisNode);
-                    aggStage->setAggTotalPartitions(shuffleInfo->getNumHashPartitions());
-                    aggStage->setAggBatchSize(DEFAULT_BATCH_SIZE);
-                    aggStage->setTotalMemoryOnThisNode(memory);
-                    success = scheduleStage(j, aggStage, communicator, DeepCopy);
-                } else if (stage->getJobStageType() == "BroadcastJoinBuildHTJobStage") {
-                    Handle<BroadcastJoinBuildHTJobStage> broadcastJoinStage =
-                        unsafeCast<BroadcastJoinBuildHTJobStage, AbstractJobStage>(stage);
-                    broadcastJoinStage->setTotalMemoryOnThisNode(memory);
-                    success = scheduleStage(j, broadcastJoinStage, communicator, DeepCopy);
-                } else if (stage->getJobStageType() == "HashPartitionedJoinBuildHTJobStage") {
-                    Handle<HashPartitionedJoinBuildHTJobStage> hashPartitionedJoinStage =
-                        unsafeCast<HashPartitionedJoinBuildHTJobStage, AbstractJobStage>(stage);
-                    int numPartitionsOnThisNode =
-                        (int)((double)(standardResources->at(j)->getNumCores()) *
-                              partitionToCoreRatio);
-                    if (numPartitionsOnThisNode == 0) {
-                        numPartitionsOnThisNode = 1;
-                    }
-                    hashPartitionedJoinStage->setNumNodePartitions(numPartitionsOnThisNode);
-                    hashPartitionedJoinStage->setTotalMemoryOnThisNode(memory);
-                    success = scheduleStage(j, hashPartitionedJoinStage, communicator, DeepCopy);
-                } else {
-                    errMsg = "Unrecognized job stage";
-                    std::cout << errMsg << std::endl;
-                    success = false;
-                }
-#ifdef PROFILING
-                auto scheduleEnd = std::chrono::high_resolution_clock::now();
-                std::cout << "Time Duration for Scheduling stage-" << stage->getStageId() << " on "
-                          << ip << ":"
-                          << std::chrono::duration_cast<std::chrono::duration<float>>(scheduleEnd -
-                                                                                      scheduleBegin)
-                                 .count()
-                          << " seconds." << std::endl;
-#endif
-                if (success == false) {
-                    errMsg = std::string("Can't execute the ") + std::to_string(i) +
-                        std::string("-th stage on the ") + std::to_string(j) +
-                        std::string("-th node");
-                    std::cout << errMsg << std::endl;
-                    callerBuzzer->buzz(PDBAlarm::GenericError, counter);
-                    return;
-                }
-                callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
-            });
-            myWorker->execute(myWork, tempBuzzer);
-        }
-        while (counter < shuffleInfo->getNumNodes()) {
-            tempBuzzer->wait();
+        if (i == pipelinedStage) {
+            // it was dispatched with the stage before it
+            while (pipelinedCounter < shuffleInfo->getNumNodes()) {
+                pipelinedBuzzer->wait();
+            }
+        } else {
+            this->numHashKeys = 0;
+            if (canPipelineWithNextStage(stagesToSchedule, i)) {
+                // the aggregation stage is dispatched first, so that it is waiting for the
+                // shuffled data when the shuffle stage starts to send it
+                pipelinedStage = i + 1;
+                pipelinedCounter = 0;
+                unsafeCast<TupleSetJobStage, AbstractJobStage>(stagesToSchedule[i])
+                    ->setPipelinedWithConsumer(true);
+                unsafeCast<AggregationJobStage, AbstractJobStage>(stagesToSchedule[i + 1])
+                    ->setNumProducers(shuffleInfo->getNumNodes());
+                dispatchStage(i + 1, pipelinedCounter, pipelinedBuzzer);
+            }
+            dispatchStage(i, counter, tempBuzzer);
+            while (counter < shuffleInfo->getNumNodes()) {
+                tempBuzzer->wait();
+            }
         }
         counter = 0;
         if (selfLearningOrNot == true) {
@@ -597,7 +707,8 @@ void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>&
               getFunctionality<SelfLearningServer>().updateJobStageForCompletion(jobInstanceStageId, "Succeeded");
 
               std::cout << "****NumHashKeys = " << numHashKeys << std::endl;
-              if (numHashKeys > 0) {
+              // the keys counted while a shuffle stage runs belong to the aggregation after it
+              if ((numHashKeys > 0) && (pipelinedStage != i + 1)) {
                   getFunctionality<SelfLearningServer>().updateJobStageForKeyDistribution(jobInstanceStageId-1, numHashKeys);
               }
         }
@@ -646,6 +757,9 @@ bool QuerySchedulerServer::scheduleStage(int index,
         }
         stageToSend->setIPAddresses(addresses);
         stageToSend->setNodeId(index);
+        if (stageToSend->getShuffleCodec() == "" && conf != nullptr) {
+            stageToSend->setShuffleCodec(conf->getShuffleCodec());
+        }
         success = communicator->sendObject<TupleSetJobStage>(stageToSend, errMsg);
         if (!success) {
             std::cout << errMsg << std::endl;
@@ -658,9 +772,16 @@ bool QuerySchedulerServer::scheduleStage(int index,
     }
     PDB_COUT << "to receive query response from the " << index << "-th remote node" << std::endl;
     Handle<SetIdentifier> result = communicator->getNextObject<SetIdentifier>(success, errMsg);
+    if ((result != nullptr) && (result->isFailed() == true)) {
+        std::cout << "TupleSetJobStage execute failure on the " << index
+                  << "-th remote node: " << result->getErrMsg() << std::endl;
+        return false;
+    }
     if (result != nullptr) {
         std::cout << "//////////update stats for TupleSetJobStage" << std::endl; 
-        this->updateStats(result);
+        this->updateStats(result, index);
+        this->addStageProfile(
+            stage->getStageId(), stage->getJobStageType(), index, result->getProfile());
         PDB_COUT << "TupleSetJobStage execute: wrote set:" << result->getDatabase() << ":"
                  << result->getSetName() << std::endl;
     } else {
@@ -702,8 +823,15 @@ bool QuerySchedulerServer::scheduleStage(int index,
     }
     PDB_COUT << "to receive query response from the " << index << "-th remote node" << std::endl;
     Handle<SetIdentifier> result = communicator->getNextObject<SetIdentifier>(success, errMsg);
+    if ((result != nullptr) && (result->isFailed() == true)) {
+        std::cout << "BroadcastJoinBuildHTJobStage execute failure on the " << index
+                  << "-th remote node: " << result->getErrMsg() << std::endl;
+        return false;
+    }
     if (result != nullptr) {
-        this->updateStats(result);
+        this->updateStats(result, index);
+        this->addStageProfile(
+            stage->getStageId(), stage->getJobStageType(), index, result->getProfile());
         PDB_COUT << "BroadcastJoinBuildHTJobStage execute: wrote set:" << result->getDatabase()
                  << ":" << result->getSetName() << std::endl;
     } else {
@@ -744,8 +872,15 @@ bool QuerySchedulerServer::scheduleStage(int index,
     }
     PDB_COUT << "to receive query response from the " << index << "-th remote node" << std::endl;
     Handle<SetIdentifier> result = communicator->getNextObject<SetIdentifier>(success, errMsg);
+    if ((result != nullptr) && (result->isFailed() == true)) {
+        std::cout << "AggregationJobStage execute failure on the " << index
+                  << "-th remote node: " << result->getErrMsg() << std::endl;
+        return false;
+    }
     if (result != nullptr) {
-        this->updateStats(result);
+        this->updateStats(result, index);
+        this->addStageProfile(
+            stage->getStageId(), stage->getJobStageType(), index, result->getProfile());
         pthread_mutex_lock(&connection_mutex);
         this->numHashKeys += result->getNumHashKeys();
         std::cout << "***result->getNumHashKeys()=" << result->getNumHashKeys() << std::endl;
@@ -792,8 +927,15 @@ bool QuerySchedulerServer::scheduleStage(int index,
     }
     PDB_COUT << "to receive query response from the " << index << "-th remote node" << std::endl;
     Handle<SetIdentifier> result = communicator->getNextObject<SetIdentifier>(success, errMsg);
+    if ((result != nullptr) && (result->isFailed() == true)) {
+        std::cout << "HashPartitionedJoinBuildHTJobStage execute failure on the " << index
+                  << "-th remote node: " << result->getErrMsg() << std::endl;
+        return false;
+    }
     if (result != nullptr) {
-        this->updateStats(result);
+        this->updateStats(result, index);
+        this->addStageProfile(
+            stage->getStageId(), stage->getJobStageType(), index, result->getProfile());
         pthread_mutex_lock(&connection_mutex);
         this->numHashKeys += result->getNumHashKeys();
         std::cout << "***result->getNumHashKeys()=" << result->getNumHashKeys() << std::endl;
@@ -854,11 +996,19 @@ void QuerySchedulerServer::scheduleQuery() {
 
 
 
-void QuerySchedulerServer::collectStats() {
-    this->statsForOptimization = make_shared<Statistics>();
+// collects stats from all storage nodes; each node only returns the sets that changed since
+// the version we last applied from it, so this is cheap after the first call
+bool QuerySchedulerServer::collectStats() {
+    if (this->statsForOptimization == nullptr) {
+        this->statsForOptimization = make_shared<Statistics>();
+    }
     atomic_int counter;
     counter = 0;
+    std::atomic<bool> allCollected{true};
     PDBBuzzerPtr tempBuzzer = make_shared<PDBBuzzer>([&](PDBAlarm myAlarm, atomic_int& counter) {
+        if (myAlarm == PDBAlarm::GenericError) {
+            allCollected = false;
+        }
         counter++;
         PDB_COUT << "counter = " << counter << std::endl;
     });
@@ -893,7 +1043,15 @@ void QuerySchedulerServer::collectStats() {
             pthread_mutex_unlock(&connection_mutex);
 
             // send StorageCollectStats to remote server
-            Handle<StorageCollectStats> collectStatsMsg = makeObject<StorageCollectStats>();
+            long sinceVersion = 0;
+            NodeID nodeId = (*(this->standardResources))[i]->getNodeId();
+            pthread_mutex_lock(&statsMutex);
+            if (nodeStatsVersions.count(nodeId) > 0) {
+                sinceVersion = nodeStatsVersions[nodeId];
+            }
+            pthread_mutex_unlock(&statsMutex);
+            Handle<StorageCollectStats> collectStatsMsg =
+                makeObject<StorageCollectStats>(sinceVersion);
             success = communicator->sendObject<StorageCollectStats>(collectStatsMsg, errMsg);
             if (!success) {
                 std::cout << errMsg << std::endl;
@@ -906,14 +1064,7 @@ void QuerySchedulerServer::collectStats() {
                 communicator->getNextObject<StorageCollectStatsResponse>(success, errMsg);
             if (result != nullptr) {
                 // update stats
-                Handle<Vector<Handle<SetIdentifier>>> stats = result->getStats();
-                if (statsForOptimization == nullptr) {
-                    statsForOptimization = make_shared<Statistics>();
-                }
-                for (int j = 0; j < stats->size(); j++) {
-                    Handle<SetIdentifier> setToUpdateStats = (*stats)[j];
-                    this->updateStats(setToUpdateStats);
-                }
+                this->applyNodeStats(result->getNodeId(), result->getVersion(), result->getStats());
 
             } else {
                 errMsg = "Collect response execute failure: can't get results";
@@ -938,6 +1089,7 @@ void QuerySchedulerServer::collectStats() {
         tempBuzzer->wait();
     }
     counter = 0;
+    return allCollected;
 }
 
 void QuerySchedulerServer::updateStats(Handle<SetIdentifier> setToUpdateStats) {
@@ -953,6 +1105,76 @@ void QuerySchedulerServer::updateStats(Handle<SetIdentifier> setToUpdateStats) {
     std::cout << "to increment " << numBytes << " for size" << std::endl;    
 }
 
+void QuerySchedulerServer::applyNodeStats(NodeID nodeId,
+                                          long version,
+                                          Handle<Vector<Handle<SetIdentifier>>> stats) {
+    const LockGuard guard{statsMutex};
+    if ((nodeStatsVersions.count(nodeId) > 0) && (nodeStatsVersions[nodeId] >= version)) {
+        // we have already seen this version
+        return;
+    }
+    for (int j = 0; j < stats->size(); j++) {
+        Handle<SetIdentifier> setToUpdateStats = (*stats)[j];
+        statsForOptimization->setNodeStats(nodeId,
+                                           setToUpdateStats->getDatabase(),
+                                           setToUpdateStats->getSetName(),
+                                           setToUpdateStats->getNumPages(),
+                                           setToUpdateStats->getPageSize(),
+                                           setToUpdateStats->getVersion());
+    }
+    nodeStatsVersions[nodeId] = version;
+}
+
+void QuerySchedulerServer::applyPendingStats() {
+    const LockGuard guard{statsMutex};
+    // apply older pushes first so that a late delivery never overwrites newer stats
+    std::stable_sort(pendingStats.begin(),
+                     pendingStats.end(),
+                     [](const std::tuple<NodeID, long, std::string, std::string, int, size_t, long>& a,
+                        const std::tuple<NodeID, long, std::string, std::string, int, size_t, long>& b) {
+                         return std::get<1>(a) < std::get<1>(b);
+                     });
+    for (auto& delta : pendingStats) {
+        NodeID nodeId = std::get<0>(delta);
+        long version = std::get<1>(delta);
+        if ((nodeStatsVersions.count(nodeId) > 0) && (nodeStatsVersions[nodeId] >= version)) {
+            continue;
+        }
+        statsForOptimization->setNodeStats(nodeId,
+                                           std::get<3>(delta),
+                                           std::get<2>(delta),
+                                           std::get<4>(delta),
+                                           std::get<5>(delta),
+                                           std::get<6>(delta));
+    }
+    // versions are only advanced after all deltas of the batch are applied, since one push may
+    // carry several sets with the same version
+    for (auto& delta : pendingStats) {
+        NodeID nodeId = std::get<0>(delta);
+        long version = std::get<1>(delta);
+        if ((nodeStatsVersions.count(nodeId) == 0) || (nodeStatsVersions[nodeId] < version)) {
+            nodeStatsVersions[nodeId] = version;
+        }
+    }
+    pendingStats.clear();
+}
+
+// the set reported by a stage is the whole set on that node, so it replaces what we knew about
+// the set on that node; this also keeps stats right when the node pushes the same set later
+void QuerySchedulerServer::updateStats(Handle<SetIdentifier> setToUpdateStats, int index) {
+    if ((this->standardResources == nullptr) || (index < 0) ||
+        (index >= this->standardResources->size())) {
+        updateStats(setToUpdateStats);
+        return;
+    }
+    NodeID nodeId = (*(this->standardResources))[index]->getNodeId();
+    statsForOptimization->setNodeStats(nodeId,
+                                       setToUpdateStats->getDatabase(),
+                                       setToUpdateStats->getSetName(),
+                                       setToUpdateStats->getNumPages(),
+                                       setToUpdateStats->getPageSize());
+}
+
 void QuerySchedulerServer::resetStats(Handle<SetIdentifier> setToResetStats) {
 
     std::string databaseName = setToResetStats->getDatabase();
@@ -962,6 +1184,92 @@ void QuerySchedulerServer::resetStats(Handle<SetIdentifier> setToResetStats) {
     statsForOptimization->setNumBytes(databaseName, setName, 0);
 }
 
+std::string QuerySchedulerServer::getResultCacheKey(
+    Handle<Vector<Handle<Computation>>> computations, std::string tcapString) {
+    if (statsForOptimization == nullptr) {
+        // no stats have been collected yet, so the versions of the inputs are unknown
+        return "";
+    }
+    std::string key = std::to_string(std::hash<std::string>()(tcapString));
+    bool hasOutput = false;
+    for (int i = 0; i < computations->size(); i++) {
+        Handle<Computation> curComp = (*computations)[i];
+        if (curComp->isCollectAsMap() == true) {
+            // results are not only in output sets
+            return "";
+        }
+        if (curComp->getComputationType() == "WriteUserSet") {
+            // each run appends to the output set, so a run can never be skipped
+            return "";
+        }
+        if (curComp->hasInput() == false) {
+            // a source, e.g. a scanner or a computation reading its materialized output
+            std::string databaseName = curComp->getDatabaseName();
+            std::string setName = curComp->getSetName();
+            key += ";" + databaseName + ":" + setName + "@" +
+                std::to_string(statsForOptimization->getVersion(databaseName, setName));
+        } else if (curComp->needsMaterializeOutput() == true) {
+            hasOutput = true;
+        }
+    }
+    if (hasOutput == false) {
+        return "";
+    }
+    return key;
+}
+
+bool QuerySchedulerServer::isResultCached(std::string key) {
+    if ((key == "") || (resultCache == nullptr)) {
+        return false;
+    }
+    std::vector<std::pair<std::string, long>> outputSets;
+    if (resultCache->lookup(key, outputSets) == false) {
+        return false;
+    }
+    for (int i = 0; i < outputSets.size(); i++) {
+        size_t pos = outputSets[i].first.find(":");
+        std::string databaseName = outputSets[i].first.substr(0, pos);
+        std::string setName = outputSets[i].first.substr(pos + 1);
+        if (statsForOptimization->getVersion(databaseName, setName) != outputSets[i].second) {
+            // the results have been overwritten or removed
+            std::cout << "cached results in " << outputSets[i].first << " have changed"
+                      << std::endl;
+            resultCache->remove(key);
+            return false;
+        }
+    }
+    return true;
+}
+
+void QuerySchedulerServer::cacheResult(std::string key,
+                                       Handle<Vector<Handle<Computation>>> computations,
+                                       double cost) {
+    if (key == "") {
+        return;
+    }
+    if (resultCache == nullptr) {
+        resultCache = make_shared<ResultCache>();
+    }
+    // to get the versions of output sets that include what this job wrote, we ask the storage
+    // nodes, as their pushes may still be on the way once all stages have finished
+    this->applyPendingStats();
+    if (this->collectStats() == false) {
+        return;
+    }
+    std::vector<std::pair<std::string, long>> outputSets;
+    for (int i = 0; i < computations->size(); i++) {
+        Handle<Computation> curComp = (*computations)[i];
+        if ((curComp->hasInput() == true) && (curComp->needsMaterializeOutput() == true)) {
+            std::string databaseName = curComp->getDatabaseName();
+            std::string setName = curComp->getSetName();
+            outputSets.push_back(std::make_pair(
+                databaseName + ":" + setName,
+                statsForOptimization->getVersion(databaseName, setName)));
+        }
+    }
+    resultCache->insert(key, outputSets, cost);
+}
+
 std::shared_ptr<ShuffleInfo> QuerySchedulerServer::getShuffleInfo () {
     if (this->shuffleInfo == nullptr) {
        initialize(true);
@@ -975,6 +1283,33 @@ std::shared_ptr<ShuffleInfo> QuerySchedulerServer::getShuffleInfo () {
 
 void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
 
+    // handler to receive stats that a storage node pushes after its sets change
+    forMe.registerHandler(
+        StorageCollectStatsResponse_TYPEID,
+        make_shared<SimpleRequestHandler<StorageCollectStatsResponse>>(
+            [&](Handle<StorageCollectStatsResponse> request, PDBCommunicatorPtr sendUsingMe) {
+                std::string errMsg;
+                bool res = true;
+                Handle<Vector<Handle<SetIdentifier>>> stats = request->getStats();
+                pthread_mutex_lock(&statsMutex);
+                for (int i = 0; i < stats->size(); i++) {
+                    pendingStats.push_back(std::make_tuple(request->getNodeId(),
+                                                           request->getVersion(),
+                                                           std::string((*stats)[i]->getSetName()),
+                                                           std::string((*stats)[i]->getDatabase()),
+                                                           (int)(*stats)[i]->getNumPages(),
+                                                           (size_t)(*stats)[i]->getPageSize(),
+                                                           (*stats)[i]->getVersion()));
+                }
+                pthread_mutex_unlock(&statsMutex);
+                PDB_COUT << "received " << stats->size() << " stats from node "
+                         << request->getNodeId() << std::endl;
+                const UseTemporaryAllocationBlock tempBlock{1024};
+                Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
+                res = sendUsingMe->sendObject(response, errMsg);
+                return make_pair(res, errMsg);
+            }));
+
     // handler to schedule a Computation-based query graph
     forMe.registerHandler(
         ExecuteComputation_TYPEID,
@@ -993,6 +1328,10 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
                 std::string tcapString = request->getTCAPString();
 
                 this->jobId = this->getNextJobId();
+                pthread_mutex_lock(&connection_mutex);
+                this->stageTypes.clear();
+                this->stageProfiles.clear();
+                pthread_mutex_unlock(&connection_mutex);
 
                 long id = -1;
                 long instanceId = -1;
@@ -1018,11 +1357,33 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
 
                 DistributedStorageManagerClient dsmClient(this->port, "localhost", logger);
 
-                // create the database first
-                success = dsmClient.createDatabase(this->jobId, errMsg);
+                // check whether the same job has run over the same versions of its input sets,
+                // and its results are still in its output sets
+                bool resultCached = false;
+                std::string resultCacheKey = "";
+                auto jobBegin = std::chrono::high_resolution_clock::now();
+                if ((this->resultCachingOrNot == true) && (this->statsForOptimization != nullptr)) {
+                    // the versions of the inputs must include data loaded right before this job,
+                    // which storage nodes push only after they have replied to the load, so we
+                    // ask the storage nodes instead of relying on their pushes
+                    this->applyPendingStats();
+                    if (this->collectStats() == true) {
+                        resultCacheKey = this->getResultCacheKey(computations, tcapString);
+                        resultCached = this->isResultCached(resultCacheKey);
+                    }
+                }
+
+                if (resultCached == true) {
+                    std::cout << "Results of " << request->getJobName()
+                              << " are cached, to skip execution" << std::endl;
+                    success = true;
+                } else {
+                    // create the database first
+                    success = dsmClient.createDatabase(this->jobId, errMsg);
+                }
 
 
-                if (success == true) {
+                if ((success == true) && (resultCached == false)) {
                     // we do not use dynamic planning
                     if (this->dynamicPlanningOrNot == false) {
                         success = parseTCAPString(computations, tcapString);
@@ -1102,6 +1463,8 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
 
                         if (this->statsForOptimization == nullptr) {
                             this->collectStats();
+                        } else {
+                            this->applyPendingStats();
                         }
 
 
@@ -1111,10 +1474,28 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
                             jobId, computations, tcapString, this->logger, this->conf, 
                             getFunctionality<SelfLearningServer>().getDB(), true);
                         this->tcapAnalyzerPtr->setNumNodes(this->standardResources->size());
+                        this->tcapAnalyzerPtr->setCatalogClient(&getFunctionality<CatalogClient>());
+                        // the sets written by the query are not placed by the dispatcher
+                        for (int i = 0; i < computations->size(); i++) {
+                            Handle<Computation> curComp = (*computations)[i];
+                            if ((curComp->getComputationType() == "WriteUserSet") ||
+                                ((curComp->hasInput() == true) &&
+                                 (curComp->needsMaterializeOutput() == true))) {
+                                getFunctionality<DispatcherServer>().bypassPartitionPolicy(
+                                    std::make_pair(curComp->getSetName(), curComp->getDatabaseName()));
+                            }
+                        }
+                        this->tcapAnalyzerPtr->setPartitioningValidator(
+                            [this](const PDBCatalogSet& partitioning) {
+                                return getFunctionality<DispatcherServer>().isPartitionedAs(
+                                    std::make_pair(partitioning.name, partitioning.database),
+                                    partitioning);
+                            });
                         int jobStageId = 0;
                         while (this->tcapAnalyzerPtr->getNumSources() > 0) {
                             std::vector<Handle<AbstractJobStage>> jobStages;
                             std::vector<Handle<SetIdentifier>> intermediateSets;
+                            Handle<SetIdentifier> chosenSourceSet = nullptr;
 #ifdef PROFILING
                             auto dynamicPlanBegin = std::chrono::high_resolution_clock::now();
                             std::cout << "JobStageId " << jobStageId << "============>";
@@ -1144,6 +1525,7 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
                                     jobStageId);
                                 if (jobStages.size() > 0) {
                                     this->tcapAnalyzerPtr->incrementConsumerIndex(sourceName);
+                                    chosenSourceSet = sourceSet;
                                     break;
                                 } else {
                                     if (hasConsumers == false) {
@@ -1203,6 +1585,31 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
                             PDB_COUT << "To schedule the query to run on the cluster" << std::endl;
                             getFunctionality<QuerySchedulerServer>().scheduleStages(
                                 jobStages, intermediateSets, shuffleInfo, instanceId);
+
+                            // learn how much data the pipeline from the chosen source produced,
+                            // so that remaining stages and later runs of this query estimate its
+                            // cost correctly
+                            if ((chosenSourceSet != nullptr) && (intermediateSets.size() > 0)) {
+                                size_t outputBytes = 0;
+                                for (int i = 0; i < intermediateSets.size(); i++) {
+                                    outputBytes += this->statsForOptimization->getNumBytes(
+                                        intermediateSets[i]->getDatabase(),
+                                        intermediateSets[i]->getSetName());
+                                }
+                                // if the estimate was far off, the remaining stages are re-planned
+                                // from the observed size: join strategies and the sizes of
+                                // intermediate sets are decided when the next stages are planned
+                                bool misestimated =
+                                    this->tcapAnalyzerPtr->isMisestimated(outputBytes);
+                                this->tcapAnalyzerPtr->learnSelectivity(chosenSourceSet,
+                                                                        outputBytes,
+                                                                        this->statsForOptimization,
+                                                                        misestimated);
+                                if (misestimated == true) {
+                                    this->applyPendingStats();
+                                    this->tcapAnalyzerPtr->replan(this->statsForOptimization);
+                                }
+                            }
   
 #ifdef PROFILING
                             auto scheduleEnd = std::chrono::high_resolution_clock::now();
@@ -1294,6 +1701,15 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
                         }
                     }
                 }
+                if ((this->resultCachingOrNot == true) && (resultCached == false) &&
+                    (success == true)) {
+                    auto jobEnd = std::chrono::high_resolution_clock::now();
+                    this->cacheResult(resultCacheKey,
+                                      computations,
+                                      std::chrono::duration_cast<std::chrono::duration<double>>(
+                                          jobEnd - jobBegin)
+                                          .count());
+                }
                 if (selfLearningOrNot == true) {
                     std::string status;
                     if (success == true) {
@@ -1303,6 +1719,7 @@ void QuerySchedulerServer::registerHandlers(PDBServer& forMe) {
                     }
                     getFunctionality<SelfLearningServer>().updateJobInstanceForCompletion (instanceId, status);
                 }
+                PDB_LOG_INFO(logger, this->getJobProfile());
                 PDB_COUT << "To send back response to client" << std::endl;
                 Handle<SimpleRequestResult> result =
                     makeObject<SimpleRequestResult>(success, errMsg);
@@ -5,6 +5,10 @@
 #include "StorageClient.h"
 #include "StorageAddDatabase.h"
 #include "StorageCleanup.h"
+#include "StorageAddData.h"
+#include "SimpleSendBytesRequest.h"
+#include "ExportedSetFile.h"
+#include <stdio.h>
 namespace pdb {
 
 StorageClient::StorageClient(int portIn,
@@ -104,6 +108,99 @@ bool StorageClient::storeData(Handle<Vector<Handle<Object>>> data,
 }
 
 
+bool StorageClient::importSet(std::string databaseName,
+                              std::string setName,
+                              std::string typeName,
+                              std::string path,
+                              std::string& errMsg) {
+    int numFiles = 0;
+    // the library that lays out the type here, which the records must have been written with
+    std::string localSchema;
+    bool isLocalSchemaKnown = false;
+    while (true) {
+        std::string partPath = path + "." + std::to_string(numFiles);
+        FILE* partFile = fopen(partPath.c_str(), "r");
+        if (partFile == NULL) {
+            break;
+        }
+        numFiles++;
+
+        std::string fileTypeName;
+        std::string schema;
+        bool success = ExportedSetFile::readHeader(partFile, fileTypeName, schema, errMsg);
+        if (success == false) {
+            errMsg = "Error importing " + partPath + ": " + errMsg;
+        } else if (typeName == "") {
+            typeName = fileTypeName;
+        } else if (typeName != fileTypeName) {
+            errMsg = "Error importing " + partPath + ": it holds " + fileTypeName + ", not " +
+                typeName;
+            success = false;
+        }
+        if ((success == true) && (schema != "")) {
+            if (isLocalSchemaKnown == false) {
+                std::string catalogErrMsg;
+                PDBCatalogTypePtr type = myHelper.getType(typeName, catalogErrMsg);
+                if (type != nullptr) {
+                    localSchema = myHelper.getSharedLibraryHash(type->id, catalogErrMsg);
+                }
+                isLocalSchemaKnown = true;
+            }
+            if (schema != localSchema) {
+                errMsg = "Error importing " + partPath +
+                    ": it was exported with another library of " + typeName;
+                success = false;
+            }
+        }
+
+        char* record;
+        size_t numBytes;
+        std::string readErrMsg;
+        while ((success == true) &&
+               ExportedSetFile::readRecord(partFile, record, numBytes, readErrMsg)) {
+            // the storage server adopts a record sent as a direct put as one page
+            success = simpleSendBytesRequest<StorageAddData, SimpleRequestResult, bool>(
+                myLogger,
+                port,
+                address,
+                false,
+                1024,
+                [&](Handle<SimpleRequestResult> result) {
+                    if (result != nullptr && !result->getRes().first) {
+                        myLogger->error("Error importing data: " + result->getRes().second);
+                        errMsg = "Error importing data: " + result->getRes().second;
+                        return false;
+                    }
+                    return true;
+                },
+                record,
+                numBytes,
+                databaseName,
+                setName,
+                typeName,
+                false,
+                true,
+                false,
+                true);
+            free(record);
+        }
+        if ((success == true) && (readErrMsg != "")) {
+            errMsg = "Error importing " + partPath + ": " + readErrMsg;
+            success = false;
+        }
+        fclose(partFile);
+        if (success == false) {
+            myLogger->error(errMsg);
+            return false;
+        }
+    }
+    if (numFiles == 0) {
+        errMsg = "Error importing data: no file " + path + ".0";
+        return false;
+    }
+    return true;
+}
+
 std::string StorageClient::getObjectType(std::string databaseName,
                                          std::string setName,
                                          std::string& errMsg) {
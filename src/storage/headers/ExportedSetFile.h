@@ -0,0 +1,50 @@
+#ifndef EXPORTED_SET_FILE_H
+#define EXPORTED_SET_FILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+// the version of the layout below that this build writes and reads
+#define PDB_EXPORTED_SET_VERSION 1
+
+// the longest type name or schema that a header may hold
+#define PDB_EXPORTED_SET_MAX_NAME 65536
+
+namespace pdb {
+
+// This class writes and reads the files of a set exported in the "binary" format, which
+// StorageClient::importSet loads back.  Each page iterator of the exporting node writes a file of
+// its own, path.0, path.1, ..., and every file is laid out as
+//
+//   header:   char[8]   magic "PDBSET\0\0"
+//             uint32_t  version, PDB_EXPORTED_SET_VERSION
+//             uint32_t  length of the type name, followed by the type name
+//             uint32_t  length of the schema, followed by the schema
+//   records:  uint64_t  length, followed by as many bytes of one page record, i.e. the
+//                       Record<Vector<Handle<Object>>> of a page as it is in memory
+//
+// The records are the objects as they are laid out by the type, so the schema is the hash of the
+// shared library of the type in the catalog, and is empty for built-in types.  Integers are in the
+// byte order of the exporting node, as are the records.
+
+class ExportedSetFile {
+
+public:
+    static bool writeHeader(FILE* file, std::string typeName, std::string schema);
+
+    // reads the header at the start of a file; returns false with errMsg if there is none
+    static bool readHeader(FILE* file,
+                           std::string& typeName,
+                           std::string& schema,
+                           std::string& errMsg);
+
+    static bool writeRecord(FILE* file, const char* record, size_t numBytes);
+
+    // reads the next record into a buffer allocated with malloc, which the caller frees; returns
+    // false at the end of the file, and also sets errMsg if the record is malformed
+    static bool readRecord(FILE* file, char*& record, size_t& numBytes, std::string& errMsg);
+};
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "PDBPage.h"
 #include "DataTypes.h"
+#include "SharedMem.h"
 #include <list>
 #include <vector>
 #include <memory>
@@ -54,7 +55,9 @@ public:
      */
     PDBPagePtr selectPageForReplacement();
 
-    vector<PDBPagePtr>* selectPagesForReplacement();
+    // to select pages to evict; if shm is given, the other unpinned pages in the slabs of
+    // selected small pages are selected as well, so that their slabs can be freed
+    vector<PDBPagePtr>* selectPagesForReplacement(SharedMemPtr shm = nullptr);
 
     void pin(LocalitySetReplacementPolicy policy, OperationType operationType);
 
@@ -123,6 +123,16 @@ public:
         return *((int*)refCountBytes);
     }
 
+    inline int decEmbeddedNumObjects() {
+        pthread_mutex_lock(&this->refCountMutex);
+        char* refCountBytes =
+            this->rawBytes + (sizeof(NodeID) + sizeof(DatabaseID) + sizeof(UserTypeID) +
+                              sizeof(SetID) + sizeof(PageID));
+        *((int*)refCountBytes) = *((int*)refCountBytes) - 1;
+        pthread_mutex_unlock(&this->refCountMutex);
+        return *((int*)refCountBytes);
+    }
+
     inline int getEmbeddedNumObjects() {
         char* refCountBytes =
             this->rawBytes + (sizeof(NodeID) + sizeof(DatabaseID) + sizeof(UserTypeID) +
@@ -198,6 +208,20 @@ void * addRemainBytes(size_t& size) {
         return retPos;
     }
 
+    /**
+     * Gives back bytes returned by addVariableBytes, if no bytes were added after them.
+     * Returns false if they are not the last bytes of the page.
+     */
+    inline bool removeLastVariableBytes(void* bytes) {
+        size_t size = *((size_t*)((char*)bytes - sizeof(size_t)));
+        if ((char*)bytes + size != this->rawBytes + this->curAppendOffset) {
+            return false;
+        }
+        this->curAppendOffset -= size + sizeof(size_t);
+        this->decEmbeddedNumObjects();
+        return true;
+    }
+
 
     /*****To Comply with Chris' interfaces******/
 
@@ -6,6 +6,7 @@
 #include "PageCircularBufferIterator.h"
 #include "PDBCommunicator.h"
 #include "PangeaStorageServer.h"
+#include <functional>
 #include <memory>
 using namespace std;
 class PDBScanWork;
@@ -18,7 +19,12 @@ typedef shared_ptr<PDBScanWork> PDBScanWorkPtr;
 
 class PDBScanWork : public pdb::PDBWork {
 public:
-    PDBScanWork(PageIteratorPtr iter, pdb::PangeaStorageServer* storage, atomic_int& counter);
+    // skipPage, if given, is asked about every page before it is sent to the backend; it
+    // returns true for a page that must not be sent, and then it unpins the page itself
+    PDBScanWork(PageIteratorPtr iter,
+                pdb::PangeaStorageServer* storage,
+                atomic_int& counter,
+                std::function<bool(PDBPagePtr)> skipPage = nullptr);
     ~PDBScanWork();
     bool sendPagePinned(pdb::PDBCommunicatorPtr myCommunicator,
                         bool morePagesToPin,
@@ -42,6 +48,7 @@ private:
     PageIteratorPtr iter;
     pdb::PangeaStorageServer* storage;
     atomic_int& counter;
+    std::function<bool(PDBPagePtr)> skipPage;
     pthread_mutex_t connection_mutex;
 };
 
@@ -4,17 +4,35 @@
 
 #include "PDBPage.h"
 #include "PDBLogger.h"
-#include <pthread.h>
+#include <atomic>
 #include <memory>
+#include <vector>
 using namespace std;
 class PageCircularBuffer;
 typedef shared_ptr<PageCircularBuffer> PageCircularBufferPtr;
 
+/**
+ * A slot of the circular buffer.
+ * The sequence number tells producers and consumers whose turn it is to access the page:
+ * it equals the position of the next push into the slot while the slot is free, and that
+ * position plus one once the page has been pushed.
+ */
+struct PageCircularBufferSlot {
+    std::atomic<size_t> sequence;
+    PDBPagePtr page;
+};
+
 /**
  * This class implements a concurrent blocking circular buffer for producer-consumer problems.
  * The consumer threads will wait until there are pages available in the buffer.
  * The producer threads will wait until there are rooms available in the buffer to push back new
  * pages.
+ *
+ * The buffer is a bounded lock-free multi-producer multi-consumer ring: producers and consumers
+ * claim slots by advancing the tail or head position with a compare-and-swap, so that they never
+ * contend on a mutex. Threads only sleep, on a futex, when the buffer is empty (consumers) or
+ * full (producers), and are only woken if somebody is actually sleeping.
+ * Several pages can be pushed or popped with a single claim.
  */
 
 class PageCircularBuffer {
@@ -28,6 +46,13 @@ public:
      */
     int addPageToTail(PDBPagePtr page);
 
+    /**
+     * Add pages to the tail of the circular buffer, in order.
+     * As many pages as there is room for are added at once; if the buffer is full, it will block
+     * until there is new room in the buffer for the remaining pages.
+     */
+    int addPagesToTail(std::vector<PDBPagePtr>& pages);
+
     /**
      * Pop page from the head of the circular buffer.
      * If the buffer is empty, it will block until there is new page added to in the buffer,
@@ -36,6 +61,14 @@ public:
      */
     PDBPagePtr popPageFromHead();
 
+    /**
+     * Pop up to maxPages pages from the head of the circular buffer, and append them to pages.
+     * If the buffer is empty, it will block until there are new pages added to the buffer,
+     * or until the buffer is closed.
+     * Return the number of pages popped, which is 0 only if the buffer is empty and closed.
+     */
+    unsigned int popPagesFromHead(std::vector<PDBPagePtr>& pages, unsigned int maxPages);
+
     /**
      * If the buffer is full, return true, otherwise, return false.
      */
@@ -48,12 +81,14 @@ public:
 
     /**
      * Return the current size of the circular buffer.
+     * Pages that are being pushed or popped concurrently may or may not be counted.
      */
     unsigned int getSize();
 
     /**
      * Close the buffer.
-     * If the buffer is empty now, notify all consumer threads that the buffer is closed.
+     * Notify all consumer threads that the buffer is closed; they will drain the pages left in
+     * the buffer, and then get nullptr.
      */
     void close();
 
@@ -72,48 +107,65 @@ public:
 
 protected:
     /**
-     * Return the page array used to construct the concurrent blocking circular buffer.
+     * Return the maximum size of the concurrent blocking circular buffer.
      */
-    PDBPagePtr* getPageArray() {
-        return pageArray;
+    unsigned int getMaxArraySize() {
+        return maxArraySize;
     }
 
     /**
-     * Return the head index to the concurrent blocking circular buffer.
+     * Initialize the concurrent blocking circular buffer.
      */
-    unsigned int getPageArrayHead() {
-        return pageArrayHead;
-    }
+    int initArray();
+
+private:
+    /**
+     * Push up to numPages pages without blocking, return the number of pages pushed.
+     */
+    unsigned int tryAddPages(PDBPagePtr* pages, unsigned int numPages);
 
     /**
-     * Return the tail index to the concurrent blocking circular buffer.
+     * Pop up to maxPages pages without blocking, return the number of pages popped.
      */
-    unsigned int getPageArrayTail() {
-        return pageArrayTail;
-    }
+    unsigned int tryPopPages(PDBPagePtr* pages, unsigned int maxPages);
 
     /**
-     * Return the maximum size of the concurrent blocking circular buffer.
+     * Blocking versions of tryAddPages and tryPopPages.
      */
-    unsigned int getMaxArraySize() {
-        return maxArraySize;
-    }
+    void addPages(PDBPagePtr* pages, unsigned int numPages);
+    unsigned int popPages(PDBPagePtr* pages, unsigned int maxPages);
 
     /**
-     * Initialize the concurrent blocking circular buffer.
+     * Sleep on the futex word as long as it still holds the value seen by the caller.
      */
-    int initArray();
+    void wait(std::atomic<int>& futexWord, int seenValue);
 
-private:
-    PDBPagePtr* pageArray;
+    /**
+     * Signal a change of the futex word, and wake up to numThreads of its waiting threads.
+     */
+    void notify(std::atomic<int>& futexWord, std::atomic<int>& numWaiters, int numThreads);
+
+    PageCircularBufferSlot* pageArray;
     pdb::PDBLoggerPtr logger;
     unsigned int maxArraySize;
-    unsigned int pageArrayHead;
-    unsigned int pageArrayTail;
-    pthread_mutex_t mutex;
-    pthread_mutex_t addPageMutex;
-    pthread_cond_t cond;
-    bool closed;
+
+    // the position of the next push, and the position of the next pop, kept on separate cache
+    // lines so that producers and consumers do not invalidate each other's line
+    char padBeforeTail[64];
+    std::atomic<size_t> pageArrayTail;
+    char padBeforeHead[64];
+    std::atomic<size_t> pageArrayHead;
+    char padAfterHead[64];
+
+    // futex words, changed whenever pages are pushed (notEmpty) or popped (notFull)
+    std::atomic<int> notEmpty;
+    std::atomic<int> notFull;
+
+    // the number of threads sleeping on each futex word
+    std::atomic<int> numWaitingConsumers;
+    std::atomic<int> numWaitingProducers;
+
+    std::atomic<bool> closed;
 };
 
 
@@ -12,12 +12,20 @@
 #include "PageCircularBuffer.h"
 
 #include <memory>
+#include <vector>
 using namespace std;
+
+// the maximum number of pages an iterator takes from the buffer per wakeup
+#ifndef PAGE_CIRCULAR_BUFFER_ITERATOR_BATCH_SIZE
+#define PAGE_CIRCULAR_BUFFER_ITERATOR_BATCH_SIZE 4
+#endif
 class PageCircularBufferIterator;
 typedef shared_ptr<PageCircularBufferIterator> PageCircularBufferIteratorPtr;
 
 /**
  * This provides a wrapper of iterator to the page circular buffer.
+ * The iterator takes up to PAGE_CIRCULAR_BUFFER_ITERATOR_BATCH_SIZE pages from the buffer at
+ * once, and returns them one by one before it goes back to the buffer.
  */
 class PageCircularBufferIterator : public PageIteratorInterface {
 public:
@@ -27,7 +35,8 @@ public:
     ~PageCircularBufferIterator();
 
     /**
-     * Return true only if the buffer is empty and closed.
+     * Return false only if the buffer is empty and closed, and all pages taken from the buffer
+     * have been returned.
      */
     bool hasNext() override;
 
@@ -50,6 +59,10 @@ private:
     PageCircularBufferPtr buffer;
     pdb::PDBLoggerPtr logger;
     unsigned int id;
+
+    // the pages taken from the buffer, and the position of the next page to return
+    std::vector<PDBPagePtr> pages;
+    unsigned int nextPage;
 };
 
 #endif /* PAGECIRCULARBUFFERITERATOR_H */
@@ -17,6 +17,7 @@
 #include <string.h>
 #include <pthread.h>
 #include <memory>
+#include <atomic>
 using namespace std;
 
 class PageScanner;
@@ -88,6 +89,11 @@ public:
     bool recvPagesLoop(pdb::Handle<pdb::StoragePagePinned> pinnedPage,
                        pdb::PDBCommunicatorPtr myCommunicator);
 
+    /**
+     * Returns true if this scanner asked for the pages of the given set.
+     */
+    bool isScanning(DatabaseID dbId, UserTypeID typeId, SetID setId);
+
     /**
      * Close the buffer
      */
@@ -98,6 +104,17 @@ public:
      */
     void openBuffer();
 
+    /**
+     * Marks the scan as incomplete, when the frontend gave up waiting for the producers of a
+     * shuffle stream; the buffer still needs to be closed
+     */
+    void setIncomplete();
+
+    /**
+     * Returns false if the frontend did not send all the pages of the set
+     */
+    bool isComplete();
+
 
 private:
     pdb::PDBCommunicatorPtr communicator;
@@ -106,6 +123,11 @@ private:
     unsigned int numThreads;
     SharedMemPtr shm;
     NodeID nodeId;
+    bool hasSet;
+    DatabaseID dbId;
+    UserTypeID typeId;
+    SetID setId;
+    std::atomic<bool> complete;
 };
 
 
@@ -13,6 +13,7 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <functional>
 #include "LocalitySet.h"
 using namespace std;
 
@@ -134,43 +135,28 @@ public:
      * Returns the pointer pointing to the starting position of the bytes.
      */
     inline void* getNewBytes(size_t size, bool evictWhenUnpin = false) {
-        if (size == 0) {
-            return nullptr;
-        }
         pthread_mutex_lock(&this->addBytesMutex);
-        if (this->inputBufferPage == nullptr) {
-
-            this->inputBufferPage = this->addPage();
-        }
-        void* buffer = this->inputBufferPage->addVariableBytes(size);
-        if (buffer == nullptr) {
-            // current inputBufferPage is full
-
-            // we unpin the inputBufferPage
-            this->inputBufferPage->decRefCount();
-            if(this->getDurabilityType() == CacheThrough) {
-               CacheKey key;
-               key.dbId = this->getDbID();
-               key.typeId = this->getTypeID();
-               key.setId = this->getSetID();
-               key.pageId = this->inputBufferPage->getPageID();
-               std::cout << "to flush a page in getNewBytes with pageId"<< key.pageId << ", size=" << size << std::endl;
-               this->pageCache->flushPageWithoutEviction(key);
-            }
-            if (evictWhenUnpin == true) {
-                this->pageCache->evictPage(this->inputBufferPage);
-            }
-
+        void* buffer = this->getNewBytesLocked(size, evictWhenUnpin);
+        pthread_mutex_unlock(&this->addBytesMutex);
+        return buffer;
+    }
 
-            // we add a new page as inputBufferPage
-            this->inputBufferPage = this->addPage();
-            buffer = this->inputBufferPage->addVariableBytes(size);
-            pthread_mutex_unlock(&this->addBytesMutex);
-            // get new bytes in the new page
-            return buffer;
+    /**
+     * To get next a few bytes like getNewBytes, and fill them with fill before any other bytes
+     * are added to the set; if fill fails, the bytes are given back.
+     * Returns false if no bytes could be got or fill failed.
+     */
+    inline bool addNewBytes(size_t size,
+                            std::function<bool(void*)> fill,
+                            bool evictWhenUnpin = false) {
+        pthread_mutex_lock(&this->addBytesMutex);
+        void* buffer = this->getNewBytesLocked(size, evictWhenUnpin);
+        bool filled = (buffer != nullptr) && fill(buffer);
+        if ((buffer != nullptr) && (filled == false)) {
+            this->inputBufferPage->removeLastVariableBytes(buffer);
         }
         pthread_mutex_unlock(&this->addBytesMutex);
-        return buffer;
+        return filled;
     }
 
 
@@ -438,6 +424,45 @@ public:
 
 
 protected:
+    /**
+     * getNewBytes, for a caller that holds addBytesMutex
+     */
+    inline void* getNewBytesLocked(size_t size, bool evictWhenUnpin) {
+        if (size == 0) {
+            return nullptr;
+        }
+        if (this->inputBufferPage == nullptr) {
+
+            this->inputBufferPage = this->addPage();
+        }
+        void* buffer = this->inputBufferPage->addVariableBytes(size);
+        if (buffer == nullptr) {
+            // current inputBufferPage is full
+
+            // we unpin the inputBufferPage
+            this->inputBufferPage->decRefCount();
+            if(this->getDurabilityType() == CacheThrough) {
+               CacheKey key;
+               key.dbId = this->getDbID();
+               key.typeId = this->getTypeID();
+               key.setId = this->getSetID();
+               key.pageId = this->inputBufferPage->getPageID();
+               std::cout << "to flush a page in getNewBytes with pageId"<< key.pageId << ", size=" << size << std::endl;
+               this->pageCache->flushPageWithoutEviction(key);
+            }
+            if (evictWhenUnpin == true) {
+                this->pageCache->evictPage(this->inputBufferPage);
+            }
+
+
+            // we add a new page as inputBufferPage
+            this->inputBufferPage = this->addPage();
+            // get new bytes in the new page
+            buffer = this->inputBufferPage->addVariableBytes(size);
+        }
+        return buffer;
+    }
+
     PartitionedFilePtr file;
     PageCachePtr pageCache;
     SharedMemPtr shm;
@@ -12,6 +12,7 @@
 #include "StorageAddTempSet.h"
 #include "StorageAddTempSetResult.h"
 #include "StoragePinPage.h"
+#include "NumaTopology.h"
 #include "StoragePinBytes.h"
 #include "StorageUnpinPage.h"
 #include "SimpleRequestResult.h"
@@ -239,6 +240,8 @@ bool DataProxy::addUserPage(
             msg->setUserTypeID(typeId);
             msg->setSetID(setId);
             msg->setWasNewPage(true);
+            // the page is allocated by a frontend thread, so it is told where it will be used
+            msg->setNumaNode(NumaTopology::getTopology().getCurrentNode());
             // send the message out
             if (!this->communicator->sendObject<pdb::StoragePinPage>(msg, errMsg)) {
                 cout << "DataProxy.AddUserPage(): Sending object failure: " << errMsg << "\n";
@@ -287,6 +290,8 @@ bool DataProxy::addUserPage(
             msg->setUserTypeID(typeId);
             msg->setSetID(setId);
             msg->setWasNewPage(true);
+            // the page is allocated by a frontend thread, so it is told where it will be used
+            msg->setNumaNode(NumaTopology::getTopology().getCurrentNode());
             // send the message out
             if (!this->communicator->sendObject<pdb::StoragePinPage>(msg, errMsg)) {
                 cout << "Sending object failure: " << errMsg << "\n";
@@ -476,6 +481,8 @@ bool DataProxy::pinUserPage(NodeID nodeId,
             msg->setSetID(setId);
             msg->setPageID(pageId);
             msg->setWasNewPage(false);
+            // the page is allocated by a frontend thread, so it is told where it will be used
+            msg->setNumaNode(NumaTopology::getTopology().getCurrentNode());
 
             // send the message out
             if (!this->communicator->sendObject<pdb::StoragePinPage>(msg, errMsg)) {
@@ -518,6 +525,8 @@ bool DataProxy::pinUserPage(NodeID nodeId,
             msg->setSetID(setId);
             msg->setPageID(pageId);
             msg->setWasNewPage(false);
+            // the page is allocated by a frontend thread, so it is told where it will be used
+            msg->setNumaNode(NumaTopology::getTopology().getCurrentNode());
 
             // send the message out
             if (!this->communicator->sendObject<pdb::StoragePinPage>(msg, errMsg)) {
@@ -0,0 +1,99 @@
+#ifndef EXPORTED_SET_FILE_CC
+#define EXPORTED_SET_FILE_CC
+
+#include "ExportedSetFile.h"
+#include <stdlib.h>
+#include <string.h>
+
+namespace pdb {
+
+namespace {
+
+const char exportedSetMagic[8] = {'P', 'D', 'B', 'S', 'E', 'T', 0, 0};
+
+bool writeString(FILE* file, const std::string& value) {
+    uint32_t length = value.size();
+    return (fwrite(&length, sizeof(uint32_t), 1, file) == 1) &&
+        (fwrite(value.data(), 1, length, file) == length);
+}
+
+bool readString(FILE* file, std::string& value) {
+    uint32_t length;
+    if ((fread(&length, sizeof(uint32_t), 1, file) != 1) || (length > PDB_EXPORTED_SET_MAX_NAME)) {
+        return false;
+    }
+    value.resize(length);
+    return fread(&value[0], 1, length, file) == length;
+}
+}
+
+bool ExportedSetFile::writeHeader(FILE* file, std::string typeName, std::string schema) {
+    uint32_t version = PDB_EXPORTED_SET_VERSION;
+    return (fwrite(exportedSetMagic, 1, 8, file) == 8) &&
+        (fwrite(&version, sizeof(uint32_t), 1, file) == 1) && writeString(file, typeName) &&
+        writeString(file, schema);
+}
+
+bool ExportedSetFile::readHeader(FILE* file,
+                                 std::string& typeName,
+                                 std::string& schema,
+                                 std::string& errMsg) {
+    char magic[8];
+    uint32_t version;
+    if ((fread(magic, 1, 8, file) != 8) || (memcmp(magic, exportedSetMagic, 8) != 0)) {
+        errMsg = "not an exported set";
+        return false;
+    }
+    if ((fread(&version, sizeof(uint32_t), 1, file) != 1) ||
+        (version != PDB_EXPORTED_SET_VERSION)) {
+        errMsg = "unsupported version of exported set";
+        return false;
+    }
+    if (!readString(file, typeName) || !readString(file, schema)) {
+        errMsg = "truncated header";
+        return false;
+    }
+    return true;
+}
+
+bool ExportedSetFile::writeRecord(FILE* file, const char* record, size_t numBytes) {
+    uint64_t length = numBytes;
+    return (fwrite(&length, sizeof(uint64_t), 1, file) == 1) &&
+        (fwrite(record, 1, numBytes, file) == numBytes);
+}
+
+bool ExportedSetFile::readRecord(FILE* file,
+                                 char*& record,
+                                 size_t& numBytes,
+                                 std::string& errMsg) {
+    record = nullptr;
+    uint64_t length;
+    if (fread(&length, sizeof(uint64_t), 1, file) != 1) {
+        return false;
+    }
+    // a record starts with its own size
+    if (length < sizeof(size_t)) {
+        errMsg = "bad record size " + std::to_string(length);
+        return false;
+    }
+    record = (char*)malloc(length);
+    if (record == nullptr) {
+        errMsg = "can not allocate a record with size " + std::to_string(length);
+        return false;
+    }
+    if (fread(record, 1, length, file) != length) {
+        errMsg = "truncated record";
+    } else if (*((size_t*)record) != length) {
+        errMsg = "record size " + std::to_string(*((size_t*)record)) + " does not match length " +
+            std::to_string(length);
+    } else {
+        numBytes = length;
+        return true;
+    }
+    free(record);
+    record = nullptr;
+    return false;
+}
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "LocalitySet.h"
 #include <iostream>
+#include <set>
 LocalitySet::LocalitySet(LocalityType localityType,
                          LocalitySetReplacementPolicy replacementPolicy,
                          OperationType operationType,
@@ -77,7 +78,7 @@ PDBPagePtr LocalitySet::selectPageForReplacement() {
     return retPage;
 }
 
-vector<PDBPagePtr>* LocalitySet::selectPagesForReplacement() {
+vector<PDBPagePtr>* LocalitySet::selectPagesForReplacement(SharedMemPtr shm) {
     vector<PDBPagePtr>* retPages = new vector<PDBPagePtr>();
     int totalPages = cachedPages->size();
     if (totalPages == 0) {
@@ -92,14 +93,7 @@ vector<PDBPagePtr>* LocalitySet::selectPagesForReplacement() {
             if ((*it)->getRefCount() == 0) {
                 retPages->push_back(*it);
                 numPages++;
-                if (this->operationType == Write) {
-                    break;
-                } else {
-                    if (numPages == 1) {
-                    /*if ((double)numPages / (double)totalPages >= (1-EVICT_STOP_THRESHOLD)) {*/
-                        break;
-                    }
-                }
+                break;
             }
         }
     } else {
@@ -118,6 +112,28 @@ vector<PDBPagePtr>* LocalitySet::selectPagesForReplacement() {
             }
         }
     }
+    // a small page only gives memory back to the pool when its whole slab is empty, so the
+    // other unpinned pages of this set in the slab of a selected small page are evicted with it
+    if ((shm != nullptr) && (numPages > 0)) {
+        set<void*> slabs;
+        set<PDBPagePtr> selected(retPages->begin(), retPages->end());
+        for (int i = 0; i < numPages; i++) {
+            void* slab = shm->getSmallPageSlab(retPages->at(i)->getRawBytes());
+            if (slab != nullptr) {
+                slabs.insert(slab);
+            }
+        }
+        if (slabs.size() > 0) {
+            for (list<PDBPagePtr>::iterator it = cachedPages->begin(); it != cachedPages->end();
+                 ++it) {
+                if (((*it)->getRefCount() == 0) && (selected.count(*it) == 0) &&
+                    (slabs.count(shm->getSmallPageSlab((*it)->getRawBytes())) > 0)) {
+                    retPages->push_back(*it);
+                    numPages++;
+                }
+            }
+        }
+    }
     if (numPages == 0) {
         delete retPages;
         return nullptr;
@@ -22,10 +22,14 @@ using namespace std;
 #define MAX_RETRIES 5
 #endif
 
-PDBScanWork::PDBScanWork(PageIteratorPtr iter, pdb::PangeaStorageServer* storage, atomic_int& counter)
+PDBScanWork::PDBScanWork(PageIteratorPtr iter,
+                         pdb::PangeaStorageServer* storage,
+                         atomic_int& counter,
+                         std::function<bool(PDBPagePtr)> skipPage)
     : counter(counter) {
     this->iter = iter;
     this->storage = storage;
+    this->skipPage = skipPage;
     pthread_mutex_init(&connection_mutex, nullptr);
 }
 
@@ -92,12 +96,12 @@ bool PDBScanWork::acceptPagePinnedAck(pdb::PDBCommunicatorPtr myCommunicator,
 // do the actual work
 void PDBScanWork::execute(PDBBuzzerPtr callerBuzzer) {
     pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("pdbScanWorks.log");
-    logger->debug("PDBScanWork: running...");
+    PDB_LOG_DEBUG(logger, "PDBScanWork: running...");
     PDBPagePtr page;
     string errMsg, info;
     bool wasError;
 
-    logger->debug("PDBScanWork: connect to backend...");
+    PDB_LOG_DEBUG(logger, "PDBScanWork: connect to backend...");
     pthread_mutex_lock(&connection_mutex);
     pdb::PDBCommunicatorPtr communicatorToBackEnd = make_shared<pdb::PDBCommunicator>();
     int retry = 0;
@@ -119,17 +123,20 @@ void PDBScanWork::execute(PDBBuzzerPtr callerBuzzer) {
     }
 
     std::cout << "PDBScanWork: pin pages..." << std::endl;
-    logger->debug("PDBScanWork: pin pages...");
+    PDB_LOG_DEBUG(logger, "PDBScanWork: pin pages...");
     // for each loaded page retrieved from iterator, notify backend server!
     while (this->iter->hasNext()) {
         page = this->iter->next();
+        if ((page != nullptr) && (this->skipPage != nullptr) && this->skipPage(page)) {
+            continue;
+        }
         if (page != nullptr) {
             // send PagePinned object to backend
             std::cout << "PDBScanWork: pin page with pageId =" << page->getPageID() << "\n";
             retry = 0;
 
             while (retry < MAX_RETRIES) {
-                logger->debug(string("PDBScanWork: pin pages with pageId = ") +
+                PDB_LOG_DEBUG(logger, string("PDBScanWork: pin pages with pageId = ") +
                               to_string(page->getPageID()));
                 bool ret = this->sendPagePinned(communicatorToBackEnd,
                                                 true,
@@ -147,14 +154,14 @@ void PDBScanWork::execute(PDBBuzzerPtr callerBuzzer) {
                 }
                 // receive ack object from backend
                 std::cout << "PDBScanWork: waiting for ack..." << std::endl;
-                logger->debug("PDBScanWork: waiting for ack... ");
+                PDB_LOG_DEBUG(logger, "PDBScanWork: waiting for ack... ");
                 ret = this->acceptPagePinnedAck(communicatorToBackEnd, wasError, info, errMsg);
                 if (ret == false) {
                     communicatorToBackEnd->reconnect(errMsg);
                     retry++;
                     continue;
                 }
-                logger->debug("PDBScanWork: ack received ");
+                PDB_LOG_DEBUG(logger, "PDBScanWork: ack received ");
                 std::cout << "PDBScanWork: got ack!" << std::endl;
                 break;
             }
@@ -162,7 +169,7 @@ void PDBScanWork::execute(PDBBuzzerPtr callerBuzzer) {
     }
     // close the connection
     std::cout << "PDBScanWork to close the loop" << std::endl;
-    logger->debug("PDBScanWork to close the loop");
+    PDB_LOG_DEBUG(logger, "PDBScanWork to close the loop");
     retry = 0;
     while (retry < MAX_RETRIES) {
         bool ret = this->sendPagePinned(communicatorToBackEnd, false, 0, 0, 0, 0, 0, 0, 0);
@@ -179,7 +186,7 @@ void PDBScanWork::execute(PDBBuzzerPtr callerBuzzer) {
         }
         // notify the caller that this scan thread has finished work.
         std::cout << "PDBScanWork finished.\n";
-        logger->debug("PDBScanWork finished.\n");
+        PDB_LOG_DEBUG(logger, "PDBScanWork finished.\n");
         break;
     }
     callerBuzzer->buzz(PDBAlarm::WorkAllDone, this->counter);
@@ -125,7 +125,7 @@ char* PageCache::allocateBufferFromSharedMemoryBlocking(size_t size, int& alignO
         if (this->inEviction == false) {
             this->evict();
         } else {
-            this->logger->info("waiting for eviction work to evict at least one page.");
+            PDB_LOG_INFO(this->logger, "waiting for eviction work to evict at least one page.");
             sched_yield();
         }
         data = (char*)this->shm->mallocAlign(size, 512, alignOffset);
@@ -814,14 +814,11 @@ bool PageCache::evictPageForDBMIN(PDBPagePtr page, LocalitySet* set) {
 
 
 
+// eviction is a finite piece of work, so it runs as a task instead of waiting for a free worker
 void PageCache::runEviction() {
-    pdb::PDBWorkerPtr worker;
-    while ((worker = this->workers->getWorker()) == nullptr) {
-        sleep(0);
-    }
     PDBEvictWorkPtr evictWork = make_shared<PDBEvictWork>(this);
     PDBBuzzerPtr buzzer = evictWork->getLinkedBuzzer();
-    worker->execute(evictWork, buzzer);
+    this->workers->getTaskScheduler()->submit(evictWork, buzzer);
 }
 
 void PageCache::evict() {
@@ -877,7 +874,7 @@ void PageCache::evict() {
              LocalitySetPtr set = localitySets->top();
              if (set != nullptr) {
                  vector<PDBPagePtr>* pagesToEvict = nullptr;
-                 pagesToEvict = set->selectPagesForReplacement();
+                 pagesToEvict = set->selectPagesForReplacement(this->shm);
                  if (pagesToEvict != nullptr) {
                      this->evictionUnlock();
                      for (j = 0; j < pagesToEvict->size(); j++) {
@@ -920,7 +917,7 @@ void PageCache::evict() {
                  it != curList->end();
                  ++it) {
                 LocalitySetPtr set = (*it);
-                pagesToEvict = set->selectPagesForReplacement();
+                pagesToEvict = set->selectPagesForReplacement(this->shm);
                 if (pagesToEvict != nullptr) {
                     this->evictionUnlock();
                     for (j = 0; j < pagesToEvict->size(); j++) {
@@ -946,7 +943,7 @@ void PageCache::evict() {
         return;
     } else{
         this->evictionLock();
-        this->logger->debug("PageCache::evict(): got the lock for evictionLock()...");
+        PDB_LOG_DEBUG(this->logger, "PageCache::evict(): got the lock for evictionLock()...");
         priority_queue<PDBPagePtr, vector<PDBPagePtr>, CompareCachedPages>* cachedPages =
             new priority_queue<PDBPagePtr, vector<PDBPagePtr>, CompareCachedPages>();
         unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>::iterator cacheIter;
@@ -961,7 +958,7 @@ void PageCache::evict() {
                 pthread_mutex_unlock(&this->evictionMutex);
                 return;
             }
-            this->logger->debug(
+            PDB_LOG_DEBUG(this->logger,
                 "PageCache::evict(): got a page, check whether it can be evicted...");
             if ((curPage->getRefCount() == 0) &&
                 ((curPage->isDirty() == false) ||
@@ -984,7 +981,7 @@ void PageCache::evict() {
             page = cachedPages->top();
             if (page == nullptr) {
                 PDB_COUT << "PageCache: nothing to evict, return!\n";
-                this->logger->debug("PageCache: nothing to evict, return!\n");
+                PDB_LOG_DEBUG(this->logger, "PageCache: nothing to evict, return!\n");
                 break;
             }
             if (this->evictPage(page) == true) {
@@ -994,7 +991,7 @@ void PageCache::evict() {
                           << ", setID=" << page->getSetID() << ", pageID: " << page->getPageID()
                           << ".\n";
 #endif
-                this->logger->debug(
+                PDB_LOG_DEBUG(this->logger,
                     std::string("Storage server: evicting page from cache for pageID:") +
                     std::to_string(page->getPageID()));
                 cachedPages->pop();
@@ -1009,7 +1006,7 @@ void PageCache::evict() {
 #ifdef PROFILING_CACHE
     std::cout << "Storage server: finished cache eviction!\n";
 #endif
-    logger->debug("Storage server: finished cache eviction!\n");
+    PDB_LOG_DEBUG(logger, "Storage server: finished cache eviction!\n");
 }
 
 void PageCache::getAndSetWarnSize(unsigned int numSets, double warnThreshold) {
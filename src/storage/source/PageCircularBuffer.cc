@@ -1,5 +1,4 @@
 
-
 #ifndef PAGE_CIRCULAR_BUFFER_CC
 #define PAGE_CIRCULAR_BUFFER_CC
 
@@ -7,28 +6,30 @@
 #include "PageCircularBuffer.h"
 #include <string>
 #include <iostream>
-#include <pthread.h>
-#include <sched.h>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
 
 PageCircularBuffer::PageCircularBuffer(unsigned int bufferSize, pdb::PDBLoggerPtr logger) {
-    this->maxArraySize = bufferSize + 1;
+    this->maxArraySize = (bufferSize > 0) ? bufferSize : 1;
     this->logger = logger;
     this->closed = false;
+    this->notEmpty = 0;
+    this->notFull = 0;
+    this->numWaitingConsumers = 0;
+    this->numWaitingProducers = 0;
     this->initArray();
-    pthread_mutex_init(&(this->mutex), NULL);
-    pthread_mutex_init(&(this->addPageMutex), NULL);
-    pthread_cond_init(&(this->cond), NULL);
 }
 
 PageCircularBuffer::~PageCircularBuffer() {
     // the buffer is not responsible for freeing the elements in the buffer
     delete[] this->pageArray;
-    pthread_mutex_destroy(&(this->mutex));
-    pthread_cond_destroy(&(this->cond));
 }
 
 int PageCircularBuffer::initArray() {
-    this->pageArray = new PDBPagePtr[this->maxArraySize];
+    this->pageArray = new PageCircularBufferSlot[this->maxArraySize];
     if (this->pageArray == nullptr) {
         cout << "PageCircularBuffer: Out of Memory in Heap.\n";
         this->logger->writeLn("PageCircularBuffer: Out of Memory in Heap.");
@@ -36,93 +37,200 @@ int PageCircularBuffer::initArray() {
     }
     unsigned int i;
     for (i = 0; i < this->maxArraySize; i++) {
-
-        this->pageArray[i] = nullptr;
+        this->pageArray[i].sequence.store(i, std::memory_order_relaxed);
+        this->pageArray[i].page = nullptr;
     }
     this->pageArrayHead = 0;
     this->pageArrayTail = 0;
     return 0;
 }
 
+// claims as many consecutive free slots as possible at the tail with one compare-and-swap;
+// a free slot stays free until it is claimed, so the slots checked before a successful swap
+// are all ours
+unsigned int PageCircularBuffer::tryAddPages(PDBPagePtr* pages, unsigned int numPages) {
+    size_t pos = this->pageArrayTail.load(std::memory_order_relaxed);
+    while (true) {
+        unsigned int numFree = 0;
+        while (numFree < numPages) {
+            size_t seq = this->pageArray[(pos + numFree) % this->maxArraySize].sequence.load(
+                std::memory_order_acquire);
+            if (seq != pos + numFree) {
+                break;
+            }
+            numFree++;
+        }
+        if (numFree == 0) {
+            size_t seq =
+                this->pageArray[pos % this->maxArraySize].sequence.load(std::memory_order_acquire);
+            if ((ssize_t)(seq - pos) < 0) {
+                // the slot still holds a page that was not popped: the buffer is full
+                return 0;
+            }
+            // another producer claimed the slot first
+            pos = this->pageArrayTail.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (this->pageArrayTail.compare_exchange_weak(
+                pos, pos + numFree, std::memory_order_relaxed)) {
+            for (unsigned int i = 0; i < numFree; i++) {
+                PageCircularBufferSlot& slot = this->pageArray[(pos + i) % this->maxArraySize];
+                slot.page = pages[i];
+                slot.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return numFree;
+        }
+    }
+}
+
+// claims as many consecutive filled slots as possible at the head with one compare-and-swap
+unsigned int PageCircularBuffer::tryPopPages(PDBPagePtr* pages, unsigned int maxPages) {
+    size_t pos = this->pageArrayHead.load(std::memory_order_relaxed);
+    while (true) {
+        unsigned int numFilled = 0;
+        while (numFilled < maxPages) {
+            size_t seq = this->pageArray[(pos + numFilled) % this->maxArraySize].sequence.load(
+                std::memory_order_acquire);
+            if (seq != pos + numFilled + 1) {
+                break;
+            }
+            numFilled++;
+        }
+        if (numFilled == 0) {
+            size_t seq =
+                this->pageArray[pos % this->maxArraySize].sequence.load(std::memory_order_acquire);
+            if ((ssize_t)(seq - (pos + 1)) < 0) {
+                // the slot was not filled yet: the buffer is empty
+                return 0;
+            }
+            // another consumer claimed the slot first
+            pos = this->pageArrayHead.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (this->pageArrayHead.compare_exchange_weak(
+                pos, pos + numFilled, std::memory_order_relaxed)) {
+            for (unsigned int i = 0; i < numFilled; i++) {
+                PageCircularBufferSlot& slot = this->pageArray[(pos + i) % this->maxArraySize];
+                pages[i] = std::move(slot.page);
+                slot.page = nullptr;
+                slot.sequence.store(pos + i + this->maxArraySize, std::memory_order_release);
+            }
+            return numFilled;
+        }
+    }
+}
+
+void PageCircularBuffer::wait(std::atomic<int>& futexWord, int seenValue) {
+    syscall(SYS_futex,
+            reinterpret_cast<int*>(&futexWord),
+            FUTEX_WAIT_PRIVATE,
+            seenValue,
+            nullptr,
+            nullptr,
+            0);
+}
+
+void PageCircularBuffer::notify(std::atomic<int>& futexWord,
+                                std::atomic<int>& numWaiters,
+                                int numThreads) {
+    futexWord.fetch_add(1);
+    // a waiter registers itself before it reads the futex word, so either we see it here, or
+    // it sees the new value of the futex word and does not sleep
+    if (numWaiters.load() > 0) {
+        syscall(SYS_futex,
+                reinterpret_cast<int*>(&futexWord),
+                FUTEX_WAKE_PRIVATE,
+                numThreads,
+                nullptr,
+                nullptr,
+                0);
+    }
+}
+
 // in our case, more than one producer will add pages to the tail of the blocking queue
-int PageCircularBuffer::addPageToTail(PDBPagePtr page) {
-    pthread_mutex_lock(&(this->addPageMutex));
-    int i = 0;
-    while (this->isFull()) {
-        i++;
-        if (i % 10000000 == 0) {
-            this->logger->info(std::to_string(i) +
-                               std::string(":PageCircularBuffer: array is full."));
-            std::cout << i << ":PageCircularBuffer: array is full." << std::endl;
+void PageCircularBuffer::addPages(PDBPagePtr* pages, unsigned int numPages) {
+    unsigned int numAdded = 0;
+    while (numAdded < numPages) {
+        unsigned int numNewPages = this->tryAddPages(pages + numAdded, numPages - numAdded);
+        if (numNewPages > 0) {
+            numAdded += numNewPages;
+            this->notify(this->notEmpty, this->numWaitingConsumers, numNewPages);
+            continue;
         }
-        pthread_cond_signal(&(this->cond));
-        sched_yield();  // TODO: consider to use another conditional variable
+        this->numWaitingProducers.fetch_add(1);
+        int seenValue = this->notFull.load();
+        if (this->isFull()) {
+            this->wait(this->notFull, seenValue);
+        }
+        this->numWaitingProducers.fetch_sub(1);
     }
+}
 
-    this->logger->writeLn("PageCircularBuffer:got a place.");
-    std::cout << "PageCircularBuffer:got a place." << std::endl;
-    this->pageArrayTail = (this->pageArrayTail + 1) % this->maxArraySize;
-    this->pageArray[this->pageArrayTail] = page;
-    pthread_mutex_unlock(&(this->addPageMutex));
-    pthread_mutex_lock(&(this->mutex));
-    if (this->getSize() <= 2) {  // TODO <= numThreads? or not necessary
-        pthread_cond_broadcast(&(this->cond));
-    } else {
-        pthread_cond_signal(&(this->cond));
+// there will be multiple consumers, which all pop pages from the head of the blocking queue
+unsigned int PageCircularBuffer::popPages(PDBPagePtr* pages, unsigned int maxPages) {
+    while (true) {
+        // pages pushed before the buffer was closed are visible once we see it closed
+        bool wasClosed = this->closed;
+        unsigned int numPages = this->tryPopPages(pages, maxPages);
+        if (numPages > 0) {
+            this->notify(this->notFull, this->numWaitingProducers, numPages);
+            return numPages;
+        }
+        if (wasClosed) {
+            return 0;
+        }
+        this->numWaitingConsumers.fetch_add(1);
+        int seenValue = this->notEmpty.load();
+        if (this->isEmpty() && !this->closed) {
+            this->wait(this->notEmpty, seenValue);
+        }
+        this->numWaitingConsumers.fetch_sub(1);
     }
-    pthread_mutex_unlock(&(this->mutex));
+}
+
+int PageCircularBuffer::addPageToTail(PDBPagePtr page) {
+    this->addPages(&page, 1);
     return 0;
 }
 
-// there will be multiple consumers, so we need to guard the blocking queue
+int PageCircularBuffer::addPagesToTail(std::vector<PDBPagePtr>& pages) {
+    this->addPages(pages.data(), pages.size());
+    return 0;
+}
 
 PDBPagePtr PageCircularBuffer::popPageFromHead() {
-    pthread_mutex_lock(&(this->mutex));
-    if (this->isEmpty() && (this->closed == false)) {
-        this->logger->writeLn("PageCircularBuffer: array is empty.");
-        std::cout << "PageCircularBuffer: array is empty." << std::endl;
-        pthread_cond_wait(&(this->cond), &(this->mutex));
-    }
-    if (!this->isEmpty()) {
-        this->logger->debug("PageCircularBuffer: not empty, return the head element");
-        std::cout << "PageCircularBuffer: not empty, return the head element" << std::endl;
-        this->pageArrayHead = (this->pageArrayHead + 1) % this->maxArraySize;
-        PDBPagePtr ret = this->pageArray[this->pageArrayHead];
-        std::cout << "Head pageID=" << ret->getPageID() << std::endl;
-        this->pageArray[this->pageArrayHead] = nullptr;
-        pthread_mutex_unlock(&(this->mutex));
-        return ret;
-    } else {
-        pthread_mutex_unlock(&(this->mutex));
-        std::cout << "Head is nullptr" << std::endl;
-        return nullptr;
-    }
+    PDBPagePtr ret = nullptr;
+    this->popPages(&ret, 1);
+    return ret;
+}
+
+unsigned int PageCircularBuffer::popPagesFromHead(std::vector<PDBPagePtr>& pages,
+                                                  unsigned int maxPages) {
+    size_t oldSize = pages.size();
+    pages.resize(oldSize + maxPages);
+    unsigned int numPages = this->popPages(pages.data() + oldSize, maxPages);
+    pages.resize(oldSize + numPages);
+    return numPages;
 }
-// not thread-safe
 
 bool PageCircularBuffer::isFull() {
-    return (this->pageArrayHead == (this->pageArrayTail + 1) % this->maxArraySize);
+    return this->getSize() >= this->maxArraySize;
 }
-// not thread-safe
 
 bool PageCircularBuffer::isEmpty() {
-    PDB_COUT << "this->pageArrayHead=" << this->pageArrayHead << std::endl;
-    this->logger->debug(std::string("this->pageArrayHead=") + std::to_string(this->pageArrayHead));
-    this->logger->debug(std::string("this->pageArrayTail=") + std::to_string(this->pageArrayTail));
-    PDB_COUT << "this->pageArrayTail=" << this->pageArrayTail << std::endl;
-    return (this->pageArrayHead == this->pageArrayTail);
+    return this->getSize() == 0;
 }
-// not thread-safe
 
 unsigned int PageCircularBuffer::getSize() {
-    return (this->pageArrayTail - this->pageArrayHead + this->maxArraySize) % this->maxArraySize;
+    size_t head = this->pageArrayHead.load();
+    size_t tail = this->pageArrayTail.load();
+    return (tail > head) ? (unsigned int)(tail - head) : 0;
 }
 
 void PageCircularBuffer::close() {
-    pthread_mutex_lock(&(this->mutex));
     this->closed = true;
-    pthread_cond_broadcast(&(this->cond));
-    pthread_mutex_unlock(&(this->mutex));
+    this->notify(this->notEmpty, this->numWaitingConsumers, INT_MAX);
+    this->notify(this->notFull, this->numWaitingProducers, INT_MAX);
 }
 
 
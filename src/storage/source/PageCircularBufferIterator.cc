@@ -13,13 +13,26 @@ PageCircularBufferIterator::PageCircularBufferIterator(unsigned int id,
     this->id = id;
     this->buffer = buffer;
     this->logger = logger;
+    this->nextPage = 0;
+    this->pages.reserve(PAGE_CIRCULAR_BUFFER_ITERATOR_BATCH_SIZE);
 }
 
 PageCircularBufferIterator::~PageCircularBufferIterator() {}
 
 // will block when queue is empty and will remove the page from queue before return;
 PDBPagePtr PageCircularBufferIterator::next() {
-    return this->buffer->popPageFromHead();
+    if (this->nextPage == this->pages.size()) {
+        this->pages.clear();
+        this->nextPage = 0;
+        if (this->buffer->popPagesFromHead(this->pages, PAGE_CIRCULAR_BUFFER_ITERATOR_BATCH_SIZE) ==
+            0) {
+            return nullptr;
+        }
+    }
+    PDBPagePtr page = this->pages[this->nextPage];
+    this->pages[this->nextPage] = nullptr;
+    this->nextPage++;
+    return page;
 }
 
 /* Potential Bug: in certain cases, two iterators may simultaneously find that the buffer is closed,
@@ -33,7 +46,8 @@ PDBPagePtr PageCircularBufferIterator::next() {
  * Now, we go solution 2, please let me know if this is a problem!
  */
 bool PageCircularBufferIterator::hasNext() {
-    bool ret = ((!this->buffer->isClosed()) || (!this->buffer->isEmpty()));
+    bool ret = (this->nextPage < this->pages.size()) || (!this->buffer->isClosed()) ||
+        (!this->buffer->isEmpty());
     PDB_COUT << "iter Id=" << this->id << ",ret=" << ret << "\n";
     return ret;
 }
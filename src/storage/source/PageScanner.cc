@@ -30,6 +30,8 @@ PageScanner::PageScanner(pdb::PDBCommunicatorPtr communicator,
     this->numThreads = numThreads;
     this->buffer = make_shared<PageCircularBuffer>(recvBufSize, logger);
     this->nodeId = nodeId;
+    this->hasSet = false;
+    this->complete = true;
 }
 
 PageScanner::~PageScanner() {}
@@ -105,6 +107,10 @@ vector<PageCircularBufferIteratorPtr> PageScanner::getSetIterators(NodeID nodeId
     getSetPagesRequest->setDatabaseID(dbId);
     getSetPagesRequest->setUserTypeID(typeId);
     getSetPagesRequest->setSetID(setId);
+    this->hasSet = true;
+    this->dbId = dbId;
+    this->typeId = typeId;
+    this->setId = setId;
 
     vector<PageCircularBufferIteratorPtr> vec;
     // send request to storage
@@ -145,14 +151,14 @@ bool PageScanner::recvPagesLoop(pdb::Handle<pdb::StoragePagePinned> pinnedPage,
     do {
         std::cout << "dataPageId:" << dataPageId << "\n";
         std::cout << "morePagesToLoad:" << morePagesToLoad << "\n";
-        logger->debug(string("got a page with pageId=") + to_string(dataPageId));
+        PDB_LOG_DEBUG(logger, string("got a page with pageId=") + to_string(dataPageId));
         // if there are no more pages to send at the frontend side, send ACK and return.
         if (morePagesToLoad == false) {
             std::cout << "BackEndServer: sending Ack to frontEnd to end loop...\n";
-            logger->debug(string("BackEndServer: sending Ack to frontEnd to end loop...\n"));
+            PDB_LOG_DEBUG(logger, string("BackEndServer: sending Ack to frontEnd to end loop...\n"));
             this->sendPagePinnedAck(myCommunicator, false, "", errMsg);
             std::cout << "BackEndServer: sent Ack to frontend to end loop...\n";
-            logger->debug(string("BackEndServer: sent Ack to frontend to end loop...\n"));
+            PDB_LOG_DEBUG(logger, string("BackEndServer: sent Ack to frontend to end loop...\n"));
             return true;
         }
         // if there are more pages to send at the frontend side,
@@ -161,7 +167,7 @@ bool PageScanner::recvPagesLoop(pdb::Handle<pdb::StoragePagePinned> pinnedPage,
             char* rawData = (char*)this->shm->getPointer(offset);
             page = make_shared<PDBPage>(rawData, offset, 0);
             std::cout << "BackEndServer: add page scanner page to circular buffer...\n";
-            logger->debug(string("BackEndServer: add page scanner page to circular buffer...\n"));
+            PDB_LOG_DEBUG(logger, string("BackEndServer: add page scanner page to circular buffer...\n"));
             if (this->buffer != nullptr) {
                 this->buffer->addPageToTail(page);
             } else {
@@ -170,10 +176,10 @@ bool PageScanner::recvPagesLoop(pdb::Handle<pdb::StoragePagePinned> pinnedPage,
                 return true;
             }
             std::cout << "BackEndServer: sending PagePinnedAck to frontEnd...\n";
-            logger->debug("BackEndServer: sending PagePinnedAck to frontEnd...\n");
+            PDB_LOG_DEBUG(logger, "BackEndServer: sending PagePinnedAck to frontEnd...\n");
             this->sendPagePinnedAck(myCommunicator, false, "", errMsg);
             std::cout << "BackEndServer: sent PagePinnedAck to frontEnd...\n";
-            logger->debug("BackEndServer: sent PagePinnedAck to frontEnd...\n");
+            PDB_LOG_DEBUG(logger, "BackEndServer: sent PagePinnedAck to frontEnd...\n");
         }
     } while ((ret = this->acceptPagePinned(myCommunicator,
                                            errMsg,
@@ -186,10 +192,15 @@ bool PageScanner::recvPagesLoop(pdb::Handle<pdb::StoragePagePinned> pinnedPage,
                                            pageSize,
                                            offset)) == true);
     std::cout << "PageScanner Work is done" << endl;
-    logger->debug("PageScanner Work is done");
+    PDB_LOG_DEBUG(logger, "PageScanner Work is done");
     return false;
 }
 
+bool PageScanner::isScanning(DatabaseID dbId, UserTypeID typeId, SetID setId) {
+    return this->hasSet && (this->dbId == dbId) && (this->typeId == typeId) &&
+        (this->setId == setId);
+}
+
 /**
  * Close the buffer
  */
@@ -202,4 +213,12 @@ void PageScanner::closeBuffer() {
 void PageScanner::openBuffer() {
     this->buffer->open();
 }
+
+void PageScanner::setIncomplete() {
+    this->complete = false;
+}
+
+bool PageScanner::isComplete() {
+    return this->complete;
+}
 #endif
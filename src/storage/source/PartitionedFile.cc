@@ -228,12 +228,12 @@ void PartitionedFile::clear() {
     }
     this->closeAll();
     remove(this->metaPartitionPath.c_str());
-    logger->info("PartitionedFile: Deleting file:" + this->metaPartitionPath);
+    PDB_LOG_INFO(logger, "PartitionedFile: Deleting file:" + this->metaPartitionPath);
     int i;
     int numPartitions = this->dataPartitionPaths.size();
     for (i = 0; i < numPartitions; i++) {
         remove(this->dataPartitionPaths.at(i).c_str());
-        logger->info("PartitionedFile: Deleting file:" + this->dataPartitionPaths.at(i));
+        PDB_LOG_INFO(logger, "PartitionedFile: Deleting file:" + this->dataPartitionPaths.at(i));
     }
     this->cleared = true;
     pthread_mutex_unlock(&this->fileMutex);
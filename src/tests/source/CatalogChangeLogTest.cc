@@ -0,0 +1,264 @@
+
+#ifndef CATALOG_CHANGE_LOG_TEST_CC
+#define CATALOG_CHANGE_LOG_TEST_CC
+
+// tests the change log of the catalog: versions, seeding the log of an existing catalog, the
+// serialization that ships changes to the workers, and applying changes on a worker catalog,
+// including replaying changes it already has and catching up after it missed some
+
+#include "PDBCatalog.h"
+
+#include <cassert>
+#include <iostream>
+#include <stdio.h>
+
+#define MANAGER_CATALOG "catalogChangeLogTestManager.sqlite"
+#define WORKER_CATALOG "catalogChangeLogTestWorker.sqlite"
+#define SEEDED_CATALOG "catalogChangeLogTestSeeded.sqlite"
+
+using namespace pdb;
+
+// registers something on the manager, and records it like the catalog server does
+void addDatabase(PDBCatalog& manager, const std::string& dbName) {
+    std::string error;
+    assert(manager.registerDatabase(std::make_shared<PDBCatalogDatabase>(dbName), error));
+    manager.logChange(PDBCatalogChange::addDatabase(dbName));
+}
+
+void addType(PDBCatalog& manager, int typeId, const std::string& typeName) {
+    std::string error;
+    auto type = std::make_shared<PDBCatalogType>(
+        typeId, "data", typeName, std::vector<char>{'l', 'i', 'b'});
+    assert(manager.registerType(type, error));
+    manager.logChange(PDBCatalogChange::addType(*type));
+}
+
+void addSet(PDBCatalog& manager,
+            const std::string& dbName,
+            const std::string& setName,
+            const std::string& typeName) {
+    std::string error;
+    auto set = std::make_shared<PDBCatalogSet>(setName, dbName, typeName);
+    assert(manager.registerSet(set, error));
+    manager.logChange(PDBCatalogChange::addSet(*set));
+}
+
+void removeSet(PDBCatalog& manager, const std::string& dbName, const std::string& setName) {
+    std::string error;
+    assert(manager.removeSet(dbName, setName, error));
+    manager.logChange(PDBCatalogChange::removeSet(dbName, setName));
+}
+
+// ships the changes after the given version from the manager, as the catalog server does
+std::vector<PDBCatalogChange> getChanges(PDBCatalog& manager, long sinceVersion) {
+    std::vector<unsigned char> bytes;
+    PDBCatalogChange::serialize(manager.getChangesSince(sinceVersion), bytes);
+    std::vector<PDBCatalogChange> changes;
+    assert(PDBCatalogChange::deserialize(bytes.data(), bytes.size(), changes));
+    return changes;
+}
+
+void applyChanges(PDBCatalog& worker, const std::vector<PDBCatalogChange>& changes) {
+    for (const auto& change : changes) {
+        std::string error;
+        if (!worker.applyChange(change, error)) {
+            std::cout << "failed to apply change " << change.version << ": " << error << std::endl;
+            assert(false);
+        }
+    }
+}
+
+// the worker has the same sets, with the same types and partitioning, as the manager
+void checkSameSets(PDBCatalog& manager, PDBCatalog& worker, const std::string& dbName) {
+    auto managerSets = manager.getSetsInDatabase(dbName);
+    auto workerSets = worker.getSetsInDatabase(dbName);
+    assert(managerSets.size() == workerSets.size());
+    for (const auto& set : managerSets) {
+        auto workerSet = worker.getSet(dbName, set.name);
+        assert(workerSet != nullptr);
+        assert(*workerSet->type == *set.type);
+        assert(workerSet->partitionLambda == set.partitionLambda);
+        assert(workerSet->numPartitions == set.numPartitions);
+        assert(workerSet->partitionNodes == set.partitionNodes);
+    }
+}
+
+void testSerialization() {
+    PDBCatalogSet set("set1", "db1", "Employee");
+    set.partitionLambda = "getSalary";
+    set.partitionLambdaInputClass = "Employee";
+    set.numPartitions = 8;
+    set.partitionNodes = "10.0.0.1:8108,10.0.0.2:8108";
+    std::vector<PDBCatalogChange> changes;
+    changes.push_back(PDBCatalogChange::addDatabase("db1"));
+    changes.push_back(PDBCatalogChange::addType(PDBCatalogType(8192, "data", "Employee", {})));
+    changes.push_back(PDBCatalogChange::addSet(set));
+    changes.push_back(PDBCatalogChange::setPartitioning(set));
+    changes.push_back(PDBCatalogChange::addNode(PDBCatalogNode("10.0.0.1:8108", "10.0.0.1", 8108, "worker")));
+    changes.push_back(PDBCatalogChange::removeSet("db1", "set1"));
+    changes.push_back(PDBCatalogChange::removeDatabase("db1"));
+    for (size_t i = 0; i < changes.size(); i++) {
+        changes[i].version = i + 1;
+    }
+
+    std::vector<unsigned char> bytes;
+    PDBCatalogChange::serialize(changes, bytes);
+    std::vector<PDBCatalogChange> read;
+    assert(PDBCatalogChange::deserialize(bytes.data(), bytes.size(), read));
+    assert(read.size() == changes.size());
+    for (size_t i = 0; i < changes.size(); i++) {
+        assert(read[i].version == changes[i].version);
+        assert(read[i].operation == changes[i].operation);
+        assert(read[i].database == changes[i].database);
+        assert(read[i].setName == changes[i].setName);
+        assert(read[i].typeName == changes[i].typeName);
+        assert(read[i].typeID == changes[i].typeID);
+        assert(read[i].typeCategory == changes[i].typeCategory);
+        assert(read[i].nodeID == changes[i].nodeID);
+        assert(read[i].nodeAddress == changes[i].nodeAddress);
+        assert(read[i].nodePort == changes[i].nodePort);
+        assert(read[i].nodeType == changes[i].nodeType);
+        assert(read[i].partitionLambda == changes[i].partitionLambda);
+        assert(read[i].partitionLambdaInputClass == changes[i].partitionLambdaInputClass);
+        assert(read[i].numPartitions == changes[i].numPartitions);
+        assert(read[i].partitionNodes == changes[i].partitionNodes);
+    }
+
+    // no changes is no bytes, and cut off bytes are rejected
+    std::vector<unsigned char> noBytes;
+    PDBCatalogChange::serialize(std::vector<PDBCatalogChange>(), noBytes);
+    assert(noBytes.empty());
+    read.clear();
+    assert(PDBCatalogChange::deserialize(noBytes.data(), 0, read) && read.empty());
+    for (size_t numBytes = 1; numBytes < bytes.size(); numBytes += 7) {
+        read.clear();
+        bool complete = PDBCatalogChange::deserialize(bytes.data(), numBytes, read);
+        assert(!complete || read.size() < changes.size());
+    }
+    read.clear();
+    assert(!PDBCatalogChange::deserialize(bytes.data(), bytes.size() - 1, read));
+    std::cout << "serialization: ok" << std::endl;
+}
+
+void testApply() {
+    PDBCatalog manager(MANAGER_CATALOG);
+    PDBCatalog worker(WORKER_CATALOG);
+    assert(manager.getLatestChange() == 0);
+    assert(worker.getLatestChange() == 0);
+
+    // versions grow by one with every change
+    addDatabase(manager, "db1");
+    addType(manager, 8192, "Employee");
+    addType(manager, 8193, "Supervisor");
+    addSet(manager, "db1", "set1", "Employee");
+    addSet(manager, "db1", "set2", "Employee");
+    assert(manager.getLatestChange() == 5);
+    assert(manager.getChangesSince(3).size() == 2);
+    assert(manager.getChangesSince(3)[0].version == 4);
+
+    // a new worker gets everything
+    applyChanges(worker, getChanges(manager, worker.getLatestChange()));
+    assert(worker.getLatestChange() == 5);
+    assert(worker.databaseExists("db1"));
+    assert(worker.typeExists("Employee") && worker.typeExists("Supervisor"));
+    checkSameSets(manager, worker, "db1");
+
+    // types come without their library, which the worker fetches when it needs it
+    assert(worker.getType("Employee")->soBytes.empty());
+    std::string error;
+    assert(worker.updateTypeLibrary("Employee", {'l', 'i', 'b'}, error));
+    assert(worker.getType("Employee")->soBytes.size() == 3);
+    assert(!worker.updateTypeLibrary("Unknown", {'l'}, error));
+
+    // replaying changes the worker already has changes nothing
+    applyChanges(worker, getChanges(manager, 0));
+    assert(worker.getLatestChange() == 5);
+    checkSameSets(manager, worker, "db1");
+
+    // a worker that was down catches up on what it missed, including a set that was removed and
+    // added again with another type, and the partitioning of a set
+    removeSet(manager, "db1", "set1");
+    addSet(manager, "db1", "set1", "Supervisor");
+    removeSet(manager, "db1", "set2");
+    auto set1 = manager.getSet("db1", "set1");
+    set1->partitionLambda = "getName";
+    set1->partitionLambdaInputClass = "Supervisor";
+    set1->numPartitions = 4;
+    set1->partitionNodes = "10.0.0.1:8108";
+    assert(manager.updateSetPartitioning(*set1, error));
+    manager.logChange(PDBCatalogChange::setPartitioning(*set1));
+    auto node = std::make_shared<PDBCatalogNode>("10.0.0.1:8108", "10.0.0.1", 8108, "worker");
+    assert(manager.registerNode(node, error));
+    manager.logChange(PDBCatalogChange::addNode(*node));
+
+    long before = worker.getLatestChange();
+    std::vector<PDBCatalogChange> missed = getChanges(manager, before);
+    assert(missed.size() == 5);
+    applyChanges(worker, missed);
+    assert(worker.getLatestChange() == manager.getLatestChange());
+    checkSameSets(manager, worker, "db1");
+    assert(!worker.setExists("db1", "set2"));
+    assert(*worker.getSet("db1", "set1")->type == "Supervisor");
+    assert(worker.nodeExists("10.0.0.1:8108"));
+
+    // applying the same changes in a row twice is safe too
+    applyChanges(worker, missed);
+    checkSameSets(manager, worker, "db1");
+
+    // removing a database
+    manager.removeDatabase("db1", error);
+    manager.logChange(PDBCatalogChange::removeDatabase("db1"));
+    applyChanges(worker, getChanges(manager, worker.getLatestChange()));
+    assert(!worker.databaseExists("db1"));
+
+    // unknown changes are rejected and not recorded
+    PDBCatalogChange unknown;
+    unknown.version = manager.getLatestChange() + 1;
+    unknown.operation = "dropEverything";
+    assert(!worker.applyChange(unknown, error));
+    assert(worker.getLatestChange() == manager.getLatestChange());
+    std::cout << "apply: ok" << std::endl;
+}
+
+// a catalog that was filled before it kept a log gets a log that rebuilds it
+void testSeeding() {
+    PDBCatalog seeded(SEEDED_CATALOG);
+    std::string error;
+    assert(seeded.registerDatabase(std::make_shared<PDBCatalogDatabase>("db2"), error));
+    assert(seeded.registerType(
+        std::make_shared<PDBCatalogType>(8194, "data", "Manager", std::vector<char>{'l'}), error));
+    assert(seeded.registerSet(std::make_shared<PDBCatalogSet>("set3", "db2", "Manager"), error));
+    assert(seeded.getLatestChange() == 0);
+    seeded.initChangeLog();
+    long numChanges = seeded.getLatestChange();
+    assert(numChanges >= 3);
+
+    // seeding again does nothing
+    seeded.initChangeLog();
+    assert(seeded.getLatestChange() == numChanges);
+
+    // the log rebuilds the catalog
+    remove(WORKER_CATALOG);
+    PDBCatalog worker(WORKER_CATALOG);
+    applyChanges(worker, getChanges(seeded, 0));
+    assert(worker.databaseExists("db2"));
+    assert(worker.typeExists("Manager"));
+    checkSameSets(seeded, worker, "db2");
+    std::cout << "seeding: ok" << std::endl;
+}
+
+int main() {
+    remove(MANAGER_CATALOG);
+    remove(WORKER_CATALOG);
+    remove(SEEDED_CATALOG);
+    testSerialization();
+    testApply();
+    testSeeding();
+    remove(MANAGER_CATALOG);
+    remove(WORKER_CATALOG);
+    remove(SEEDED_CATALOG);
+    std::cout << "CatalogChangeLogTest: all tests passed" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,149 @@
+
+#ifndef COLUMN_BLOCK_TEST_CC
+#define COLUMN_BLOCK_TEST_CC
+
+// tests the column blocks that combiners ship: a combiner page compacted into column blocks reads
+// back as the pairs it was merged from, for primitive and String keys, and a page whose blocks do
+// not fit is left to be shipped as maps
+
+#include "CombinerProcessor.h"
+#include "ColumnBlock.h"
+#include "PDBString.h"
+#include "PDBMap.h"
+#include "PDBVector.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#define PAGE_SIZE (1024 * 1024)
+#define NUM_PARTITIONS 2
+#define NUM_KEYS_PER_PARTITION 100
+
+using namespace pdb;
+
+void makeKey(int i, int& key) {
+    key = i;
+}
+
+void makeKey(int i, String& key) {
+    key = String("key" + std::to_string(i));
+}
+
+std::string getKeyName(int key) {
+    return std::to_string(key);
+}
+
+std::string getKeyName(String key) {
+    return std::string(key.c_str());
+}
+
+// writes an input page of the combiner: one map for each hash partition
+template <class KeyType>
+void makeInputPage(void* page) {
+    const UseTemporaryAllocationBlock block{page, PAGE_SIZE};
+    Handle<Vector<Handle<Map<KeyType, int>>>> maps =
+        makeObject<Vector<Handle<Map<KeyType, int>>>>(NUM_PARTITIONS);
+    for (int p = 0; p < NUM_PARTITIONS; p++) {
+        Handle<Map<KeyType, int>> map = makeObject<Map<KeyType, int>>();
+        for (int i = p * NUM_KEYS_PER_PARTITION; i < (p + 1) * NUM_KEYS_PER_PARTITION; i++) {
+            KeyType key;
+            makeKey(i, key);
+            (*map)[key] = i;
+        }
+        maps->push_back(map);
+    }
+    getRecord(maps);
+}
+
+template <class KeyType>
+void testRoundTrip(std::string name) {
+    assert((ColumnBlock<KeyType, int>::isSupported()));
+    void* inputPage = calloc(PAGE_SIZE, 1);
+    void* outputPage = calloc(PAGE_SIZE, 1);
+    void* compactPage = calloc(PAGE_SIZE, 1);
+    void* smallPage = calloc(256, 1);
+    makeInputPage<KeyType>(inputPage);
+
+    // the same page is merged twice, so each value doubles
+    std::vector<HashPartitionID> partitions;
+    for (int p = 0; p < NUM_PARTITIONS; p++) {
+        partitions.push_back(p);
+    }
+    CombinerProcessor<KeyType, int> combiner(partitions);
+    combiner.initialize();
+    combiner.loadOutputPage(outputPage, PAGE_SIZE);
+    for (int i = 0; i < 2; i++) {
+        combiner.loadInputPage(inputPage);
+        assert(!combiner.fillNextOutputPage());
+    }
+    combiner.finalize();
+    combiner.fillNextOutputPage();
+    size_t mapBytes = ((Record<Vector<Handle<Object>>>*)outputPage)->numBytes();
+
+    // blocks that do not fit leave the maps to be shipped, untouched
+    assert(combiner.compactOutputPage(smallPage, 256) == 0);
+    assert(((Record<Vector<Handle<Object>>>*)outputPage)->numBytes() == mapBytes);
+    Handle<Vector<Handle<AggregationMap<KeyType, int>>>> maps =
+        ((Record<Vector<Handle<AggregationMap<KeyType, int>>>>*)outputPage)->getRootObject();
+    assert(maps->size() == NUM_PARTITIONS);
+    for (int p = 0; p < NUM_PARTITIONS; p++) {
+        assert((*maps)[p]->size() == NUM_KEYS_PER_PARTITION);
+    }
+    maps = nullptr;
+
+    size_t blockBytes = combiner.compactOutputPage(compactPage, PAGE_SIZE);
+    assert(blockBytes > 0);
+    assert(blockBytes < mapBytes);
+    combiner.clearOutputPage();
+
+    Handle<Vector<Handle<Object>>> blocks =
+        ((Record<Vector<Handle<Object>>>*)compactPage)->getRootObject();
+    assert(blocks->size() == NUM_PARTITIONS);
+    for (int p = 0; p < NUM_PARTITIONS; p++) {
+        Handle<Object>& object = (*blocks)[p];
+        assert((ColumnBlock<KeyType, int>::isColumnBlock(object)));
+        ColumnBlock<KeyType, int> block;
+        block.attach(object);
+        assert(block.getHashPartitionId() == (HashPartitionID)p);
+        assert(block.size() == NUM_KEYS_PER_PARTITION);
+        std::map<std::string, int> pairs;
+        size_t which = 0;
+        block.forEachPair(which, [&](KeyType key, int value) { pairs[getKeyName(key)] = value; });
+        assert(which == NUM_KEYS_PER_PARTITION);
+        assert(pairs.size() == NUM_KEYS_PER_PARTITION);
+        for (int i = p * NUM_KEYS_PER_PARTITION; i < (p + 1) * NUM_KEYS_PER_PARTITION; i++) {
+            KeyType key;
+            makeKey(i, key);
+            assert(pairs[getKeyName(key)] == 2 * i);
+        }
+        block.clear();
+    }
+    blocks = nullptr;
+
+    free(inputPage);
+    free(outputPage);
+    free(compactPage);
+    free(smallPage);
+    std::cout << "round trip with " << name << " keys: ok" << std::endl;
+}
+
+int main() {
+    makeObjectAllocatorBlock(64 * 1024 * 1024, true);
+
+    // a map of objects has no column layout, and is always shipped as a map
+    assert((!ColumnBlock<int, Vector<int>>::isSupported()));
+    assert((ColumnBlock<String, double>::isSupported()));
+
+    testRoundTrip<int>("int");
+    testRoundTrip<String>("String");
+    std::cout << "ColumnBlockTest: all ok" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,228 @@
+
+#ifndef EXPORT_IMPORT_SET_TEST_CC
+#define EXPORT_IMPORT_SET_TEST_CC
+
+// tests the "binary" export of sets: the files that ExportedSetFile writes read back as they were
+// written, and malformed files are rejected; with a cluster running, a set exported in the binary
+// format and loaded by StorageClient::importSet into another set holds the same objects
+
+#include "ExportedSetFile.h"
+#include "PDBClient.h"
+#include "StorageClient.h"
+#include "SharedEmployee.h"
+#include "PDBVector.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <cassert>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define NUM_RECORDS 3
+#define RECORD_SIZE (64 * 1024)
+
+using namespace pdb;
+
+// writes a record of a page with the given number of ints
+std::vector<char> makeRecord(int numInts) {
+    std::vector<char> page(RECORD_SIZE);
+    const UseTemporaryAllocationBlock block{page.data(), page.size()};
+    Handle<Vector<int>> ints = makeObject<Vector<int>>(numInts);
+    for (int i = 0; i < numInts; i++) {
+        ints->push_back(i);
+    }
+    Record<Vector<int>>* record = getRecord(ints);
+    page.resize(record->numBytes());
+    return page;
+}
+
+// writes a file with the records and the given bytes after them
+void writeFile(std::string path, std::vector<std::vector<char>>& records, std::string tail) {
+    FILE* file = fopen(path.c_str(), "w");
+    assert(file != NULL);
+    assert(ExportedSetFile::writeHeader(file, "pdb::Vector<int>", "a1b2"));
+    for (size_t i = 0; i < records.size(); i++) {
+        assert(ExportedSetFile::writeRecord(file, records[i].data(), records[i].size()));
+    }
+    fwrite(tail.data(), 1, tail.size(), file);
+    fclose(file);
+}
+
+// reads the records of a file; returns false with errMsg if the file is malformed
+bool readFile(std::string path, std::vector<std::vector<char>>& records, std::string& errMsg) {
+    FILE* file = fopen(path.c_str(), "r");
+    assert(file != NULL);
+    std::string typeName;
+    std::string schema;
+    errMsg = "";
+    bool success = ExportedSetFile::readHeader(file, typeName, schema, errMsg);
+    if (success == true) {
+        assert(typeName == "pdb::Vector<int>");
+        assert(schema == "a1b2");
+        char* record;
+        size_t numBytes;
+        while (ExportedSetFile::readRecord(file, record, numBytes, errMsg)) {
+            records.push_back(std::vector<char>(record, record + numBytes));
+            free(record);
+        }
+        success = (errMsg == "");
+    }
+    fclose(file);
+    return success;
+}
+
+void testFormat() {
+    std::string path = "exportImportSetTest.0";
+    std::vector<std::vector<char>> records;
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        records.push_back(makeRecord(100 * (i + 1)));
+    }
+    std::string errMsg;
+
+    // the records read back as they were written
+    writeFile(path, records, "");
+    std::vector<std::vector<char>> readBack;
+    assert(readFile(path, readBack, errMsg));
+    assert(readBack == records);
+    Handle<Vector<int>> ints = ((Record<Vector<int>>*)readBack[1].data())->getRootObject();
+    assert(ints->size() == 200);
+    assert((*ints)[199] == 199);
+    ints = nullptr;
+
+    // a record cut short
+    std::string length(sizeof(uint64_t), 0);
+    *((uint64_t*)&length[0]) = RECORD_SIZE;
+    writeFile(path, records, length + "short");
+    readBack.clear();
+    assert(!readFile(path, readBack, errMsg));
+    assert(readBack.size() == NUM_RECORDS);
+
+    // a length that does not match the size that the record starts with
+    std::vector<char> bad = records[0];
+    *((size_t*)bad.data()) = bad.size() + 1;
+    std::vector<std::vector<char>> badRecords(1, bad);
+    writeFile(path, badRecords, "");
+    readBack.clear();
+    assert(!readFile(path, readBack, errMsg));
+    assert(readBack.empty());
+
+    // raw records without a header, as the binary format was written before
+    FILE* file = fopen(path.c_str(), "w");
+    fwrite(records[0].data(), 1, records[0].size(), file);
+    fclose(file);
+    assert(!readFile(path, readBack, errMsg));
+    remove(path.c_str());
+    std::cout << "format: ok" << std::endl;
+}
+
+// counts the objects in the files of a set exported in the binary format
+size_t countExportedObjects(std::string path) {
+    size_t numObjects = 0;
+    for (int i = 0; true; i++) {
+        FILE* file = fopen((path + "." + std::to_string(i)).c_str(), "r");
+        if (file == NULL) {
+            break;
+        }
+        std::string typeName;
+        std::string schema;
+        std::string errMsg;
+        assert(ExportedSetFile::readHeader(file, typeName, schema, errMsg));
+        assert(typeName != "");
+        char* record;
+        size_t numBytes;
+        while (ExportedSetFile::readRecord(file, record, numBytes, errMsg)) {
+            numObjects += ((Record<Vector<Handle<Object>>>*)record)->getRootObject()->size();
+            free(record);
+        }
+        assert(errMsg == "");
+        fclose(file);
+    }
+    return numObjects;
+}
+
+// stops the test if a request to the cluster failed
+void check(bool success, std::string what, std::string& errMsg) {
+    if (success == false) {
+        std::cout << "Failed to " << what << ": " << errMsg << std::endl;
+        exit(-1);
+    }
+}
+
+// exports a set, imports the files into a new set on a storage node, and exports that set
+void testRoundTrip(std::string managerIp, int storagePort) {
+    PDBLoggerPtr clientLogger = make_shared<PDBLogger>("clientLog");
+    PDBClient pdbClient(8108, managerIp, clientLogger, false, true);
+    std::string errMsg;
+    pdbClient.registerType("libraries/libSharedEmployee.so", errMsg);
+    check(pdbClient.createDatabase("export_db", errMsg), "create database", errMsg);
+    check(pdbClient.createSet<SharedEmployee>("export_db", "export_set", errMsg),
+          "create set",
+          errMsg);
+    check(pdbClient.createSet<SharedEmployee>("export_db", "import_set", errMsg),
+          "create set",
+          errMsg);
+
+    int numObjects = 0;
+    for (int num = 0; num < 4; num++) {
+        makeObjectAllocatorBlock(4 * 1024 * 1024, true);
+        Handle<Vector<Handle<SharedEmployee>>> storeMe =
+            makeObject<Vector<Handle<SharedEmployee>>>();
+        try {
+            for (int i = 0; true; i++) {
+                Handle<SharedEmployee> myData =
+                    makeObject<SharedEmployee>("Joe Johnson" + to_string(i), i + 45);
+                storeMe->push_back(myData);
+                numObjects++;
+            }
+        } catch (NotEnoughSpace& n) {
+            check(pdbClient.sendData<SharedEmployee>(
+                      std::pair<std::string, std::string>("export_set", "export_db"),
+                      storeMe,
+                      errMsg),
+                  "send data",
+                  errMsg);
+        }
+    }
+    check(pdbClient.flushData(errMsg), "flush data", errMsg);
+
+    // the storage node writes the files on its own disk
+    check(pdbClient.exportSet("export_db", "export_set", "/tmp/export_set", "binary", errMsg),
+          "export set",
+          errMsg);
+    assert(countExportedObjects("/tmp/export_set") == (size_t)numObjects);
+
+    StorageClient storageClient(storagePort, managerIp, clientLogger, true);
+    check(storageClient.importSet("export_db", "import_set", "", "/tmp/export_set", errMsg),
+          "import set",
+          errMsg);
+    assert(!storageClient.importSet(
+        "export_db", "import_set", "SharedEmployee", "/tmp/no_such_export", errMsg));
+    check(pdbClient.exportSet("export_db", "import_set", "/tmp/import_set", "binary", errMsg),
+          "export imported set",
+          errMsg);
+    assert(countExportedObjects("/tmp/import_set") == (size_t)numObjects);
+
+    check(pdbClient.removeDatabase("export_db", errMsg), "remove database", errMsg);
+    std::cout << "round trip of " << numObjects << " objects: ok" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "Usage: #roundTrip[Y/N] #managerIp #storagePort" << std::endl;
+    makeObjectAllocatorBlock(16 * 1024 * 1024, true);
+    testFormat();
+
+    // the round trip needs a cluster whose storage node runs on this machine
+    if ((argc > 1) && (strcmp(argv[1], "Y") == 0)) {
+        std::string managerIp = (argc > 2) ? argv[2] : "localhost";
+        int storagePort = (argc > 3) ? atoi(argv[3]) : 8109;
+        testRoundTrip(managerIp, storagePort);
+    }
+    std::cout << "ExportImportSetTest: all ok" << std::endl;
+    return 0;
+}
+
+#endif
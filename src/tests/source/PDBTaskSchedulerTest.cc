@@ -0,0 +1,197 @@
+
+#ifndef PDB_TASK_SCHEDULER_TEST_CC
+#define PDB_TASK_SCHEDULER_TEST_CC
+
+// tests the work-stealing PDBTaskScheduler without a worker queue: the runners are plain threads
+// that call runTasks (); checks that every task runs once, that nested fan-outs do not deadlock
+// even with a single runner, that idle runners steal, continuations, PDBWork tasks, and shutdown
+
+#include "GenericWork.h"
+#include "PDBTaskScheduler.h"
+
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define NUM_TASKS 10000
+
+using namespace pdb;
+
+// runs a scheduler on numRunners threads for the duration of a test
+class SchedulerRunners {
+public:
+    SchedulerRunners(int numRunners, PDBLoggerPtr logger) {
+        scheduler = make_shared<PDBTaskScheduler>(nullptr, numRunners, logger);
+        for (int i = 0; i < numRunners; i++) {
+            threads.emplace_back([this, i] { scheduler->runTasks(i); });
+        }
+    }
+
+    ~SchedulerRunners() {
+        scheduler->shutDown();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    PDBTaskSchedulerPtr scheduler;
+
+    std::vector<std::thread> threads;
+};
+
+// every task submitted from outside the runners runs exactly once
+void testAllTasksRun(PDBLoggerPtr logger) {
+    SchedulerRunners runners(4, logger);
+    std::vector<std::atomic<int>> timesRun(NUM_TASKS);
+    std::vector<PDBTaskFuturePtr> futures;
+    for (int i = 0; i < NUM_TASKS; i++) {
+        futures.push_back(runners.scheduler->submit([&timesRun, i] { timesRun[i]++; }));
+    }
+    for (auto& future : futures) {
+        future->wait();
+        assert(future->isDone());
+    }
+    for (auto& times : timesRun) {
+        assert(times == 1);
+    }
+    std::cout << "all tasks run: ok" << std::endl;
+}
+
+// a task that fans out and waits for its children does not deadlock, even on a single runner
+void testNestedFanOut(PDBLoggerPtr logger) {
+    SchedulerRunners runners(1, logger);
+    PDBTaskSchedulerPtr scheduler = runners.scheduler;
+    std::atomic<int> numLeaves{0};
+    PDBTaskFuturePtr root = scheduler->submit([scheduler, &numLeaves] {
+        assert(scheduler->isRunner());
+        std::vector<PDBTaskFuturePtr> children;
+        for (int i = 0; i < 8; i++) {
+            children.push_back(scheduler->submit([scheduler, &numLeaves] {
+                std::vector<PDBTaskFuturePtr> leaves;
+                for (int j = 0; j < 8; j++) {
+                    leaves.push_back(scheduler->submit([&numLeaves] { numLeaves++; }));
+                }
+                for (auto& leaf : leaves) {
+                    leaf->wait();
+                }
+            }));
+        }
+        for (auto& child : children) {
+            child->wait();
+        }
+    });
+    root->wait();
+    assert(numLeaves == 64);
+    assert(!scheduler->isRunner());
+    std::cout << "nested fan-out: ok" << std::endl;
+}
+
+// tasks spawned by one runner are stolen by the idle ones
+void testStealing(PDBLoggerPtr logger) {
+    SchedulerRunners runners(4, logger);
+    PDBTaskSchedulerPtr scheduler = runners.scheduler;
+    std::mutex threadsMutex;
+    std::set<std::thread::id> threadsUsed;
+    PDBTaskFuturePtr root = scheduler->submit([&] {
+        std::vector<PDBTaskFuturePtr> children;
+        for (int i = 0; i < 64; i++) {
+            children.push_back(scheduler->submit([&] {
+                usleep(1000);
+                std::lock_guard<std::mutex> guard(threadsMutex);
+                threadsUsed.insert(std::this_thread::get_id());
+            }));
+        }
+        for (auto& child : children) {
+            child->wait();
+        }
+    });
+    root->wait();
+    assert(threadsUsed.size() > 1);
+    std::cout << "stealing: ok (" << threadsUsed.size() << " runners)" << std::endl;
+}
+
+// continuations run after their task, also when attached to a future that is already done
+void testContinuations(PDBLoggerPtr logger) {
+    SchedulerRunners runners(2, logger);
+    PDBTaskSchedulerPtr scheduler = runners.scheduler;
+    std::atomic<int> step{0};
+    std::atomic<bool> inOrder{true};
+    PDBBuzzerPtr buzzer = make_shared<PDBBuzzer>([](PDBAlarm myAlarm) {});
+    PDBTaskFuturePtr first = scheduler->submit([&] {
+        usleep(10000);
+        step = 1;
+    });
+    first->then([&] {
+        if (step != 1) {
+            inOrder = false;
+        }
+        step = 2;
+        buzzer->buzz(PDBAlarm::WorkAllDone);
+    });
+    while (step != 2) {
+        buzzer->wait();
+    }
+    assert(inOrder);
+
+    first->then([&] {
+        step = 3;
+        buzzer->buzz(PDBAlarm::WorkAllDone);
+    });
+    while (step != 3) {
+        buzzer->wait();
+    }
+    std::cout << "continuations: ok" << std::endl;
+}
+
+// a PDBWork submitted as a task buzzes its buzzer, as if it was run by a worker
+void testWork(PDBLoggerPtr logger) {
+    SchedulerRunners runners(2, logger);
+    std::atomic_int counter{0};
+    PDBBuzzerPtr buzzer =
+        make_shared<PDBBuzzer>([](PDBAlarm myAlarm, std::atomic_int& counter) { counter++; });
+    for (int i = 0; i < 16; i++) {
+        PDBWorkPtr work = make_shared<GenericWork>([&counter](PDBBuzzerPtr callerBuzzer) {
+            callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
+        });
+        runners.scheduler->submit(work, buzzer);
+    }
+    while (counter < 16) {
+        buzzer->wait();
+    }
+    assert(counter == 16);
+    std::cout << "work: ok" << std::endl;
+}
+
+// shutting down lets the runners finish the queued tasks before they exit
+void testShutDown(PDBLoggerPtr logger) {
+    std::atomic<int> numRun{0};
+    {
+        SchedulerRunners runners(2, logger);
+        for (int i = 0; i < 100; i++) {
+            runners.scheduler->submit([&numRun] {
+                usleep(100);
+                numRun++;
+            });
+        }
+    }
+    assert(numRun == 100);
+    std::cout << "shut down: ok" << std::endl;
+}
+
+int main() {
+    PDBLoggerPtr logger = make_shared<PDBLogger>("taskSchedulerTest.log");
+    testAllTasksRun(logger);
+    testNestedFanOut(logger);
+    testStealing(logger);
+    testContinuations(logger);
+    testWork(logger);
+    testShutDown(logger);
+    std::cout << "PDBTaskSchedulerTest: all tests passed" << std::endl;
+    return 0;
+}
+
+#endif
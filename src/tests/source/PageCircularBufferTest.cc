@@ -0,0 +1,219 @@
+
+#ifndef PAGE_CIRCULAR_BUFFER_TEST_CC
+#define PAGE_CIRCULAR_BUFFER_TEST_CC
+
+// tests the lock-free PageCircularBuffer: the order of pages, batch push and pop, many producers
+// and consumers, and that close and pops wake up the threads that sleep on the buffer
+
+#include "PageCircularBuffer.h"
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define NUM_PRODUCERS 4
+#define NUM_CONSUMERS 4
+#define NUM_PAGES_PER_PRODUCER 20000
+
+using namespace pdb;
+
+// the header of a page, which the page reads when it is created
+std::vector<char*> pageHeaders;
+
+PDBPagePtr makePage(PageID pageId) {
+    char* header = (char*)calloc(1, 128);
+    pageHeaders.push_back(header);
+    PDBPagePtr page = make_shared<PDBPage>(header, 0);
+    page->setPageID(pageId);
+    return page;
+}
+
+// pages come out in the order they went in, whether pushed and popped one by one or in batches
+void testOrder(PDBLoggerPtr logger) {
+    PageCircularBuffer buffer(8, logger);
+    assert(buffer.isEmpty());
+    for (PageID i = 0; i < 5; i++) {
+        buffer.addPageToTail(makePage(i));
+    }
+    std::vector<PDBPagePtr> pages;
+    for (PageID i = 5; i < 8; i++) {
+        pages.push_back(makePage(i));
+    }
+    buffer.addPagesToTail(pages);
+    assert(buffer.isFull());
+    assert(buffer.getSize() == 8);
+
+    assert(buffer.popPageFromHead()->getPageID() == 0);
+    std::vector<PDBPagePtr> popped;
+    assert(buffer.popPagesFromHead(popped, 4) == 4);
+    assert(buffer.popPagesFromHead(popped, 10) == 3);
+    for (PageID i = 0; i < 7; i++) {
+        assert(popped[i]->getPageID() == i + 1);
+    }
+    assert(buffer.isEmpty());
+    std::cout << "order: ok" << std::endl;
+}
+
+// closing a buffer lets consumers drain the pages left, and then they get nothing
+void testCloseDrains(PDBLoggerPtr logger) {
+    PageCircularBuffer buffer(8, logger);
+    for (PageID i = 0; i < 3; i++) {
+        buffer.addPageToTail(makePage(i));
+    }
+    buffer.close();
+    std::vector<PDBPagePtr> popped;
+    assert(buffer.popPagesFromHead(popped, 2) == 2);
+    assert(buffer.popPageFromHead()->getPageID() == 2);
+    assert(buffer.popPageFromHead() == nullptr);
+    assert(buffer.popPagesFromHead(popped, 2) == 0);
+    std::cout << "close drains: ok" << std::endl;
+}
+
+// consumers sleeping on an empty buffer are woken up by close
+void testCloseWakesConsumers(PDBLoggerPtr logger) {
+    PageCircularBuffer buffer(4, logger);
+    std::vector<std::thread> consumers;
+    std::atomic<int> numDone{0};
+    for (int i = 0; i < NUM_CONSUMERS; i++) {
+        consumers.emplace_back([&] {
+            assert(buffer.popPageFromHead() == nullptr);
+            numDone++;
+        });
+    }
+    usleep(100000);
+    assert(numDone == 0);
+    buffer.close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    assert(numDone == NUM_CONSUMERS);
+    std::cout << "close wakes consumers: ok" << std::endl;
+}
+
+// a producer sleeping on a full buffer is woken up by a pop, and a consumer sleeping on an
+// empty buffer is woken up by a push
+void testWakeUp(PDBLoggerPtr logger) {
+    PageCircularBuffer buffer(2, logger);
+    buffer.addPageToTail(makePage(0));
+    buffer.addPageToTail(makePage(1));
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        buffer.addPageToTail(makePage(2));
+        pushed = true;
+    });
+    usleep(100000);
+    assert(!pushed);
+    assert(buffer.popPageFromHead()->getPageID() == 0);
+    producer.join();
+    assert(pushed);
+    assert(buffer.popPageFromHead()->getPageID() == 1);
+    assert(buffer.popPageFromHead()->getPageID() == 2);
+
+    PDBPagePtr page = makePage(3);
+    std::atomic<bool> popped{false};
+    std::thread consumer([&] {
+        assert(buffer.popPageFromHead()->getPageID() == 3);
+        popped = true;
+    });
+    usleep(100000);
+    assert(!popped);
+    buffer.addPageToTail(page);
+    consumer.join();
+    assert(popped);
+    std::cout << "wake up: ok" << std::endl;
+}
+
+// every page pushed by many producers is popped exactly once by many consumers, and the pages
+// of each producer come out in the order it pushed them
+void testManyProducersAndConsumers(PDBLoggerPtr logger) {
+    PageCircularBuffer buffer(16, logger);
+    std::vector<PDBPagePtr> pages;
+    for (PageID i = 0; i < NUM_PRODUCERS * NUM_PAGES_PER_PRODUCER; i++) {
+        pages.push_back(makePage(i));
+    }
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; p++) {
+        producers.emplace_back([&, p] {
+            int i = 0;
+            while (i < NUM_PAGES_PER_PRODUCER) {
+                // mix single and batch pushes
+                if (i % 3 == 0) {
+                    buffer.addPageToTail(pages[p * NUM_PAGES_PER_PRODUCER + i]);
+                    i++;
+                } else {
+                    std::vector<PDBPagePtr> batch;
+                    for (int j = 0; j < 5 && i < NUM_PAGES_PER_PRODUCER; j++, i++) {
+                        batch.push_back(pages[p * NUM_PAGES_PER_PRODUCER + i]);
+                    }
+                    buffer.addPagesToTail(batch);
+                }
+            }
+        });
+    }
+
+    std::vector<std::vector<PageID>> consumed(NUM_CONSUMERS);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < NUM_CONSUMERS; c++) {
+        consumers.emplace_back([&, c] {
+            std::vector<PDBPagePtr> popped;
+            while (true) {
+                popped.clear();
+                if (c % 2 == 0) {
+                    PDBPagePtr page = buffer.popPageFromHead();
+                    if (page == nullptr) {
+                        break;
+                    }
+                    popped.push_back(page);
+                } else if (buffer.popPagesFromHead(popped, 7) == 0) {
+                    break;
+                }
+                for (auto& page : popped) {
+                    consumed[c].push_back(page->getPageID());
+                }
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    buffer.close();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    std::vector<int> timesSeen(NUM_PRODUCERS * NUM_PAGES_PER_PRODUCER, 0);
+    for (int c = 0; c < NUM_CONSUMERS; c++) {
+        std::vector<long> lastSeen(NUM_PRODUCERS, -1);
+        for (PageID pageId : consumed[c]) {
+            timesSeen[pageId]++;
+            long producer = pageId / NUM_PAGES_PER_PRODUCER;
+            assert((long)pageId > lastSeen[producer]);
+            lastSeen[producer] = pageId;
+        }
+    }
+    for (int times : timesSeen) {
+        assert(times == 1);
+    }
+    assert(buffer.isEmpty());
+    std::cout << "many producers and consumers: ok" << std::endl;
+}
+
+int main() {
+    PDBLoggerPtr logger = make_shared<PDBLogger>("pageCircularBufferTest.log");
+    testOrder(logger);
+    testCloseDrains(logger);
+    testCloseWakesConsumers(logger);
+    testWakeUp(logger);
+    testManyProducersAndConsumers(logger);
+    for (char* header : pageHeaders) {
+        free(header);
+    }
+    std::cout << "PageCircularBufferTest: all tests passed" << std::endl;
+    return 0;
+}
+
+#endif
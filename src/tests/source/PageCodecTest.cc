@@ -0,0 +1,174 @@
+
+#ifndef PAGE_CODEC_TEST_CC
+#define PAGE_CODEC_TEST_CC
+
+// tests PageCodec and ShuffleCodecPolicy: frames of every codec decompress into the page they
+// were made from, raw snappy from the dispatcher is still accepted, malformed frames are rejected,
+// and the adaptive policy stops and starts compressing as the costs it is told about change
+
+#include "PageCodec.h"
+#include "ShuffleCodecPolicy.h"
+
+#include <snappy.h>
+
+#include <cassert>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define PAGE_SIZE (256 * 1024)
+
+using namespace pdb;
+
+// a page that compresses well, like the pages of records that the combiners write
+std::vector<char> makePage() {
+    std::vector<char> page(PAGE_SIZE);
+    for (size_t i = 0; i < page.size(); i++) {
+        page[i] = (i % 64 < 48) ? 0 : (char)(i % 7);
+    }
+    return page;
+}
+
+void testRoundTrip(PageCodecType codec, int level) {
+    std::vector<char> page = makePage();
+    char* frame = PageCodec::getBuffer(PageCodec::maxFrameSize(codec, page.size()));
+    size_t frameSize = PageCodec::compress(codec, level, page.data(), page.size(), frame);
+
+    // codecs that this build lacks fall back to snappy, and the frame says so
+    PageCodecType usedCodec = PageCodec::isAvailable(codec) ? codec : SnappyCodec;
+    assert(PageCodec::getCodec(frame, frameSize) == usedCodec);
+    assert(PageCodec::getPageSize(frame, frameSize) == page.size());
+    if (usedCodec != NoCodec) {
+        assert(frameSize < page.size());
+    }
+
+    std::vector<char> dest(page.size());
+    assert(PageCodec::decompress(frame, frameSize, dest.data(), dest.size()));
+    assert(memcmp(dest.data(), page.data(), page.size()) == 0);
+
+    // the page does not fit into a smaller buffer
+    assert(!PageCodec::decompress(frame, frameSize, dest.data(), dest.size() - 1));
+
+    // a frame cut short is rejected
+    assert(!PageCodec::decompress(frame, frameSize - 1, dest.data(), dest.size()));
+    PageCodec::releaseBuffer(frame);
+    std::cout << "round trip " << PageCodec::getName(codec, level) << ": ok" << std::endl;
+}
+
+// the dispatcher sends raw snappy without a frame header
+void testRawSnappy() {
+    std::vector<char> page = makePage();
+    std::vector<char> compressed(snappy::MaxCompressedLength(page.size()));
+    size_t compressedSize = 0;
+    snappy::RawCompress(page.data(), page.size(), compressed.data(), &compressedSize);
+
+    assert(PageCodec::getCodec(compressed.data(), compressedSize) == SnappyCodec);
+    assert(PageCodec::getPageSize(compressed.data(), compressedSize) == page.size());
+    std::vector<char> dest(page.size());
+    assert(PageCodec::decompress(compressed.data(), compressedSize, dest.data(), dest.size()));
+    assert(memcmp(dest.data(), page.data(), page.size()) == 0);
+    assert(!PageCodec::decompress(compressed.data(), compressedSize, dest.data(), dest.size() / 2));
+    std::cout << "raw snappy: ok" << std::endl;
+}
+
+// a snappy frame whose header claims a smaller page than its stream holds must not be written
+// past that size
+void testSnappyLengthMismatch() {
+    std::vector<char> page = makePage();
+    char* frame = PageCodec::getBuffer(PageCodec::maxFrameSize(SnappyCodec, page.size()));
+    size_t frameSize = PageCodec::compress(SnappyCodec, 0, page.data(), page.size(), frame);
+
+    // the header sits at the start of the frame, and its page size is its last field
+    size_t headerSize = PageCodec::maxFrameSize(NoCodec, 0);
+    uint64_t* pageSize = (uint64_t*)(frame + headerSize - sizeof(uint64_t));
+    assert(*pageSize == page.size());
+    *pageSize = page.size() / 2;
+    std::vector<char> dest(page.size() / 2);
+    assert(!PageCodec::decompress(frame, frameSize, dest.data(), dest.size()));
+
+    // an uncompressed frame must hold exactly the page
+    frameSize = PageCodec::compress(NoCodec, 0, page.data(), page.size(), frame);
+    *pageSize = page.size() / 2;
+    assert(!PageCodec::decompress(frame, frameSize, dest.data(), dest.size()));
+    PageCodec::releaseBuffer(frame);
+    std::cout << "length mismatch: ok" << std::endl;
+}
+
+void testParse() {
+    PageCodecType codec;
+    int level;
+    assert(PageCodec::parse("none", codec, level) && codec == NoCodec);
+    assert(PageCodec::parse("snappy", codec, level) && codec == SnappyCodec);
+    assert(PageCodec::parse("lz4", codec, level) && codec == LZ4Codec);
+    assert(PageCodec::parse("zstd", codec, level) && codec == ZstdCodec &&
+           level == PDB_DEFAULT_ZSTD_LEVEL);
+    assert(PageCodec::parse("zstd:3", codec, level) && codec == ZstdCodec && level == 3);
+    assert(!PageCodec::parse("gzip", codec, level));
+    std::cout << "parse: ok" << std::endl;
+}
+
+// a fixed codec is always used, an adaptive one only while compression pays
+void testPolicy() {
+    int level;
+    ShuffleCodecPolicy fixed("snappy");
+    assert(fixed.getName() == "snappy");
+    fixed.recordCompression(SnappyCodec, 1000, 900, 1000000);
+    fixed.recordSend(1000, 1);
+    assert(fixed.nextCodec(level) == SnappyCodec);
+
+    ShuffleCodecPolicy none("adaptive:none");
+    assert(none.getName() == "none");
+    assert(none.nextCodec(level) == NoCodec);
+
+    ShuffleCodecPolicy adaptive("adaptive:zstd:2");
+    assert(adaptive.getName() == "adaptive:zstd:2");
+    assert(adaptive.nextCodec(level) == ZstdCodec && level == 2);
+
+    // compressing costs more than the bytes it saves take to send: stop, but probe now and then
+    adaptive.recordCompression(ZstdCodec, 1000, 500, 100000);
+    adaptive.recordSend(1000, 1000);
+    int numCompressed = 0;
+    for (int i = 0; i < PDB_ADAPTIVE_PROBE_INTERVAL * 4; i++) {
+        if (adaptive.nextCodec(level) != NoCodec) {
+            numCompressed++;
+        }
+    }
+    assert(numCompressed == 4);
+
+    // the network gets slow: compressing pays again
+    for (int i = 0; i < 32; i++) {
+        adaptive.recordCompression(ZstdCodec, 1000, 500, 1000);
+        adaptive.recordSend(1000, 1000000);
+    }
+    assert(adaptive.nextCodec(level) == ZstdCodec);
+
+    // pages that hardly shrink are not worth compressing, however slow the network is
+    for (int i = 0; i < 32; i++) {
+        adaptive.recordCompression(ZstdCodec, 1000, 990, 1000);
+        adaptive.recordSend(1000, 1000000);
+    }
+    assert(adaptive.nextCodec(level) == NoCodec);
+
+    // a spec that can not be parsed is taken as adaptive with the default codec
+    ShuffleCodecPolicy unknown("gzip");
+    PageCodecType defaultCodec = PageCodec::isAvailable(LZ4Codec) ? LZ4Codec : SnappyCodec;
+    assert(unknown.getName() == "adaptive:" + PageCodec::getName(defaultCodec, 0));
+    std::cout << "policy: ok" << std::endl;
+}
+
+int main() {
+    testRoundTrip(NoCodec, 0);
+    testRoundTrip(SnappyCodec, 0);
+    testRoundTrip(LZ4Codec, 0);
+    testRoundTrip(ZstdCodec, PDB_DEFAULT_ZSTD_LEVEL);
+    testRoundTrip(ZstdCodec, 9);
+    testRawSnappy();
+    testSnappyLengthMismatch();
+    testParse();
+    testPolicy();
+    std::cout << "PageCodecTest: all ok" << std::endl;
+    return 0;
+}
+
+#endif
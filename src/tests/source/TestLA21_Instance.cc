@@ -40,10 +40,7 @@ int main(int argc, char** argv) {
         std::cout << myStatements->get(i)->toString() << std::endl;
     }
     std::cout << "Start executation:" << std::endl;
-    for (int i = 0; i < myStatements->size(); i++) {
-        std::cout << "Current statement:" << myStatements->get(i)->toString() << std::endl;
-        myStatements->get(i)->evaluateQuery(instance);
-    }
+    myStatements->evaluateProgram(instance);
     instance.clearCachedSets();
     int code = system("scripts/cleanupSoFiles.sh");
     if (code < 0) {
@@ -0,0 +1,113 @@
+#ifndef PDB_EXECUTION_PROFILER_H
+#define PDB_EXECUTION_PROFILER_H
+
+#include <map>
+#include <string>
+#include <time.h>
+
+namespace pdb {
+
+// the counters of one operator
+struct OperatorProfile {
+
+    // how often the operator ran
+    long numCalls = 0;
+
+    // the total time spent in the operator
+    long nanos = 0;
+
+    long rowsIn = 0;
+
+    long rowsOut = 0;
+
+    long bytes = 0;
+
+    // events counted by the operator that are neither rows nor bytes, e.g. TLB misses
+    long count = 0;
+};
+
+// This class collects, for each operator of a stage (a ComputeExecutor or sink in a pipeline,
+// page pin/unpin, shuffle send, combiner merge, ...), how often it ran, how long it took, and
+// how many rows and bytes it processed, or how many events it counted. Each thread records into its own counters, so that
+// recording never contends with other threads; the counters of all threads are merged into a
+// summary when a stage completes, which is shipped back with the stage result, so that the
+// scheduler can assemble the profile of the whole job.
+//
+// Operators are named by a string literal or by a name returned by intern(), so that a thread
+// can find its counters by comparing pointers rather than strings.
+//
+// Stages may run at the same time in one process, so counters are kept per stage: each thread
+// records into the stage it currently works for, which is set with a StageScope by the handler
+// of the stage, and is passed on to the PDBWorkers and tasks that the thread starts.
+//
+// A summary is a string with one operator per line:
+//     name\tnumCalls\tnanos\trowsIn\trowsOut\tbytes\tcount
+
+class ExecutionProfiler {
+
+public:
+    // returns a timestamp in nanoseconds, to measure the time spent in an operator
+    static long now() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1000000000L + ts.tv_nsec;
+    }
+
+    // returns a name for operators whose name is built at run time; the name lives as long as
+    // the process, and equal names give the same pointer, so this is best called once per
+    // operator, outside of any loop
+    static const char* intern(const std::string& name);
+
+    // returns the key of a stage, which is the same for equal job and stage ids
+    static const char* getStageKey(const std::string& jobId, long stageId);
+
+    // returns the stage the calling thread works for, nullptr if none
+    static const char* getStage();
+
+    // sets the stage the calling thread works for, nullptr if none
+    static void setStage(const char* stage);
+
+    // has the calling thread work for a stage while the scope lives
+    class StageScope {
+    public:
+        StageScope(const char* stage) : previous(getStage()) {
+            setStage(stage);
+        }
+
+        ~StageScope() {
+            setStage(previous);
+        }
+
+    private:
+        const char* previous;
+    };
+
+    // adds one call of an operator to the counters of the calling thread; name must be a string
+    // literal or a name returned by intern()
+    static void record(const char* name,
+                       long nanos,
+                       long rowsIn = 0,
+                       long rowsOut = 0,
+                       long bytes = 0);
+
+    // adds events counted by an operator, e.g. hardware counters, to the counters of the
+    // calling thread; name must be a string literal or a name returned by intern()
+    static void count(const char* name, long count);
+
+    // clears the counters of a stage in all threads, called when the stage starts
+    static void reset(const char* stage);
+
+    // merges the counters of a stage in all threads into a summary and clears them, called when
+    // the stage completes
+    static std::string collect(const char* stage);
+
+    // parses a summary and adds its counters to the given counters
+    static void merge(std::string summary, std::map<std::string, OperatorProfile>& profiles);
+
+    // formats counters for printing, one operator per line, each line starting with indent
+    static std::string format(std::map<std::string, OperatorProfile>& profiles,
+                              std::string indent);
+};
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef PDB_HARDWARE_COUNTERS_H
+#define PDB_HARDWARE_COUNTERS_H
+
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <string>
+
+namespace pdb {
+
+// This class counts the TLB misses and page faults incurred by the calling thread between
+// start () and stop (). TLB misses are read via perf_event_open, and are reported as -1 if
+// the kernel does not allow it (e.g. in a container, or with perf_event_paranoid > 2);
+// page faults are read via getrusage, which always works.
+
+class HardwareCounters {
+
+public:
+    HardwareCounters() {
+        dTLBFd = openCounter(PERF_COUNT_HW_CACHE_DTLB);
+        iTLBFd = openCounter(PERF_COUNT_HW_CACHE_ITLB);
+    }
+
+    ~HardwareCounters() {
+        if (dTLBFd >= 0) {
+            close(dTLBFd);
+        }
+        if (iTLBFd >= 0) {
+            close(iTLBFd);
+        }
+    }
+
+    // to start counting
+    void start() {
+        resetCounter(dTLBFd);
+        resetCounter(iTLBFd);
+        struct rusage usage;
+        getrusage(RUSAGE_THREAD, &usage);
+        minorFaults = usage.ru_minflt;
+        majorFaults = usage.ru_majflt;
+    }
+
+    // to stop counting
+    void stop() {
+        dTLBMisses = readCounter(dTLBFd);
+        iTLBMisses = readCounter(iTLBFd);
+        struct rusage usage;
+        getrusage(RUSAGE_THREAD, &usage);
+        minorFaults = usage.ru_minflt - minorFaults;
+        majorFaults = usage.ru_majflt - majorFaults;
+    }
+
+    long getDTLBMisses() {
+        return dTLBMisses;
+    }
+
+    long getITLBMisses() {
+        return iTLBMisses;
+    }
+
+    long getMinorFaults() {
+        return minorFaults;
+    }
+
+    long getMajorFaults() {
+        return majorFaults;
+    }
+
+    std::string toString() {
+        return std::string("dTLB-load-misses=") + std::to_string(dTLBMisses) +
+            std::string(", iTLB-load-misses=") + std::to_string(iTLBMisses) +
+            std::string(", minor-faults=") + std::to_string(minorFaults) +
+            std::string(", major-faults=") + std::to_string(majorFaults);
+    }
+
+private:
+    static int openCounter(int cache) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    static void resetCounter(int fd) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    static long readCounter(int fd) {
+        if (fd < 0) {
+            return -1;
+        }
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+            return -1;
+        }
+        return count;
+    }
+
+    int dTLBFd;
+    int iTLBFd;
+    long dTLBMisses = -1;
+    long iTLBMisses = -1;
+    long minorFaults = 0;
+    long majorFaults = 0;
+};
+}
+
+#endif
@@ -0,0 +1,223 @@
+#ifndef PDB_EXECUTION_PROFILER_CC
+#define PDB_EXECUTION_PROFILER_CC
+
+#include "ExecutionProfiler.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace pdb {
+
+namespace {
+
+void addTo(OperatorProfile& to, const OperatorProfile& from) {
+    to.numCalls += from.numCalls;
+    to.nanos += from.nanos;
+    to.rowsIn += from.rowsIn;
+    to.rowsOut += from.rowsOut;
+    to.bytes += from.bytes;
+    to.count += from.count;
+}
+
+struct ThreadProfile;
+
+// protects the list of thread counters and the counters of exited threads
+pthread_mutex_t registryMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// protects the interned names
+pthread_mutex_t namesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// never destroyed, since the counters of threads point to the names
+std::set<std::string>& getNames() {
+    static std::set<std::string>* names = new std::set<std::string>();
+    return *names;
+}
+
+// never destroyed, since threads may exit while static objects are destroyed
+std::vector<ThreadProfile*>& getRegistry() {
+    static std::vector<ThreadProfile*>* registry = new std::vector<ThreadProfile*>();
+    return *registry;
+}
+
+// the counters of an operator in a stage, keyed by the addresses of the stage key and the name
+typedef std::pair<const char*, const char*> StageOperator;
+
+std::map<StageOperator, OperatorProfile>& getRetiredProfiles() {
+    static std::map<StageOperator, OperatorProfile>* retired =
+        new std::map<StageOperator, OperatorProfile>();
+    return *retired;
+}
+
+// moves the counters of a stage out of profiles into merged
+void takeStage(const char* stage,
+               std::map<StageOperator, OperatorProfile>& profiles,
+               std::map<std::string, OperatorProfile>& merged) {
+    auto it = profiles.lower_bound(StageOperator(stage, nullptr));
+    while ((it != profiles.end()) && (it->first.first == stage)) {
+        addTo(merged[it->first.second], it->second);
+        it = profiles.erase(it);
+    }
+}
+
+// the counters of one thread; the mutex is only contended while a summary is collected
+struct ThreadProfile {
+
+    pthread_mutex_t mutex;
+
+    // keyed by the addresses of the stage key and of the name, see record
+    std::map<StageOperator, OperatorProfile> profiles;
+
+    ThreadProfile() {
+        pthread_mutex_init(&mutex, nullptr);
+        pthread_mutex_lock(&registryMutex);
+        getRegistry().push_back(this);
+        pthread_mutex_unlock(&registryMutex);
+    }
+
+    ~ThreadProfile() {
+        pthread_mutex_lock(&registryMutex);
+        std::vector<ThreadProfile*>& registry = getRegistry();
+        registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+        for (auto& profile : profiles) {
+            addTo(getRetiredProfiles()[profile.first], profile.second);
+        }
+        pthread_mutex_unlock(&registryMutex);
+        pthread_mutex_destroy(&mutex);
+    }
+};
+
+thread_local ThreadProfile threadProfile;
+
+// the stage the thread works for
+thread_local const char* currentStage = nullptr;
+}
+
+const char* ExecutionProfiler::getStageKey(const std::string& jobId, long stageId) {
+    return intern(jobId + ":" + std::to_string(stageId));
+}
+
+const char* ExecutionProfiler::getStage() {
+    return currentStage;
+}
+
+void ExecutionProfiler::setStage(const char* stage) {
+    currentStage = stage;
+}
+
+const char* ExecutionProfiler::intern(const std::string& name) {
+    pthread_mutex_lock(&namesMutex);
+    const char* interned = getNames().insert(name).first->c_str();
+    pthread_mutex_unlock(&namesMutex);
+    return interned;
+}
+
+void ExecutionProfiler::record(
+    const char* name, long nanos, long rowsIn, long rowsOut, long bytes) {
+    pthread_mutex_lock(&threadProfile.mutex);
+    OperatorProfile& profile = threadProfile.profiles[StageOperator(currentStage, name)];
+    profile.numCalls++;
+    profile.nanos += nanos;
+    profile.rowsIn += rowsIn;
+    profile.rowsOut += rowsOut;
+    profile.bytes += bytes;
+    pthread_mutex_unlock(&threadProfile.mutex);
+}
+
+void ExecutionProfiler::count(const char* name, long count) {
+    pthread_mutex_lock(&threadProfile.mutex);
+    OperatorProfile& profile = threadProfile.profiles[StageOperator(currentStage, name)];
+    profile.numCalls++;
+    profile.count += count;
+    pthread_mutex_unlock(&threadProfile.mutex);
+}
+
+void ExecutionProfiler::reset(const char* stage) {
+    std::map<std::string, OperatorProfile> dropped;
+    pthread_mutex_lock(&registryMutex);
+    for (ThreadProfile* thread : getRegistry()) {
+        pthread_mutex_lock(&thread->mutex);
+        takeStage(stage, thread->profiles, dropped);
+        pthread_mutex_unlock(&thread->mutex);
+    }
+    takeStage(stage, getRetiredProfiles(), dropped);
+    pthread_mutex_unlock(&registryMutex);
+}
+
+std::string ExecutionProfiler::collect(const char* stage) {
+    std::map<std::string, OperatorProfile> merged;
+    pthread_mutex_lock(&registryMutex);
+    for (ThreadProfile* thread : getRegistry()) {
+        pthread_mutex_lock(&thread->mutex);
+        takeStage(stage, thread->profiles, merged);
+        pthread_mutex_unlock(&thread->mutex);
+    }
+    takeStage(stage, getRetiredProfiles(), merged);
+    pthread_mutex_unlock(&registryMutex);
+
+    std::string summary;
+    for (auto& profile : merged) {
+        summary += profile.first + "\t" + std::to_string(profile.second.numCalls) + "\t" +
+            std::to_string(profile.second.nanos) + "\t" + std::to_string(profile.second.rowsIn) +
+            "\t" + std::to_string(profile.second.rowsOut) + "\t" +
+            std::to_string(profile.second.bytes) + "\t" + std::to_string(profile.second.count) +
+            "\n";
+    }
+    return summary;
+}
+
+void ExecutionProfiler::merge(std::string summary,
+                              std::map<std::string, OperatorProfile>& profiles) {
+    std::istringstream lines(summary);
+    std::string line;
+    while (std::getline(lines, line)) {
+        size_t nameEnd = line.find('\t');
+        if (nameEnd == std::string::npos) {
+            continue;
+        }
+        OperatorProfile profile;
+        if (sscanf(line.c_str() + nameEnd + 1,
+                   "%ld\t%ld\t%ld\t%ld\t%ld\t%ld",
+                   &profile.numCalls,
+                   &profile.nanos,
+                   &profile.rowsIn,
+                   &profile.rowsOut,
+                   &profile.bytes,
+                   &profile.count) != 6) {
+            continue;
+        }
+        addTo(profiles[line.substr(0, nameEnd)], profile);
+    }
+}
+
+std::string ExecutionProfiler::format(std::map<std::string, OperatorProfile>& profiles,
+                                      std::string indent) {
+    std::string formatted;
+    char buffer[256];
+    for (auto& profile : profiles) {
+        if (profile.second.count > 0) {
+            snprintf(buffer,
+                     sizeof(buffer),
+                     "(calls=%ld count=%ld)",
+                     profile.second.numCalls,
+                     profile.second.count);
+        } else {
+            snprintf(buffer,
+                     sizeof(buffer),
+                     "(calls=%ld time=%.3fms rows in=%ld rows out=%ld bytes=%ld)",
+                     profile.second.numCalls,
+                     profile.second.nanos / 1000000.0,
+                     profile.second.rowsIn,
+                     profile.second.rowsOut,
+                     profile.second.bytes);
+        }
+        formatted += indent + profile.first + " " + buffer + "\n";
+    }
+    return formatted;
+}
+}
+
+#endif
@@ -0,0 +1,172 @@
+
+#ifndef PDB_TASK_SCHEDULER_H
+#define PDB_TASK_SCHEDULER_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <pthread.h>
+#include <vector>
+
+#include "PDBBuzzer.h"
+#include "PDBLogger.h"
+
+// the number of task runner threads of a worker queue; 0 means one per online CPU, but never
+// more than the number of workers of the queue
+#ifndef PDB_NUM_TASK_RUNNERS
+#define PDB_NUM_TASK_RUNNERS 0
+#endif
+
+// how long a runner that waits for a future, and finds nothing to run, sleeps before it looks
+// for tasks again, in microseconds
+#ifndef PDB_TASK_HELP_INTERVAL_US
+#define PDB_TASK_HELP_INTERVAL_US 1000
+#endif
+
+// This is a work-stealing task runtime that runs alongside the PDBWorkerQueue.  A PDBWorker
+// occupies a whole thread for as long as its PDBWork runs, and getWorker () blocks until a
+// thread is free; a task instead is a short function that is queued and run by one of a fixed
+// set of runner threads, sized to the number of CPUs.
+//
+// Each runner owns a deque: tasks submitted by a runner are pushed to the back of its own deque
+// and popped from the back again (so that a task and the tasks it spawns stay on one core),
+// while idle runners steal from the front of the other deques.  Tasks submitted from outside
+// the runners are spread round-robin over the deques.
+//
+// Each task comes with a future.  Waiting for a future on a runner thread does not block the
+// runner: it keeps running queued tasks until the future completes, so nested fan-outs
+// (a task that submits tasks and waits for them) can not deadlock, however few runners there
+// are.  Continuations can be attached to a future with then ().
+//
+// Tasks must not block on events that only other tasks can cause, other than by waiting for
+// futures.  Long-running loops that block on I/O or on a PageCircularBuffer should still be
+// run by a PDBWorker.
+
+namespace pdb {
+
+class PDBWorkerQueue;
+class PDBWork;
+typedef shared_ptr<PDBWork> PDBWorkPtr;
+
+class PDBTaskScheduler;
+typedef shared_ptr<PDBTaskScheduler> PDBTaskSchedulerPtr;
+
+class PDBTaskFuture;
+typedef shared_ptr<PDBTaskFuture> PDBTaskFuturePtr;
+
+typedef std::function<void()> PDBTask;
+
+class PDBTaskFuture {
+public:
+    PDBTaskFuture(PDBTaskScheduler* scheduler);
+    ~PDBTaskFuture();
+
+    // returns true once the task has run
+    bool isDone();
+
+    // blocks until the task has run; on a runner thread, runs other tasks in the meantime
+    void wait();
+
+    // submits the continuation to the scheduler once the task has run
+    void then(PDBTask continuation);
+
+private:
+    friend class PDBTaskScheduler;
+
+    // marks the task as run, wakes up the waiters and submits the continuations
+    void setDone();
+
+    PDBTaskScheduler* scheduler;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t doneSignal;
+    std::atomic<bool> done;
+    std::vector<PDBTask> continuations;
+};
+
+class PDBTaskScheduler {
+public:
+    // creates a scheduler with the given number of deques; the runner threads are created by
+    // the worker queue when the first task is submitted, and call runTasks (); without a worker
+    // queue, the caller has to run runTasks () on threads of its own
+    PDBTaskScheduler(PDBWorkerQueue* workers, int numRunners, PDBLoggerPtr logger);
+    ~PDBTaskScheduler();
+
+    // queues a task, and returns the future that completes once it has run
+    PDBTaskFuturePtr submit(PDBTask task);
+
+    // queues a PDBWork as a task; the work gets the buzzer as its caller buzzer, exactly as if
+    // it was run by a PDBWorker, so code that waits on buzzers does not change
+    PDBTaskFuturePtr submit(PDBWorkPtr work, PDBBuzzerPtr buzzer);
+
+    // runs one queued task on the calling thread, which must be a runner of this scheduler;
+    // returns false if there was no task to run
+    bool runOneTask();
+
+    // returns true if the calling thread is a runner of this scheduler
+    bool isRunner();
+
+    // the loop of a runner thread; returns once the scheduler is shut down and no task is left
+    void runTasks(int runnerId);
+
+    // lets the runners finish the queued tasks and exit; runners that were not started yet are
+    // never started
+    void shutDown();
+
+    int getNumRunners() {
+        return numRunners;
+    }
+
+private:
+    struct TaskEntry {
+        PDBTask task;
+        PDBTaskFuturePtr future;
+
+        // the profiler stage of the thread that submitted the task
+        const char* stage = nullptr;
+    };
+
+    // a deque of tasks, which is mostly used by its owner, so its mutex is rarely contended
+    struct TaskDeque {
+        pthread_mutex_t mutex;
+        std::deque<TaskEntry> tasks;
+    };
+
+    // takes a task from the back of the deque of the caller, or steals one from the front of
+    // another deque
+    bool takeTask(int runnerId, TaskEntry& entry);
+
+    void runTask(TaskEntry& entry);
+
+    // has the worker queue start the runner threads, if they were not started yet
+    void startRunners();
+
+    PDBWorkerQueue* workers;
+
+    int numRunners;
+
+    std::vector<TaskDeque*> deques;
+
+    // the deque that receives the next task submitted from outside the runners
+    std::atomic<unsigned int> nextDeque;
+
+    // the number of tasks in all deques
+    std::atomic<int> numQueued;
+
+    // idle runners sleep on this signal
+    pthread_mutex_t idleMutex;
+    pthread_cond_t idleSignal;
+    std::atomic<int> numSleeping;
+
+    std::atomic<bool> shuttingDown;
+
+    // whether the runner threads were started, protected by startMutex
+    std::atomic<bool> runnersStarted;
+    pthread_mutex_t startMutex;
+
+    PDBLoggerPtr logger;
+};
+}
+
+#endif
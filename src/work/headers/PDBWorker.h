@@ -64,6 +64,9 @@ private:
     // used to signal when we are done, or when some event happens
     PDBBuzzerPtr buzzWhenDone;
 
+    // the profiler stage of the thread that gave us the work
+    const char* profilerStage = nullptr;
+
     // for coordinating the thread who is running this guy
     pthread_mutex_t workerMutex;
     pthread_cond_t workToDoSignal;
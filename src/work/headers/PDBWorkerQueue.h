@@ -13,6 +13,7 @@
 
 #include "PDBLogger.h"
 #include "PDBWorker.h"
+#include "PDBTaskScheduler.h"
 #include <pthread.h>
 #include <set>
 #include <vector>
@@ -81,6 +82,17 @@ public:
     // gets the logger
     PDBLoggerPtr getLogger();
 
+    // gets the work-stealing task scheduler, whose runner threads are created when the first
+    // task is submitted (and, like the workers, have an allocator at the base of their stack)
+    PDBTaskSchedulerPtr getTaskScheduler();
+
+    // creates the runner threads of the task scheduler; called by the scheduler, once
+    void startTaskRunners();
+
+    // if set to true before a queue is created, each worker thread of the queue is pinned
+    // to one CPU, with consecutive workers spread round-robin over the NUMA nodes
+    static void setPinWorkers(bool pinWorkers);
+
 private:
     // these are the workers that are unassigned
     vector<PDBWorkerPtr> waiting;
@@ -95,6 +107,14 @@ private:
     // the list of all of the threads
     vector<pthread_t> threads;
 
+    // creates the runner thread of the task scheduler with the given id, whose call stack
+    // lives in the given range
+    void addTaskRunner(int runnerId, void* stackStart, void* stackEnd);
+
+    // the task scheduler, and the threads running its tasks
+    PDBTaskSchedulerPtr taskScheduler;
+    vector<pthread_t> runnerThreads;
+
     // the protecting mutex
     pthread_mutex_t workingMutex;
 
@@ -110,6 +130,9 @@ private:
     // a pointer to the original location for the call stacks for all of the worker threads
     // we need this so that we can free the memory at shutdown
     void* origStackBase;
+
+    // whether to pin worker threads to CPUs
+    static bool pinWorkers;
 };
 }
 
@@ -37,7 +37,7 @@ public:
         bool success;
         std::string errMsg;
         size_t objectSize = myCommunicator->getSizeOfNextObject();
-        myLogger->debug(std::string("SimpleRequestHandle: to receive object with size=") +
+        PDB_LOG_DEBUG(myLogger, std::string("SimpleRequestHandle: to receive object with size=") +
                         std::to_string(objectSize));
         if (objectSize == 0) {
             std::cout << "SimpleRequestHandler: object size=0" << std::endl;
@@ -73,7 +73,7 @@ public:
                 return;
             }
 
-            myLogger->info("SimpleRequestHandler: finished processing requet.");
+            PDB_LOG_INFO(myLogger, "SimpleRequestHandler: finished processing requet.");
             free(memory);
             callerBuzzer->buzz(PDBAlarm::WorkAllDone);
         }
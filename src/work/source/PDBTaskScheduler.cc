@@ -0,0 +1,247 @@
+
+#ifndef PDB_TASK_SCHEDULER_C
+#define PDB_TASK_SCHEDULER_C
+
+#include "PDBTaskScheduler.h"
+#include "ExecutionProfiler.h"
+#include "PDBWork.h"
+#include "PDBWorkerQueue.h"
+#include <sys/time.h>
+#include <time.h>
+
+namespace pdb {
+
+namespace {
+
+// the scheduler the calling thread runs tasks for, and the deque it owns
+thread_local PDBTaskScheduler* currentScheduler = nullptr;
+thread_local int currentRunnerId = -1;
+}
+
+PDBTaskFuture::PDBTaskFuture(PDBTaskScheduler* schedulerIn) : scheduler(schedulerIn) {
+    pthread_mutex_init(&mutex, nullptr);
+    pthread_cond_init(&doneSignal, nullptr);
+    done = false;
+}
+
+PDBTaskFuture::~PDBTaskFuture() {
+    pthread_mutex_destroy(&mutex);
+    pthread_cond_destroy(&doneSignal);
+}
+
+bool PDBTaskFuture::isDone() {
+    return done;
+}
+
+void PDBTaskFuture::wait() {
+    if (scheduler->isRunner()) {
+        // help instead of blocking the runner
+        while (!done) {
+            if (scheduler->runOneTask()) {
+                continue;
+            }
+            struct timeval now;
+            gettimeofday(&now, nullptr);
+            long nanos = (now.tv_usec + PDB_TASK_HELP_INTERVAL_US) * 1000L;
+            struct timespec deadline;
+            deadline.tv_sec = now.tv_sec + nanos / 1000000000L;
+            deadline.tv_nsec = nanos % 1000000000L;
+            pthread_mutex_lock(&mutex);
+            if (!done) {
+                pthread_cond_timedwait(&doneSignal, &mutex, &deadline);
+            }
+            pthread_mutex_unlock(&mutex);
+        }
+        return;
+    }
+    pthread_mutex_lock(&mutex);
+    while (!done) {
+        pthread_cond_wait(&doneSignal, &mutex);
+    }
+    pthread_mutex_unlock(&mutex);
+}
+
+void PDBTaskFuture::then(PDBTask continuation) {
+    pthread_mutex_lock(&mutex);
+    if (!done) {
+        continuations.push_back(continuation);
+        pthread_mutex_unlock(&mutex);
+        return;
+    }
+    pthread_mutex_unlock(&mutex);
+    scheduler->submit(continuation);
+}
+
+void PDBTaskFuture::setDone() {
+    std::vector<PDBTask> toSubmit;
+    pthread_mutex_lock(&mutex);
+    done = true;
+    pthread_cond_broadcast(&doneSignal);
+    toSubmit.swap(continuations);
+    pthread_mutex_unlock(&mutex);
+    for (PDBTask& continuation : toSubmit) {
+        scheduler->submit(continuation);
+    }
+}
+
+PDBTaskScheduler::PDBTaskScheduler(PDBWorkerQueue* workersIn,
+                                   int numRunnersIn,
+                                   PDBLoggerPtr loggerIn) {
+    workers = workersIn;
+    numRunners = (numRunnersIn > 0) ? numRunnersIn : 1;
+    logger = loggerIn;
+    for (int i = 0; i < numRunners; i++) {
+        TaskDeque* deque = new TaskDeque();
+        pthread_mutex_init(&deque->mutex, nullptr);
+        deques.push_back(deque);
+    }
+    nextDeque = 0;
+    numQueued = 0;
+    numSleeping = 0;
+    shuttingDown = false;
+    runnersStarted = false;
+    pthread_mutex_init(&startMutex, nullptr);
+    pthread_mutex_init(&idleMutex, nullptr);
+    pthread_cond_init(&idleSignal, nullptr);
+}
+
+PDBTaskScheduler::~PDBTaskScheduler() {
+    for (TaskDeque* deque : deques) {
+        pthread_mutex_destroy(&deque->mutex);
+        delete deque;
+    }
+    pthread_mutex_destroy(&startMutex);
+    pthread_mutex_destroy(&idleMutex);
+    pthread_cond_destroy(&idleSignal);
+}
+
+void PDBTaskScheduler::startRunners() {
+    pthread_mutex_lock(&startMutex);
+    if (!runnersStarted && !shuttingDown) {
+        if (workers != nullptr) {
+            workers->startTaskRunners();
+        }
+        runnersStarted = true;
+    }
+    pthread_mutex_unlock(&startMutex);
+}
+
+PDBTaskFuturePtr PDBTaskScheduler::submit(PDBTask task) {
+    PDBTaskFuturePtr future = make_shared<PDBTaskFuture>(this);
+    int target = isRunner() ? currentRunnerId : (int)(nextDeque++ % numRunners);
+    TaskDeque* deque = deques[target];
+    pthread_mutex_lock(&deque->mutex);
+    deque->tasks.push_back(TaskEntry{task, future, ExecutionProfiler::getStage()});
+    pthread_mutex_unlock(&deque->mutex);
+    numQueued++;
+    if (!runnersStarted) {
+        startRunners();
+    }
+
+    // a runner registers as sleeping before it checks numQueued, so either it sees our task,
+    // or we see it sleeping and wake it up
+    if (numSleeping > 0) {
+        pthread_mutex_lock(&idleMutex);
+        pthread_cond_signal(&idleSignal);
+        pthread_mutex_unlock(&idleMutex);
+    }
+    return future;
+}
+
+PDBTaskFuturePtr PDBTaskScheduler::submit(PDBWorkPtr work, PDBBuzzerPtr buzzer) {
+    PDBWorkerQueue* parent = workers;
+    return submit([parent, work, buzzer]() { work->execute(parent, buzzer); });
+}
+
+bool PDBTaskScheduler::isRunner() {
+    return currentScheduler == this;
+}
+
+bool PDBTaskScheduler::takeTask(int runnerId, TaskEntry& entry) {
+    if (numQueued <= 0) {
+        return false;
+    }
+
+    // first our own deque, newest task first
+    TaskDeque* deque = deques[runnerId];
+    pthread_mutex_lock(&deque->mutex);
+    if (!deque->tasks.empty()) {
+        entry = std::move(deque->tasks.back());
+        deque->tasks.pop_back();
+        pthread_mutex_unlock(&deque->mutex);
+        numQueued--;
+        return true;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+
+    // then steal the oldest task of another runner
+    for (int i = 1; i < numRunners; i++) {
+        deque = deques[(runnerId + i) % numRunners];
+        pthread_mutex_lock(&deque->mutex);
+        if (!deque->tasks.empty()) {
+            entry = std::move(deque->tasks.front());
+            deque->tasks.pop_front();
+            pthread_mutex_unlock(&deque->mutex);
+            numQueued--;
+            return true;
+        }
+        pthread_mutex_unlock(&deque->mutex);
+    }
+    return false;
+}
+
+void PDBTaskScheduler::runTask(TaskEntry& entry) {
+    // the task records its profile into the stage it was submitted for
+    ExecutionProfiler::StageScope stageScope(entry.stage);
+    entry.task();
+    entry.task = nullptr;
+    entry.future->setDone();
+    entry.future = nullptr;
+}
+
+bool PDBTaskScheduler::runOneTask() {
+    TaskEntry entry;
+    if (!takeTask(currentRunnerId, entry)) {
+        return false;
+    }
+    runTask(entry);
+    return true;
+}
+
+void PDBTaskScheduler::runTasks(int runnerId) {
+    currentScheduler = this;
+    currentRunnerId = runnerId;
+    while (true) {
+        TaskEntry entry;
+        if (takeTask(runnerId, entry)) {
+            runTask(entry);
+            continue;
+        }
+        pthread_mutex_lock(&idleMutex);
+        numSleeping++;
+        if (numQueued <= 0 && !shuttingDown) {
+            pthread_cond_wait(&idleSignal, &idleMutex);
+        }
+        numSleeping--;
+        bool exit = shuttingDown && numQueued <= 0;
+        pthread_mutex_unlock(&idleMutex);
+        if (exit) {
+            break;
+        }
+    }
+    currentScheduler = nullptr;
+    currentRunnerId = -1;
+}
+
+void PDBTaskScheduler::shutDown() {
+    pthread_mutex_lock(&startMutex);
+    shuttingDown = true;
+    pthread_mutex_unlock(&startMutex);
+    pthread_mutex_lock(&idleMutex);
+    shuttingDown = true;
+    pthread_cond_broadcast(&idleSignal);
+    pthread_mutex_unlock(&idleMutex);
+}
+}
+
+#endif
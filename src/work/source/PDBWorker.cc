@@ -3,6 +3,7 @@
 #define PDB_WORKER_C
 
 #include "Allocator.h"
+#include "ExecutionProfiler.h"
 #include "LockGuard.h"
 #include "PDBWorker.h"
 #include <iostream>
@@ -27,6 +28,7 @@ void PDBWorker::execute(PDBWorkPtr runMeIn, PDBBuzzerPtr buzzWhenDoneIn) {
     const LockGuard guard{workerMutex};
     runMe = runMeIn;
     buzzWhenDone = buzzWhenDoneIn;
+    profilerStage = ExecutionProfiler::getStage();
     okToExecute = true;
     pthread_cond_signal(&workToDoSignal);
 }
@@ -48,8 +50,11 @@ void PDBWorker::enter() {
     }
     getAllocator().cleanInactiveBlocks((size_t)(67108844));
     getAllocator().cleanInactiveBlocks((size_t)(12582912));
-    // then do the work
-    runMe->execute(parent, buzzWhenDone);
+    // then do the work, for the stage of the thread that gave it to us
+    {
+        ExecutionProfiler::StageScope stageScope(profilerStage);
+        runMe->execute(parent, buzzWhenDone);
+    }
     okToExecute = false;
 }
 
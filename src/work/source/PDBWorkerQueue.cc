@@ -8,12 +8,20 @@
 #include "NothingWork.h"
 #include <limits.h>
 #include "PDBWorkerQueue.h"
+#include "NumaTopology.h"
+#include <unistd.h>
 
 namespace pdb {
 
 extern void* stackBase;
 extern void* stackEnd;
 
+bool PDBWorkerQueue::pinWorkers = false;
+
+void PDBWorkerQueue::setPinWorkers(bool pinWorkersIn) {
+    pinWorkers = pinWorkersIn;
+}
+
 PDBWorkerQueue::PDBWorkerQueue(PDBLoggerPtr myLoggerIn, int numWorkers) {
 
     // first, make sure that another worker queue does not exist
@@ -38,15 +46,28 @@ PDBWorkerQueue::PDBWorkerQueue(PDBLoggerPtr myLoggerIn, int numWorkers) {
         exit(1);
     }
 
+    // the runners of the task scheduler get their stacks right after the ones of the workers
+    int numRunners = PDB_NUM_TASK_RUNNERS;
+    if (numRunners <= 0) {
+        numRunners = sysconf(_SC_NPROCESSORS_ONLN);
+        if (numRunners > numWorkers) {
+            numRunners = numWorkers;
+        }
+        if (numRunners <= 0) {
+            numRunners = 1;
+        }
+    }
+    int numStacks = numWorkers + numRunners;
+
     // this is the location where each worker is going to have their stack
-    origStackBase = calloc(1024 * 1024 * 4 * (numWorkers + 1), 1);
+    origStackBase = calloc(1024 * 1024 * 4 * (size_t)(numStacks + 1), 1);
     if (origStackBase == nullptr) {
-        std::cout << "PDBWorkerQueue.cc: Failed to allocate memory with size = " << 1024 * 1024 * 4 * (numWorkers + 1) << std::endl;
+        std::cout << "PDBWorkerQueue.cc: Failed to allocate memory with size = " << 1024 * 1024 * 4 * (size_t)(numStacks + 1) << std::endl;
         exit(1);
     }
     // align it to 2^22... chop off the last 22 bits, and then add 2^22 to the address
     stackBase = (void*)(((((size_t)origStackBase) >> 22) << 22) + (1024 * 1024 * 4));
-    stackEnd = ((char*)stackBase) + 1024 * 1024 * 4 * numWorkers;
+    stackEnd = ((char*)stackBase) + 1024 * 1024 * 4 * (size_t)numStacks;
 
     // create each worker...
     for (int i = 0; i < numWorkers; i++) {
@@ -60,14 +81,43 @@ PDBWorkerQueue::PDBWorkerQueue(PDBLoggerPtr myLoggerIn, int numWorkers) {
                          (i + 1) * 1024 * 1024 * 4 + ((char*)stackBase));
     }
     myLogger = myLoggerIn;
+
+    // the runners of the task scheduler are only created once the first task is submitted, so
+    // that processes that never use tasks do not pay for their threads
+    taskScheduler = make_shared<PDBTaskScheduler>(this, numRunners, myLogger);
+}
+
+void PDBWorkerQueue::startTaskRunners() {
+    // the stacks of the runners come right after the ones of the workers, each with an allocator
+    // of its own
+    size_t firstStack = threads.size();
+    for (int i = 0; i < taskScheduler->getNumRunners(); i++) {
+        char* stackStart = (firstStack + i) * 1024 * 1024 * 4 + ((char*)stackBase);
+        new (stackStart) Allocator(PDBWorkerQueue::defaultAllocatorBlockSize);
+        addTaskRunner(i, stackStart + sizeof(Allocator), stackStart + 1024 * 1024 * 4);
+    }
 }
 
 PDBLoggerPtr PDBWorkerQueue::getLogger() {
     return myLogger;
 }
 
+PDBTaskSchedulerPtr PDBWorkerQueue::getTaskScheduler() {
+    return taskScheduler;
+}
+
 PDBWorkerQueue::~PDBWorkerQueue() {
 
+    // let the runners finish the queued tasks first, since tasks may still use workers; once the
+    // scheduler is shut down, no more runners are started
+    taskScheduler->shutDown();
+    for (pthread_t thread : runnerThreads) {
+        if (pthread_join(thread, nullptr) != 0) {
+            cout << "Error joining with a task runner as the worker queue is shutting down!!\n";
+            exit(-1);
+        }
+    }
+
     // let everyone know we are shutting down
     shuttingDown = true;
 
@@ -101,7 +151,7 @@ PDBWorkerQueue::~PDBWorkerQueue() {
     pthread_cond_destroy(&waitingSignal);
 
     // kill the allocators and destroy the stack space
-    for (int i = 0; i < threads.size(); i++) {
+    for (size_t i = 0; i < threads.size() + runnerThreads.size(); i++) {
         ((Allocator*)(i * 1024 * 1024 * 4 + ((char*)stackBase)))->~Allocator();
     }
     free(origStackBase);
@@ -160,6 +210,17 @@ void PDBWorkerQueue::addAnotherWorker(void* stackBaseIn, void* stackEndIn) {
     // pthread_attr_setdetachstate(&tattr, PTHREAD_CREATE_DETACHED);
     pthread_attr_setstack(&tattr, stackBaseIn, ((char*)stackEndIn) - (char*)stackBaseIn);
 
+    // pin the thread if asked to
+    if (pinWorkers) {
+        std::vector<int> cpus = NumaTopology::getTopology().getInterleavedCpus();
+        if (cpus.size() > 0) {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(cpus[(threads.size() - 1) % cpus.size()], &cpuSet);
+            pthread_attr_setaffinity_np(&tattr, sizeof(cpu_set_t), &cpuSet);
+        }
+    }
+
     int return_code = pthread_create(&(threads[threads.size() - 1]), &tattr, enterTheQueue, this);
     if (return_code) {
         cout << "ERROR; return code from pthread_create () is " << return_code << '\n';
@@ -169,6 +230,54 @@ void PDBWorkerQueue::addAnotherWorker(void* stackBaseIn, void* stackEndIn) {
     }
 }
 
+// this is the entry point for all of the task runner threads
+
+struct TaskRunnerArgs {
+    PDBTaskScheduler* scheduler;
+    int runnerId;
+};
+
+void* enterTheTaskScheduler(void* taskRunnerArgs) {
+    TaskRunnerArgs* args = static_cast<TaskRunnerArgs*>(taskRunnerArgs);
+    PDBTaskScheduler* scheduler = args->scheduler;
+    int runnerId = args->runnerId;
+    delete args;
+    scheduler->runTasks(runnerId);
+    return nullptr;
+}
+
+void PDBWorkerQueue::addTaskRunner(int runnerId, void* stackBaseIn, void* stackEndIn) {
+
+    // adjust the stack base to align it correctly
+    stackBaseIn = (void*)((((long)stackBaseIn + (PTHREAD_STACK_MIN - 1)) / PTHREAD_STACK_MIN) *
+                          PTHREAD_STACK_MIN);
+
+    pthread_attr_t tattr;
+    pthread_attr_init(&tattr);
+    pthread_attr_setstack(&tattr, stackBaseIn, ((char*)stackEndIn) - (char*)stackBaseIn);
+
+    // runners are meant to be one per CPU, so they are pinned to consecutive CPUs if asked to
+    if (pinWorkers) {
+        std::vector<int> cpus = NumaTopology::getTopology().getInterleavedCpus();
+        if (cpus.size() > 0) {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(cpus[runnerId % cpus.size()], &cpuSet);
+            pthread_attr_setaffinity_np(&tattr, sizeof(cpu_set_t), &cpuSet);
+        }
+    }
+
+    pthread_t thread;
+    int return_code =
+        pthread_create(&thread, &tattr, enterTheTaskScheduler, new TaskRunnerArgs{taskScheduler.get(), runnerId});
+    pthread_attr_destroy(&tattr);
+    if (return_code) {
+        cout << "ERROR; return code from pthread_create () is " << return_code << '\n';
+        exit(-1);
+    }
+    runnerThreads.push_back(thread);
+}
+
 void PDBWorkerQueue::notifyAllWorkers(PDBAlarm withMe) {
     const LockGuard guard{workingMutex};
 
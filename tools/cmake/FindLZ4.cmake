@@ -0,0 +1,43 @@
+#.rst:
+# FindLZ4
+# --------
+# Finds the liblz4 library
+#
+# This will will define the following variables::
+#
+# LZ4_FOUND - system has liblz4
+# LZ4_INCLUDE_DIRS - the liblz4 include directory
+# LZ4_LIBRARIES - the liblz4 libraries
+#
+# and the following imported targets::
+#
+#   LZ4::LZ4   - The liblz4 library
+
+if(PKG_CONFIG_FOUND)
+  pkg_check_modules(PC_LZ4 liblz4 QUIET)
+endif()
+
+find_path(LZ4_INCLUDE_DIR lz4.h
+        PATHS ${PC_LZ4_INCLUDEDIR})
+find_library(LZ4_LIBRARY lz4
+        PATHS ${PC_LZ4_LIBRARY})
+set(LZ4_VERSION ${PC_LZ4_VERSION})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4
+        REQUIRED_VARS LZ4_LIBRARY LZ4_INCLUDE_DIR
+        VERSION_VAR LZ4_VERSION)
+
+if(LZ4_FOUND)
+  set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+  set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+
+  if(NOT TARGET LZ4::LZ4)
+    add_library(LZ4::LZ4 UNKNOWN IMPORTED)
+    set_target_properties(LZ4::LZ4 PROPERTIES
+            IMPORTED_LOCATION "${LZ4_LIBRARY}"
+            INTERFACE_INCLUDE_DIRECTORIES "${LZ4_INCLUDE_DIR}")
+  endif()
+endif()
+
+mark_as_advanced(LZ4_INCLUDE_DIR LZ4_LIBRARY)
@@ -0,0 +1,43 @@
+#.rst:
+# FindZstd
+# --------
+# Finds the libzstd library
+#
+# This will will define the following variables::
+#
+# ZSTD_FOUND - system has libzstd
+# ZSTD_INCLUDE_DIRS - the libzstd include directory
+# ZSTD_LIBRARIES - the libzstd libraries
+#
+# and the following imported targets::
+#
+#   ZSTD::ZSTD   - The libzstd library
+
+if(PKG_CONFIG_FOUND)
+  pkg_check_modules(PC_ZSTD libzstd QUIET)
+endif()
+
+find_path(ZSTD_INCLUDE_DIR zstd.h
+        PATHS ${PC_ZSTD_INCLUDEDIR})
+find_library(ZSTD_LIBRARY zstd
+        PATHS ${PC_ZSTD_LIBRARY})
+set(ZSTD_VERSION ${PC_ZSTD_VERSION})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(ZSTD
+        REQUIRED_VARS ZSTD_LIBRARY ZSTD_INCLUDE_DIR
+        VERSION_VAR ZSTD_VERSION)
+
+if(ZSTD_FOUND)
+  set(ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+  set(ZSTD_INCLUDE_DIRS ${ZSTD_INCLUDE_DIR})
+
+  if(NOT TARGET ZSTD::ZSTD)
+    add_library(ZSTD::ZSTD UNKNOWN IMPORTED)
+    set_target_properties(ZSTD::ZSTD PROPERTIES
+            IMPORTED_LOCATION "${ZSTD_LIBRARY}"
+            INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIR}")
+  endif()
+endif()
+
+mark_as_advanced(ZSTD_INCLUDE_DIR ZSTD_LIBRARY)